@@ -0,0 +1,476 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/simplecashflow.hpp>
+#include <ql/math/solvers1d/newtonsafe.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/settings.hpp>
+#include <typeinfo>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        const Spread basisPoint_ = 1.0e-4;
+
+        // same as in cashflows.cpp, with cumulated times
+        Real modifiedDuration(const std::vector<Time>& times,
+                              const std::vector<Real>& amounts,
+                              const InterestRate& y) {
+            Real P = 0.0;
+            Real dPdy = 0.0;
+            Rate r = y.rate();
+            Natural N = y.frequency();
+            for (Size i=0; i<times.size(); ++i) {
+                Time t = times[i];
+                Real c = amounts[i];
+                DiscountFactor B = y.discountFactor(t);
+                P += c * B;
+                switch (y.compounding()) {
+                  case Simple:
+                    dPdy -= c * B*B * t;
+                    break;
+                  case Compounded:
+                    dPdy -= c * t * B/(1+r/N);
+                    break;
+                  case Continuous:
+                    dPdy -= c * B * t;
+                    break;
+                  case SimpleThenCompounded:
+                    if (t<=1.0/N)
+                        dPdy -= c * B*B * t;
+                    else
+                        dPdy -= c * t * B/(1+r/N);
+                    break;
+                  case CompoundedThenSimple:
+                    if (t>1.0/N)
+                        dPdy -= c * B*B * t;
+                    else
+                        dPdy -= c * t * B/(1+r/N);
+                    break;
+                  default:
+                    QL_FAIL("unknown compounding convention (" <<
+                            Integer(y.compounding()) << ")");
+                }
+            }
+            if (P == 0.0) // no cashflows
+                return 0.0;
+            return -dPdy/P; // reverse derivative sign
+        }
+
+        template <class T>
+        Integer sign(T x) {
+            static T zero = T();
+            if (x == zero)
+                return 0;
+            else if (x > zero)
+                return 1;
+            else
+                return -1;
+        }
+
+        std::vector<Time> cumulated(std::vector<Time> steps) {
+            for (Size i=1; i<steps.size(); ++i)
+                steps[i] += steps[i-1];
+            return steps;
+        }
+
+    }
+
+
+    class CompiledLeg::IrrFinder {
+      public:
+        IrrFinder(const CompiledLeg& leg,
+                  Real npv,
+                  DayCounter dayCounter,
+                  Compounding compounding,
+                  Frequency frequency,
+                  Date npvDate)
+        : npv_(npv), dayCounter_(std::move(dayCounter)),
+          compounding_(compounding), frequency_(frequency),
+          steps_(leg.stepwiseTimes(dayCounter_, npvDate)),
+          times_(cumulated(steps_)) {
+            leg.amounts(amounts_, nullptr);
+            for (Size i=0; i<amounts_.size(); ++i) {
+                if (leg.exCoupon_[i] != 0)
+                    amounts_[i] = 0.0;
+            }
+            checkSign();
+        }
+        Real operator()(Rate y) const {
+            InterestRate yield(y, dayCounter_, compounding_, frequency_);
+            Real NPV = 0.0;
+            DiscountFactor discount = 1.0;
+            for (Size i=0; i<amounts_.size(); ++i) {
+                discount *= yield.discountFactor(steps_[i]);
+                NPV += amounts_[i] * discount;
+            }
+            return npv_ - NPV;
+        }
+        Real derivative(Rate y) const {
+            InterestRate yield(y, dayCounter_, compounding_, frequency_);
+            return modifiedDuration(times_, amounts_, yield);
+        }
+      private:
+        void checkSign() const {
+            // ex-coupon amounts were set to zero and don't count
+            Integer lastSign = sign(-npv_),
+                    signChanges = 0;
+            for (Real amount : amounts_) {
+                Integer thisSign = sign(amount);
+                if (lastSign * thisSign < 0) // sign change
+                    signChanges++;
+                if (thisSign != 0)
+                    lastSign = thisSign;
+            }
+            QL_REQUIRE(signChanges > 0,
+                       "the given cash flows cannot result in the given "
+                       "market price due to their sign");
+        }
+        Real npv_;
+        DayCounter dayCounter_;
+        Compounding compounding_;
+        Frequency frequency_;
+        std::vector<Time> steps_, times_;
+        std::vector<Real> amounts_;
+    };
+
+
+    CompiledLeg::CompiledLeg(const Leg& leg,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate,
+                             const DayCounter& curveDayCounter,
+                             Date curveReferenceDate)
+    : settlementDate_(settlementDate), curveDayCounter_(curveDayCounter),
+      curveReferenceDate_(curveReferenceDate) {
+        const Date today = Settings::instance().evaluationDate();
+        if (settlementDate_ == Date())
+            settlementDate_ = today;
+        if (curveReferenceDate_ == Date())
+            curveReferenceDate_ = today;
+
+        for (const auto& cf : leg) {
+            if (cf->hasOccurred(settlementDate_, includeSettlementDateFlows))
+                continue;
+
+            const Size i = dates_.size();
+            dates_.push_back(cf->date());
+            exCoupon_.push_back(cf->tradingExCoupon(settlementDate_) ? 1 : 0);
+
+            auto coupon = ext::dynamic_pointer_cast<Coupon>(cf);
+            if (coupon != nullptr) {
+                isCoupon_.push_back(1);
+                accrualStartDates_.push_back(coupon->accrualStartDate());
+                referencePeriodStarts_.push_back(
+                                            coupon->referencePeriodStart());
+                referencePeriodEnds_.push_back(coupon->referencePeriodEnd());
+                bpsWeights_.push_back(coupon->nominal() *
+                                      coupon->accrualPeriod());
+            } else {
+                isCoupon_.push_back(0);
+                accrualStartDates_.emplace_back();
+                referencePeriodStarts_.emplace_back();
+                referencePeriodEnds_.emplace_back();
+                bpsWeights_.push_back(0.0);
+            }
+
+            // amounts known in advance
+            if (ext::dynamic_pointer_cast<FixedRateCoupon>(cf) != nullptr ||
+                ext::dynamic_pointer_cast<SimpleCashFlow>(cf) != nullptr) {
+                fixedAmounts_.push_back(cf->amount());
+                continue;
+            }
+            fixedAmounts_.push_back(0.0);
+
+            // Ibor coupons projected on the forwarding curve; the
+            // others, including derived classes and coupons fixed or
+            // fixing today, are asked for their amounts
+            auto ibor = ext::dynamic_pointer_cast<IborCoupon>(cf);
+            if (ibor != nullptr && typeid(*ibor) == typeid(IborCoupon)
+                && !ibor->isInArrears() && ibor->fixingDate() > today
+                && !ibor->iborIndex()->forwardingTermStructure().empty()) {
+                auto pricer = ext::dynamic_pointer_cast<BlackIborCouponPricer>(
+                                                             ibor->pricer());
+                if (pricer != nullptr
+                    && typeid(*pricer) == typeid(BlackIborCouponPricer)
+                    && pricer->timingAdjustment()
+                       == BlackIborCouponPricer::Black76) {
+                    const Real weight =
+                        ibor->nominal() * ibor->accrualPeriod();
+                    Floating f = {
+                        i, ibor->fixingValueDate(), ibor->fixingEndDate(),
+                        ibor->spanningTime(),
+                        weight * ibor->spread(), weight * ibor->gearing(),
+                        ibor->iborIndex()->forwardingTermStructure()
+                    };
+                    floating_.push_back(f);
+                    continue;
+                }
+            }
+            generic_.emplace_back(i, cf);
+        }
+
+        if (!curveDayCounter_.empty()) {
+            times_.resize(dates_.size());
+            for (Size i=0; i<dates_.size(); ++i)
+                times_[i] = curveDayCounter_.yearFraction(curveReferenceDate_,
+                                                          dates_[i]);
+        }
+    }
+
+    void CompiledLeg::amounts(std::vector<Real>& amounts,
+                              const YieldTermStructure* forecastCurve) const {
+        amounts = fixedAmounts_;
+        for (const auto& f : floating_) {
+            QL_REQUIRE(forecastCurve != nullptr || !f.forwardingCurve.empty(),
+                       "null forwarding term structure for the coupon at "
+                       "index " << f.index);
+            const YieldTermStructure& curve =
+                forecastCurve != nullptr ? *forecastCurve
+                                         : *f.forwardingCurve.currentLink();
+            Rate forward = (curve.discount(f.valueDate) /
+                            curve.discount(f.endDate) - 1.0) / f.spanningTime;
+            amounts[f.index] = f.a + f.b * forward;
+        }
+        for (const auto& g : generic_)
+            amounts[g.first] = g.second->amount();
+    }
+
+    void CompiledLeg::discounts(std::vector<DiscountFactor>& discounts,
+                                const YieldTermStructure& curve) const {
+        discounts.resize(dates_.size());
+        if (!times_.empty()
+            && curve.referenceDate() == curveReferenceDate_
+            && curve.dayCounter() == curveDayCounter_) {
+            for (Size i=0; i<times_.size(); ++i)
+                discounts[i] = curve.discount(times_[i]);
+        } else {
+            for (Size i=0; i<dates_.size(); ++i)
+                discounts[i] = curve.discount(dates_[i]);
+        }
+    }
+
+    std::vector<Time> CompiledLeg::stepwiseTimes(const DayCounter& dc,
+                                                 Date npvDate) const {
+        // same as getStepwiseDiscountTime in cashflows.cpp
+        std::vector<Time> steps(dates_.size());
+        Date lastDate = npvDate;
+        for (Size i=0; i<dates_.size(); ++i) {
+            const Date& cashFlowDate = dates_[i];
+            Date refStartDate, refEndDate;
+            if (isCoupon_[i] != 0) {
+                refStartDate = referencePeriodStarts_[i];
+                refEndDate = referencePeriodEnds_[i];
+            } else {
+                if (lastDate == npvDate) {
+                    // we don't have a previous coupon date,
+                    // so we fake it
+                    refStartDate = cashFlowDate - 1*Years;
+                } else  {
+                    refStartDate = lastDate;
+                }
+                refEndDate = cashFlowDate;
+            }
+
+            if (isCoupon_[i] != 0 && lastDate != accrualStartDates_[i]) {
+                Time couponPeriod = dc.yearFraction(accrualStartDates_[i],
+                                                    cashFlowDate,
+                                                    refStartDate, refEndDate);
+                Time accruedPeriod = dc.yearFraction(accrualStartDates_[i],
+                                                     lastDate,
+                                                     refStartDate, refEndDate);
+                steps[i] = couponPeriod - accruedPeriod;
+            } else {
+                steps[i] = dc.yearFraction(lastDate, cashFlowDate,
+                                           refStartDate, refEndDate);
+            }
+            lastDate = cashFlowDate;
+        }
+        return steps;
+    }
+
+    Real CompiledLeg::npv(const YieldTermStructure& discountCurve,
+                          Date npvDate) const {
+        return npv(discountCurve, nullptr, npvDate);
+    }
+
+    Real CompiledLeg::npv(const YieldTermStructure& discountCurve,
+                          const YieldTermStructure& forecastCurve,
+                          Date npvDate) const {
+        return npv(discountCurve, &forecastCurve, npvDate);
+    }
+
+    Real CompiledLeg::npv(const YieldTermStructure& discountCurve,
+                          const YieldTermStructure* forecastCurve,
+                          Date npvDate) const {
+        if (dates_.empty())
+            return 0.0;
+
+        if (npvDate == Date())
+            npvDate = settlementDate_;
+
+        std::vector<Real> c;
+        std::vector<DiscountFactor> B;
+        amounts(c, forecastCurve);
+        discounts(B, discountCurve);
+        Real totalNPV = 0.0;
+        for (Size i=0; i<c.size(); ++i) {
+            if (exCoupon_[i] == 0)
+                totalNPV += c[i] * B[i];
+        }
+        return totalNPV/discountCurve.discount(npvDate);
+    }
+
+    Real CompiledLeg::bps(const YieldTermStructure& discountCurve,
+                          Date npvDate) const {
+        if (dates_.empty())
+            return 0.0;
+
+        if (npvDate == Date())
+            npvDate = settlementDate_;
+
+        std::vector<DiscountFactor> B;
+        discounts(B, discountCurve);
+        Real bps = 0.0;
+        for (Size i=0; i<B.size(); ++i) {
+            if (exCoupon_[i] == 0)
+                bps += bpsWeights_[i] * B[i];
+        }
+        return basisPoint_*bps/discountCurve.discount(npvDate);
+    }
+
+    void CompiledLeg::npvbps(const YieldTermStructure& discountCurve,
+                             Date npvDate,
+                             Real& npv,
+                             Real& bps) const {
+        npv = bps = 0.0;
+        if (dates_.empty())
+            return;
+
+        if (npvDate == Date())
+            npvDate = settlementDate_;
+
+        std::vector<Real> c;
+        std::vector<DiscountFactor> B;
+        amounts(c, nullptr);
+        discounts(B, discountCurve);
+        for (Size i=0; i<c.size(); ++i) {
+            if (exCoupon_[i] == 0) {
+                npv += c[i] * B[i];
+                bps += bpsWeights_[i] * B[i];
+            }
+        }
+        DiscountFactor d = discountCurve.discount(npvDate);
+        npv /= d;
+        bps = basisPoint_ * bps / d;
+    }
+
+    Real CompiledLeg::npv(const InterestRate& y, Date npvDate) const {
+        if (dates_.empty())
+            return 0.0;
+
+        if (npvDate == Date())
+            npvDate = settlementDate_;
+
+        std::vector<Real> c;
+        amounts(c, nullptr);
+        std::vector<Time> steps = stepwiseTimes(y.dayCounter(), npvDate);
+        Real npv = 0.0;
+        DiscountFactor discount = 1.0;
+        for (Size i=0; i<c.size(); ++i) {
+            discount *= y.discountFactor(steps[i]);
+            if (exCoupon_[i] == 0)
+                npv += c[i] * discount;
+        }
+        return npv;
+    }
+
+    Real CompiledLeg::bps(const InterestRate& yield, Date npvDate) const {
+        if (dates_.empty())
+            return 0.0;
+
+        FlatForward flatRate(settlementDate_, yield.rate(),
+                             yield.dayCounter(), yield.compounding(),
+                             yield.frequency());
+        return bps(flatRate, npvDate);
+    }
+
+    Rate CompiledLeg::yield(Real npv,
+                            const DayCounter& dayCounter,
+                            Compounding compounding,
+                            Frequency frequency,
+                            Date npvDate,
+                            Real accuracy,
+                            Size maxIterations,
+                            Rate guess) const {
+        if (npvDate == Date())
+            npvDate = settlementDate_;
+
+        IrrFinder objFunction(*this, npv, dayCounter, compounding,
+                              frequency, npvDate);
+        NewtonSafe solver;
+        solver.setMaxEvaluations(maxIterations);
+        return solver.solve(objFunction, accuracy, guess, guess/10.0);
+    }
+
+    Time CompiledLeg::duration(const InterestRate& y,
+                               Duration::Type type,
+                               Date npvDate) const {
+        if (dates_.empty())
+            return 0.0;
+
+        if (npvDate == Date())
+            npvDate = settlementDate_;
+
+        std::vector<Real> c;
+        amounts(c, nullptr);
+        for (Size i=0; i<c.size(); ++i) {
+            if (exCoupon_[i] != 0)
+                c[i] = 0.0;
+        }
+        const std::vector<Time> t =
+            cumulated(stepwiseTimes(y.dayCounter(), npvDate));
+
+        switch (type) {
+          case Duration::Simple: {
+              Real P = 0.0, dPdy = 0.0;
+              for (Size i=0; i<c.size(); ++i) {
+                  DiscountFactor B = y.discountFactor(t[i]);
+                  P += c[i] * B;
+                  dPdy += t[i] * c[i] * B;
+              }
+              if (P == 0.0) // no cashflows
+                  return 0.0;
+              return dPdy/P;
+          }
+          case Duration::Modified:
+            return modifiedDuration(t, c, y);
+          case Duration::Macaulay:
+            QL_REQUIRE(y.compounding() == Compounded,
+                       "compounded rate required");
+            return (1.0+y.rate()/y.frequency()) * modifiedDuration(t, c, y);
+          default:
+            QL_FAIL("unknown duration type");
+        }
+    }
+
+}
@@ -0,0 +1,148 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compiledleg.hpp
+    \brief Snapshot of a leg for repeated cash-flow analysis
+*/
+
+#ifndef quantlib_compiled_leg_hpp
+#define quantlib_compiled_leg_hpp
+
+#include <ql/cashflows/duration.hpp>
+#include <ql/cashflow.hpp>
+#include <ql/handle.hpp>
+#include <ql/interestrate.hpp>
+
+namespace QuantLib {
+
+    class YieldTermStructure;
+
+    //! Snapshot of a leg for repeated cash-flow analysis
+    /*! The cash flows of the leg which didn't occur at the given
+        settlement date are stored into contiguous arrays, so that
+        the functions below can be called repeatedly, e.g., under
+        different discount curves or yields, without going through
+        the cash flows each time.  Their results are the same as
+        those of the corresponding functions in the CashFlows class.
+
+        Fixed-rate coupons and simple cash flows are stored with
+        their amounts.  Ibor coupons which didn't fix yet and which
+        are priced by a BlackIborCouponPricer without convexity
+        adjustments are stored with their projection parameters, and
+        their amounts are projected on the forwarding curve of their
+        index or on the given forecast curve.  The amounts of any
+        other cash flows are asked to the cash flows at each call.
+
+        If a discount curve has the same reference date and day
+        counter passed to the constructor, the discount factors are
+        calculated from the times stored in the snapshot.
+
+        \warning the leg must be compiled again if its cash flows or
+                 their pricers change, as well as when the evaluation
+                 date changes.
+
+        \ingroup cashflows
+    */
+    class CompiledLeg {
+      public:
+        CompiledLeg(const Leg& leg,
+                    bool includeSettlementDateFlows,
+                    Date settlementDate = Date(),
+                    const DayCounter& curveDayCounter = DayCounter(),
+                    Date curveReferenceDate = Date());
+        //! \name Inspectors
+        //@{
+        //! number of cash flows not occurred at the settlement date
+        Size size() const { return dates_.size(); }
+        //! number of cash flows whose amounts are not stored
+        Size genericCashFlows() const { return generic_.size(); }
+        const Date& settlementDate() const { return settlementDate_; }
+        //@}
+        //! \name YieldTermStructure functions
+        //@{
+        Real npv(const YieldTermStructure& discountCurve,
+                 Date npvDate = Date()) const;
+        /*! NPV with the stored Ibor coupons projected on the forecast
+            curve instead of the forwarding curve of their index. */
+        Real npv(const YieldTermStructure& discountCurve,
+                 const YieldTermStructure& forecastCurve,
+                 Date npvDate = Date()) const;
+        Real bps(const YieldTermStructure& discountCurve,
+                 Date npvDate = Date()) const;
+        void npvbps(const YieldTermStructure& discountCurve,
+                    Date npvDate,
+                    Real& npv,
+                    Real& bps) const;
+        //@}
+        //! \name Yield functions
+        //@{
+        Real npv(const InterestRate& yield,
+                 Date npvDate = Date()) const;
+        Real bps(const InterestRate& yield,
+                 Date npvDate = Date()) const;
+        Rate yield(Real npv,
+                   const DayCounter& dayCounter,
+                   Compounding compounding,
+                   Frequency frequency,
+                   Date npvDate = Date(),
+                   Real accuracy = 1.0e-10,
+                   Size maxIterations = 100,
+                   Rate guess = 0.05) const;
+        Time duration(const InterestRate& yield,
+                      Duration::Type type,
+                      Date npvDate = Date()) const;
+        //@}
+      private:
+        class IrrFinder;
+        void amounts(std::vector<Real>& amounts,
+                     const YieldTermStructure* forecastCurve) const;
+        void discounts(std::vector<DiscountFactor>& discounts,
+                       const YieldTermStructure& discountCurve) const;
+        std::vector<Time> stepwiseTimes(const DayCounter& dayCounter,
+                                        Date npvDate) const;
+        Real npv(const YieldTermStructure& discountCurve,
+                 const YieldTermStructure* forecastCurve,
+                 Date npvDate) const;
+        Date settlementDate_;
+        DayCounter curveDayCounter_;
+        Date curveReferenceDate_;
+        // all cash flows
+        std::vector<Date> dates_;
+        std::vector<Time> times_;
+        std::vector<Real> fixedAmounts_, bpsWeights_;
+        std::vector<char> exCoupon_;
+        // coupon data used for yield calculations
+        std::vector<char> isCoupon_;
+        std::vector<Date> accrualStartDates_;
+        std::vector<Date> referencePeriodStarts_, referencePeriodEnds_;
+        // Ibor coupons: amount = a + b * forward rate
+        struct Floating {
+            Size index;
+            Date valueDate, endDate;
+            Time spanningTime;
+            Real a, b;
+            Handle<YieldTermStructure> forwardingCurve;
+        };
+        std::vector<Floating> floating_;
+        // any other cash flows
+        std::vector<std::pair<Size, ext::shared_ptr<CashFlow> > > generic_;
+    };
+
+}
+
+
+#endif
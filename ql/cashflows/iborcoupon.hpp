@@ -56,6 +56,9 @@ namespace QuantLib {
         const ext::shared_ptr<IborIndex>& iborIndex() const { return iborIndex_; }
         //! this is dependent on usingAtParCoupons()
         const Date& fixingEndDate() const { return fixingEndDate_; }
+        const Date& fixingValueDate() const { return fixingValueDate_; }
+        //! time between fixingValueDate() and fixingEndDate()
+        Time spanningTime() const { return spanningTime_; }
         //@}
         //! \name FloatingRateCoupon interface
         //@{
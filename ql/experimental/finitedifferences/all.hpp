@@ -2,7 +2,9 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/experimental/finitedifferences/dynprogvppintrinsicvalueengine.hpp>
+#include <ql/experimental/finitedifferences/fdblackscholesfwddensityengine.hpp>
 #include <ql/experimental/finitedifferences/fdextoujumpvanillaengine.hpp>
+#include <ql/experimental/finitedifferences/fdhestonfwddensityengine.hpp>
 #include <ql/experimental/finitedifferences/fdklugeextouspreadengine.hpp>
 #include <ql/experimental/finitedifferences/fdmblackscholesfwdop.hpp>
 #include <ql/experimental/finitedifferences/fdmdupire1dop.hpp>
@@ -0,0 +1,127 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/experimental/finitedifferences/fdblackscholesfwddensityengine.hpp>
+#include <ql/experimental/finitedifferences/fdmblackscholesfwdop.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmforwarddensitysolver.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+        // discrete Dirac delta at x0, spread over the neighbouring nodes
+        Disposable<Array> diracDensity(const Array& x, Real x0) {
+            QL_REQUIRE(x.size() > 3 && x[1] <= x0 && x[x.size()-2] >= x0,
+                       "insufficient mesher");
+
+            Array p(x.size(), 0.0);
+
+            const Size upper = std::upper_bound(x.begin(), x.end()-1, x0)
+                             - x.begin();
+            const Size lower = upper-1;
+
+            const Real dx = x[upper] - x[lower];
+            p[lower] = (x[upper] - x0)/dx/(0.5*(x[lower+1] - x[lower-1]));
+            p[upper] = (x0 - x[lower])/dx/(0.5*(x[upper+1] - x[upper-1]));
+
+            return p;
+        }
+    }
+
+    FdBlackScholesFwdDensityEngine::FdBlackScholesFwdDensityEngine(
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+        Size tGrid,
+        Size xGrid,
+        Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc,
+        bool localVol,
+        Real illegalLocalVolOverwrite)
+    : process_(std::move(process)), tGrid_(tGrid), xGrid_(xGrid),
+      dampingSteps_(dampingSteps), schemeDesc_(schemeDesc),
+      localVol_(localVol),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {
+        registerWith(process_);
+    }
+
+    void FdBlackScholesFwdDensityEngine::registerExpiries(
+                                        const std::vector<Date>& expiries) {
+        for (const auto& expiry : expiries)
+            if (std::find(expiries_.begin(), expiries_.end(), expiry)
+                    == expiries_.end())
+                expiries_.push_back(expiry);
+        solver_.reset();
+    }
+
+    void FdBlackScholesFwdDensityEngine::update() {
+        solver_.reset();
+        VanillaOption::engine::update();
+    }
+
+    ext::shared_ptr<FdmForwardDensitySolver>
+    FdBlackScholesFwdDensityEngine::densitySolver() const {
+        std::vector<Time> times;
+        for (const auto& expiry : expiries_) {
+            const Time t = process_->time(expiry);
+            if (t > 0.0)
+                times.push_back(t);
+        }
+        const Time maturity = *std::max_element(times.begin(), times.end());
+
+        const Real spot = process_->x0();
+        const ext::shared_ptr<FdmMesher> mesher(
+            ext::make_shared<FdmMesherComposite>(
+                ext::make_shared<FdmBlackScholesMesher>(
+                    xGrid_, process_, maturity, spot,
+                    Null<Real>(), Null<Real>(), 1e-5, 1.5,
+                    std::pair<Real, Real>(spot, 0.1))));
+
+        const ext::shared_ptr<FdmLinearOpComposite> fwdOp(
+            ext::make_shared<FdmBlackScholesFwdOp>(
+                mesher, process_, spot, localVol_,
+                illegalLocalVolOverwrite_));
+
+        return ext::make_shared<FdmForwardDensitySolver>(
+            mesher, fwdOp, diracDensity(mesher->locations(0), std::log(spot)),
+            0.0, times, tGrid_, dampingSteps_, schemeDesc_);
+    }
+
+    void FdBlackScholesFwdDensityEngine::calculate() const {
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        const Date expiry = arguments_.exercise->lastDate();
+        const Time maturity = process_->time(expiry);
+        QL_REQUIRE(maturity > 0.0, "expired option");
+
+        if (std::find(expiries_.begin(), expiries_.end(), expiry)
+                == expiries_.end()) {
+            expiries_.push_back(expiry);
+            solver_.reset();
+        }
+        if (solver_ == nullptr)
+            solver_ = densitySolver();
+
+        results_.value = process_->riskFreeRate()->discount(expiry)
+            * solver_->expectation(solver_->timeIndex(maturity),
+                                   *arguments_.payoff);
+    }
+}
@@ -0,0 +1,81 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdblackscholesfwddensityengine.hpp
+    \brief Fokker-Planck forward density engine for European options
+*/
+
+#ifndef quantlib_fd_black_scholes_fwd_density_engine_hpp
+#define quantlib_fd_black_scholes_fwd_density_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+namespace QuantLib {
+
+    class FdmForwardDensitySolver;
+    class GeneralizedBlackScholesProcess;
+
+    //! Fokker-Planck forward density engine for European options
+    /*! The transition density of the log-spot is evolved once up to
+        the last registered expiry; every European option expiring
+        at a registered date is then priced by integrating its payoff
+        against the density snapshot at its expiry, so that a whole
+        volatility surface costs a single forward solve.  Options
+        with expiries that were not registered are added to the set,
+        which triggers a new solve.
+
+        With local volatility, the forward equation is driven by the
+        local volatility surface; otherwise the at-the-money Black
+        volatility is used.
+
+        Only the value of the options is calculated.
+
+        \ingroup vanillaengines
+    */
+    class FdBlackScholesFwdDensityEngine : public VanillaOption::engine {
+      public:
+        explicit FdBlackScholesFwdDensityEngine(
+            ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+            Size tGrid = 100,
+            Size xGrid = 400,
+            Size dampingSteps = 2,
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
+            bool localVol = false,
+            Real illegalLocalVolOverwrite = -Null<Real>());
+
+        void calculate() const override;
+        void update() override;
+
+        //! expiries of the options priced by a single forward solve
+        void registerExpiries(const std::vector<Date>& expiries);
+
+      private:
+        ext::shared_ptr<FdmForwardDensitySolver> densitySolver() const;
+
+        const ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        const Size tGrid_, xGrid_, dampingSteps_;
+        const FdmSchemeDesc schemeDesc_;
+        const bool localVol_;
+        const Real illegalLocalVolOverwrite_;
+
+        mutable std::vector<Date> expiries_;
+        mutable ext::shared_ptr<FdmForwardDensitySolver> solver_;
+    };
+}
+
+#endif
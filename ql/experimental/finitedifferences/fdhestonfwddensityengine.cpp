@@ -0,0 +1,140 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+#include <ql/exercise.hpp>
+#include <ql/experimental/finitedifferences/fdhestonfwddensityengine.hpp>
+#include <ql/experimental/finitedifferences/fdmhestonfwdop.hpp>
+#include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmforwarddensitysolver.hpp>
+#include <ql/methods/finitedifferences/utilities/hestonrndcalculator.hpp>
+#include <ql/methods/finitedifferences/utilities/squarerootprocessrndcalculator.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    FdHestonFwdDensityEngine::FdHestonFwdDensityEngine(
+        const ext::shared_ptr<HestonModel>& model,
+        Size tGrid,
+        Size xGrid,
+        Size vGrid,
+        Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc,
+        FdmHestonGreensFct::Algorithm greensAlgorithm)
+    : GenericModelEngine<HestonModel,
+                         VanillaOption::arguments,
+                         VanillaOption::results>(model),
+      tGrid_(tGrid), xGrid_(xGrid), vGrid_(vGrid),
+      dampingSteps_(dampingSteps), schemeDesc_(schemeDesc),
+      greensAlgorithm_(greensAlgorithm) {}
+
+    void FdHestonFwdDensityEngine::registerExpiries(
+                                        const std::vector<Date>& expiries) {
+        for (const auto& expiry : expiries)
+            if (std::find(expiries_.begin(), expiries_.end(), expiry)
+                    == expiries_.end())
+                expiries_.push_back(expiry);
+        solver_.reset();
+    }
+
+    void FdHestonFwdDensityEngine::update() {
+        solver_.reset();
+        GenericModelEngine<HestonModel, VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    ext::shared_ptr<FdmForwardDensitySolver>
+    FdHestonFwdDensityEngine::densitySolver() const {
+        const ext::shared_ptr<HestonProcess> process = model_->process();
+
+        std::vector<Time> times;
+        for (const auto& expiry : expiries_) {
+            const Time t = process->time(expiry);
+            if (t > 0.0)
+                times.push_back(t);
+        }
+        const Time maturity = *std::max_element(times.begin(), times.end());
+
+        // the first day is bridged by the Green's function
+        const Time t0 = std::min(1.0/365,
+            0.5*(*std::min_element(times.begin(), times.end())));
+
+        // 1. log-spot mesher
+        const Real eps = 1e-4;
+        const HestonRNDCalculator spotRnd(process);
+        const Real x0 = std::log(process->s0()->value());
+        const Real xMin = std::min(spotRnd.invcdf(eps, maturity), x0 - 0.1);
+        const Real xMax = std::max(spotRnd.invcdf(1-eps, maturity), x0 + 0.1);
+
+        // 2. log-variance mesher
+        const Real v0 = process->v0();
+        const SquareRootProcessRNDCalculator varianceRnd(
+            v0, process->kappa(), process->theta(), process->sigma());
+
+        const Real z0 = std::log(v0);
+        const Real zMin = std::min(std::log(1e-5), z0 - 1.0);
+        const Real zMax = std::max(
+            std::log(varianceRnd.stationary_invcdf(0.9995)), z0 + 1.0);
+
+        const std::vector<ext::tuple<Real, Real, bool> > cPoints = {
+            ext::make_tuple(zMin, 1.0, false),
+            ext::make_tuple(z0, 10.0, true),
+            ext::make_tuple(zMax, 100.0, false)
+        };
+
+        const ext::shared_ptr<FdmMesher> mesher(
+            ext::make_shared<FdmMesherComposite>(
+                ext::make_shared<Concentrating1dMesher>(
+                    xMin, xMax, xGrid_, std::make_pair(x0, 0.1), true),
+                ext::make_shared<Concentrating1dMesher>(
+                    zMin, zMax, vGrid_, cPoints, 1e-12)));
+
+        // 3. forward operator and initial density
+        const ext::shared_ptr<FdmLinearOpComposite> fwdOp(
+            ext::make_shared<FdmHestonFwdOp>(
+                mesher, process, FdmSquareRootFwdOp::Log));
+
+        const Array p0 =
+            FdmHestonGreensFct(mesher, process, FdmSquareRootFwdOp::Log)
+                .get(t0, greensAlgorithm_);
+
+        return ext::make_shared<FdmForwardDensitySolver>(
+            mesher, fwdOp, p0, t0, times, tGrid_, dampingSteps_, schemeDesc_);
+    }
+
+    void FdHestonFwdDensityEngine::calculate() const {
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        const ext::shared_ptr<HestonProcess> process = model_->process();
+
+        const Date expiry = arguments_.exercise->lastDate();
+        const Time maturity = process->time(expiry);
+        QL_REQUIRE(maturity > 0.0, "expired option");
+
+        if (std::find(expiries_.begin(), expiries_.end(), expiry)
+                == expiries_.end()) {
+            expiries_.push_back(expiry);
+            solver_.reset();
+        }
+        if (solver_ == nullptr)
+            solver_ = densitySolver();
+
+        results_.value = process->riskFreeRate()->discount(expiry)
+            * solver_->expectation(solver_->timeIndex(maturity),
+                                   *arguments_.payoff);
+    }
+}
@@ -0,0 +1,80 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+/*! \file fdhestonfwddensityengine.hpp
+    \brief Heston Fokker-Planck forward density engine for European options
+*/
+
+#ifndef quantlib_fd_heston_fwd_density_engine_hpp
+#define quantlib_fd_heston_fwd_density_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/pricingengines/genericmodelengine.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/experimental/finitedifferences/fdmhestongreensfct.hpp>
+
+namespace QuantLib {
+
+    class FdmForwardDensitySolver;
+
+    //! Heston Fokker-Planck forward density engine for European options
+    /*! The joint density of log-spot and log-variance is evolved once
+        up to the last registered expiry, starting from the Green's
+        function of the Heston process after one day; every European
+        option expiring at a registered date is then priced by
+        integrating its payoff against the marginal density of the
+        log-spot at its expiry.  Options with expiries that were not
+        registered are added to the set, which triggers a new solve.
+
+        Only the value of the options is calculated.
+
+        \ingroup vanillaengines
+    */
+    class FdHestonFwdDensityEngine
+        : public GenericModelEngine<HestonModel,
+                                    VanillaOption::arguments,
+                                    VanillaOption::results> {
+      public:
+        explicit FdHestonFwdDensityEngine(
+            const ext::shared_ptr<HestonModel>& model,
+            Size tGrid = 100,
+            Size xGrid = 201,
+            Size vGrid = 201,
+            Size dampingSteps = 0,
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer(),
+            FdmHestonGreensFct::Algorithm greensAlgorithm
+                = FdmHestonGreensFct::Gaussian);
+
+        void calculate() const override;
+        void update() override;
+
+        //! expiries of the options priced by a single forward solve
+        void registerExpiries(const std::vector<Date>& expiries);
+
+      private:
+        ext::shared_ptr<FdmForwardDensitySolver> densitySolver() const;
+
+        const Size tGrid_, xGrid_, vGrid_, dampingSteps_;
+        const FdmSchemeDesc schemeDesc_;
+        const FdmHestonGreensFct::Algorithm greensAlgorithm_;
+
+        mutable std::vector<Date> expiries_;
+        mutable ext::shared_ptr<FdmForwardDensitySolver> solver_;
+    };
+}
+
+#endif
@@ -26,6 +26,7 @@
 
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
 
 namespace QuantLib {
 
@@ -70,7 +71,9 @@ namespace QuantLib {
         // factory
         static rsg_type make_sequence_generator(Size dimension,
                                                 BigNatural seed) {
-            return rsg_type(dimension, seed);
+            return rsg_type(dimension,
+                            RandomStreamSelector::seed(
+                                   seed, RandomStreamSelector::offset()));
         }
     };
 
@@ -70,6 +70,8 @@ namespace QuantLib {
         TimeGrid timeGrid() const;
         ext::shared_ptr<path_pricer_type> pathPricer() const;
         ext::shared_ptr<path_generator_type> pathGenerator() const;
+        // the calibrated path pricer is shared and collects statistics
+        bool allowsParallelSimulation() const { return false; }
 
         ext::shared_ptr<StochasticProcess> process_;
         const Size timeSteps_;
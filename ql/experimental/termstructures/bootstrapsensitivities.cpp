@@ -0,0 +1,163 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/termstructures/bootstrapsensitivities.hpp>
+#include <algorithm>
+#include <functional>
+
+namespace QuantLib {
+
+    BootstrapSensitivities::BootstrapSensitivities(Real bump)
+    : bump_(bump) {
+        QL_REQUIRE(bump_ > 0.0, "positive bump required");
+    }
+
+    void BootstrapSensitivities::addCurve(const ext::shared_ptr<Curve>& curve) {
+        QL_REQUIRE(curve, "null curve given");
+        curves_.push_back(curve);
+        registerWith(curve->termStructure());
+        update();
+    }
+
+    Size BootstrapSensitivities::size() const {
+        Size n = 0;
+        for (const auto& curve : curves_)
+            n += curve->size();
+        return n;
+    }
+
+    std::vector<Handle<Quote> > BootstrapSensitivities::quotes() const {
+        std::vector<Handle<Quote> > result;
+        for (const auto& curve : curves_) {
+            for (Size i=0; i<curve->size(); ++i)
+                result.push_back(curve->helper(i)->quote());
+        }
+        return result;
+    }
+
+    std::vector<Date> BootstrapSensitivities::pillarDates() const {
+        std::vector<Date> result;
+        for (const auto& curve : curves_) {
+            for (Size i=0; i<curve->size(); ++i)
+                result.push_back(curve->pillarDate(i));
+        }
+        return result;
+    }
+
+    const Array& BootstrapSensitivities::pillarValues() const {
+        calculate();
+        return values_;
+    }
+
+    const Matrix& BootstrapSensitivities::jacobian() const {
+        calculate();
+        return jacobian_;
+    }
+
+    const Matrix& BootstrapSensitivities::quoteJacobian() const {
+        calculate();
+        return quoteJacobian_;
+    }
+
+    Disposable<Array>
+    BootstrapSensitivities::shiftedPillarValues(const Array& quoteShifts) const {
+        calculate();
+        QL_REQUIRE(quoteShifts.size() == values_.size(),
+                   "wrong number of quote shifts (" << quoteShifts.size()
+                   << " provided, " << values_.size() << " required)");
+        Array result = jacobian_ * quoteShifts;
+        result += values_;
+        return result;
+    }
+
+    Disposable<Matrix>
+    BootstrapSensitivities::shiftedPillarValues(const Matrix& scenarios) const {
+        calculate();
+        QL_REQUIRE(scenarios.columns() == values_.size(),
+                   "wrong number of quote shifts (" << scenarios.columns()
+                   << " provided, " << values_.size() << " required)");
+        Matrix result = scenarios * transpose(jacobian_);
+        for (Size i=0; i<result.rows(); ++i)
+            std::transform(result.row_begin(i), result.row_end(i),
+                           values_.begin(), result.row_begin(i),
+                           std::plus<Real>());
+        return result;
+    }
+
+    std::vector<ext::shared_ptr<YieldTermStructure> >
+    BootstrapSensitivities::shiftedCurves(const Array& quoteShifts) const {
+        return buildCurves(shiftedPillarValues(quoteShifts));
+    }
+
+    std::vector<ext::shared_ptr<YieldTermStructure> >
+    BootstrapSensitivities::buildCurves(const Array& values) const {
+        std::vector<ext::shared_ptr<YieldTermStructure> > result;
+        result.reserve(curves_.size());
+        Array::const_iterator begin = values.begin();
+        for (const auto& curve : curves_) {
+            Array::const_iterator end = begin + curve->size();
+            result.push_back(curve->curve(std::vector<Real>(begin, end)));
+            begin = end;
+        }
+        return result;
+    }
+
+    void BootstrapSensitivities::performCalculations() const {
+        QL_REQUIRE(!curves_.empty(), "no curves given");
+
+        // pillars of all curves, bootstrapped if needed
+        std::vector<std::pair<const Curve*, Size> > pillars;
+        std::vector<ext::shared_ptr<RateHelper> > helpers;
+        for (const auto& curve : curves_) {
+            for (Size i=0; i<curve->size(); ++i) {
+                pillars.emplace_back(curve.get(), i);
+                helpers.push_back(curve->helper(i));
+            }
+        }
+        Size n = pillars.size();
+        values_ = Array(n);
+        for (Size j=0; j<n; ++j)
+            values_[j] = pillars[j].first->value(pillars[j].second);
+
+        // each column of dQ/dz is obtained by shifting a pillar value
+        // in place and asking all helpers for their implied quotes
+        quoteJacobian_ = Matrix(n, n);
+        Array up(n), down(n);
+        for (Size j=0; j<n; ++j) {
+            const Curve& curve = *pillars[j].first;
+            Size i = pillars[j].second;
+            Real z = values_[j];
+            try {
+                curve.setValue(i, z + bump_);
+                for (Size k=0; k<n; ++k)
+                    up[k] = helpers[k]->impliedQuote();
+                curve.setValue(i, z - bump_);
+                for (Size k=0; k<n; ++k)
+                    down[k] = helpers[k]->impliedQuote();
+                curve.setValue(i, z);
+            } catch (...) {
+                curve.setValue(i, z);
+                throw;
+            }
+            for (Size k=0; k<n; ++k)
+                quoteJacobian_[k][j] = (up[k] - down[k]) / (2.0 * bump_);
+        }
+
+        jacobian_ = inverse(quoteJacobian_);
+    }
+
+}
@@ -0,0 +1,211 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file bootstrapsensitivities.hpp
+    \brief sensitivities of bootstrapped curves by implicit differentiation
+*/
+
+#ifndef quantlib_bootstrap_sensitivities_hpp
+#define quantlib_bootstrap_sensitivities_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+
+namespace QuantLib {
+
+    //! Sensitivities of bootstrapped curves to their quotes
+    /*! Once a set of curves is bootstrapped, each of their pillar
+        values \f$ z_i \f$ is implied by the quote \f$ q_i \f$ of the
+        corresponding helper, i.e., the curves solve
+        \f[
+            Q_i(z) - q_i = 0
+        \f]
+        where \f$ Q_i(z) \f$ is the quote implied by the \f$ i \f$-th
+        helper.  Differentiating implicitly, the Jacobian of the
+        pillar values with respect to the quotes is
+        \f[
+            \frac{\partial z}{\partial q} =
+            \left(\frac{\partial Q}{\partial z}\right)^{-1}.
+        \f]
+        This class calculates \f$ \partial Q / \partial z \f$ by
+        shifting each pillar value in place and asking all helpers
+        for their implied quotes, and inverts it once; no curve is
+        bootstrapped again.  The helpers of a curve can depend on
+        any of the other curves passed (e.g., for exogenous
+        discounting), so that their interdependence is taken into
+        account.
+
+        Given the Jacobian, the pillar values for any set of quote
+        shifts are obtained at first order by a matrix product, and
+        the corresponding curves can be built without bootstrapping.
+
+        \warning each pillar value must be determined by a single
+                 helper; this is the case for the iterative and local
+                 bootstraps, but not for global bootstraps using
+                 additional helpers.
+
+        \ingroup yieldtermstructures
+    */
+    class BootstrapSensitivities : public LazyObject {
+      public:
+        //! access to the pillars of a bootstrapped curve
+        class Curve {
+          public:
+            virtual ~Curve() = default;
+            virtual ext::shared_ptr<YieldTermStructure> termStructure() const = 0;
+            //! number of bootstrapped pillars
+            virtual Size size() const = 0;
+            virtual Date pillarDate(Size i) const = 0;
+            virtual Real value(Size i) const = 0;
+            /*! sets the value of the i-th pillar without
+                notifying observers or bootstrapping the curve */
+            virtual void setValue(Size i, Real value) const = 0;
+            //! the helper implying the value of the i-th pillar
+            virtual ext::shared_ptr<RateHelper> helper(Size i) const = 0;
+            //! a curve of the same kind with the given pillar values
+            virtual ext::shared_ptr<YieldTermStructure>
+            curve(const std::vector<Real>& values) const = 0;
+        };
+
+        /*! \param bump  shift applied to the pillar values for the
+                         central differences of the implied quotes
+        */
+        explicit BootstrapSensitivities(Real bump = 1.0e-6);
+
+        //! adds a curve to the set; its pillars follow the previous ones
+        template <class Traits, class Interpolator,
+                  template <class> class Bootstrap>
+        void addCurve(
+            const ext::shared_ptr<
+                PiecewiseYieldCurve<Traits, Interpolator, Bootstrap> >& curve);
+        void addCurve(const ext::shared_ptr<Curve>& curve);
+
+        //! \name Inspectors
+        //@{
+        //! number of pillars (and quotes) for all curves
+        Size size() const;
+        std::vector<Handle<Quote> > quotes() const;
+        std::vector<Date> pillarDates() const;
+        const Array& pillarValues() const;
+        //@}
+        //! \name Results
+        //@{
+        //! \f$ \partial z_i / \partial q_j \f$
+        const Matrix& jacobian() const;
+        //! \f$ \partial Q_i / \partial z_j \f$
+        const Matrix& quoteJacobian() const;
+        //! pillar values after the given quote shifts, at first order
+        Disposable<Array> shiftedPillarValues(const Array& quoteShifts) const;
+        /*! pillar values for a set of scenarios; each row of the
+            argument contains the quote shifts of a scenario, and
+            the corresponding row of the result contains the pillar
+            values.
+        */
+        Disposable<Matrix> shiftedPillarValues(const Matrix& scenarios) const;
+        /*! curves with the pillar values obtained from the given quote
+            shifts; the curves have a fixed reference date and don't
+            depend on the helpers or on each other.
+        */
+        std::vector<ext::shared_ptr<YieldTermStructure> >
+        shiftedCurves(const Array& quoteShifts) const;
+        //@}
+      private:
+        void performCalculations() const override;
+        std::vector<ext::shared_ptr<YieldTermStructure> >
+        buildCurves(const Array& values) const;
+        Real bump_;
+        std::vector<ext::shared_ptr<Curve> > curves_;
+        mutable Array values_;
+        mutable Matrix jacobian_, quoteJacobian_;
+    };
+
+
+    namespace detail {
+
+        template <class PiecewiseCurve>
+        class PiecewiseCurvePillars : public BootstrapSensitivities::Curve {
+            typedef typename PiecewiseCurve::traits_type Traits;
+            typedef typename PiecewiseCurve::interpolator_type Interpolator;
+            typedef typename Traits::template curve<Interpolator>::type
+                                                                base_curve;
+          public:
+            explicit PiecewiseCurvePillars(ext::shared_ptr<PiecewiseCurve> curve)
+            : curve_(std::move(curve)) {}
+            ext::shared_ptr<YieldTermStructure> termStructure() const override {
+                return curve_;
+            }
+            Size size() const override {
+                // data_[0] is not bootstrapped
+                return curve_->data().size() - 1;
+            }
+            Date pillarDate(Size i) const override {
+                return curve_->dates()[i+1];
+            }
+            Real value(Size i) const override {
+                return curve_->data()[i+1];
+            }
+            void setValue(Size i, Real value) const override {
+                // same as BootstrapError::operator()
+                Traits::updateGuess(curve_->data_, value, i+1);
+                curve_->interpolation_.update();
+            }
+            ext::shared_ptr<RateHelper> helper(Size i) const override {
+                // expired helpers come first in the sorted instruments
+                Size expired = curve_->instruments_.size() - size();
+                return curve_->instruments_[expired+i];
+            }
+            ext::shared_ptr<YieldTermStructure>
+            curve(const std::vector<Real>& values) const override {
+                QL_REQUIRE(values.size() == size(),
+                           "wrong number of pillar values ("
+                           << values.size() << " provided, "
+                           << size() << " required)");
+                QL_REQUIRE(curve_->jumpDates().empty(),
+                           "curves with jumps not supported");
+                std::vector<Real> data = curve_->data();
+                for (Size i=0; i<values.size(); ++i)
+                    Traits::updateGuess(data, values[i], i+1);
+                return ext::make_shared<base_curve>(curve_->dates(), data,
+                                                    curve_->dayCounter(),
+                                                    curve_->calendar(),
+                                                    curve_->interpolator_);
+            }
+          private:
+            ext::shared_ptr<PiecewiseCurve> curve_;
+        };
+
+    }
+
+
+    // template definitions
+
+    template <class Traits, class Interpolator,
+              template <class> class Bootstrap>
+    void BootstrapSensitivities::addCurve(
+        const ext::shared_ptr<
+            PiecewiseYieldCurve<Traits, Interpolator, Bootstrap> >& curve) {
+        typedef PiecewiseYieldCurve<Traits, Interpolator, Bootstrap> curve_type;
+        addCurve(ext::shared_ptr<Curve>(
+                      new detail::PiecewiseCurvePillars<curve_type>(curve)));
+    }
+
+}
+
+
+#endif
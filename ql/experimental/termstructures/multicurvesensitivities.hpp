@@ -24,6 +24,7 @@
 #ifndef quantlib_multicurve_sensitivity_hpp
 #define quantlib_multicurve_sensitivity_hpp
 
+#include <ql/experimental/termstructures/bootstrapsensitivities.hpp>
 #include <ql/shared_ptr.hpp>
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
 #include <ql/termstructures/yield/ratehelpers.hpp>
@@ -40,10 +41,11 @@ namespace {
 namespace QuantLib {
 
 //! Multi curve sensitivities
-/*! This class provides a simple (yet most likely not the fastest) way to create sensitivities
-  to the <em>par quotes</em>, provided in the piecewiseyieldcurve for stripping. If constructed with more
-than one curve, the class iterates over all quotes of the provided curves and shifts each quote of all provided curves
-taking interdependence into account.
+/*! This class provides a simple way to create sensitivities to the <em>par quotes</em>, provided in the
+  piecewiseyieldcurve for stripping. If constructed with more than one curve, the class takes into account the
+interdependence of the provided curves. By default, the sensitivities are calculated by BootstrapSensitivities
+without bootstrapping the curves again; optionally, the class iterates over all quotes of the provided curves and
+shifts each of them, bootstrapping the curves after each shift.
 
 The class computes the sensitvities as a QuantLib Matrix class in the form:
 \f[
@@ -66,16 +68,22 @@ private:
 public:
   //! Multi curve sensitivties
   /*! @param curves std::map of string (curve name) and handle to piecewiseyieldcurve
+      @param rebootstrap if true, each quote is shifted and the curves are bootstrapped again
   */
 
-  explicit MultiCurveSensitivities(curvespec curves) : curves_(std::move(curves)) {
+  explicit MultiCurveSensitivities(curvespec curves, bool rebootstrap = false)
+  : curves_(std::move(curves)) {
       for (curvespec::const_iterator it = curves_.begin(); it != curves_.end(); ++it)
           registerWith((*it).second);
+      if (!rebootstrap)
+          backend_ = ext::make_shared<BootstrapSensitivities>();
       for (curvespec::const_iterator it = curves_.begin(); it != curves_.end(); ++it) {
           ext::shared_ptr<PiecewiseYieldCurve<ZeroYield, Linear> > curve =
               ext::dynamic_pointer_cast<PiecewiseYieldCurve<ZeroYield, Linear> >(
                   it->second.currentLink());
           QL_REQUIRE(curve != nullptr, "Couldn't cast curvename: " << it->first);
+          if (backend_ != nullptr)
+              backend_->addCurve(curve);
           for (auto& instrument : curve->instruments_) {
               allQuotes_.push_back(instrument->quote());
               std::stringstream tmp;
@@ -101,6 +109,7 @@ private:
   std::vector< Handle< Quote > > allQuotes_;
   std::vector< std::pair< Date, Real > > origNodes_;
   mutable Matrix sensi_, invSensi_;
+  ext::shared_ptr< BootstrapSensitivities > backend_;
   curvespec curves_;
   std::vector< std::string > headers_;
 };
@@ -108,6 +117,12 @@ private:
 inline void MultiCurveSensitivities::performCalculations() const {
   std::vector< Rate > sensiVector;
   origZeros_ = allZeros();
+  if (backend_ != nullptr) {
+      // same layout as below: one row per quote, one column per zero
+      sensi_ = transpose(backend_->jacobian());
+      invSensi_ = transpose(backend_->quoteJacobian());
+      return;
+  }
   for (const auto& allQuote : allQuotes_) {
       Rate bps = +1e-4;
       Rate origQuote = allQuote->value();
@@ -0,0 +1,387 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/instruments/portfoliovaluator.hpp>
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/inflationcouponpricer.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/settings.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <boost/unordered_set.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        // Nodes of the dependency graph of an instrument, including
+        // the instrument itself.  The dependencies of lazy objects
+        // which were calculated are not used and are not traversed.
+        std::vector<Observable*> dependencies(Instrument* instrument) {
+            std::vector<Observable*> nodes;
+            boost::unordered_set<Observable*> visited;
+            std::vector<Observable*> stack(1, instrument);
+            while (!stack.empty()) {
+                Observable* node = stack.back();
+                stack.pop_back();
+                if (!visited.insert(node).second)
+                    continue;
+                nodes.push_back(node);
+                auto* lazy = dynamic_cast<LazyObject*>(node);
+                if (lazy != nullptr && lazy->isCalculated())
+                    continue;
+                if (auto* observer = dynamic_cast<Observer*>(node)) {
+                    for (const auto& observable : observer->observables())
+                        stack.push_back(observable.get());
+                }
+            }
+            return nodes;
+        }
+
+        // calculates shared lazy term structures and caches the
+        // reference dates and local volatilities, so that they are
+        // only read afterwards
+        void prepare(Observable* node) {
+            try {
+                if (auto* curve = dynamic_cast<YieldTermStructure*>(node)) {
+                    curve->discount(curve->referenceDate());
+                } else if (auto* ts = dynamic_cast<TermStructure*>(node)) {
+                    ts->referenceDate();
+                } else if (auto* process =
+                           dynamic_cast<GeneralizedBlackScholesProcess*>(
+                                                                   node)) {
+                    process->localVolatility();
+                }
+            } catch (...) {
+                // errors will be reported by the instruments; the
+                // object will not be shared if it's lazy
+            }
+        }
+
+        // whether the evaluation of the instruments modifies the node
+        bool isModified(Observable* node) {
+            auto* lazy = dynamic_cast<LazyObject*>(node);
+            if (lazy != nullptr)
+                return !lazy->isCalculated();
+            return dynamic_cast<PricingEngine*>(node) != nullptr
+                || dynamic_cast<FloatingRateCouponPricer*>(node) != nullptr
+                || dynamic_cast<InflationCouponPricer*>(node) != nullptr;
+        }
+
+        Size root(std::vector<Size>& parent, Size i) {
+            while (parent[i] != i) {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        }
+
+        // settings of the calling session, to be copied into the
+        // sessions of the worker threads
+        class SessionSettings {
+          public:
+            SessionSettings()
+            : evaluationDate_(Settings::instance().evaluationDate()),
+              includeReferenceDateEvents_(
+                  Settings::instance().includeReferenceDateEvents()),
+              includeTodaysCashFlows_(
+                  Settings::instance().includeTodaysCashFlows()),
+              enforcesTodaysHistoricFixings_(
+                  Settings::instance().enforcesTodaysHistoricFixings()) {
+                for (const auto& name : IndexManager::instance().histories())
+                    fixings_.emplace_back(
+                        name, IndexManager::instance().getHistory(name));
+            }
+            void restore() const {
+                Settings& settings = Settings::instance();
+                settings.evaluationDate() = evaluationDate_;
+                settings.includeReferenceDateEvents() =
+                    includeReferenceDateEvents_;
+                settings.includeTodaysCashFlows() = includeTodaysCashFlows_;
+                settings.enforcesTodaysHistoricFixings() =
+                    enforcesTodaysHistoricFixings_;
+                for (const auto& f : fixings_)
+                    IndexManager::instance().setHistory(f.first, f.second);
+            }
+          private:
+            Date evaluationDate_;
+            bool includeReferenceDateEvents_;
+            boost::optional<bool> includeTodaysCashFlows_;
+            bool enforcesTodaysHistoricFixings_;
+            std::vector<std::pair<std::string, TimeSeries<Real> > > fixings_;
+        };
+
+        // one queue of groups per thread; threads take groups from
+        // the back of their own queue and steal them from the front
+        // of the others
+        class WorkQueues {
+          public:
+            WorkQueues(const std::vector<std::vector<Size> >& groups,
+                       Size queues)
+            : queues_(queues) {
+                // larger groups first, dealt round-robin
+                std::vector<Size> order(groups.size());
+                for (Size i=0; i<order.size(); ++i)
+                    order[i] = i;
+                std::stable_sort(order.begin(), order.end(),
+                                 [&groups](Size i, Size j) {
+                                     return groups[i].size()
+                                         > groups[j].size();
+                                 });
+                for (Size k=0; k<order.size(); ++k)
+                    queues_[k % queues].tasks.push_front(order[k]);
+            }
+            bool next(Size queue, Size& task) {
+                {
+                    Queue& own = queues_[queue];
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    if (!own.tasks.empty()) {
+                        task = own.tasks.back();
+                        own.tasks.pop_back();
+                        return true;
+                    }
+                }
+                for (Size k=1; k<queues_.size(); ++k) {
+                    Queue& other = queues_[(queue+k) % queues_.size()];
+                    std::lock_guard<std::mutex> lock(other.mutex);
+                    if (!other.tasks.empty()) {
+                        task = other.tasks.front();
+                        other.tasks.pop_front();
+                        return true;
+                    }
+                }
+                return false;
+            }
+          private:
+            struct Queue {
+                std::mutex mutex;
+                std::deque<Size> tasks;
+            };
+            std::vector<Queue> queues_;
+        };
+
+    }
+
+
+    // threads kept alive between evaluations; each call to run()
+    // passes the index of each worker to the given task and returns
+    // when all of them are done
+    class PortfolioValuator::Workers {
+      public:
+        explicit Workers(Size workers)
+        : task_(nullptr), pending_(0), generation_(0), stop_(false) {
+            threads_.reserve(workers);
+            for (Size k=1; k<=workers; ++k)
+                threads_.emplace_back([this, k]() { work(k); });
+        }
+        ~Workers() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            start_.notify_all();
+            for (auto& thread : threads_)
+                thread.join();
+        }
+        Workers(const Workers&) = delete;
+        Workers& operator=(const Workers&) = delete;
+
+        //! runs task(k) on the k-th worker and task(0) on the caller
+        void run(const std::function<void(Size)>& task) {
+            std::lock_guard<std::mutex> running(running_);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                task_ = &task;
+                pending_ = threads_.size();
+                ++generation_;
+            }
+            start_.notify_all();
+
+            task(0);
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this]() { return pending_ == 0; });
+            task_ = nullptr;
+        }
+      private:
+        void work(Size k) {
+            Size generation = 0;
+            for (;;) {
+                const std::function<void(Size)>* task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    start_.wait(lock, [&]() {
+                        return stop_ || generation_ != generation;
+                    });
+                    if (stop_)
+                        return;
+                    generation = generation_;
+                    task = task_;
+                }
+
+                // the task handles its own errors
+                (*task)(k);
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--pending_ == 0)
+                    done_.notify_one();
+            }
+        }
+        std::vector<std::thread> threads_;
+        std::mutex running_, mutex_;
+        std::condition_variable start_, done_;
+        const std::function<void(Size)>* task_;
+        Size pending_, generation_;
+        bool stop_;
+    };
+
+
+    PortfolioValuator::PortfolioValuator(Size threads)
+    : threads_(threads) {
+        if (threads_ == 0)
+            threads_ = std::max<Size>(std::thread::hardware_concurrency(), 1);
+        if (threads_ > 1)
+            workers_ = ext::make_shared<Workers>(threads_-1);
+    }
+
+    std::vector<std::vector<Size> > PortfolioValuator::partition(
+            const std::vector<ext::shared_ptr<Instrument> >& instruments) {
+        const Size n = instruments.size();
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(instruments[i], "null instrument at index " << i);
+
+        // shared objects are prepared first...
+        std::map<Observable*, Size> owners;
+        std::vector<Observable*> shared;
+        for (Size i=0; i<n; ++i) {
+            for (Observable* node : dependencies(instruments[i].get())) {
+                // nodes found again are reached by another instrument;
+                // they are then marked with n so they're stored once
+                auto owner = owners.insert(std::make_pair(node, i));
+                if (!owner.second && owner.first->second != n) {
+                    shared.push_back(node);
+                    owner.first->second = n;
+                }
+            }
+        }
+        for (Observable* node : shared)
+            prepare(node);
+
+        // ...and the instruments sharing objects which would still
+        // be modified are then joined.
+        std::vector<Size> parent(n);
+        for (Size i=0; i<n; ++i)
+            parent[i] = i;
+        owners.clear();
+        for (Size i=0; i<n; ++i) {
+            for (Observable* node : dependencies(instruments[i].get())) {
+                if (!isModified(node))
+                    continue;
+                auto owner = owners.insert(std::make_pair(node, i));
+                if (!owner.second)
+                    parent[root(parent, i)] =
+                        root(parent, owner.first->second);
+            }
+        }
+
+        std::vector<std::vector<Size> > groups;
+        std::vector<Size> group(n, Null<Size>());
+        for (Size i=0; i<n; ++i) {
+            Size r = root(parent, i);
+            if (group[r] == Null<Size>()) {
+                group[r] = groups.size();
+                groups.emplace_back();
+            }
+            groups[group[r]].push_back(i);
+        }
+        return groups;
+    }
+
+    std::vector<PortfolioValuator::Result> PortfolioValuator::valuate(
+            const std::vector<ext::shared_ptr<Instrument> >& instruments)
+                                                                   const {
+        std::vector<Result> results(instruments.size());
+        const std::vector<std::vector<Size> > groups =
+            partition(instruments);
+
+        auto evaluate = [&](Size g) {
+            for (Size i : groups[g]) {
+                try {
+                    results[i].npv = instruments[i]->NPV();
+                } catch (std::exception& e) {
+                    results[i].error = e.what();
+                } catch (...) {
+                    results[i].error = "unknown error";
+                }
+            }
+        };
+
+        const Size threads = std::min(threads_, groups.size());
+
+        WorkQueues queues(groups, std::max<Size>(threads, 1));
+        auto run = [&](Size queue) {
+            Size g;
+            while (queues.next(queue, g))
+                evaluate(g);
+        };
+
+        if (threads <= 1) {
+            run(0);
+            return results;
+        }
+
+        #if defined(QL_ENABLE_SESSIONS)
+        const SessionSettings settings;
+        std::set<ThreadKey> sessions;
+        sessions.insert(sessionId());
+        std::mutex mutex;
+        #endif
+        workers_->run([&](Size k) {
+            if (k >= threads)
+                return;
+            #if defined(QL_ENABLE_SESSIONS)
+            if (k > 0) {
+                try {
+                    // the first thread in a new session copies the
+                    // settings into it; the others sharing it wait
+                    // for the copy.  Threads in the calling session
+                    // already see its settings.
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (sessions.insert(sessionId()).second)
+                        settings.restore();
+                } catch (...) {
+                    // the other threads will take its groups
+                    return;
+                }
+            }
+            #endif
+            run(k);
+        });
+
+        return results;
+    }
+
+}
@@ -0,0 +1,103 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file portfoliovaluator.hpp
+    \brief parallel valuation of a portfolio of instruments
+*/
+
+#ifndef quantlib_portfolio_valuator_hpp
+#define quantlib_portfolio_valuator_hpp
+
+#include <ql/instrument.hpp>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Parallel valuation of a portfolio of instruments
+    /*! The instruments are partitioned into groups that can be
+        evaluated concurrently; each group is evaluated in a single
+        thread, and the groups are distributed to a pool of threads
+        which steal work from each other when they run out of it.
+
+        Two instruments are put in the same group when they depend,
+        directly or through other observers, on the same pricing
+        engine, coupon pricer or lazy object which is not calculated
+        yet, since their evaluation would modify it.  Shared term
+        structures and Black-Scholes processes are prepared in the
+        calling thread before the evaluation, so that the lazy ones
+        are calculated once and can be read concurrently; pricing
+        engines should therefore not be shared between instruments
+        if the evaluation is to be done in parallel.  Objects whose
+        results were calculated, as well as quotes, handles and
+        indexes, are only read and can be shared.
+
+        The worker threads are started by the constructor and are
+        reused by every call to valuate() until the last copy of the
+        valuator is destroyed; concurrent calls on the same valuator
+        are serialized.
+
+        When sessions are disabled, or when a worker thread shares
+        the session of the calling thread, the workers read the
+        settings and the index fixings of the calling session; they
+        must not be modified while valuate() runs.  When sessions
+        are enabled (see QL_ENABLE_SESSIONS) and sessionId() returns
+        another id for a worker thread, the settings and fixings of
+        the calling session are copied into the new session before
+        the worker evaluates any instrument.
+
+        \warning objects with mutable state other than the ones
+                 listed above must not be shared between instruments
+                 in different groups.
+
+        \ingroup instruments
+    */
+    class PortfolioValuator {
+      public:
+        //! outcome of the evaluation of an instrument
+        struct Result {
+            Real npv = Null<Real>();
+            //! error message, if the evaluation failed
+            std::string error;
+            bool successful() const { return error.empty(); }
+        };
+        /*! \param threads  the number of threads to use, including
+                            the calling one; if null, the number of
+                            concurrent threads supported by the
+                            hardware is used.
+        */
+        explicit PortfolioValuator(Size threads = 0);
+        //! evaluates the instruments; results are in the same order
+        std::vector<Result> valuate(
+            const std::vector<ext::shared_ptr<Instrument> >&) const;
+        //! groups of instruments, by index, as used by valuate()
+        /*! Shared term structures and processes are prepared as
+            described above before partitioning the instruments.
+        */
+        static std::vector<std::vector<Size> > partition(
+            const std::vector<ext::shared_ptr<Instrument> >&);
+        Size threads() const { return threads_; }
+      private:
+        class Workers;
+        Size threads_;
+        ext::shared_ptr<Workers> workers_;
+    };
+
+}
+
+
+#endif
@@ -63,6 +63,36 @@ namespace QuantLib {
         return result;
     }
 
+    void CumulativeNormalDistribution::transform(const Real* begin,
+                                                 const Real* end,
+                                                 Real* output) const {
+        const Size n = end - begin;
+        for (Size i=0; i<n; ++i) {
+            // the values are 0 or 1 in double precision beyond 40
+            const Real x = std::min(std::max((begin[i] - average_)/sigma_,
+                                             Real(-40.0)), Real(40.0));
+            const Real z = std::fabs(x);
+            const Real e = std::exp(-0.5*z*z);
+            const Real p =
+                ((((((3.52624965998911e-02*z + 0.700383064443688)*z
+                     + 6.37396220353165)*z + 33.912866078383)*z
+                   + 112.079291497871)*z + 221.213596169931)*z
+                 + 220.206867912376);
+            const Real q =
+                (((((((8.83883476483184e-02*z + 1.75566716318264)*z
+                      + 16.064177579207)*z + 86.7807322029461)*z
+                    + 296.564248779674)*z + 637.333633378831)*z
+                  + 793.826512519948)*z + 440.413735824752);
+            // continued fraction for Mills' ratio
+            Real c = z + 0.65;
+            for (Integer k=12; k>=1; --k)
+                c = z + k/c;
+            const Real tail = z < 5.0 ? e*p/q : e/(c*M_SQRT2*M_SQRTPI);
+            output[i] = x > 0.0 ? 1.0 - tail : tail;
+        }
+    }
+
+
     #if !defined(QL_PATCH_SOLARIS)
     const CumulativeNormalDistribution InverseCumulativeNormal::f_;
     #endif
@@ -126,6 +156,38 @@ namespace QuantLib {
         return z;
     }
 
+    void InverseCumulativeNormal::transform(const Real* begin,
+                                            const Real* end,
+                                            Real* output) const {
+        const Size n = end - begin;
+        bool inRange = true;
+        for (Size i=0; i<n; ++i)
+            inRange = inRange && (begin[i] > 0.0 && begin[i] < 1.0);
+        if (!inRange) {
+            // rare: tail_value recovers or reports the invalid points
+            for (Size i=0; i<n; ++i)
+                output[i] = (*this)(begin[i]);
+            return;
+        }
+
+        for (Size i=0; i<n; ++i) {
+            const Real x = begin[i];
+
+            Real z = x - 0.5;
+            Real r = z*z;
+            const Real central =
+                (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+
+            z = std::sqrt(-2.0*std::log(std::min(x, 1.0-x)));
+            const Real tail = (((((c1_*z+c2_)*z+c3_)*z+c4_)*z+c5_)*z+c6_) /
+                ((((d1_*z+d2_)*z+d3_)*z+d4_)*z+1.0);
+
+            z = x < x_low_ ? tail : (x_high_ < x ? -tail : central);
+            output[i] = average_ + sigma_*z;
+        }
+    }
+
     const Real MoroInverseCumulativeNormal::a0_ =  2.50662823884;
     const Real MoroInverseCumulativeNormal::a1_ =-18.61500062529;
     const Real MoroInverseCumulativeNormal::a2_ = 41.39119773534;
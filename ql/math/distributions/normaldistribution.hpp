@@ -78,6 +78,17 @@ namespace QuantLib {
         // function
         Real operator()(Real x) const;
         Real derivative(Real x) const;
+        //! values for the contiguous points in [begin, end)
+        /*! The values are written starting from output, which can
+            coincide with begin.  This method uses a branchless
+            approximation (Hart's rational function as given by
+            G. West, "Better approximations to cumulative normal
+            functions", 2005, and a continued fraction for the tails)
+            which compilers can vectorize.  Its absolute error is
+            below 2.0e-16 and its relative error below 5.0e-11.
+        */
+        void transform(const Real* begin, const Real* end,
+                       Real* output) const;
       private:
         Real average_, sigma_;
         NormalDistribution gaussian_;
@@ -143,6 +154,15 @@ namespace QuantLib {
 
             return z;
         }
+        //! values for the contiguous points in [begin, end)
+        /*! The values are written starting from output, which can
+            coincide with begin.  Both the central and the tail
+            approximations are calculated for all points in a loop
+            which compilers can vectorize; the results are the same
+            as the ones of operator().
+        */
+        void transform(const Real* begin, const Real* end,
+                       Real* output) const;
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
@@ -0,0 +1,252 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/qldefines.hpp>
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        // entries [begin, end) of row i of a ublas compressed matrix
+        void rowRange(const SparseMatrix& A, Size i,
+                      Size& begin, Size& end) {
+            if (i+1 < A.filled1()) {
+                begin = A.index1_data()[i];
+                end = A.index1_data()[i+1];
+            } else {
+                begin = end = 0;
+            }
+        }
+
+        bool samePattern(const SparseMatrix& A,
+                         const std::vector<Size>& rowPtr,
+                         const std::vector<Size>& cols) {
+            const Size n = A.size1();
+            if (rowPtr.size() != n+1)
+                return false;
+
+            for (Size i=0; i < n; ++i) {
+                Size begin, end;
+                rowRange(A, i, begin, end);
+
+                Size k = rowPtr[i];
+                bool diagonal = false;
+                for (Size j=begin; j < end; ++j) {
+                    const Size c = A.index2_data()[j];
+                    if (!diagonal && c >= i) {
+                        diagonal = true;
+                        if (c > i) {
+                            if (k == rowPtr[i+1] || cols[k] != i)
+                                return false;
+                            ++k;
+                        }
+                    }
+                    if (k == rowPtr[i+1] || cols[k] != c)
+                        return false;
+                    ++k;
+                }
+                if (!diagonal) {
+                    if (k == rowPtr[i+1] || cols[k] != i)
+                        return false;
+                    ++k;
+                }
+                if (k != rowPtr[i+1])
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    CsrMatrix::CsrMatrix(const SparseMatrix& A, Real a, Real d) {
+        assign(A, a, d);
+    }
+
+    bool CsrMatrix::assign(const SparseMatrix& A, Real a, Real d) {
+        QL_REQUIRE(A.size1() == A.size2(),
+                   "CSR matrix works only with square matrices");
+
+        const Size n = A.size1();
+        const bool changed = !samePattern(A, rowPtr_, cols_);
+
+        if (changed) {
+            rowPtr_.assign(n+1, 0);
+            diag_.resize(n);
+            cols_.clear();
+            cols_.reserve(A.nnz() + n);
+
+            for (Size i=0; i < n; ++i) {
+                Size begin, end;
+                rowRange(A, i, begin, end);
+
+                bool diagonal = false;
+                for (Size j=begin; j < end; ++j) {
+                    const Size c = A.index2_data()[j];
+                    if (!diagonal && c >= i) {
+                        diagonal = true;
+                        diag_[i] = cols_.size();
+                        if (c > i)
+                            cols_.push_back(i);
+                    }
+                    cols_.push_back(c);
+                }
+                if (!diagonal) {
+                    diag_[i] = cols_.size();
+                    cols_.push_back(i);
+                }
+                rowPtr_[i+1] = cols_.size();
+            }
+            values_.resize(cols_.size());
+        }
+
+        for (Size i=0; i < n; ++i) {
+            Size begin, end;
+            rowRange(A, i, begin, end);
+
+            Size k = rowPtr_[i];
+            for (Size j=begin; j < end; ++j) {
+                if (k == diag_[i] && A.index2_data()[j] != i)
+                    values_[k++] = 0.0;
+                values_[k++] = a*A.value_data()[j];
+            }
+            if (k < rowPtr_[i+1])
+                values_[k] = 0.0;
+            values_[diag_[i]] += d;
+        }
+
+        return changed;
+    }
+
+    bool CsrMatrix::assign(const CsrMatrix& A, Real a, Real d) {
+        const bool changed = rowPtr_ != A.rowPtr_ || cols_ != A.cols_;
+        if (changed) {
+            rowPtr_ = A.rowPtr_;
+            cols_ = A.cols_;
+            diag_ = A.diag_;
+        }
+        values_.resize(A.values_.size());
+        for (Size k=0; k < values_.size(); ++k)
+            values_[k] = a*A.values_[k];
+        for (Size i=0; i < diag_.size(); ++i)
+            values_[diag_[i]] += d;
+
+        return changed;
+    }
+
+    void CsrMatrix::apply_into(const Array& x, Array& y) const {
+        const Size n = rows();
+        QL_REQUIRE(x.size() == n, "inconsistent length of x "
+                   << x.size() << " vs " << n);
+        QL_REQUIRE(&x != &y, "result must differ from x");
+
+        if (y.size() != n)
+            y = Array(n);
+
+        const Size* rowPtr = rowPtr_.data();
+        const Size* cols = cols_.data();
+        const Real* values = values_.data();
+        const Real* xptr = x.begin();
+        Real* yptr = y.begin();
+
+        for (Size i=0; i < n; ++i) {
+            Real t = 0.0;
+            for (Size k=rowPtr[i]; k < rowPtr[i+1]; ++k)
+                t += values[k]*xptr[cols[k]];
+            yptr[i] = t;
+        }
+    }
+
+    Disposable<Array> CsrMatrix::apply(const Array& x) const {
+        Array y(x.size());
+        apply_into(x, y);
+        return y;
+    }
+
+
+    CsrIlu0Preconditioner::CsrIlu0Preconditioner(const CsrMatrix& A) {
+        factorize(A);
+    }
+
+    void CsrIlu0Preconditioner::factorize(const CsrMatrix& A) {
+        const Size n = A.rows();
+
+        if (rowPtr_ != A.rowPointers() || cols_ != A.columns()) {
+            rowPtr_ = A.rowPointers();
+            cols_ = A.columns();
+            diag_ = A.diagonal();
+            invDiag_.resize(n);
+            work_.assign(n, Null<Size>());
+        }
+        lu_ = A.values();
+
+        for (Size i=0; i < n; ++i) {
+            for (Size k=rowPtr_[i]; k < rowPtr_[i+1]; ++k)
+                work_[cols_[k]] = k;
+
+            for (Size k=rowPtr_[i]; k < diag_[i]; ++k) {
+                const Size c = cols_[k];
+                const Real l = lu_[k] *= invDiag_[c];
+                for (Size j=diag_[c]+1; j < rowPtr_[c+1]; ++j) {
+                    const Size pos = work_[cols_[j]];
+                    if (pos != Null<Size>())
+                        lu_[pos] -= l*lu_[j];
+                }
+            }
+
+            const Real pivot = lu_[diag_[i]];
+            QL_REQUIRE(pivot != 0.0, "zero pivot in row " << i
+                       << " of the ILU(0) factorisation");
+            invDiag_[i] = 1.0/pivot;
+
+            for (Size k=rowPtr_[i]; k < rowPtr_[i+1]; ++k)
+                work_[cols_[k]] = Null<Size>();
+        }
+    }
+
+    void CsrIlu0Preconditioner::apply_into(const Array& b, Array& y) const {
+        const Size n = invDiag_.size();
+        QL_REQUIRE(b.size() == n, "inconsistent length of b "
+                   << b.size() << " vs " << n);
+
+        if (&b != &y)
+            y = b;
+
+        for (Size i=0; i < n; ++i) {
+            Real t = y[i];
+            for (Size k=rowPtr_[i]; k < diag_[i]; ++k)
+                t -= lu_[k]*y[cols_[k]];
+            y[i] = t;
+        }
+        for (Size i=n; i-- > 0;) {
+            Real t = y[i];
+            for (Size k=diag_[i]+1; k < rowPtr_[i+1]; ++k)
+                t -= lu_[k]*y[cols_[k]];
+            y[i] = t*invDiag_[i];
+        }
+    }
+
+    Disposable<Array> CsrIlu0Preconditioner::apply(const Array& b) const {
+        Array y(b);
+        apply_into(y, y);
+        return y;
+    }
+}
+
+#endif
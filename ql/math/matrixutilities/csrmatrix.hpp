@@ -0,0 +1,105 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrmatrix.hpp
+    \brief compressed sparse row matrix and ILU(0) preconditioner
+*/
+
+#ifndef quantlib_csr_matrix_hpp
+#define quantlib_csr_matrix_hpp
+
+#include <ql/qldefines.hpp>
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! square sparse matrix in compressed sparse row format
+    /*! The rows are kept in plain arrays, with the column indices of
+        each row sorted and the diagonal always stored, so that the
+        matrix-vector product runs as a single pass without any of
+        the indirections of the ublas containers.
+
+        The matrix is meant to be assembled once and then refilled
+        with new values, e.g., scaled copies of another matrix for
+        each time step of a finite-difference scheme; storage is only
+        reallocated if the sparsity pattern changes.
+    */
+    class CsrMatrix {
+      public:
+        CsrMatrix() = default;
+        explicit CsrMatrix(const SparseMatrix& A, Real a = 1.0, Real d = 0.0);
+
+        /*! sets the matrix to a*A + d*I and returns whether the
+            sparsity pattern changed.
+        */
+        bool assign(const SparseMatrix& A, Real a = 1.0, Real d = 0.0);
+        /*! sets the matrix to a*A + d*I, with the sparsity pattern of
+            A, and returns whether the pattern changed.
+        */
+        bool assign(const CsrMatrix& A, Real a = 1.0, Real d = 0.0);
+
+        Size rows() const { return rowPtr_.empty() ? 0 : rowPtr_.size()-1; }
+        Size nonZeros() const { return values_.size(); }
+
+        const std::vector<Size>& rowPointers() const { return rowPtr_; }
+        const std::vector<Size>& columns() const { return cols_; }
+        const std::vector<Real>& values() const { return values_; }
+        //! position of the diagonal element of each row in values()
+        const std::vector<Size>& diagonal() const { return diag_; }
+
+        //! y = A*x
+        void apply_into(const Array& x, Array& y) const;
+        Disposable<Array> apply(const Array& x) const;
+
+      private:
+        std::vector<Size> rowPtr_, cols_, diag_;
+        std::vector<Real> values_;
+    };
+
+
+    //! ILU(0) preconditioner for CsrMatrix
+    /*! The incomplete factorisation keeps the sparsity pattern of the
+        matrix. The symbolic part is done once; afterwards, factorize()
+        only recomputes the values, reusing all storage, as long as the
+        pattern of the matrix doesn't change.
+    */
+    class CsrIlu0Preconditioner {
+      public:
+        CsrIlu0Preconditioner() = default;
+        explicit CsrIlu0Preconditioner(const CsrMatrix& A);
+
+        void factorize(const CsrMatrix& A);
+
+        //! solves L*U*y = b
+        void apply_into(const Array& b, Array& y) const;
+        Disposable<Array> apply(const Array& b) const;
+
+      private:
+        std::vector<Size> rowPtr_, cols_, diag_;
+        std::vector<Real> lu_, invDiag_;
+        std::vector<Size> work_;
+    };
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,153 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/randomnumbers/philoxuniformrng.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        const boost::uint32_t M0 = 0xD2511F53U, M1 = 0xCD9E8D57U;
+        const boost::uint32_t W0 = 0x9E3779B9U, W1 = 0xBB67AE85U;
+        const Size rounds = 10;
+
+        // number of blocks encrypted together; the loops over them
+        // are independent and can be vectorized.
+        const Size lanes = 16;
+
+    }
+
+    PhiloxUniformRng::PhiloxUniformRng(BigNatural seed, BigNatural stream)
+    : stream_(stream), counter_(0), index_(4) {
+        boost::uint64_t s =
+            (seed != 0 ? seed : SeedGenerator::instance().get());
+        key_[0] = boost::uint32_t(s);
+        key_[1] = boost::uint32_t(s >> 32);
+        std::fill(buffer_, buffer_+4, 0U);
+    }
+
+    void PhiloxUniformRng::encrypt(const boost::uint32_t counter[4],
+                                   const boost::uint32_t key[2],
+                                   boost::uint32_t output[4]) {
+        boost::uint32_t c0 = counter[0], c1 = counter[1],
+                        c2 = counter[2], c3 = counter[3];
+        boost::uint32_t k0 = key[0], k1 = key[1];
+        for (Size r=0; r<rounds; ++r) {
+            if (r > 0) {
+                k0 += W0;
+                k1 += W1;
+            }
+            const boost::uint64_t p0 = boost::uint64_t(M0)*c0;
+            const boost::uint64_t p1 = boost::uint64_t(M1)*c2;
+            c0 = boost::uint32_t(p1 >> 32) ^ c1 ^ k0;
+            c1 = boost::uint32_t(p1);
+            c2 = boost::uint32_t(p0 >> 32) ^ c3 ^ k1;
+            c3 = boost::uint32_t(p0);
+        }
+        output[0] = c0;
+        output[1] = c1;
+        output[2] = c2;
+        output[3] = c3;
+    }
+
+    void PhiloxUniformRng::generate(boost::uint64_t counter, Size n,
+                                    boost::uint32_t* output) const {
+        boost::uint32_t c0[lanes], c1[lanes], c2[lanes], c3[lanes];
+        const boost::uint32_t s0 = boost::uint32_t(stream_),
+                              s1 = boost::uint32_t(stream_ >> 32);
+        for (Size first=0; first<n; first+=lanes) {
+            const Size m = std::min(lanes, n-first);
+            for (Size j=0; j<m; ++j) {
+                const boost::uint64_t c = counter + first + j;
+                c0[j] = boost::uint32_t(c);
+                c1[j] = boost::uint32_t(c >> 32);
+                c2[j] = s0;
+                c3[j] = s1;
+            }
+            boost::uint32_t k0 = key_[0], k1 = key_[1];
+            for (Size r=0; r<rounds; ++r) {
+                if (r > 0) {
+                    k0 += W0;
+                    k1 += W1;
+                }
+                for (Size j=0; j<m; ++j) {
+                    const boost::uint64_t p0 = boost::uint64_t(M0)*c0[j];
+                    const boost::uint64_t p1 = boost::uint64_t(M1)*c2[j];
+                    c0[j] = boost::uint32_t(p1 >> 32) ^ c1[j] ^ k0;
+                    c1[j] = boost::uint32_t(p1);
+                    c2[j] = boost::uint32_t(p0 >> 32) ^ c3[j] ^ k1;
+                    c3[j] = boost::uint32_t(p0);
+                }
+            }
+            boost::uint32_t* y = output + 4*first;
+            for (Size j=0; j<m; ++j) {
+                y[4*j]   = c0[j];
+                y[4*j+1] = c1[j];
+                y[4*j+2] = c2[j];
+                y[4*j+3] = c3[j];
+            }
+        }
+    }
+
+    void PhiloxUniformRng::refill() const {
+        generate(counter_, 1, buffer_);
+        ++counter_;
+        index_ = 0;
+    }
+
+    void PhiloxUniformRng::seek(BigNatural stream,
+                                boost::uint64_t position) {
+        stream_ = stream;
+        counter_ = position/4;
+        index_ = 4;
+        if (position % 4 != 0) {
+            refill();
+            index_ = Size(position % 4);
+        }
+    }
+
+    void PhiloxUniformRng::nextBlock(Size n, Real* output) const {
+        Size i = 0;
+        // first, the numbers left from the last block...
+        for (; i<n && index_<4; ++i)
+            output[i] = nextReal();
+        // ...then, whole blocks...
+        const Size chunk = 4*lanes;
+        boost::uint32_t values[chunk];
+        while (n-i >= 4) {
+            const Size blocks = std::min(lanes, (n-i)/4);
+            generate(counter_, blocks, values);
+            counter_ += blocks;
+            for (Size j=0; j<4*blocks; ++j)
+                output[i+j] = (Real(values[j]) + 0.5)/4294967296.0;
+            i += 4*blocks;
+        }
+        // ...and the rest.
+        for (; i<n; ++i)
+            output[i] = nextReal();
+    }
+
+    void PhiloxUniformRng::nextGaussianBlock(
+        Size n, Real* output, const InverseCumulativeNormal& icn) const {
+        nextBlock(n, output);
+        for (Size i=0; i<n; ++i)
+            output[i] = icn(output[i]);
+    }
+
+}
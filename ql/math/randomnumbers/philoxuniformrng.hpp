@@ -0,0 +1,120 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file philoxuniformrng.hpp
+    \brief counter-based Philox uniform random-number generator
+*/
+
+#ifndef quantlib_philox_uniform_rng_hpp
+#define quantlib_philox_uniform_rng_hpp
+
+#include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/randomnumbers/randomsequencegenerator.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <boost/cstdint.hpp>
+
+namespace QuantLib {
+
+    //! Uniform random number generator
+    /*! Counter-based Philox-4x32-10 generator, see
+        J.K. Salmon, M.A. Moraes, R.O. Dror, D.E. Shaw, "Parallel
+        random numbers: as easy as 1, 2, 3", Proceedings of the
+        International Conference for High Performance Computing,
+        Networking, Storage and Analysis (2011).
+
+        The n-th block of four 32-bit numbers of a stream is obtained
+        by encrypting the 128-bit counter (n, stream) with the 64-bit
+        seed as a key.  Therefore, the generator can be positioned on
+        any number of any stream in constant time, and distinct
+        streams with the same seed are independent; this makes
+        parallel simulations reproducible regardless of the order in
+        which their parts are run.
+
+        \test the generator is checked against the known-answer tests
+              of the reference implementation; skipping and block
+              generation are checked against sequential drawing.
+    */
+    class PhiloxUniformRng {
+      public:
+        typedef Sample<Real> sample_type;
+        /*! if the given seed is 0, a random seed will be chosen
+            based on clock() */
+        explicit PhiloxUniformRng(BigNatural seed = 0,
+                                  BigNatural stream = 0);
+        /*! returns a sample with weight 1.0 containing a random number
+            in the (0.0, 1.0) interval  */
+        sample_type next() const { return {nextReal(), 1.0}; }
+        //! return a random number in the (0.0, 1.0)-interval
+        Real nextReal() const {
+            return (Real(nextInt32()) + 0.5)/4294967296.0;
+        }
+        //! return a random integer in the [0,0xffffffff]-interval
+        unsigned long nextInt32() const {
+            if (index_ == 4)
+                refill();
+            return buffer_[index_++];
+        }
+        //! \name Skipping
+        //@{
+        //! moves to the given number of the given stream
+        void seek(BigNatural stream, boost::uint64_t position);
+        BigNatural stream() const { return BigNatural(stream_); }
+        //! number of 32-bit integers drawn from the current stream
+        boost::uint64_t position() const { return 4*counter_ + index_ - 4; }
+        //@}
+        //! \name Block generation
+        //@{
+        //! writes the next n numbers in the (0.0, 1.0)-interval
+        void nextBlock(Size n, Real* output) const;
+        /*! writes the next n numbers mapped by the given inverse
+            cumulative normal; they are the same returned by
+            InverseCumulativeRng<PhiloxUniformRng,InverseCumulativeNormal>.
+        */
+        void nextGaussianBlock(Size n, Real* output,
+                               const InverseCumulativeNormal& icn
+                                   = InverseCumulativeNormal()) const;
+        //@}
+        //! the Philox-4x32-10 bijection
+        static void encrypt(const boost::uint32_t counter[4],
+                            const boost::uint32_t key[2],
+                            boost::uint32_t output[4]);
+      private:
+        void refill() const;
+        // generates the n blocks starting from the given counter
+        void generate(boost::uint64_t counter, Size n,
+                      boost::uint32_t* output) const;
+        boost::uint32_t key_[2];
+        boost::uint64_t stream_;
+        mutable boost::uint64_t counter_;
+        mutable boost::uint32_t buffer_[4];
+        mutable Size index_;
+    };
+
+
+    // sequences are filled a block at a time
+    template <>
+    inline const RandomSequenceGenerator<PhiloxUniformRng>::sample_type&
+    RandomSequenceGenerator<PhiloxUniformRng>::nextSequence() const {
+        rng_.nextBlock(dimensionality_, &sequence_.value[0]);
+        sequence_.weight = 1.0;
+        return sequence_;
+    }
+
+}
+
+
+#endif
@@ -28,15 +28,108 @@
 
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/philoxuniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/sobolblockrsg.hpp>
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/distributions/poissondistribution.hpp>
+#include <boost/cstdint.hpp>
 
 namespace QuantLib {
 
+    //! Selects the stream returned by the sequence-generator factories
+    /*! While an instance of this class is alive, the
+        make_sequence_generator() factories of the traits below
+        (called on the same thread) return generators positioned on
+        the stream starting at the given offset: low-discrepancy
+        generators are skipped ahead to the given point of their
+        sequence, as are counter-based pseudo-random generators, while
+        other pseudo-random generators are seeded with a seed derived
+        from the passed one and the offset.  A null offset selects
+        the default stream.
+
+        This allows drivers such as McSimulation to split a
+        simulation in independent and reproducible blocks without
+        changes to the engines building the generators.
+    */
+    class RandomStreamSelector {
+      public:
+        explicit RandomStreamSelector(BigNatural offset)
+        : previous_(current()) {
+            current() = offset;
+        }
+        RandomStreamSelector(const RandomStreamSelector&) = delete;
+        RandomStreamSelector& operator=(const RandomStreamSelector&) = delete;
+        ~RandomStreamSelector() { current() = previous_; }
+        //! the currently selected stream offset
+        static BigNatural offset() { return current(); }
+        //! seed for the stream starting at the given offset
+        static BigNatural seed(BigNatural seed, BigNatural offset) {
+            // a null seed asks for a random one, which is fine for
+            // any stream; otherwise, we scramble the offset so that
+            // adjacent streams get unrelated seeds (the mixing is the
+            // finalizer of the SplitMix64 generator.)
+            if (seed == 0 || offset == 0)
+                return seed;
+            boost::uint64_t z =
+                boost::uint64_t(seed) +
+                boost::uint64_t(offset) * 0x9E3779B97F4A7C15ULL;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            z ^= z >> 31;
+            BigNatural s = BigNatural(z);
+            return s != 0 ? s : seed;
+        }
+      private:
+        static BigNatural& current() {
+            static thread_local BigNatural offset = 0;
+            return offset;
+        }
+        BigNatural previous_;
+    };
+
+    namespace detail {
+
+        template <class URSG>
+        inline void skipToStream(URSG&, BigNatural offset) {
+            QL_REQUIRE(offset == 0,
+                       "sequence generator does not support skip-ahead");
+        }
+
+        inline void skipToStream(SobolRsg& g, BigNatural offset) {
+            if (offset != 0)
+                g.skipTo(boost::uint_least32_t(offset));
+        }
+
+        inline void skipToStream(SobolBlockRsg& g, BigNatural offset) {
+            if (offset != 0)
+                g.skipTo(boost::uint_least32_t(offset));
+        }
+
+        template <class URNG>
+        inline RandomSequenceGenerator<URNG> makeRandomStream(
+                         Size dimension, BigNatural seed, BigNatural offset) {
+            return RandomSequenceGenerator<URNG>(
+                dimension, RandomStreamSelector::seed(seed, offset));
+        }
+
+        // counter-based generators jump to the given sequence
+        template <>
+        inline RandomSequenceGenerator<PhiloxUniformRng>
+        makeRandomStream<PhiloxUniformRng>(Size dimension,
+                                           BigNatural seed,
+                                           BigNatural offset) {
+            PhiloxUniformRng rng(seed);
+            rng.seek(0, boost::uint64_t(offset)*dimension);
+            return RandomSequenceGenerator<PhiloxUniformRng>(dimension, rng);
+        }
+
+    }
+
+
     // random number traits
 
     template <class URNG, class IC>
@@ -51,7 +144,8 @@ namespace QuantLib {
         // factory
         static rsg_type make_sequence_generator(Size dimension,
                                                 BigNatural seed) {
-            ursg_type g(dimension, seed);
+            ursg_type g = detail::makeRandomStream<URNG>(
+                          dimension, seed, RandomStreamSelector::offset());
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
         // data
@@ -77,6 +171,15 @@ namespace QuantLib {
     typedef GenericPseudoRandom<MersenneTwisterUniformRng,
                                 InverseCumulativePoisson> PoissonPseudoRandom;
 
+    //! traits for counter-based pseudo-random number generation
+    /*! Within the streams selected by RandomStreamSelector, the
+        generators continue the sequence of the default stream; thus,
+        simulations split in blocks return the same results as the
+        serial ones.
+    */
+    typedef GenericPseudoRandom<PhiloxUniformRng,
+                                InverseCumulativeNormal> PhiloxPseudoRandom;
+
 
     template <class URSG, class IC>
     struct GenericLowDiscrepancy {
@@ -89,6 +192,7 @@ namespace QuantLib {
         static rsg_type make_sequence_generator(Size dimension,
                                                 BigNatural seed) {
             ursg_type g(dimension, seed);
+            detail::skipToStream(g, RandomStreamSelector::offset());
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
         // data
@@ -104,6 +208,11 @@ namespace QuantLib {
     typedef GenericLowDiscrepancy<SobolRsg,
                                   InverseCumulativeNormal> LowDiscrepancy;
 
+    //! low-discrepancy traits generating and transforming blocks of points
+    /*! The sequences are the same as the ones of LowDiscrepancy. */
+    typedef GenericLowDiscrepancy<SobolBlockRsg,
+                                  InverseCumulativeNormal> LowDiscrepancyBlock;
+
 }
 
 
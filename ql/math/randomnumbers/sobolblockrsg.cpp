@@ -0,0 +1,157 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/randomnumbers/sobolblockrsg.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    const int SobolBlockRsg::bits_ = 8*sizeof(boost::uint_least32_t);
+    const double SobolBlockRsg::normalizationFactor_ =
+        0.5/(1UL<<(SobolBlockRsg::bits_-1));
+
+    SobolBlockRsg::SobolBlockRsg(Size dimensionality,
+                                 unsigned long seed,
+                                 SobolRsg::DirectionIntegers directionIntegers)
+    : dimensionality_(dimensionality), sequenceCounter_(0), firstDraw_(true),
+      sequence_(std::vector<Real>(dimensionality), 1.0),
+      directionIntegers_(bits_*dimensionality) {
+
+        const SobolRsg rsg(dimensionality, seed, directionIntegers);
+
+        const std::vector<std::vector<boost::uint_least32_t> >& v =
+            rsg.directionIntegers();
+        for (Size k=0; k<dimensionality_; ++k)
+            for (Size j=0; j<Size(bits_); ++j)
+                directionIntegers_[j*dimensionality_+k] = v[k][j];
+
+        // the first point of the sequence, as set up by SobolRsg
+        integerSequence_ = rsg.nextInt32Sequence();
+    }
+
+    void SobolBlockRsg::skipTo(boost::uint_least32_t skip) {
+        const boost::uint_least32_t N = skip+1;
+        const boost::uint_least32_t G = N ^ (N>>1);
+
+        std::fill(integerSequence_.begin(), integerSequence_.end(), 0);
+        for (Size index=0; index<Size(bits_) && (G>>index) != 0; ++index) {
+            if (G>>index & 1) {
+                const boost::uint_least32_t* d =
+                    &directionIntegers_[index*dimensionality_];
+                for (Size k=0; k<dimensionality_; ++k)
+                    integerSequence_[k] ^= d[k];
+            }
+        }
+        sequenceCounter_ = skip;
+    }
+
+    void SobolBlockRsg::advance() const {
+        if (firstDraw_) {
+            // it was precomputed in the constructor or by skipTo
+            firstDraw_ = false;
+            return;
+        }
+        sequenceCounter_++;
+        QL_REQUIRE(sequenceCounter_ != 0, "period exceeded");
+
+        // find rightmost zero bit of the counter
+        boost::uint_least32_t n = sequenceCounter_;
+        Size j = 0;
+        while ((n & 1) != 0U) { n >>= 1; j++; }
+
+        const boost::uint_least32_t* d = &directionIntegers_[j*dimensionality_];
+        boost::uint_least32_t* x = &integerSequence_[0];
+        for (Size k=0; k<dimensionality_; ++k)
+            x[k] ^= d[k];
+    }
+
+    const std::vector<boost::uint_least32_t>&
+    SobolBlockRsg::nextInt32Sequence() const {
+        advance();
+        return integerSequence_;
+    }
+
+    const SobolBlockRsg::sample_type& SobolBlockRsg::nextSequence() const {
+        advance();
+        for (Size k=0; k<dimensionality_; ++k)
+            sequence_.value[k] = integerSequence_[k] * normalizationFactor_;
+        return sequence_;
+    }
+
+    void SobolBlockRsg::nextBlock(Size n, Real* output) const {
+        for (Size i=0; i<n; ++i) {
+            advance();
+            Real* y = output + i*dimensionality_;
+            for (Size k=0; k<dimensionality_; ++k)
+                y[k] = integerSequence_[k] * normalizationFactor_;
+        }
+        if (n > 0)
+            std::copy(output + (n-1)*dimensionality_, output + n*dimensionality_,
+                      sequence_.value.begin());
+    }
+
+    void SobolBlockRsg::nextGaussianBlock(
+        Size n, Real* output, const InverseCumulativeNormal& icn) const {
+        for (Size i=0; i<n; ++i) {
+            advance();
+            Real* y = output + i*dimensionality_;
+            for (Size k=0; k<dimensionality_; ++k)
+                y[k] = icn(integerSequence_[k] * normalizationFactor_);
+        }
+        if (n > 0)
+            std::copy(output + (n-1)*dimensionality_, output + n*dimensionality_,
+                      sequence_.value.begin());
+    }
+
+
+    InverseCumulativeRsg<SobolBlockRsg, InverseCumulativeNormal>::
+    InverseCumulativeRsg(SobolBlockRsg usg)
+    : InverseCumulativeRsg(std::move(usg), InverseCumulativeNormal()) {}
+
+    InverseCumulativeRsg<SobolBlockRsg, InverseCumulativeNormal>::
+    InverseCumulativeRsg(SobolBlockRsg usg,
+                         const InverseCumulativeNormal& inverseCum)
+    : uniformSequenceGenerator_(std::move(usg)),
+      dimension_(uniformSequenceGenerator_.dimension()),
+      // blocks of a few thousand values at most
+      blockSize_(std::max<Size>(1, std::min<Size>(64, 4096/dimension_))),
+      x_(std::vector<Real>(dimension_), 1.0), ICD_(inverseCum),
+      block_(blockSize_*dimension_), position_(blockSize_) {}
+
+    const InverseCumulativeRsg<SobolBlockRsg,
+                               InverseCumulativeNormal>::sample_type&
+    InverseCumulativeRsg<SobolBlockRsg, InverseCumulativeNormal>::
+    nextSequence() const {
+        if (position_ == blockSize_) {
+            uniformSequenceGenerator_.nextGaussianBlock(
+                blockSize_, &block_[0], ICD_);
+            position_ = 0;
+        }
+        const Real* y = &block_[position_*dimension_];
+        std::copy(y, y + dimension_, x_.value.begin());
+        ++position_;
+        return x_;
+    }
+
+    void InverseCumulativeRsg<SobolBlockRsg, InverseCumulativeNormal>::
+    skipTo(boost::uint_least32_t n) {
+        uniformSequenceGenerator_.skipTo(n);
+        position_ = blockSize_;
+    }
+
+}
@@ -0,0 +1,119 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file sobolblockrsg.hpp
+    \brief Sobol sequence generator returning blocks of points
+*/
+
+#ifndef quantlib_sobol_block_rsg_hpp
+#define quantlib_sobol_block_rsg_hpp
+
+#include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/inversecumulativersg.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+
+namespace QuantLib {
+
+    //! Sobol sequence generator returning blocks of points
+    /*! The generator returns the same sequence as SobolRsg with the
+        same parameters, but it can also write a block of consecutive
+        points into a contiguous buffer.  The direction integers are
+        stored bit by bit across dimensions, so that the Gray-code
+        update of all dimensions is a single loop over contiguous
+        memory which compilers can vectorize.  Gaussian blocks are
+        obtained by mapping each integer directly to its normal
+        variate, without storing the uniform point first.
+
+        To partition the sequence among workers, each of them can
+        use its own instance and skipTo() its first point; skipping
+        costs a number of XOR operations per dimension proportional
+        to the logarithm of the point index.
+
+        \test the returned points are checked against the ones of
+              SobolRsg, with and without skipping.
+    */
+    class SobolBlockRsg {
+      public:
+        typedef Sample<std::vector<Real> > sample_type;
+        /*! \pre dimensionality must be <= PPMT_MAX_DIM */
+        explicit SobolBlockRsg(Size dimensionality,
+                               unsigned long seed = 0,
+                               SobolRsg::DirectionIntegers directionIntegers
+                                   = SobolRsg::Jaeckel);
+        /*! skip to the n-th sample in the low-discrepancy sequence */
+        void skipTo(boost::uint_least32_t n);
+        const std::vector<boost::uint_least32_t>& nextInt32Sequence() const;
+        const sample_type& nextSequence() const;
+        const sample_type& lastSequence() const { return sequence_; }
+        Size dimension() const { return dimensionality_; }
+
+        //! writes the next n points one after the other into output
+        /*! output must have room for n*dimension() values; the
+            last point is also available as lastSequence().
+        */
+        void nextBlock(Size n, Real* output) const;
+        //! as nextBlock(), mapped by the given inverse cumulative normal
+        void nextGaussianBlock(Size n, Real* output,
+                               const InverseCumulativeNormal& icn
+                                   = InverseCumulativeNormal()) const;
+
+      private:
+        void advance() const;
+
+        static const int bits_;
+        static const double normalizationFactor_;
+        Size dimensionality_;
+        mutable boost::uint_least32_t sequenceCounter_;
+        mutable bool firstDraw_;
+        mutable sample_type sequence_;
+        mutable std::vector<boost::uint_least32_t> integerSequence_;
+        // integer j of dimension k at j*dimensionality_+k
+        std::vector<boost::uint_least32_t> directionIntegers_;
+    };
+
+
+    //! Gaussian Sobol sequence generator working on blocks of points
+    /*! This specialization generates and transforms blocks of points
+        ahead of time and returns them one at a time; the returned
+        sequence is the same as the one of the generic class.
+    */
+    template <>
+    class InverseCumulativeRsg<SobolBlockRsg, InverseCumulativeNormal> {
+      public:
+        typedef Sample<std::vector<Real> > sample_type;
+        explicit InverseCumulativeRsg(SobolBlockRsg uniformSequenceGenerator);
+        InverseCumulativeRsg(SobolBlockRsg uniformSequenceGenerator,
+                             const InverseCumulativeNormal& inverseCumulative);
+        //! returns next sample from the inverse cumulative distribution
+        const sample_type& nextSequence() const;
+        const sample_type& lastSequence() const { return x_; }
+        Size dimension() const { return dimension_; }
+        /*! skip to the n-th sample in the low-discrepancy sequence;
+            the points already transformed are discarded */
+        void skipTo(boost::uint_least32_t n);
+      private:
+        SobolBlockRsg uniformSequenceGenerator_;
+        Size dimension_, blockSize_;
+        mutable sample_type x_;
+        InverseCumulativeNormal ICD_;
+        mutable std::vector<Real> block_;
+        mutable Size position_;
+    };
+
+}
+
+#endif
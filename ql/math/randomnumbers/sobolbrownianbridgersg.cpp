@@ -23,6 +23,7 @@
 */
 
 #include <ql/math/randomnumbers/sobolbrownianbridgersg.hpp>
+#include <boost/iterator/permutation_iterator.hpp>
 
 namespace QuantLib {
     SobolBrownianBridgeRsg::SobolBrownianBridgeRsg(
@@ -32,17 +33,28 @@ namespace QuantLib {
         SobolRsg::DirectionIntegers directionIntegers)
     : factors_(factors), steps_(steps), dim_(factors*steps),
       seq_(sample_type::value_type(factors*steps), 1.0),
-      gen_(factors, steps, ordering, seed, directionIntegers) {
+      generator_(SobolBlockRsg(factors*steps, seed, directionIntegers),
+                 InverseCumulativeNormal()),
+      bridge_(steps),
+      orderedIndices_(SobolBrownianGenerator(factors, steps, ordering,
+                                             seed, directionIntegers)
+                      .orderedIndices()),
+      bridgedVariates_(steps) {
     }
 
     const SobolBrownianBridgeRsg::sample_type&
     SobolBrownianBridgeRsg::nextSequence() const {
-        gen_.nextPath();
-        std::vector<Real> output(factors_);
-        for (Size i=0; i < steps_; ++i) {
-            gen_.nextStep(output);
-            std::copy(output.begin(), output.end(),
-                      seq_.value.begin()+i*factors_);
+        const sample_type& sample = generator_.nextSequence();
+        for (Size i=0; i < factors_; ++i) {
+            bridge_.transform(boost::make_permutation_iterator(
+                                  sample.value.begin(),
+                                  orderedIndices_[i].begin()),
+                              boost::make_permutation_iterator(
+                                  sample.value.begin(),
+                                  orderedIndices_[i].end()),
+                              bridgedVariates_.begin());
+            for (Size j=0; j < steps_; ++j)
+                seq_.value[j*factors_+i] = bridgedVariates_[j];
         }
 
         return seq_;
@@ -56,4 +68,8 @@ namespace QuantLib {
     Size SobolBrownianBridgeRsg::dimension() const {
         return dim_;
     }
+
+    void SobolBrownianBridgeRsg::skipTo(boost::uint_least32_t n) {
+        generator_.skipTo(n);
+    }
 }
@@ -29,6 +29,13 @@
 
 namespace QuantLib {
 
+    //! Brownian-bridged Sobol sequence generator
+    /*! The generator returns the same variates as the steps of a
+        SobolBrownianGenerator, step by step and factor by factor in
+        a single sequence.  The Gaussian variates are generated in
+        blocks by SobolBlockRsg and bridged directly into the
+        returned sequence.
+    */
     class SobolBrownianBridgeRsg {
       public:
         typedef Sample<std::vector<Real> > sample_type;
@@ -44,10 +51,17 @@ namespace QuantLib {
         const sample_type& lastSequence() const;
         Size dimension() const;
 
+        //! skips to the n-th path of the underlying Sobol sequence
+        void skipTo(boost::uint_least32_t n);
+
       private:
         const Size factors_, steps_, dim_;
         mutable sample_type seq_;
-        mutable SobolBrownianGenerator gen_;
+        InverseCumulativeRsg<SobolBlockRsg, InverseCumulativeNormal>
+            generator_;
+        const BrownianBridge bridge_;
+        std::vector<std::vector<Size> > orderedIndices_;
+        mutable std::vector<Real> bridgedVariates_;
     };
 }
 
@@ -131,6 +131,9 @@ namespace QuantLib {
         }
         const sample_type& lastSequence() const { return sequence_; }
         Size dimension() const { return dimensionality_; }
+        //! direction integers of each dimension, one per bit
+        const std::vector<std::vector<boost::uint_least32_t> >&
+        directionIntegers() const { return directionIntegers_; }
       private:
         static const int bits_;
         static const double normalizationFactor_;
@@ -25,6 +25,8 @@ namespace QuantLib {
 
     Real GeneralStatistics::weightSum() const {
         Real result = 0.0;
+        for (Size i=0; i<values_.size(); ++i)
+            result += 1.0;
         std::vector<std::pair<Real,Real> >::const_iterator it;
         for (it=samples_.begin(); it!=samples_.end(); ++it) {
             result += it->second;
@@ -92,6 +94,17 @@ namespace QuantLib {
 
         sort();
 
+        if (samples_.empty()) {
+            // all weights are 1
+            Size k = 0, l = values_.size()-1;
+            Real integral = 1.0, target = percent*sampleWeight;
+            while (integral < target && k != l) {
+                ++k;
+                integral += 1.0;
+            }
+            return values_[k];
+        }
+
         std::vector<std::pair<Real,Real> >::iterator k, l;
         k = samples_.begin();
         l = samples_.end()-1;
@@ -116,6 +129,17 @@ namespace QuantLib {
 
         sort();
 
+        if (samples_.empty()) {
+            // all weights are 1
+            Size k = values_.size()-1;
+            Real integral = 1.0, target = percent*sampleWeight;
+            while (integral < target && k != 0) {
+                --k;
+                integral += 1.0;
+            }
+            return values_[k];
+        }
+
         std::vector<std::pair<Real,Real> >::reverse_iterator k, l;
         k = samples_.rbegin();
         l = samples_.rend()-1;
@@ -129,4 +153,21 @@ namespace QuantLib {
         return k->first;
     }
 
+    void GeneralStatistics::merge(const GeneralStatistics& other) {
+        if (other.samples() == 0)
+            return;
+        if (samples_.empty() && other.samples_.empty()) {
+            values_.insert(values_.end(),
+                           other.values_.begin(), other.values_.end());
+        } else {
+            expand();
+            samples_.reserve(samples_.size() + other.samples());
+            samples_.insert(samples_.end(),
+                            other.samples_.begin(), other.samples_.end());
+            for (Real x : other.values_)
+                samples_.emplace_back(x, 1.0);
+        }
+        sorted_ = false;
+    }
+
 }
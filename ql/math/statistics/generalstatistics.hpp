@@ -29,6 +29,7 @@
 #include <ql/errors.hpp>
 #include <vector>
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
 namespace QuantLib {
@@ -41,7 +42,10 @@ namespace QuantLib {
 
         It doesn't suffer the numerical instability problem of
         IncrementalStatistics. The downside is that it stores all
-        samples, thus increasing the memory requirements.
+        samples, thus increasing the memory requirements.  As long
+        as all the weights are 1, as is the case for most Monte Carlo
+        simulations, the values are stored without their weights,
+        which halves the memory used.
     */
     class GeneralStatistics {
       public:
@@ -52,8 +56,67 @@ namespace QuantLib {
         //! number of samples collected
         Size samples() const;
 
+        //! read-only view of the collected (value, weight) pairs
+        /*! The view reads the storage of the statistics, returning
+            the values stored without weights with a unit weight, and
+            can be converted to a vector of pairs.  It is invalidated
+            by any change of the data.
+        */
+        class DataView {
+          public:
+            typedef std::pair<Real,Real> value_type;
+            class const_iterator {
+              public:
+                typedef std::input_iterator_tag iterator_category;
+                typedef std::pair<Real,Real> value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef const value_type* pointer;
+                typedef value_type reference;
+                const_iterator(const GeneralStatistics* s, Size i)
+                : s_(s), i_(i) {}
+                value_type operator*() const { return s_->sample(i_); }
+                pointer operator->() const {
+                    current_ = s_->sample(i_);
+                    return &current_;
+                }
+                const_iterator& operator++() { ++i_; return *this; }
+                const_iterator operator++(int) {
+                    const_iterator tmp = *this;
+                    ++i_;
+                    return tmp;
+                }
+                bool operator==(const const_iterator& o) const {
+                    return i_ == o.i_ && s_ == o.s_;
+                }
+                bool operator!=(const const_iterator& o) const {
+                    return !(*this == o);
+                }
+              private:
+                const GeneralStatistics* s_;
+                Size i_;
+                mutable value_type current_;
+            };
+            explicit DataView(const GeneralStatistics& s) : s_(&s) {}
+            Size size() const { return s_->samples(); }
+            bool empty() const { return size() == 0; }
+            value_type operator[](Size i) const { return s_->sample(i); }
+            const_iterator begin() const { return const_iterator(s_, 0); }
+            const_iterator end() const {
+                return const_iterator(s_, size());
+            }
+            operator std::vector<value_type>() const {
+                return std::vector<value_type>(begin(), end());
+            }
+          private:
+            const GeneralStatistics* s_;
+        };
+
         //! collected data
-        const std::vector<std::pair<Real,Real> >& data() const;
+        /*! The returned view doesn't modify the statistics, so that
+            concurrent readers are safe and values stored without
+            weights stay so.
+        */
+        DataView data() const;
 
         //! sum of data weights
         Real weightSum() const;
@@ -117,6 +180,13 @@ namespace QuantLib {
                                               const Predicate& inRange) const {
             Real num = 0.0, den = 0.0;
             Size N = 0;
+            for (Real x : values_) {
+                if (inRange(x)) {
+                    num += f(x);
+                    den += 1.0;
+                    N += 1;
+                }
+            }
             std::vector<std::pair<Real,Real> >::const_iterator i;
             for (i=samples_.begin(); i!=samples_.end(); ++i) {
                 Real x = i->first, w = i->second;
@@ -169,6 +239,9 @@ namespace QuantLib {
                 add(*begin, *wbegin);
         }
 
+        //! adds the data collected by another instance
+        void merge(const GeneralStatistics& other);
+
         //! resets the data to a null set
         void reset();
 
@@ -179,7 +252,14 @@ namespace QuantLib {
         void sort() const;
         //@}
       private:
+        // i-th (value, weight) pair, from either storage
+        std::pair<Real,Real> sample(Size i) const;
+        // moves the values stored without weights into samples_
+        void expand() const;
+        // samples_ is empty as long as all weights are 1; values_
+        // is empty afterwards
         mutable std::vector<std::pair<Real,Real> > samples_;
+        mutable std::vector<Real> values_;
         mutable bool sorted_;
     };
 
@@ -191,12 +271,28 @@ namespace QuantLib {
     }
 
     inline Size GeneralStatistics::samples() const {
-        return samples_.size();
+        return samples_.size() + values_.size();
+    }
+
+    inline GeneralStatistics::DataView GeneralStatistics::data() const {
+        return DataView(*this);
+    }
+
+    inline std::pair<Real,Real> GeneralStatistics::sample(Size i) const {
+        if (samples_.empty())
+            return std::make_pair(values_[i], 1.0);
+        return samples_[i];
+    }
+
+    inline bool operator==(const GeneralStatistics::DataView& lhs,
+                           const GeneralStatistics::DataView& rhs) {
+        return lhs.size() == rhs.size()
+            && std::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
-    inline const std::vector<std::pair<Real,Real> >&
-    GeneralStatistics::data() const {
-        return samples_;
+    inline bool operator!=(const GeneralStatistics::DataView& lhs,
+                           const GeneralStatistics::DataView& rhs) {
+        return !(lhs == rhs);
     }
 
     inline Real GeneralStatistics::standardDeviation() const {
@@ -209,12 +305,16 @@ namespace QuantLib {
 
     inline Real GeneralStatistics::min() const {
         QL_REQUIRE(samples() > 0, "empty sample set");
+        if (samples_.empty())
+            return *std::min_element(values_.begin(), values_.end());
         return std::min_element(samples_.begin(),
                                 samples_.end())->first;
     }
 
     inline Real GeneralStatistics::max() const {
         QL_REQUIRE(samples() > 0, "empty sample set");
+        if (samples_.empty())
+            return *std::max_element(values_.begin(), values_.end());
         return std::max_element(samples_.begin(),
                                 samples_.end())->first;
     }
@@ -222,26 +322,48 @@ namespace QuantLib {
     /*! \pre weights must be positive or null */
     inline void GeneralStatistics::add(Real value, Real weight) {
         QL_REQUIRE(weight>=0.0, "negative weight not allowed");
-        samples_.emplace_back(value, weight);
+        if (weight == 1.0 && samples_.empty()) {
+            values_.push_back(value);
+        } else {
+            expand();
+            samples_.emplace_back(value, weight);
+        }
         sorted_ = false;
     }
 
     inline void GeneralStatistics::reset() {
         samples_ = std::vector<std::pair<Real,Real> >();
+        values_ = std::vector<Real>();
         sorted_ = true;
     }
 
     inline void GeneralStatistics::reserve(Size n) const {
-        samples_.reserve(n);
+        if (samples_.empty())
+            values_.reserve(n);
+        else
+            samples_.reserve(n);
     }
 
     inline void GeneralStatistics::sort() const {
         if (!sorted_) {
-            std::sort(samples_.begin(), samples_.end());
+            if (samples_.empty())
+                std::sort(values_.begin(), values_.end());
+            else
+                std::sort(samples_.begin(), samples_.end());
             sorted_ = true;
         }
     }
 
+    inline void GeneralStatistics::expand() const {
+        if (!values_.empty()) {
+            samples_.reserve(std::max(values_.capacity(),
+                                      values_.size()+1));
+            for (Real x : values_)
+                samples_.emplace_back(x, 1.0);
+            values_ = std::vector<Real>();
+        }
+    }
+
 }
 
 
@@ -0,0 +1,155 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/mergeablestatistics.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    MergeableStatistics::MergeableStatistics() {
+        reset();
+    }
+
+    Real MergeableStatistics::mean() const {
+        QL_REQUIRE(weightSum_ > 0.0, "sampleWeight_= 0, unsufficient");
+        return mean_;
+    }
+
+    Real MergeableStatistics::variance() const {
+        QL_REQUIRE(weightSum_ > 0.0, "sampleWeight_= 0, unsufficient");
+        QL_REQUIRE(samples_ > 1, "sample number <= 1, unsufficient");
+        Real n = static_cast<Real>(samples_);
+        return n / (n - 1.0) * m2_ / weightSum_;
+    }
+
+    Real MergeableStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    Real MergeableStatistics::errorEstimate() const {
+        return std::sqrt(variance() / samples_);
+    }
+
+    Real MergeableStatistics::skewness() const {
+        QL_REQUIRE(samples_ > 2, "sample number <= 2, unsufficient");
+        Real n = static_cast<Real>(samples_);
+        Real r1 = n / (n - 2.0);
+        Real r2 = (n - 1.0) / (n - 2.0);
+        Real s2 = m2_ / weightSum_;
+        return std::sqrt(r1 * r2) * (m3_ / weightSum_) / (s2 * std::sqrt(s2));
+    }
+
+    Real MergeableStatistics::kurtosis() const {
+        QL_REQUIRE(samples_ > 3, "sample number <= 3, unsufficient");
+        Real n = static_cast<Real>(samples_);
+        Real r1 = (n - 1.0) / (n - 2.0);
+        Real r2 = (n + 1.0) / (n - 3.0);
+        Real r3 = (n - 1.0) / (n - 3.0);
+        Real s2 = m2_ / weightSum_;
+        return ((m4_ / weightSum_) / (s2 * s2) * r2 - 3.0 * r3) * r1;
+    }
+
+    Real MergeableStatistics::min() const {
+        QL_REQUIRE(samples_ > 0, "empty sample set");
+        return min_;
+    }
+
+    Real MergeableStatistics::max() const {
+        QL_REQUIRE(samples_ > 0, "empty sample set");
+        return max_;
+    }
+
+    Real MergeableStatistics::downsideVariance() const {
+        QL_REQUIRE(downsideWeightSum_ > 0.0, "sampleWeight_= 0, unsufficient");
+        QL_REQUIRE(downsideSamples_ > 1, "sample number <= 1, unsufficient");
+        Real n = static_cast<Real>(downsideSamples_);
+        Real r1 = n / (n - 1.0);
+        return r1 * downsideSquaredSum_ / downsideWeightSum_;
+    }
+
+    Real MergeableStatistics::downsideDeviation() const {
+        return std::sqrt(downsideVariance());
+    }
+
+    void MergeableStatistics::add(Real value, Real valueWeight) {
+        QL_REQUIRE(valueWeight >= 0.0, "negative weight (" << valueWeight
+                                                           << ") not allowed");
+        if (samples_ == 0) {
+            min_ = max_ = value;
+        } else {
+            min_ = std::min(min_, value);
+            max_ = std::max(max_, value);
+        }
+        ++samples_;
+        merge(valueWeight, value, 0.0, 0.0, 0.0);
+        if (value < 0.0) {
+            ++downsideSamples_;
+            downsideWeightSum_ += valueWeight;
+            downsideSquaredSum_ += valueWeight * value * value;
+        }
+    }
+
+    void MergeableStatistics::merge(const MergeableStatistics& other) {
+        if (other.samples_ == 0)
+            return;
+        if (samples_ == 0) {
+            *this = other;
+            return;
+        }
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        samples_ += other.samples_;
+        merge(other.weightSum_, other.mean_,
+              other.m2_, other.m3_, other.m4_);
+        downsideSamples_ += other.downsideSamples_;
+        downsideWeightSum_ += other.downsideWeightSum_;
+        downsideSquaredSum_ += other.downsideSquaredSum_;
+    }
+
+    void MergeableStatistics::merge(Real wB, Real meanB,
+                                    Real m2B, Real m3B, Real m4B) {
+        if (wB == 0.0)
+            return;
+        const Real wA = weightSum_, w = wA + wB;
+        const Real delta = meanB - mean_;
+        const Real dw = delta / w;
+        const Real dw2 = dw * dw;
+
+        // higher moments first, as they use the old lower ones
+        m4_ += m4B
+            + delta * dw2 * dw * wA * wB * (wA * wA - wA * wB + wB * wB)
+            + 6.0 * dw2 * (wA * wA * m2B + wB * wB * m2_)
+            + 4.0 * dw * (wA * m3B - wB * m3_);
+        m3_ += m3B
+            + delta * dw2 * wA * wB * (wA - wB)
+            + 3.0 * dw * (wA * m2B - wB * m2_);
+        m2_ += m2B + delta * dw * wA * wB;
+        mean_ += dw * wB;
+        weightSum_ = w;
+    }
+
+    void MergeableStatistics::reset() {
+        samples_ = 0;
+        weightSum_ = mean_ = 0.0;
+        m2_ = m3_ = m4_ = 0.0;
+        min_ = max_ = Null<Real>();
+        downsideSamples_ = 0;
+        downsideWeightSum_ = downsideSquaredSum_ = 0.0;
+    }
+
+}
@@ -0,0 +1,159 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mergeablestatistics.hpp
+    \brief incremental statistics which can be merged
+*/
+
+#ifndef quantlib_mergeable_statistics_hpp
+#define quantlib_mergeable_statistics_hpp
+
+#include <ql/utilities/null.hpp>
+#include <ql/errors.hpp>
+
+namespace QuantLib {
+
+    //! Statistics tool based on incremental accumulation
+    /*! It provides the same statistics as IncrementalStatistics, but
+        the central moments are updated with the pairwise formulas of
+        T.F. Chan, G.H. Golub, R.J. LeVeque, "Updating formulae and a
+        pairwise algorithm for computing sample variances" (1979) and
+        P. Pébay, "Formulas for robust, one-pass parallel computation
+        of covariances and arbitrary-order statistical moments" (2008).
+
+        Therefore, accumulators filled separately, e.g., by different
+        threads, can be merged into one which returns the statistics
+        of all the data, with no need to store them.
+
+        \test the statistics of merged accumulators are checked
+              against the ones of a single accumulator.
+    */
+    class MergeableStatistics {
+      public:
+        typedef Real value_type;
+        MergeableStatistics();
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const { return samples_; }
+
+        //! sum of data weights
+        Real weightSum() const { return weightSum_; }
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate \f$ \epsilon \f$, defined as the
+            square root of the ratio of the variance to the number of
+            samples.
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        //! number of negative samples collected
+        Size downsideSamples() const { return downsideSamples_; }
+
+        //! sum of data weights for negative samples
+        Real downsideWeightSum() const { return downsideWeightSum_; }
+
+        /*! returns the downside variance, defined as
+            \f[ \frac{N}{N-1} \times \frac{ \sum_{i=1}^{N}
+                \theta \times x_i^{2}}{ \sum_{i=1}^{N} w_i} \f],
+            where \f$ \theta \f$ = 0 if x > 0 and
+            \f$ \theta \f$ =1 if x <0
+        */
+        Real downsideVariance() const;
+
+        /*! returns the downside deviation, defined as the
+            square root of the downside variance.
+        */
+        Real downsideDeviation() const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weight must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        /*! \pre weights must be positive or null */
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! adds the data collected by another instance
+        void merge(const MergeableStatistics& other);
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        // adds a set of data with the given weight sum and moments
+        void merge(Real weight, Real mean, Real m2, Real m3, Real m4);
+        Size samples_;
+        Real weightSum_, mean_;
+        // weighted sums of the powers of the deviations from the mean
+        Real m2_, m3_, m4_;
+        Real min_, max_;
+        Size downsideSamples_;
+        Real downsideWeightSum_, downsideSquaredSum_;
+    };
+
+}
+
+
+#endif
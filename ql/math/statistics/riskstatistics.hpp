@@ -42,6 +42,7 @@ namespace QuantLib {
     class GenericRiskStatistics : public S {
       public:
         typedef typename S::value_type value_type;
+        using S::S;
 
         /*! returns the variance of observations below the mean,
             \f[ \frac{N}{N-1}
@@ -26,6 +26,7 @@
 
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/statistics/mergeablestatistics.hpp>
 #include <ql/math/matrix.hpp>
 
 namespace QuantLib {
@@ -111,6 +112,11 @@ namespace QuantLib {
         //! \name Modifiers
         //@{
         void reset(Size dimension = 0);
+        //! adds the data collected by another instance
+        /*! \pre the underlying statistics class must provide a
+                 merge() method.
+        */
+        void merge(const GenericSequenceStatistics& other);
         template <class Sequence>
         void add(const Sequence& sample,
                  Real weight = 1.0) {
@@ -153,6 +159,7 @@ namespace QuantLib {
     */
     typedef GenericSequenceStatistics<Statistics> SequenceStatistics;
     typedef GenericSequenceStatistics<IncrementalStatistics> SequenceStatisticsInc;
+    typedef GenericSequenceStatistics<MergeableStatistics> SequenceStatisticsMergeable;
 
     // inline definitions
 
@@ -243,6 +250,21 @@ namespace QuantLib {
         }
     }
 
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                                  const GenericSequenceStatistics& other) {
+        if (other.dimension_ == 0)
+            return;
+        if (dimension_ == 0)
+            reset(other.dimension_);
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+        quadraticSum_ += other.quadraticSum_;
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
+    }
+
     template <class Stat>
     Disposable<Matrix> GenericSequenceStatistics<Stat>::covariance() const {
         Real sampleWeight = weightSum();
@@ -0,0 +1,186 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/tdigeststatistics.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    TDigestStatistics::TDigestStatistics(Real compression)
+    : compression_(compression) {
+        QL_REQUIRE(compression_ >= 10.0,
+                   "compression (" << compression_ << ") must be at least 10");
+    }
+
+    Real TDigestStatistics::percentile(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        return quantile(percent);
+    }
+
+    Real TDigestStatistics::topPercentile(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        return quantile(1.0 - percent);
+    }
+
+    Size TDigestStatistics::centroids() const {
+        std::vector<Centroid> buffer;
+        return compressed(buffer).size();
+    }
+
+    Real TDigestStatistics::quantile(Real q) const {
+        QL_REQUIRE(weightSum() > 0.0, "empty sample set");
+
+        std::vector<Centroid> buffer;
+        const std::vector<Centroid>& c = compressed(buffer);
+
+        const Real target = q*weightSum();
+        const Size n = c.size();
+
+        // the centroid holding the target weight
+        Size i = 0;
+        Real below = 0.0;
+        while (i < n-1 && below + c[i].weight < target) {
+            below += c[i].weight;
+            ++i;
+        }
+
+        // single samples are returned as they are
+        if (c[i].samples == 1)
+            return c[i].mean;
+
+        // otherwise, we interpolate linearly between the centers of
+        // the neighbouring centroids, or the extreme samples
+        const Real center = below + 0.5*c[i].weight;
+        if (target < center) {
+            Real x0, w0;
+            if (i == 0) {
+                x0 = min();
+                w0 = 0.0;
+            } else {
+                x0 = c[i-1].mean;
+                w0 = below - ((c[i-1].samples == 1) ? 0.0
+                                                     : 0.5*c[i-1].weight);
+            }
+            return x0 + (c[i].mean - x0)*(target - w0)/(center - w0);
+        } else {
+            Real x1, w1;
+            if (i == n-1) {
+                x1 = max();
+                w1 = weightSum();
+            } else {
+                x1 = c[i+1].mean;
+                w1 = below + c[i].weight
+                    + ((c[i+1].samples == 1) ? 0.0 : 0.5*c[i+1].weight);
+            }
+            if (w1 <= center)
+                return c[i].mean;
+            return c[i].mean + (x1 - c[i].mean)*(target - center)/(w1 - center);
+        }
+    }
+
+    void TDigestStatistics::compress(std::vector<Centroid>& c) const {
+        std::sort(c.begin(), c.end(),
+                  [](const Centroid& a, const Centroid& b) {
+                      return a.mean < b.mean;
+                  });
+
+        Real total = 0.0;
+        for (const auto& i : c)
+            total += i.weight;
+        if (c.empty() || total <= 0.0)
+            return;
+
+        // scale function k1 of Dunning and Ertl: a centroid may span
+        // at most one unit of k, which keeps the tail centroids small
+        const Real scale = compression_/(2.0*M_PI);
+        const auto k = [&](Real q) {
+            return scale*std::asin(std::max(-1.0, std::min(1.0, 2.0*q-1.0)));
+        };
+
+        std::vector<Centroid> result;
+        result.reserve(c.size());
+        Centroid current = c.front();
+        Real below = 0.0;
+        for (Size i=1; i<c.size(); ++i) {
+            const Real w = current.weight + c[i].weight;
+            if (k((below + w)/total) - k(below/total) <= 1.0) {
+                if (w > 0.0)
+                    current.mean += (c[i].mean - current.mean)*c[i].weight/w;
+                current.weight = w;
+                current.samples += c[i].samples;
+            } else {
+                below += current.weight;
+                result.push_back(current);
+                current = c[i];
+            }
+        }
+        result.push_back(current);
+        c.swap(result);
+    }
+
+    const std::vector<TDigestStatistics::Centroid>&
+    TDigestStatistics::compressed(std::vector<Centroid>& buffer) const {
+        if (unmerged_.empty())
+            return centroids_;
+
+        buffer.reserve(centroids_.size() + unmerged_.size());
+        buffer.assign(centroids_.begin(), centroids_.end());
+        buffer.insert(buffer.end(), unmerged_.begin(), unmerged_.end());
+        compress(buffer);
+        return buffer;
+    }
+
+    void TDigestStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight >= 0.0, "negative weight (" << weight
+                   << ") not allowed");
+        moments_.add(value, weight);
+        unmerged_.push_back({value, weight, 1});
+        if (unmerged_.size() >= 5*static_cast<Size>(compression_)) {
+            unmerged_.insert(unmerged_.end(),
+                             centroids_.begin(), centroids_.end());
+            compress(unmerged_);
+            centroids_.swap(unmerged_);
+            unmerged_.clear();
+        }
+    }
+
+    void TDigestStatistics::merge(const TDigestStatistics& other) {
+        if (other.samples() == 0)
+            return;
+        moments_.merge(other.moments_);
+        unmerged_.insert(unmerged_.end(),
+                         other.centroids_.begin(), other.centroids_.end());
+        unmerged_.insert(unmerged_.end(),
+                         other.unmerged_.begin(), other.unmerged_.end());
+        unmerged_.insert(unmerged_.end(),
+                         centroids_.begin(), centroids_.end());
+        compress(unmerged_);
+        centroids_.swap(unmerged_);
+        unmerged_.clear();
+    }
+
+    void TDigestStatistics::reset() {
+        moments_.reset();
+        centroids_.clear();
+        unmerged_.clear();
+    }
+
+}
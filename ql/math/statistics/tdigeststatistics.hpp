@@ -0,0 +1,203 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file tdigeststatistics.hpp
+    \brief statistics tool based on a mergeable quantile sketch
+*/
+
+#ifndef quantlib_tdigest_statistics_hpp
+#define quantlib_tdigest_statistics_hpp
+
+#include <ql/math/statistics/mergeablestatistics.hpp>
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Statistics tool based on a t-digest quantile sketch
+    /*! The empirical distribution is summarized by a t-digest, see
+        T. Dunning, O. Ertl, "Computing extremely accurate quantiles
+        using t-digests" (2019): the samples are clustered into
+        centroids whose size shrinks towards the tails, so that
+        percentiles close to 0 or 1, and therefore value-at-risk and
+        expected shortfall, keep their accuracy.  The number of
+        centroids is bounded by a multiple of the compression, so the
+        memory used doesn't grow with the number of samples, and
+        sketches filled separately, e.g., by different threads, can
+        be merged.  The moments are the exact ones of
+        MergeableStatistics.
+
+        Percentiles and expectation values are approximate: samples
+        merged into a centroid are represented by their mean.  Use
+        GeneralStatistics when exact results are required.
+
+        \test percentiles, value-at-risk and expected shortfall of
+              merged sketches are checked against the exact ones.
+    */
+    class TDigestStatistics {
+      public:
+        typedef Real value_type;
+        /*! the compression bounds the number of centroids; larger
+            values give more accurate percentiles. */
+        explicit TDigestStatistics(Real compression = 200.0);
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const { return moments_.samples(); }
+        //! sum of data weights
+        Real weightSum() const { return moments_.weightSum(); }
+        Real mean() const { return moments_.mean(); }
+        Real variance() const { return moments_.variance(); }
+        Real standardDeviation() const {
+            return moments_.standardDeviation();
+        }
+        Real errorEstimate() const { return moments_.errorEstimate(); }
+        Real skewness() const { return moments_.skewness(); }
+        Real kurtosis() const { return moments_.kurtosis(); }
+        Real min() const { return moments_.min(); }
+        Real max() const { return moments_.max(); }
+
+        /*! Expectation value of a function \f$ f \f$ on a given
+            range \f$ \mathcal{R} \f$; see
+            GeneralStatistics::expectationValue.  Single samples are
+            used as they are; the samples of larger centroids are
+            assumed to be spread linearly between the midpoints to
+            the neighbouring centroids, which is sampled by a few
+            points preserving the weight and the mean of the centroid.
+            The function returns a pair made of the result and the
+            approximate number of samples within the range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            std::vector<Centroid> buffer;
+            const std::vector<Centroid>& c = compressed(buffer);
+            Real num = 0.0, den = 0.0, N = 0.0;
+            for (Size i=0; i<c.size(); ++i) {
+                if (c[i].samples == 1) {
+                    if (inRange(c[i].mean)) {
+                        num += f(c[i].mean)*c[i].weight;
+                        den += c[i].weight;
+                        N += 1.0;
+                    }
+                    continue;
+                }
+                const Real x = c[i].mean;
+                const Real lo = (i == 0) ? min() : 0.5*(c[i-1].mean + x);
+                const Real hi = (i == c.size()-1) ? max()
+                                                  : 0.5*(x + c[i+1].mean);
+                // the weights on each side preserve the mean
+                const Real wl = (hi > lo) ? (hi - x)/(hi - lo) : 0.5;
+                const Size m = subdivisions_;
+                for (Size j=0; j<m; ++j) {
+                    const Real u = (j + 0.5)/m;
+                    const Real xl = lo + u*(x - lo), xr = x + u*(hi - x);
+                    if (inRange(xl)) {
+                        num += f(xl)*c[i].weight*wl/m;
+                        den += c[i].weight*wl/m;
+                        N += c[i].samples*wl/m;
+                    }
+                    if (inRange(xr)) {
+                        num += f(xr)*c[i].weight*(1.0-wl)/m;
+                        den += c[i].weight*(1.0-wl)/m;
+                        N += c[i].samples*(1.0-wl)/m;
+                    }
+                }
+            }
+            if (den == 0.0 || N == 0.0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den,
+                                      std::max(Size(1), Size(N + 0.5)));
+        }
+
+        /*! approximate \f$ y \f$-th percentile; see
+            GeneralStatistics::percentile.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! approximate \f$ y \f$-th top percentile; see
+            GeneralStatistics::topPercentile.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+
+        //! number of centroids summarizing the samples
+        Size centroids() const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weight must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        /*! \pre weights must be positive or null */
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! adds the data collected by another instance
+        void merge(const TDigestStatistics& other);
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Real mean, weight;
+            Size samples;
+        };
+        // quantile in [0, 1], interpolated between the centroids
+        Real quantile(Real q) const;
+        // sorts and clusters the given centroids in place
+        void compress(std::vector<Centroid>& c) const;
+        // the compressed centroids, using buffer if new data were
+        // added since the last compression; this doesn't modify the
+        // sketch, so that concurrent inspectors are safe
+        const std::vector<Centroid>& compressed(
+                                       std::vector<Centroid>& buffer) const;
+
+        // points per side sampling a centroid in expectationValue()
+        static const Size subdivisions_ = 4;
+        Real compression_;
+        MergeableStatistics moments_;
+        // compressed centroids, sorted by mean
+        std::vector<Centroid> centroids_;
+        // data added since the last compression
+        std::vector<Centroid> unmerged_;
+    };
+
+
+    //! risk measures based on a t-digest quantile sketch
+    typedef GenericRiskStatistics<TDigestStatistics> TDigestRiskStatistics;
+
+}
+
+
+#endif
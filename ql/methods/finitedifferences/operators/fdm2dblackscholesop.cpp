@@ -26,6 +26,7 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/fdm2dblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
+#include <algorithm>
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
 #include <boost/numeric/ublas/matrix.hpp>
@@ -114,42 +115,86 @@ namespace QuantLib {
                                  ->forwardRate(t1, t2, Continuous).rate();
     }
 
-    Disposable<Array> Fdm2dBlackScholesOp::apply(const Array& x) const {
-        return opX_.apply(x) + opY_.apply(x) + apply_mixed(x);
+    Disposable<Array> Fdm2dBlackScholesOp::apply(const Array& r) const {
+        Array retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
     }
-    
-    Disposable<Array> Fdm2dBlackScholesOp::apply_mixed(const Array& x) const {
-        return corrMapT_.apply(x) + currentForwardRate_*x;
+
+    Disposable<Array> Fdm2dBlackScholesOp::apply_mixed(const Array& r) const {
+        Array retVal(r.size());
+        apply_mixed_into(r, retVal);
+        return retVal;
     }
-    
-    Disposable<Array> Fdm2dBlackScholesOp::apply_direction(
-                                       Size direction, const Array& x) const {
+
+    Disposable<Array>
+    Fdm2dBlackScholesOp::apply_direction(Size direction, const Array& r) const {
+        Array retVal(r.size());
+        apply_direction_into(direction, r, retVal);
+        return retVal;
+    }
+
+    Disposable<Array>
+    Fdm2dBlackScholesOp::solve_splitting(Size direction, const Array& r, Real a) const {
+        Array retVal(r.size());
+        solve_splitting_into(direction, r, a, retVal);
+        return retVal;
+    }
+
+    Disposable<Array> Fdm2dBlackScholesOp::preconditioner(const Array& r, Real dt) const {
+        Array retVal(r.size());
+        preconditioner_into(r, dt, retVal);
+        return retVal;
+    }
+
+    void Fdm2dBlackScholesOp::apply_into(const Array& x,
+                                         Array& result) const {
+        opX_.apply_into(x, result);
+        opY_.apply_into(x, tmp_);
+        result += tmp_;
+        apply_mixed_into(x, tmp_);
+        result += tmp_;
+    }
+
+    void Fdm2dBlackScholesOp::apply_mixed_into(const Array& x,
+                                               Array& result) const {
+        corrMapT_.apply_into(x, result);
+        for (Size i=0; i < result.size(); ++i)
+            result[i] += currentForwardRate_*x[i];
+    }
+
+    void Fdm2dBlackScholesOp::apply_direction_into(Size direction,
+                                                   const Array& x,
+                                                   Array& result) const {
         if (direction == 0) {
-            return opX_.apply(x);
+            opX_.apply_into(x, result);
         }
         else if (direction == 1) {
-            return opY_.apply(x);
+            opY_.apply_into(x, result);
         }
         else {
             QL_FAIL("direction is too large");
         }
     }
-    
-    Disposable<Array> Fdm2dBlackScholesOp::solve_splitting(Size direction,
-                                               const Array& x, Real s) const {
+
+    void Fdm2dBlackScholesOp::solve_splitting_into(Size direction,
+                                                   const Array& x,
+                                                   Real s,
+                                                   Array& result) const {
         if (direction == 0) {
-            return opX_.solve_splitting(direction, x, s);
+            opX_.solve_splitting_into(direction, x, s, result);
         }
         else if (direction == 1) {
-            return opY_.solve_splitting(direction, x, s);
+            opY_.solve_splitting_into(direction, x, s, result);
         }
         else
             QL_FAIL("direction is too large");
     }
-    
-    Disposable<Array> Fdm2dBlackScholesOp::preconditioner(const Array& r, 
-                                                          Real dt) const {
-        return solve_splitting(0, r, dt);
+
+    void Fdm2dBlackScholesOp::preconditioner_into(const Array& r,
+                                                  Real dt,
+                                                  Array& result) const {
+        solve_splitting_into(0, r, dt, result);
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
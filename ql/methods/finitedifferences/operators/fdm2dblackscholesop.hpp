@@ -53,6 +53,18 @@ namespace QuantLib {
 
         Disposable<Array> solve_splitting(Size direction, const Array& x, Real s) const override;
         Disposable<Array> preconditioner(const Array& r, Real s) const override;
+        void apply_into(const Array& r, Array& result) const override;
+        void apply_mixed_into(const Array& r, Array& result) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r,
+                                  Array& result) const override;
+        void solve_splitting_into(Size direction,
+                                  const Array& r,
+                                  Real s,
+                                  Array& result) const override;
+        void preconditioner_into(const Array& r,
+                                 Real s,
+                                 Array& result) const override;
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const override;
@@ -68,6 +80,7 @@ namespace QuantLib {
         NinePointLinearOp corrMapT_;
         const NinePointLinearOp corrMapTemplate_;
         const Real illegalLocalVolOverwrite_;
+        mutable Array tmp_;
     };
 }
 #endif
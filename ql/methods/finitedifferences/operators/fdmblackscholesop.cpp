@@ -25,6 +25,8 @@
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 namespace QuantLib {
@@ -42,37 +44,126 @@ namespace QuantLib {
       volTS_(bsProcess->blackVolatility().currentLink()),
       localVol_((localVol) ? bsProcess->localVolatility().currentLink() :
                              ext::shared_ptr<LocalVolTermStructure>()),
-      x_((localVol) ? Array(Exp(mesher->locations(direction))) : Array()),
       dxMap_(FirstDerivativeOp(direction, mesher)), dxxMap_(SecondDerivativeOp(direction, mesher)),
       mapT_(direction, mesher), strike_(strike),
+      strikeDirection_(Null<Size>()),
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite), direction_(direction),
-      quantoHelper_(std::move(quantoHelper)) {}
+      quantoHelper_(std::move(quantoHelper)) {
+        setupLocalVolNodes();
+    }
+
+    FdmBlackScholesOp::FdmBlackScholesOp(
+        const ext::shared_ptr<FdmMesher>& mesher,
+        const ext::shared_ptr<GeneralizedBlackScholesProcess>& bsProcess,
+        const std::vector<Real>& strikes,
+        Size strikeDirection,
+        bool localVol,
+        Real illegalLocalVolOverwrite,
+        Size direction,
+        ext::shared_ptr<FdmQuantoHelper> quantoHelper)
+    : mesher_(mesher), rTS_(bsProcess->riskFreeRate().currentLink()),
+      qTS_(bsProcess->dividendYield().currentLink()),
+      volTS_(bsProcess->blackVolatility().currentLink()),
+      localVol_((localVol) ? bsProcess->localVolatility().currentLink() :
+                             ext::shared_ptr<LocalVolTermStructure>()),
+      dxMap_(FirstDerivativeOp(direction, mesher)), dxxMap_(SecondDerivativeOp(direction, mesher)),
+      mapT_(direction, mesher), strike_(Null<Real>()),
+      strikes_(strikes), strikeDirection_(strikeDirection),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite), direction_(direction),
+      quantoHelper_(std::move(quantoHelper)) {
+        QL_REQUIRE(!strikes_.empty(), "no strikes given");
+        QL_REQUIRE(strikeDirection_ != direction_,
+                   "strike direction must differ from spot direction");
+        QL_REQUIRE(strikeDirection_ < mesher->layout()->dim().size()
+                   && strikes_.size()
+                       == mesher->layout()->dim()[strikeDirection_],
+                   "number of strikes (" << strikes_.size()
+                   << ") differs from the grid size in the strike direction");
+
+        setupLocalVolNodes();
+    }
+
+    void FdmBlackScholesOp::setupLocalVolNodes() {
+        if (localVol_ == nullptr)
+            return;
+
+        // the local volatility only depends on the spot, hence it is
+        // evaluated once per distinct grid location in direction_
+        const Array& locations = mesher_->locations(direction_);
+        std::vector<Real> nodes(locations.begin(), locations.end());
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+        x_ = Array(nodes.size());
+        for (Size i=0; i < nodes.size(); ++i)
+            x_[i] = std::exp(nodes[i]);
+
+        xIndex_.resize(locations.size());
+        for (Size i=0; i < locations.size(); ++i)
+            xIndex_[i] = std::lower_bound(nodes.begin(), nodes.end(),
+                                          locations[i]) - nodes.begin();
+    }
+
+    Disposable<Array> FdmBlackScholesOp::quantoKey(Time t1, Time t2) const {
+        // the quanto adjustment is affine in the equity volatility
+        Array key(2, 0.0);
+        if (quantoHelper_ != nullptr) {
+            key[0] = quantoHelper_->quantoAdjustment(0.0, t1, t2);
+            key[1] = quantoHelper_->quantoAdjustment(1.0, t1, t2) - key[0];
+        }
+        return key;
+    }
 
     void FdmBlackScholesOp::setTime(Time t1, Time t2) {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
+        const Array quanto = quantoKey(t1, t2);
 
-        if (localVol_ != nullptr) {
+        if (localVol_ != nullptr || !strikes_.empty()) {
             const ext::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
             const FdmLinearOpIterator endIter = layout->end();
 
-            Array v(layout->size());
-            for (FdmLinearOpIterator iter = layout->begin();
-                 iter!=endIter; ++iter) {
-                const Size i = iter.index();
+            // variances per distinct spot or per strike
+            Array nodeVar((localVol_ != nullptr) ? x_.size() : strikes_.size());
+            if (localVol_ != nullptr) {
+                const Time t = 0.5*(t1+t2);
+                for (Size i=0; i < x_.size(); ++i) {
+                    if (illegalLocalVolOverwrite_ < 0.0) {
+                        nodeVar[i] = square<Real>()(
+                            localVol_->localVol(t, x_[i], true));
+                    }
+                    else {
+                        try {
+                            nodeVar[i] = square<Real>()(
+                                localVol_->localVol(t, x_[i], true));
+                        } catch (Error&) {
+                            nodeVar[i] = square<Real>()(illegalLocalVolOverwrite_);
+                        }
 
-                if (illegalLocalVolOverwrite_ < 0.0) {
-                    v[i] = square<Real>()(
-                        localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                }
-                else {
-                    try {
-                        v[i] = square<Real>()(
-                            localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                    } catch (Error&) {
-                        v[i] = square<Real>()(illegalLocalVolOverwrite_);
                     }
+                }
+            } else {
+                for (Size k=0; k < strikes_.size(); ++k)
+                    nodeVar[k] = volTS_->blackForwardVariance(
+                        t1, t2, strikes_[k])/(t2-t1);
+            }
+
+            Array key(4 + nodeVar.size());
+            key[0] = r; key[1] = q;
+            std::copy(quanto.begin(), quanto.end(), key.begin()+2);
+            std::copy(nodeVar.begin(), nodeVar.end(), key.begin()+4);
+            if (!cache_.update(key))
+                return;
 
+            Array v(layout->size());
+            if (localVol_ != nullptr) {
+                for (Size i=0; i < v.size(); ++i)
+                    v[i] = nodeVar[xIndex_[i]];
+            } else {
+                for (FdmLinearOpIterator iter = layout->begin();
+                     iter!=endIter; ++iter) {
+                    v[iter.index()] =
+                        nodeVar[iter.coordinates()[strikeDirection_]];
                 }
             }
 
@@ -88,6 +179,12 @@ namespace QuantLib {
             const Real v
                 = volTS_->blackForwardVariance(t1, t2, strike_)/(t2-t1);
 
+            Array key(5);
+            key[0] = r; key[1] = q; key[2] = v;
+            std::copy(quanto.begin(), quanto.end(), key.begin()+3);
+            if (!cache_.update(key))
+                return;
+
             if (quantoHelper_ != nullptr) {
                 mapT_.axpyb(
                     Array(1, r - q - 0.5*v)
@@ -106,38 +203,80 @@ namespace QuantLib {
 
     Size FdmBlackScholesOp::size() const { return 1U; }
 
-    Disposable<Array> FdmBlackScholesOp::apply(const Array& u) const {
-        return mapT_.apply(u);
+    Disposable<Array> FdmBlackScholesOp::apply(const Array& r) const {
+        Array retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
     }
 
-    Disposable<Array> FdmBlackScholesOp::apply_direction(Size direction,
-                                                    const Array& r) const {
-        if (direction == direction_)
-            return mapT_.apply(r);
-        else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
-        }
+    Disposable<Array> FdmBlackScholesOp::apply_mixed(const Array& r) const {
+        Array retVal(r.size());
+        apply_mixed_into(r, retVal);
+        return retVal;
     }
 
-    Disposable<Array> FdmBlackScholesOp::apply_mixed(const Array& r) const {
-        Array retVal(r.size(), 0.0);
+    Disposable<Array>
+    FdmBlackScholesOp::apply_direction(Size direction, const Array& r) const {
+        Array retVal(r.size());
+        apply_direction_into(direction, r, retVal);
         return retVal;
     }
 
-    Disposable<Array> FdmBlackScholesOp::solve_splitting(Size direction,
-                                                const Array& r, Real dt) const {
-        if (direction == direction_)
-            return mapT_.solve_splitting(r, dt, 1.0);
+    Disposable<Array>
+    FdmBlackScholesOp::solve_splitting(Size direction, const Array& r, Real a) const {
+        Array retVal(r.size());
+        solve_splitting_into(direction, r, a, retVal);
+        return retVal;
+    }
+
+    Disposable<Array> FdmBlackScholesOp::preconditioner(const Array& r, Real dt) const {
+        Array retVal(r.size());
+        preconditioner_into(r, dt, retVal);
+        return retVal;
+    }
+
+    void FdmBlackScholesOp::apply_into(const Array& r, Array& result) const {
+        mapT_.apply_into(r, result);
+    }
+
+    void FdmBlackScholesOp::apply_mixed_into(const Array& r,
+                                             Array& result) const {
+        if (result.size() != r.size())
+            result = Array(r.size());
+        std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::apply_direction_into(Size direction,
+                                                 const Array& r,
+                                                 Array& result) const {
+        if (direction == direction_) {
+            mapT_.apply_into(r, result);
+        }
+        else {
+            if (result.size() != r.size())
+                result = Array(r.size());
+            std::fill(result.begin(), result.end(), 0.0);
+        }
+    }
+
+    void FdmBlackScholesOp::solve_splitting_into(Size direction,
+                                                 const Array& r,
+                                                 Real dt,
+                                                 Array& result) const {
+        if (direction == direction_) {
+            mapT_.solve_splitting_into(r, dt, 1.0, result, scratch_);
+        }
         else {
-            Array retVal(r);
-            return retVal;
+            if (result.size() != r.size())
+                result = Array(r.size());
+            std::copy(r.begin(), r.end(), result.begin());
         }
     }
 
-    Disposable<Array> FdmBlackScholesOp::preconditioner(const Array& r,
-                                                        Real dt) const {
-        return solve_splitting(direction_, r, dt);
+    void FdmBlackScholesOp::preconditioner_into(const Array& r,
+                                                Real dt,
+                                                Array& result) const {
+        solve_splitting_into(direction_, r, dt, result);
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
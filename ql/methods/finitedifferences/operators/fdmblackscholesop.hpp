@@ -29,6 +29,7 @@
 #include <ql/payoff.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmquantohelper.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmcoefficientcache.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
@@ -46,6 +47,21 @@ namespace QuantLib {
             Size direction = 0,
             ext::shared_ptr<FdmQuantoHelper> quantoHelper = ext::shared_ptr<FdmQuantoHelper>());
 
+        /*! operator for a strip of payoffs with the given strikes,
+            laid out along strikeDirection of the mesher.  Each strike
+            gets the forward variance of its own point on the smile;
+            the strike direction itself carries no dynamics.
+        */
+        FdmBlackScholesOp(
+            const ext::shared_ptr<FdmMesher>& mesher,
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            const std::vector<Real>& strikes,
+            Size strikeDirection,
+            bool localVol = false,
+            Real illegalLocalVolOverwrite = -Null<Real>(),
+            Size direction = 0,
+            ext::shared_ptr<FdmQuantoHelper> quantoHelper = ext::shared_ptr<FdmQuantoHelper>());
+
         Size size() const override;
         void setTime(Time t1, Time t2) override;
 
@@ -54,23 +70,46 @@ namespace QuantLib {
         Disposable<Array> apply_direction(Size direction, const Array& r) const override;
         Disposable<Array> solve_splitting(Size direction, const Array& r, Real s) const override;
         Disposable<Array> preconditioner(const Array& r, Real s) const override;
+        void apply_into(const Array& r, Array& result) const override;
+        void apply_mixed_into(const Array& r, Array& result) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r,
+                                  Array& result) const override;
+        void solve_splitting_into(Size direction,
+                                  const Array& r,
+                                  Real s,
+                                  Array& result) const override;
+        void preconditioner_into(const Array& r,
+                                 Real s,
+                                 Array& result) const override;
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const override;
 #endif
+        //! number of setTime() calls which reused the previous coefficients
+        Size reusedCoefficients() const { return cache_.hits(); }
+
       private:
+        void setupLocalVolNodes();
+        Disposable<Array> quantoKey(Time t1, Time t2) const;
+
         const ext::shared_ptr<FdmMesher> mesher_;
         const ext::shared_ptr<YieldTermStructure> rTS_, qTS_;
         const ext::shared_ptr<BlackVolTermStructure> volTS_;
         const ext::shared_ptr<LocalVolTermStructure> localVol_;
-        const Array x_;
+        Array x_;
+        std::vector<Size> xIndex_;
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
         TripleBandLinearOp mapT_;
         const Real strike_;
+        const std::vector<Real> strikes_;
+        const Size strikeDirection_;
         const Real illegalLocalVolOverwrite_;
         const Size direction_;
         const ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
+        FdmCoefficientCache cache_;
+        mutable Array scratch_;
     };
 }
 
@@ -27,6 +27,7 @@
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
+#include <algorithm>
 
 
 namespace QuantLib {
@@ -71,44 +72,86 @@ namespace QuantLib {
     }
 
     Disposable<Array> FdmG2Op::apply(const Array& r) const {
-        return mapX_.apply(r) + mapY_.apply(r) + apply_mixed(r);
+        Array retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
     }
 
     Disposable<Array> FdmG2Op::apply_mixed(const Array& r) const {
-        return corrMap_.apply(r);
+        Array retVal(r.size());
+        apply_mixed_into(r, retVal);
+        return retVal;
     }
 
     Disposable<Array>
     FdmG2Op::apply_direction(Size direction, const Array& r) const {
+        Array retVal(r.size());
+        apply_direction_into(direction, r, retVal);
+        return retVal;
+    }
+
+    Disposable<Array>
+    FdmG2Op::solve_splitting(Size direction, const Array& r, Real a) const {
+        Array retVal(r.size());
+        solve_splitting_into(direction, r, a, retVal);
+        return retVal;
+    }
+
+    Disposable<Array> FdmG2Op::preconditioner(const Array& r, Real dt) const {
+        Array retVal(r.size());
+        preconditioner_into(r, dt, retVal);
+        return retVal;
+    }
+
+    void FdmG2Op::apply_into(const Array& r, Array& result) const {
+        mapX_.apply_into(r, result);
+        mapY_.apply_into(r, tmp_);
+        result += tmp_;
+        apply_mixed_into(r, tmp_);
+        result += tmp_;
+    }
+
+    void FdmG2Op::apply_mixed_into(const Array& r, Array& result) const {
+        corrMap_.apply_into(r, result);
+    }
+
+    void FdmG2Op::apply_direction_into(Size direction,
+                                       const Array& r,
+                                       Array& result) const {
         if (direction == direction1_) {
-            return mapX_.apply(r);
+            mapX_.apply_into(r, result);
         }
         else if (direction == direction2_) {
-            return mapY_.apply(r);
+            mapY_.apply_into(r, result);
         }
         else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
+            if (result.size() != r.size())
+                result = Array(r.size());
+            std::fill(result.begin(), result.end(), 0.0);
         }
     }
 
-    Disposable<Array>
-    FdmG2Op::solve_splitting(Size direction, const Array& r, Real a) const {
+    void FdmG2Op::solve_splitting_into(Size direction,
+                                       const Array& r,
+                                       Real a,
+                                       Array& result) const {
         if (direction == direction1_) {
-            return mapX_.solve_splitting(r, a, 1.0);
+            mapX_.solve_splitting_into(r, a, 1.0, result, scratch_);
         }
         else if (direction == direction2_) {
-            return mapY_.solve_splitting(r, a, 1.0);
+            mapY_.solve_splitting_into(r, a, 1.0, result, scratch_);
         }
         else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
+            if (result.size() != r.size())
+                result = Array(r.size());
+            std::fill(result.begin(), result.end(), 0.0);
         }
     }
 
-    Disposable<Array>
-    FdmG2Op::preconditioner(const Array& r, Real dt) const {
-        return solve_splitting(direction1_, r, dt);
+    void FdmG2Op::preconditioner_into(const Array& r,
+                                      Real dt,
+                                      Array& result) const {
+        solve_splitting_into(direction1_, r, dt, result);
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -49,6 +49,18 @@ namespace QuantLib {
         Disposable<Array> apply_direction(Size direction, const Array& r) const override;
         Disposable<Array> solve_splitting(Size direction, const Array& r, Real s) const override;
         Disposable<Array> preconditioner(const Array& r, Real s) const override;
+        void apply_into(const Array& r, Array& result) const override;
+        void apply_mixed_into(const Array& r, Array& result) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r,
+                                  Array& result) const override;
+        void solve_splitting_into(Size direction,
+                                  const Array& r,
+                                  Real s,
+                                  Array& result) const override;
+        void preconditioner_into(const Array& r,
+                                 Real s,
+                                 Array& result) const override;
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const override;
@@ -62,6 +74,7 @@ namespace QuantLib {
         TripleBandLinearOp mapX_, mapY_;
 
         const ext::shared_ptr<G2> model_;
+        mutable Array tmp_, scratch_;
     };
 }
 
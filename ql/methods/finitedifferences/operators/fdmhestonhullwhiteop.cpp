@@ -25,6 +25,7 @@
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -62,6 +63,11 @@ namespace QuantLib {
 
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
+        Array key(2);
+        key[0] = phi; key[1] = q;
+        if (!cache_.update(key))
+            return;
+
         mapT_.axpyb(x_+phi-varianceValues_-q, dxMap_, dxxMap_, Array());
     }
 
@@ -102,48 +108,92 @@ namespace QuantLib {
         return 3;
     }
 
-    Disposable<Array> FdmHestonHullWhiteOp::apply(const Array& u) const {
-        return  dyMap_.apply(u) + dxMap_.getMap().apply(u)
-              + hullWhiteOp_.apply(u)
-              + hestonCorrMap_.apply(u) + equityIrCorrMap_.apply(u);
+    Disposable<Array> FdmHestonHullWhiteOp::apply(const Array& r) const {
+        Array retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
+    }
+
+    Disposable<Array> FdmHestonHullWhiteOp::apply_mixed(const Array& r) const {
+        Array retVal(r.size());
+        apply_mixed_into(r, retVal);
+        return retVal;
     }
 
     Disposable<Array>
-    FdmHestonHullWhiteOp::apply_direction(Size direction,
-                                          const Array& r) const {
+    FdmHestonHullWhiteOp::apply_direction(Size direction, const Array& r) const {
+        Array retVal(r.size());
+        apply_direction_into(direction, r, retVal);
+        return retVal;
+    }
+
+    Disposable<Array>
+    FdmHestonHullWhiteOp::solve_splitting(Size direction, const Array& r, Real a) const {
+        Array retVal(r.size());
+        solve_splitting_into(direction, r, a, retVal);
+        return retVal;
+    }
+
+    Disposable<Array> FdmHestonHullWhiteOp::preconditioner(const Array& r, Real dt) const {
+        Array retVal(r.size());
+        preconditioner_into(r, dt, retVal);
+        return retVal;
+    }
+
+    void FdmHestonHullWhiteOp::apply_into(const Array& u,
+                                          Array& result) const {
+        dyMap_.apply_into(u, result);
+        dxMap_.getMap().apply_into(u, tmp_);
+        result += tmp_;
+        hullWhiteOp_.apply_into(u, tmp_);
+        result += tmp_;
+        hestonCorrMap_.apply_into(u, tmp_);
+        result += tmp_;
+        equityIrCorrMap_.apply_into(u, tmp_);
+        result += tmp_;
+    }
+
+    void FdmHestonHullWhiteOp::apply_direction_into(Size direction,
+                                                    const Array& r,
+                                                    Array& result) const {
         if (direction == 0)
-            return dxMap_.getMap().apply(r);
+            dxMap_.getMap().apply_into(r, result);
         else if (direction == 1)
-            return dyMap_.apply(r);
+            dyMap_.apply_into(r, result);
         else if (direction == 2)
-            return hullWhiteOp_.apply(r);
+            hullWhiteOp_.apply_into(r, result);
         else
             QL_FAIL("direction too large");
     }
 
-    Disposable<Array> FdmHestonHullWhiteOp::apply_mixed(const Array& r) const {
-        return hestonCorrMap_.apply(r) + equityIrCorrMap_.apply(r);
+    void FdmHestonHullWhiteOp::apply_mixed_into(const Array& r,
+                                                Array& result) const {
+        hestonCorrMap_.apply_into(r, result);
+        equityIrCorrMap_.apply_into(r, tmp_);
+        result += tmp_;
     }
 
-    Disposable<Array>
-    FdmHestonHullWhiteOp::solve_splitting(Size direction, const Array& r,
-                                          Real a) const {
+    void FdmHestonHullWhiteOp::solve_splitting_into(Size direction,
+                                                    const Array& r,
+                                                    Real a,
+                                                    Array& result) const {
         if (direction == 0) {
-            return dxMap_.getMap().solve_splitting(r, a, 1.0);
+            dxMap_.getMap().solve_splitting_into(r, a, 1.0, result, scratch_);
         }
         else if (direction == 1) {
-            return dyMap_.solve_splitting(r, a, 1.0);
+            dyMap_.solve_splitting_into(r, a, 1.0, result, scratch_);
         }
         else if (direction == 2) {
-            return hullWhiteOp_.solve_splitting(2, r, a);
+            hullWhiteOp_.solve_splitting_into(2, r, a, result);
         }
         else
             QL_FAIL("direction too large");
     }
-    
-    Disposable<Array> FdmHestonHullWhiteOp::preconditioner(const Array& r, 
-                                                           Real dt) const {
-        return solve_splitting(0, r, dt);
+
+    void FdmHestonHullWhiteOp::preconditioner_into(const Array& r,
+                                                   Real dt,
+                                                   Array& result) const {
+        solve_splitting_into(0, r, dt, result);
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
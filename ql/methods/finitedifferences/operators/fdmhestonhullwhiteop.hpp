@@ -33,6 +33,7 @@
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/ninepointlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmcoefficientcache.hpp>
 
 namespace QuantLib {
 
@@ -57,6 +58,7 @@ namespace QuantLib {
         const ext::shared_ptr<HullWhite> hwModel_;
         const ext::shared_ptr<FdmMesher> mesher_;
         const ext::shared_ptr<YieldTermStructure> qTS_;
+        FdmCoefficientCache cache_;
     };
 
     class FdmHestonHullWhiteOp : public FdmLinearOpComposite {
@@ -76,6 +78,18 @@ namespace QuantLib {
         Disposable<Array> apply_direction(Size direction, const Array& r) const override;
         Disposable<Array> solve_splitting(Size direction, const Array& r, Real s) const override;
         Disposable<Array> preconditioner(const Array& r, Real s) const override;
+        void apply_into(const Array& r, Array& result) const override;
+        void apply_mixed_into(const Array& r, Array& result) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r,
+                                  Array& result) const override;
+        void solve_splitting_into(Size direction,
+                                  const Array& r,
+                                  Real s,
+                                  Array& result) const override;
+        void preconditioner_into(const Array& r,
+                                 Real s,
+                                 Array& result) const override;
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const override;
@@ -89,6 +103,7 @@ namespace QuantLib {
         TripleBandLinearOp dyMap_;
         FdmHestonHullWhiteEquityPart dxMap_;
         FdmHullWhiteOp hullWhiteOp_;
+        mutable Array tmp_, scratch_;
     };
 }
 
@@ -25,6 +25,7 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -58,7 +59,29 @@ namespace QuantLib {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
-        L_ = getLeverageFctSlice(t1, t2);
+        const Array nodes = getLeverageFctNodes(t1, t2);
+
+        Array key(4 + nodes.size(), 0.0);
+        key[0] = r; key[1] = q;
+        if (quantoHelper_ != nullptr) {
+            // the quanto adjustment is affine in the equity volatility
+            key[2] = quantoHelper_->quantoAdjustment(0.0, t1, t2);
+            key[3] = quantoHelper_->quantoAdjustment(1.0, t1, t2) - key[2];
+        }
+        std::copy(nodes.begin(), nodes.end(), key.begin()+4);
+        if (!cache_.update(key))
+            return;
+
+        const ext::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
+        if (L_.size() != layout->size())
+            L_ = Array(layout->size(), 1.0);
+        if (!nodes.empty()) {
+            const FdmLinearOpIterator endIter = layout->end();
+            for (FdmLinearOpIterator iter = layout->begin();
+                 iter!=endIter; ++iter) {
+                L_[iter.index()] = nodes[iter.coordinates()[0]];
+            }
+        }
         const Array Lsquare = L_*L_;
 
         if (quantoHelper_ != nullptr) {
@@ -72,6 +95,28 @@ namespace QuantLib {
         }
     }
 
+    Disposable<Array> FdmHestonEquityPart::getLeverageFctNodes(
+        Time t1, Time t2) const {
+        // leverage function per spot node of the grid
+        if (!leverageFct_) {
+            return Array();
+        }
+        const Real t = 0.5*(t1+t2);
+        const Time time = std::min(leverageFct_->maxTime(), t);
+
+        const ext::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
+        const Size nx = layout->dim()[0];
+        const Array& x = mesher_->locations(0);
+
+        Array v(nx);
+        for (Size i=0; i < nx; ++i) {
+            const Real spot = std::min(leverageFct_->maxStrike(),
+                std::max(leverageFct_->minStrike(), std::exp(x[i])));
+            v[i] = std::max(0.01, leverageFct_->localVol(time, spot, true));
+        }
+        return v;
+    }
+
     Disposable<Array> FdmHestonEquityPart::getLeverageFctSlice(Time t1, Time t2)
     const {
         const ext::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
@@ -80,23 +125,12 @@ namespace QuantLib {
         if (!leverageFct_) {
             return v;
         }
-        const Real t = 0.5*(t1+t2);
-        const Time time = std::min(leverageFct_->maxTime(), t);
 
+        const Array nodes = getLeverageFctNodes(t1, t2);
         const FdmLinearOpIterator endIter = layout->end();
         for (FdmLinearOpIterator iter = layout->begin();
              iter!=endIter; ++iter) {
-            const Size nx = iter.coordinates()[0];
-
-            if (iter.coordinates()[1] == 0) {
-                const Real x = std::exp(mesher_->location(iter, 0));
-                const Real spot = std::min(leverageFct_->maxStrike(),
-                                           std::max(leverageFct_->minStrike(), x));
-                v[nx] = std::max(0.01, leverageFct_->localVol(time, spot, true));
-            }
-            else {
-                v[iter.index()] = v[nx];
-            }
+            v[iter.index()] = nodes[iter.coordinates()[0]];
         }
         return v;
     }
@@ -118,6 +152,9 @@ namespace QuantLib {
 
     void FdmHestonVariancePart::setTime(Time t1, Time t2) {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
+        if (!cache_.update(Array(1, r)))
+            return;
+
         mapT_.axpyb(Array(), dyMap_, dyMap_, Array(1,-0.5*r));
     }
 
@@ -151,47 +188,92 @@ namespace QuantLib {
         dyMap_.setTime(t1, t2);
     }
 
+    Size FdmHestonOp::reusedCoefficients() const {
+        return std::min(dxMap_.reusedCoefficients(),
+                        dyMap_.reusedCoefficients());
+    }
+
     Size FdmHestonOp::size() const {
         return 2;
     }
 
-    Disposable<Array> FdmHestonOp::apply(const Array& u) const {
-        return dyMap_.getMap().apply(u) + dxMap_.getMap().apply(u)
-              + dxMap_.getL()*correlationMap_.apply(u);
+    Disposable<Array> FdmHestonOp::apply(const Array& r) const {
+        Array retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
+    }
+
+    Disposable<Array> FdmHestonOp::apply_mixed(const Array& r) const {
+        Array retVal(r.size());
+        apply_mixed_into(r, retVal);
+        return retVal;
+    }
+
+    Disposable<Array>
+    FdmHestonOp::apply_direction(Size direction, const Array& r) const {
+        Array retVal(r.size());
+        apply_direction_into(direction, r, retVal);
+        return retVal;
+    }
+
+    Disposable<Array>
+    FdmHestonOp::solve_splitting(Size direction, const Array& r, Real a) const {
+        Array retVal(r.size());
+        solve_splitting_into(direction, r, a, retVal);
+        return retVal;
+    }
+
+    Disposable<Array> FdmHestonOp::preconditioner(const Array& r, Real dt) const {
+        Array retVal(r.size());
+        preconditioner_into(r, dt, retVal);
+        return retVal;
+    }
+
+    void FdmHestonOp::apply_into(const Array& u, Array& result) const {
+        dyMap_.getMap().apply_into(u, result);
+        dxMap_.getMap().apply_into(u, tmp_);
+        result += tmp_;
+        correlationMap_.apply_into(u, tmp_);
+        const Array& l = dxMap_.getL();
+        for (Size i=0; i < result.size(); ++i)
+            result[i] += l[i]*tmp_[i];
     }
 
-    Disposable<Array> FdmHestonOp::apply_direction(Size direction,
-                                                   const Array& r) const {
+    void FdmHestonOp::apply_direction_into(Size direction,
+                                           const Array& r,
+                                           Array& result) const {
         if (direction == 0)
-            return dxMap_.getMap().apply(r);
+            dxMap_.getMap().apply_into(r, result);
         else if (direction == 1)
-            return dyMap_.getMap().apply(r);
+            dyMap_.getMap().apply_into(r, result);
         else
             QL_FAIL("direction too large");
     }
 
-    Disposable<Array> FdmHestonOp::apply_mixed(const Array& r) const {
-        return dxMap_.getL()*correlationMap_.apply(r);
+    void FdmHestonOp::apply_mixed_into(const Array& r, Array& result) const {
+        correlationMap_.apply_into(r, result);
+        result *= dxMap_.getL();
     }
 
-    Disposable<Array>
-        FdmHestonOp::solve_splitting(Size direction,
-                                     const Array& r, Real a) const {
-
+    void FdmHestonOp::solve_splitting_into(Size direction,
+                                           const Array& r,
+                                           Real a,
+                                           Array& result) const {
         if (direction == 0) {
-            return dxMap_.getMap().solve_splitting(r, a, 1.0);
+            dxMap_.getMap().solve_splitting_into(r, a, 1.0, result, scratch_);
         }
         else if (direction == 1) {
-            return dyMap_.getMap().solve_splitting(r, a, 1.0);
+            dyMap_.getMap().solve_splitting_into(r, a, 1.0, result, scratch_);
         }
         else
             QL_FAIL("direction too large");
     }
 
-    Disposable<Array>
-        FdmHestonOp::preconditioner(const Array& r, Real dt) const {
-
-        return solve_splitting(1, solve_splitting(0, r, dt), dt) ;
+    void FdmHestonOp::preconditioner_into(const Array& r,
+                                          Real dt,
+                                          Array& result) const {
+        solve_splitting_into(0, r, dt, tmp_);
+        solve_splitting_into(1, tmp_, dt, result);
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
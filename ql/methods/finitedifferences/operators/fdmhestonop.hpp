@@ -29,6 +29,7 @@
 
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmquantohelper.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmcoefficientcache.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/ninepointlinearop.hpp>
@@ -49,9 +50,11 @@ namespace QuantLib {
         void setTime(Time t1, Time t2);
         const TripleBandLinearOp& getMap() const;
         const Array& getL() const { return L_; }
+        Size reusedCoefficients() const { return cache_.hits(); }
 
       protected:
         Disposable<Array> getLeverageFctSlice(Time t1, Time t2) const;
+        Disposable<Array> getLeverageFctNodes(Time t1, Time t2) const;
 
         Array varianceValues_, volatilityValues_, L_;
         const FirstDerivativeOp  dxMap_;
@@ -62,6 +65,7 @@ namespace QuantLib {
         const ext::shared_ptr<YieldTermStructure> rTS_, qTS_;
         const ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
         const ext::shared_ptr<LocalVolTermStructure> leverageFct_;
+        FdmCoefficientCache cache_;
     };
 
     class FdmHestonVariancePart {
@@ -74,12 +78,14 @@ namespace QuantLib {
 
         void setTime(Time t1, Time t2);
         const TripleBandLinearOp& getMap() const;
+        Size reusedCoefficients() const { return cache_.hits(); }
 
       protected:
         const TripleBandLinearOp dyMap_;
         TripleBandLinearOp mapT_;
 
         const ext::shared_ptr<YieldTermStructure> rTS_;
+        FdmCoefficientCache cache_;
     };
 
 
@@ -102,14 +108,30 @@ namespace QuantLib {
         Disposable<Array> apply_direction(Size direction, const Array& r) const override;
         Disposable<Array> solve_splitting(Size direction, const Array& r, Real s) const override;
         Disposable<Array> preconditioner(const Array& r, Real s) const override;
+        void apply_into(const Array& r, Array& result) const override;
+        void apply_mixed_into(const Array& r, Array& result) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r,
+                                  Array& result) const override;
+        void solve_splitting_into(Size direction,
+                                  const Array& r,
+                                  Real s,
+                                  Array& result) const override;
+        void preconditioner_into(const Array& r,
+                                 Real s,
+                                 Array& result) const override;
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const override;
 #endif
+        //! number of setTime() calls which reused the previous coefficients
+        Size reusedCoefficients() const;
+
       private:
         NinePointLinearOp correlationMap_;
         FdmHestonVariancePart dyMap_;
         FdmHestonEquityPart dxMap_;
+        mutable Array tmp_, scratch_;
     };
 }
 
@@ -26,6 +26,7 @@
 #include <ql/methods/finitedifferences/operators/fdmhullwhiteop.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -52,44 +53,86 @@ namespace QuantLib {
 
         const Real phi = 0.5*(  dynamics->shortRate(t1, 0.0)
                               + dynamics->shortRate(t2, 0.0));
+        if (!cache_.update(Array(1, phi)))
+            return;
 
         mapT_.axpyb(Array(), dzMap_, dzMap_, -(x_+phi));
     }
 
     Disposable<Array> FdmHullWhiteOp::apply(const Array& r) const {
-        return mapT_.apply(r);
+        Array retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
     }
 
     Disposable<Array> FdmHullWhiteOp::apply_mixed(const Array& r) const {
-        Array retVal(r.size(), 0.0);
+        Array retVal(r.size());
+        apply_mixed_into(r, retVal);
         return retVal;
     }
 
     Disposable<Array>
     FdmHullWhiteOp::apply_direction(Size direction, const Array& r) const {
-        if (direction == direction_)
-            return mapT_.apply(r);
+        Array retVal(r.size());
+        apply_direction_into(direction, r, retVal);
+        return retVal;
+    }
+
+    Disposable<Array>
+    FdmHullWhiteOp::solve_splitting(Size direction, const Array& r, Real a) const {
+        Array retVal(r.size());
+        solve_splitting_into(direction, r, a, retVal);
+        return retVal;
+    }
+
+    Disposable<Array> FdmHullWhiteOp::preconditioner(const Array& r, Real dt) const {
+        Array retVal(r.size());
+        preconditioner_into(r, dt, retVal);
+        return retVal;
+    }
+
+    void FdmHullWhiteOp::apply_into(const Array& r, Array& result) const {
+        mapT_.apply_into(r, result);
+    }
+
+    void FdmHullWhiteOp::apply_mixed_into(const Array& r,
+                                          Array& result) const {
+        if (result.size() != r.size())
+            result = Array(r.size());
+        std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::apply_direction_into(Size direction,
+                                              const Array& r,
+                                              Array& result) const {
+        if (direction == direction_) {
+            mapT_.apply_into(r, result);
+        }
         else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
+            if (result.size() != r.size())
+                result = Array(r.size());
+            std::fill(result.begin(), result.end(), 0.0);
         }
     }
 
-    Disposable<Array> FdmHullWhiteOp::solve_splitting(
-        Size direction, const Array& r, Real a) const {
-
+    void FdmHullWhiteOp::solve_splitting_into(Size direction,
+                                              const Array& r,
+                                              Real a,
+                                              Array& result) const {
         if (direction == direction_) {
-            return mapT_.solve_splitting(r, a, 1.0);
+            mapT_.solve_splitting_into(r, a, 1.0, result, scratch_);
         }
         else {
-            Array retVal(r.size(), 0.0);
-            return retVal;
+            if (result.size() != r.size())
+                result = Array(r.size());
+            std::fill(result.begin(), result.end(), 0.0);
         }
     }
 
-    Disposable<Array>
-    FdmHullWhiteOp::preconditioner(const Array& r, Real dt) const {
-        return solve_splitting(direction_, r, dt);
+    void FdmHullWhiteOp::preconditioner_into(const Array& r,
+                                             Real dt,
+                                             Array& result) const {
+        solve_splitting_into(direction_, r, dt, result);
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -26,6 +26,7 @@
 
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmcoefficientcache.hpp>
 
 namespace QuantLib {
 
@@ -50,6 +51,18 @@ namespace QuantLib {
         Disposable<Array> apply_direction(Size direction, const Array& r) const override;
         Disposable<Array> solve_splitting(Size direction, const Array& r, Real s) const override;
         Disposable<Array> preconditioner(const Array& r, Real s) const override;
+        void apply_into(const Array& r, Array& result) const override;
+        void apply_mixed_into(const Array& r, Array& result) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r,
+                                  Array& result) const override;
+        void solve_splitting_into(Size direction,
+                                  const Array& r,
+                                  Real s,
+                                  Array& result) const override;
+        void preconditioner_into(const Array& r,
+                                 Real s,
+                                 Array& result) const override;
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const override;
@@ -60,6 +73,8 @@ namespace QuantLib {
         const TripleBandLinearOp dzMap_;
         TripleBandLinearOp mapT_;
         const ext::shared_ptr<HullWhite> model_;
+        FdmCoefficientCache cache_;
+        mutable Array scratch_;
     };
 }
 
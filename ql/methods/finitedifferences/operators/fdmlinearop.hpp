@@ -36,6 +36,15 @@ namespace QuantLib {
         typedef Array array_type;
         virtual ~FdmLinearOp() = default;
         virtual Disposable<array_type> apply(const array_type& r) const = 0;
+        //! applies the operator to r and stores the outcome in result
+        /*! result is resized if needed and can't be the same array
+            as r.  The default implementation calls apply(); derived
+            operators can override it to reuse the memory of result.
+        */
+        virtual void apply_into(const array_type& r,
+                                array_type& result) const {
+            result = apply(r);
+        }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<SparseMatrix> toMatrix() const = 0;
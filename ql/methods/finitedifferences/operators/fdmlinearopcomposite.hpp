@@ -51,6 +51,37 @@ namespace QuantLib {
         virtual Disposable<Array> 
             preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name In-place versions
+
+            These store their outcome into result, which is resized
+            if needed and can't be the same array as r.  The default
+            implementations call the methods above; derived operators
+            can override them to reuse the memory of result and of
+            their own scratch arrays, in which case they're not meant
+            to be called concurrently on the same instance.
+        */
+        //@{
+        virtual void apply_mixed_into(const Array& r, Array& result) const {
+            result = apply_mixed(r);
+        }
+        virtual void apply_direction_into(Size direction,
+                                          const Array& r,
+                                          Array& result) const {
+            result = apply_direction(direction, r);
+        }
+        virtual void solve_splitting_into(Size direction,
+                                          const Array& r,
+                                          Real s,
+                                          Array& result) const {
+            result = solve_splitting(direction, r, s);
+        }
+        virtual void preconditioner_into(const Array& r,
+                                         Real s,
+                                         Array& result) const {
+            result = preconditioner(r, s);
+        }
+        //@}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const {
             QL_FAIL(" ublas representation is not implemented");
@@ -22,6 +22,7 @@
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/ninepointlinearop.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmthreadpool.hpp>
 
 namespace QuantLib {
 
@@ -125,12 +126,20 @@ namespace QuantLib {
 
     Disposable<Array> NinePointLinearOp::apply(const Array& u)
         const {
+        Array retVal(u.size());
+        apply_into(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply_into(const Array& u, Array& retVal) const {
 
         const ext::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
         QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
                     << u.size() << " vs " << index->size());
+        QL_REQUIRE(&u != &retVal, "result must differ from r");
 
-        Array retVal(u.size());
+        if (retVal.size() != u.size())
+            retVal = Array(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -139,19 +148,21 @@ namespace QuantLib {
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
 
-        //#pragma omp parallel for
-        for (Size i=0; i < retVal.size(); ++i) {
-            retVal[i] =   a00[i]*u[i00[i]]
-                        + a01[i]*u[i01[i]]
-                        + a02[i]*u[i02[i]]
-                        + a10[i]*u[i10[i]]
-                        + a11[i]*u[i]
-                        + a12[i]*u[i12[i]]
-                        + a20[i]*u[i20[i]]
-                        + a21[i]*u[i21[i]]
-                        + a22[i]*u[i22[i]];
-        }
-        return retVal;
+        const Real* uptr = u.begin();
+        Real* rptr = retVal.begin();
+        fdmParallelFor(retVal.size(), [=](Size begin, Size end) {
+            for (Size i=begin; i < end; ++i) {
+                rptr[i] =   a00[i]*uptr[i00[i]]
+                          + a01[i]*uptr[i01[i]]
+                          + a02[i]*uptr[i02[i]]
+                          + a10[i]*uptr[i10[i]]
+                          + a11[i]*uptr[i]
+                          + a12[i]*uptr[i12[i]]
+                          + a20[i]*uptr[i20[i]]
+                          + a21[i]*uptr[i21[i]]
+                          + a22[i]*uptr[i22[i]];
+            }
+        }, 4096);
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
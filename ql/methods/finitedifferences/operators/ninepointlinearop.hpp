@@ -51,6 +51,7 @@ namespace QuantLib {
         #endif
 
         Disposable<Array> apply(const Array& r) const override;
+        void apply_into(const Array& r, Array& result) const override;
         Disposable<NinePointLinearOp> mult(const Array& u) const;
 
         void swap(NinePointLinearOp& m);
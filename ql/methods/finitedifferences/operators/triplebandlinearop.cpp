@@ -24,9 +24,64 @@
 #include <ql/methods/finitedifferences/tridiagonaloperator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmthreadpool.hpp>
+#include <algorithm>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace {
+
+        // maximum number of lines solved together
+        const Size maxBatchSize = 64;
+        // lines along the first direction interleaved together
+        const Size laneCount = 8;
+
+        /* Thomson algorithm for m tridiagonal systems of size n, the
+           j-th element of the l-th one being at j*stride + l.  The
+           systems are advanced together, so that the innermost loops
+           run over contiguous memory and can be vectorized.  Each
+           element of r is read before the same element of x is
+           written, so that they can share memory.
+        */
+        void solveInterleaved(Size n, Size m, Size stride, Real a, Real b,
+                              const Real* lower, const Real* diag,
+                              const Real* upper, const Real* r,
+                              Real* x, Real* tmp, Real* bet) {
+            Size zeros = 0;
+            for (Size l=0; l < m; ++l) {
+                bet[l] = 1.0/(a*diag[l]+b);
+                zeros += (bet[l] == 0.0);
+                x[l] = r[l]*bet[l];
+            }
+            QL_REQUIRE(zeros == 0, "division by zero");
+
+            for (Size j=1; j < n; ++j) {
+                const Size row = j*stride;
+                for (Size l=0; l < m; ++l) {
+                    const Size i = row + l, im1 = i - stride;
+                    tmp[i] = a*upper[im1]*bet[l];
+
+                    const Real beta = b+a*(diag[i]-tmp[i]*lower[i]);
+                    zeros += (beta == 0.0);
+                    bet[l] = 1.0/beta;
+
+                    x[i] = (r[i]-a*lower[i]*x[im1])*bet[l];
+                }
+            }
+            QL_ENSURE(zeros == 0, "division by zero");
+
+            for (Size j=n-1; j > 0; --j) {
+                const Size row = (j-1)*stride;
+                for (Size l=0; l < m; ++l) {
+                    const Size i = row + l;
+                    x[i] -= tmp[i+stride]*x[i+stride];
+                }
+            }
+        }
+
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const ext::shared_ptr<FdmMesher>& mesher)
@@ -241,9 +296,16 @@ namespace QuantLib {
     }
 
     Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
+        Array retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply_into(const Array& r, Array& result) const {
         const ext::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
 
         QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(&r != &result, "result must differ from r");
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
@@ -251,13 +313,16 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
-        array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < index->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
-        }
+        if (result.size() != r.size())
+            result = Array(r.size());
 
-        return retVal;
+        const Real* rptr = r.begin();
+        Real* xptr = result.begin();
+        fdmParallelFor(index->size(), [=](Size begin, Size end) {
+            for (Size i=begin; i < end; ++i)
+                xptr[i] =   rptr[i0ptr[i]]*lptr[i] + rptr[i]*dptr[i]
+                          + rptr[i2ptr[i]]*uptr[i];
+        }, 4096);
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -279,8 +344,19 @@ namespace QuantLib {
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+        Array retVal(r.size()), tmp(r.size());
+        solve_splitting_into(r, a, b, retVal, tmp);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting_into(const Array& r,
+                                                  Real a, Real b,
+                                                  Array& result,
+                                                  Array& scratch) const {
         const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
+        QL_REQUIRE(&scratch != &r && &scratch != &result,
+                   "workspace must differ from rhs and result");
 
 #ifdef QL_EXTRA_SAFETY_CHECKS
         for (FdmLinearOpIterator iter = layout->begin();
@@ -293,36 +369,95 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
+        if (result.size() != r.size())
+            result = Array(r.size());
+        if (scratch.size() != r.size())
+            scratch = Array(r.size());
+
+        // The tridiagonal systems along the lines of the given
+        // direction are independent, since lower and upper vanish at
+        // the boundaries, and are solved in batches.  The lines
+        // sharing all coordinates but the ones before direction_ are
+        // already interleaved in memory; lines along the first
+        // direction are contiguous instead, and are interleaved into
+        // a buffer first.
+        const Size n = layout->dim()[direction_];
+        const Size stride = layout->spacing()[direction_];
+        const Size nLines = layout->size()/n;
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
-
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
-
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
-
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
-
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+        const Real* rptr = r.begin();
+        Real* xptr = result.begin();
+        Real* tmp = scratch.begin();
+
+        if (stride > 1) {
+            const Size blockSize = std::min(stride, maxBatchSize);
+            const Size blocksPerSlab = (stride + blockSize - 1)/blockSize;
+            const Size nBlocks = blocksPerSlab*(nLines/stride);
+
+            fdmParallelFor(nBlocks, [=](Size begin, Size end) {
+                Real bet[maxBatchSize];
+                for (Size k=begin; k < end; ++k) {
+                    const Size slab = k / blocksPerSlab;
+                    const Size first = (k % blocksPerSlab)*blockSize;
+                    const Size base = slab*n*stride + first;
+                    solveInterleaved(n, std::min(blockSize, stride - first),
+                                     stride, a, b,
+                                     lptr+base, dptr+base, uptr+base,
+                                     rptr+base, xptr+base, tmp+base, bet);
+                }
+            }, std::max<Size>(1, 4096/(n*blockSize)));
+        }
+        else {
+            const Size nGroups = (nLines + laneCount - 1)/laneCount;
+
+            fdmParallelFor(nGroups, [=](Size begin, Size end) {
+                Real bet[maxBatchSize];
+                // interleaved lower, diag, upper, rhs/solution and
+                // workspace; allocated once per thread
+                thread_local std::vector<Real> buffer;
+                if (buffer.size() < 5*n*laneCount)
+                    buffer.resize(5*n*laneCount);
+                Real* pl = &buffer[0];
+                Real* pd = pl + n*laneCount;
+                Real* pu = pd + n*laneCount;
+                Real* px = pu + n*laneCount;
+                Real* pt = px + n*laneCount;
+
+                for (Size g=begin; g < end; ++g) {
+                    const Size first = g*laneCount;
+                    const Size m = std::min(laneCount, nLines - first);
+                    const Size base = first*n;
+                    if (m < laneCount) {
+                        for (Size l=0; l < m; ++l) {
+                            const Size i = base + l*n;
+                            solveInterleaved(n, 1, 1, a, b,
+                                             lptr+i, dptr+i, uptr+i,
+                                             rptr+i, xptr+i, tmp+i, bet);
+                        }
+                        continue;
+                    }
+
+                    for (Size l=0; l < laneCount; ++l) {
+                        const Size i = base + l*n;
+                        for (Size j=0; j < n; ++j) {
+                            pl[j*laneCount+l] = lptr[i+j];
+                            pd[j*laneCount+l] = dptr[i+j];
+                            pu[j*laneCount+l] = uptr[i+j];
+                            px[j*laneCount+l] = rptr[i+j];
+                        }
+                    }
+                    solveInterleaved(n, laneCount, laneCount, a, b,
+                                     pl, pd, pu, px, px, pt, bet);
+                    for (Size l=0; l < laneCount; ++l) {
+                        const Size i = base + l*n;
+                        for (Size j=0; j < n; ++j)
+                            xptr[i+j] = px[j*laneCount+l];
+                    }
+                }
+            }, std::max<Size>(1, 4096/(n*laneCount)));
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
-
-        return retVal;
     }
 }
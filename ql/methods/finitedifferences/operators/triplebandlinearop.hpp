@@ -51,8 +51,15 @@ namespace QuantLib {
         #endif
 
         Disposable<Array> apply(const Array& r) const override;
+        void apply_into(const Array& r, Array& result) const override;
         Disposable<Array> solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
+        /*! solves \f$ (aA + bI)x = r \f$ into result, which can be
+            the same array as r; scratch is used as workspace.  Both
+            arrays are resized if needed.
+        */
+        void solve_splitting_into(const Array& r, Real a, Real b,
+                                  Array& result, Array& scratch) const;
 
         Disposable<TripleBandLinearOp> mult(const Array& u) const;
         // interpret u as the diagonal of a diagonal matrix, multiplied on LHS
@@ -20,6 +20,7 @@
 */
 
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -37,27 +38,41 @@ namespace QuantLib {
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply_into(a, y_);
+        for (Size k=0; k < a.size(); ++k)
+            y_[k] = a[k] + dt_*y_[k];
+        bcSet_.applyAfterApplying(y_);
 
-        Array y0 = y;
+        if (y0_.size() != y_.size())
+            y0_ = Array(y_.size());
+        std::copy(y_.begin(), y_.end(), y0_.begin());
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction_into(i, a, rhs_);
+            for (Size k=0; k < rhs_.size(); ++k)
+                rhs_[k] = y_[k] - theta_*dt_*rhs_[k];
+            map_->solve_splitting_into(i, rhs_, -theta_*dt_, y_);
         }
 
+        if (diff_.size() != a.size())
+            diff_ = Array(a.size());
+        for (Size k=0; k < a.size(); ++k)
+            diff_[k] = y_[k] - a[k];
         bcSet_.applyBeforeApplying(*map_);
-        Array yt = y0 + mu_*dt_*map_->apply_mixed(y-a);
-        bcSet_.applyAfterApplying(yt);
+        map_->apply_mixed_into(diff_, yt_);
+        for (Size k=0; k < yt_.size(); ++k)
+            yt_[k] = y0_[k] + mu_*dt_*yt_[k];
+        bcSet_.applyAfterApplying(yt_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = yt - theta_*dt_*map_->apply_direction(i, a);
-            yt = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction_into(i, a, rhs_);
+            for (Size k=0; k < rhs_.size(); ++k)
+                rhs_[k] = yt_[k] - theta_*dt_*rhs_[k];
+            map_->solve_splitting_into(i, rhs_, -theta_*dt_, yt_);
         }
-        bcSet_.applyAfterSolving(yt);
+        bcSet_.applyAfterSolving(yt_);
 
-        a = yt;
+        a.swap(yt_);
     }
 
     void CraigSneydScheme::setStep(Time dt) {
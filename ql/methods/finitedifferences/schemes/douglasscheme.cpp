@@ -20,6 +20,7 @@
 */
 
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -34,16 +35,20 @@ namespace QuantLib {
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply_into(a, y_);
+        for (Size k=0; k < a.size(); ++k)
+            y_[k] = a[k] + dt_*y_[k];
+        bcSet_.applyAfterApplying(y_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction_into(i, a, rhs_);
+            for (Size k=0; k < rhs_.size(); ++k)
+                rhs_[k] = y_[k] - theta_*dt_*rhs_[k];
+            map_->solve_splitting_into(i, rhs_, -theta_*dt_, y_);
         }
-        bcSet_.applyAfterSolving(y);
+        bcSet_.applyAfterSolving(y_);
 
-        a = y;
+        a.swap(y_);
     }
 
     void DouglasScheme::setStep(Time dt) {
@@ -54,6 +54,8 @@ namespace QuantLib {
         const Real theta_;
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        // work arrays reused across steps
+        Array y_, rhs_;
     };
 }
 
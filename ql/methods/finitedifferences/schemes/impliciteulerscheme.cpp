@@ -21,12 +21,22 @@
 
 #include <ql/functional.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #include <utility>
 
 namespace QuantLib {
 
+    struct ImplicitEulerScheme::Ilu0Preconditioner {
+        #if !defined(QL_NO_UBLAS_SUPPORT)
+        CsrMatrix op, matrix;
+        CsrIlu0Preconditioner ilu;
+        #endif
+        // theta*dt of the current factorisation
+        Real step = Null<Real>();
+    };
+
     ImplicitEulerScheme::ImplicitEulerScheme(ext::shared_ptr<FdmLinearOpComposite> map,
                                              const bc_set& bcSet,
                                              Real relTol,
@@ -73,6 +83,31 @@ namespace QuantLib {
                 (*iterations_) += result.errors.size();
                 a = result.x;
             }
+            else if (solverType_ == BiCGstabILU0) {
+                #if !defined(QL_NO_UBLAS_SUPPORT)
+                if (!ilu_) {
+                    ilu_ = ext::make_shared<Ilu0Preconditioner>();
+                    ilu_->op.assign(map_->toMatrix());
+                }
+                if (ilu_->step != theta*dt_) {
+                    ilu_->matrix.assign(ilu_->op, -theta*dt_, 1.0);
+                    ilu_->ilu.factorize(ilu_->matrix);
+                    ilu_->step = theta*dt_;
+                }
+
+                const CsrIlu0Preconditioner& ilu = ilu_->ilu;
+                const BiCGStabResult result =
+                    QuantLib::BiCGstab(
+                        applyF, std::max(Size(10), a.size()), relTol_,
+                        [&](const Array& _a) { return ilu.apply(_a); })
+                    .solve(a, a);
+
+                (*iterations_) += result.iterations;
+                a = result.x;
+                #else
+                QL_FAIL("BiCGstabILU0 solver requires ublas support");
+                #endif
+            }
             else
                 QL_FAIL("unknown/illegal solver type");
         }
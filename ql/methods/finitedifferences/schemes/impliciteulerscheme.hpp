@@ -32,9 +32,21 @@
 
 namespace QuantLib {
 
+    //! Implicit-Euler scheme
+    /*! With BiCGstabILU0, BiCGstab is preconditioned by the ILU(0)
+        factorisation of 1 - theta*dt*L instead of the operator's own
+        preconditioner.  This pays off for operators with mixed
+        derivatives, for which the splitting preconditioner is a poor
+        approximation.  The operator L is assembled via
+        FdmLinearOpComposite::toMatrix() into a CsrMatrix at the first
+        step only, and the factorisation is only recalculated when
+        the step size changes; BiCGstab itself applies the operator
+        at the current time, so that time-dependent operators are
+        solved exactly and only the preconditioner is frozen.
+    */
     class ImplicitEulerScheme {
       public:
-        enum SolverType { BiCGstab, GMRES };
+        enum SolverType { BiCGstab, GMRES, BiCGstabILU0 };
 
         // typedefs
         typedef OperatorTraits<FdmLinearOp> traits;
@@ -66,6 +78,11 @@ namespace QuantLib {
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
         const SolverType solverType_;
+
+        // operator matrix and preconditioner for BiCGstabILU0,
+        // shared by the copies of the scheme
+        struct Ilu0Preconditioner;
+        ext::shared_ptr<Ilu0Preconditioner> ilu_;
     };
 }
 
@@ -61,6 +61,8 @@ namespace QuantLib {
         const Real mu_;
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        // work arrays reused across steps
+        Array y_, y0_, yt_, rhs_, diff_;
     };
 }
 
@@ -0,0 +1,125 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/solvers/fdm1dimmultipayoffsolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    Fdm1DimMultiPayoffSolver::Fdm1DimMultiPayoffSolver(
+        const FdmSolverDesc& solverDesc,
+        const FdmSchemeDesc& schemeDesc,
+        ext::shared_ptr<FdmLinearOpComposite> op)
+    : solverDesc_(solverDesc), schemeDesc_(schemeDesc), op_(std::move(op)),
+      thetaCondition_(ext::make_shared<FdmSnapshotCondition>(
+          0.99 * std::min(1.0 / 365.0,
+                          solverDesc.condition->stoppingTimes().empty() ?
+                              solverDesc.maturity :
+                              solverDesc.condition->stoppingTimes().front()))),
+      conditions_(FdmStepConditionComposite::joinConditions(thetaCondition_, solverDesc.condition)),
+      n_(solverDesc.mesher->layout()->dim().front()),
+      x_(n_), initialValues_(solverDesc.mesher->layout()->size()) {
+
+        const ext::shared_ptr<FdmMesher> mesher = solverDesc.mesher;
+        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+
+        QL_REQUIRE(layout->dim().size() == 2,
+                   "two-dimensional mesher required");
+
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            initialValues_[iter.index()]
+                 = solverDesc_.calculator->avgInnerValue(iter,
+                                                         solverDesc.maturity);
+            if (iter.coordinates()[1] == 0)
+                x_[iter.coordinates()[0]] = mesher->location(iter, 0);
+        }
+    }
+
+    Size Fdm1DimMultiPayoffSolver::size() const {
+        return solverDesc_.mesher->layout()->dim()[1];
+    }
+
+    void Fdm1DimMultiPayoffSolver::performCalculations() const {
+        Array rhs(initialValues_);
+
+        FdmBackwardSolver solver(op_, solverDesc_.bcSet, conditions_,
+                                 schemeDesc_);
+        solver.rollback(rhs, solverDesc_.maturity, 0.0,
+                        solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        steps_ = solver.numberOfSteps();
+        rejectedSteps_ = solver.rejectedSteps();
+
+        resultValues_.swap(rhs);
+
+        // the payoffs are contiguous columns of n_ values each
+        interpolations_.resize(size());
+        for (Size i=0; i < interpolations_.size(); ++i)
+            interpolations_[i] =
+                ext::make_shared<MonotonicCubicNaturalSpline>(
+                    x_.begin(), x_.end(), resultValues_.begin() + i*n_);
+    }
+
+    const CubicInterpolation&
+    Fdm1DimMultiPayoffSolver::interpolation(Size i) const {
+        calculate();
+        QL_REQUIRE(i < interpolations_.size(),
+                   "payoff index (" << i << ") out of range");
+        return *interpolations_[i];
+    }
+
+    Real Fdm1DimMultiPayoffSolver::interpolateAt(Size i, Real x) const {
+        return interpolation(i)(x);
+    }
+
+    Real Fdm1DimMultiPayoffSolver::thetaAt(Size i, Real x) const {
+        if (conditions_->stoppingTimes().front() == 0.0)
+            return Null<Real>();
+
+        const Real value = interpolateAt(i, x);
+
+        const Array& rhs = thetaCondition_->getValues();
+        Real temp = MonotonicCubicNaturalSpline(
+            x_.begin(), x_.end(), rhs.begin() + i*n_)(x);
+        return ( temp - value ) / thetaCondition_->getTime();
+    }
+
+    Real Fdm1DimMultiPayoffSolver::derivativeX(Size i, Real x) const {
+        return interpolation(i).derivative(x);
+    }
+
+    Real Fdm1DimMultiPayoffSolver::derivativeXX(Size i, Real x) const {
+        return interpolation(i).secondDerivative(x);
+    }
+
+    Size Fdm1DimMultiPayoffSolver::numberOfSteps() const {
+        calculate();
+        return steps_;
+    }
+
+    Size Fdm1DimMultiPayoffSolver::rejectedSteps() const {
+        calculate();
+        return rejectedSteps_;
+    }
+}
@@ -0,0 +1,86 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdm1dimmultipayoffsolver.hpp
+    \brief one-factor solver for a strip of payoffs rolled back together
+*/
+
+#ifndef quantlib_fdm_1_dim_multi_payoff_solver_hpp
+#define quantlib_fdm_1_dim_multi_payoff_solver_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class CubicInterpolation;
+    class FdmSnapshotCondition;
+
+    //! one-factor solver for a strip of payoffs
+    /*! The mesher of the solver description has two directions: the
+        state variable in direction 0 and the index of the payoff in
+        direction 1, which carries no dynamics.  All payoffs are
+        rolled back in a single pass, so that the line solves of the
+        operator are batched across them.
+    */
+    class Fdm1DimMultiPayoffSolver : public LazyObject {
+      public:
+        Fdm1DimMultiPayoffSolver(const FdmSolverDesc& solverDesc,
+                                 const FdmSchemeDesc& schemeDesc,
+                                 ext::shared_ptr<FdmLinearOpComposite> op);
+
+        //! number of payoffs
+        Size size() const;
+
+        Real interpolateAt(Size i, Real x) const;
+        Real thetaAt(Size i, Real x) const;
+
+        Real derivativeX(Size i, Real x) const;
+        Real derivativeXX(Size i, Real x) const;
+
+        //! number of time steps accepted during the rollback
+        Size numberOfSteps() const;
+        //! number of adaptive time steps rejected during the rollback
+        Size rejectedSteps() const;
+
+      protected:
+        void performCalculations() const override;
+
+      private:
+        const CubicInterpolation& interpolation(Size i) const;
+
+        const FdmSolverDesc solverDesc_;
+        const FdmSchemeDesc schemeDesc_;
+        const ext::shared_ptr<FdmLinearOpComposite> op_;
+
+        const ext::shared_ptr<FdmSnapshotCondition> thetaCondition_;
+        const ext::shared_ptr<FdmStepConditionComposite> conditions_;
+
+        const Size n_;
+        std::vector<Real> x_;
+        Array initialValues_;
+        mutable Array resultValues_;
+        mutable std::vector<ext::shared_ptr<CubicInterpolation> >
+            interpolations_;
+        mutable Size steps_ = 0, rejectedSteps_ = 0;
+    };
+}
+
+#endif
@@ -60,9 +60,12 @@ namespace QuantLib {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-            .rollback(rhs, solverDesc_.maturity, 0.0,
-                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        FdmBackwardSolver solver(op_, solverDesc_.bcSet, conditions_,
+                                 schemeDesc_);
+        solver.rollback(rhs, solverDesc_.maturity, 0.0,
+                        solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        steps_ = solver.numberOfSteps();
+        rejectedSteps_ = solver.rejectedSteps();
 
         std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
         interpolation_ = ext::make_shared<MonotonicCubicNaturalSpline>(x_.begin(), x_.end(),
@@ -99,4 +102,14 @@ namespace QuantLib {
         calculate();
         return interpolation_->secondDerivative(x);
     }
+
+    Size Fdm1DimSolver::numberOfSteps() const {
+        calculate();
+        return steps_;
+    }
+
+    Size Fdm1DimSolver::rejectedSteps() const {
+        calculate();
+        return rejectedSteps_;
+    }
 }
@@ -47,6 +47,11 @@ namespace QuantLib {
         Real derivativeX(Real x) const;
         Real derivativeXX(Real x) const;
 
+        //! number of time steps accepted during the rollback
+        Size numberOfSteps() const;
+        //! number of adaptive time steps rejected during the rollback
+        Size rejectedSteps() const;
+
       protected:
         void performCalculations() const override;
 
@@ -61,6 +66,7 @@ namespace QuantLib {
         std::vector<Real> x_, initialValues_;
         mutable Array resultValues_;
         mutable ext::shared_ptr<CubicInterpolation> interpolation_;
+        mutable Size steps_ = 0, rejectedSteps_ = 0;
     };
 }
 
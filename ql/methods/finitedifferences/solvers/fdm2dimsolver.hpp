@@ -50,6 +50,11 @@ namespace QuantLib {
         Real derivativeYY(Real x, Real y) const;
         Real derivativeXY(Real x, Real y) const;
 
+        //! number of time steps accepted during the rollback
+        Size numberOfSteps() const;
+        //! number of adaptive time steps rejected during the rollback
+        Size rejectedSteps() const;
+
       protected:
         void performCalculations() const override;
 
@@ -64,6 +69,7 @@ namespace QuantLib {
         std::vector<Real> x_, y_, initialValues_;
         mutable Matrix resultValues_;
         mutable ext::shared_ptr<BicubicSpline> interpolation_;
+        mutable Size steps_ = 0, rejectedSteps_ = 0;
     };
 }
 
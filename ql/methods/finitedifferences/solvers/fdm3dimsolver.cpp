@@ -77,9 +77,12 @@ namespace QuantLib {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-             .rollback(rhs, solverDesc_.maturity, 0.0,
-                       solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        FdmBackwardSolver solver(op_, solverDesc_.bcSet, conditions_,
+                                 schemeDesc_);
+        solver.rollback(rhs, solverDesc_.maturity, 0.0,
+                        solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        steps_ = solver.numberOfSteps();
+        rejectedSteps_ = solver.rejectedSteps();
 
         for (Size i=0; i < z_.size(); ++i) {
             std::copy(rhs.begin()+i    *y_.size()*x_.size(),
@@ -127,4 +130,14 @@ namespace QuantLib {
                                             zArray.begin())(z)
                 - interpolateAt(x, y, z)) / thetaCondition_->getTime();
     }
+
+    Size Fdm3DimSolver::numberOfSteps() const {
+        calculate();
+        return steps_;
+    }
+
+    Size Fdm3DimSolver::rejectedSteps() const {
+        calculate();
+        return rejectedSteps_;
+    }
 }
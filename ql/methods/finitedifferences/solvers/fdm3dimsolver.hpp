@@ -45,6 +45,11 @@ namespace QuantLib {
         Real interpolateAt(Real x, Real y, Rate z) const;
         Real thetaAt(Real x, Real y, Rate z) const;
 
+        //! number of time steps accepted during the rollback
+        Size numberOfSteps() const;
+        //! number of adaptive time steps rejected during the rollback
+        Size rejectedSteps() const;
+
       private:
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
@@ -56,6 +61,7 @@ namespace QuantLib {
         std::vector<Real> x_, y_, z_, initialValues_;
         mutable std::vector<Matrix> resultValues_;
         mutable std::vector<ext::shared_ptr<BicubicSpline> > interpolation_;
+        mutable Size steps_ = 0, rejectedSteps_ = 0;
     };
 }
 
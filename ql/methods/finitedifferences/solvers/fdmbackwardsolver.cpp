@@ -22,6 +22,7 @@
 /*! \file fdmbackwardsolver.cpp
 */
 
+#include <ql/math/comparison.hpp>
 #include <ql/mathconstants.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
@@ -35,13 +36,36 @@
 #include <ql/methods/finitedifferences/schemes/trbdf2scheme.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmthreadpool.hpp>
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 
 namespace QuantLib {
     
-    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
-    : type(aType), theta(aTheta), mu(aMu) { }
+    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu,
+                                 Size aThreads, Real aErrorTolerance,
+                                 ImplicitEulerScheme::SolverType aSolverType)
+    : type(aType), theta(aTheta), mu(aMu), threads(aThreads),
+      errorTolerance(aErrorTolerance), solverType(aSolverType) {
+        QL_REQUIRE(threads > 0, "at least one thread required");
+        QL_REQUIRE(errorTolerance == Null<Real>() || errorTolerance > 0.0,
+                   "positive error tolerance required");
+    }
+
+    FdmSchemeDesc FdmSchemeDesc::withThreads(Size n) const {
+        return {type, theta, mu, n, errorTolerance, solverType};
+    }
+
+    FdmSchemeDesc FdmSchemeDesc::withAdaptiveSteps(Real tol) const {
+        return {type, theta, mu, threads, tol, solverType};
+    }
+
+    FdmSchemeDesc FdmSchemeDesc::withSolverType(
+                          ImplicitEulerScheme::SolverType solver) const {
+        return {type, theta, mu, threads, errorTolerance, solver};
+    }
 
     FdmSchemeDesc FdmSchemeDesc::Douglas() { return {FdmSchemeDesc::DouglasType, 0.5, 0.0}; }
 
@@ -87,22 +111,163 @@ namespace QuantLib {
                      condition :
                      ext::make_shared<FdmStepConditionComposite>(
                          std::list<std::vector<Time> >(), FdmStepConditionComposite::Conditions())),
-      schemeDesc_(schemeDesc) {}
+      schemeDesc_(schemeDesc), steps_(0), rejected_(0), dt_(0.0), minStep_(0.0) {}
+
+    namespace {
+        // order of consistency of the scheme in time
+        Size schemeOrder(const FdmSchemeDesc& desc) {
+            switch (desc.type) {
+              case FdmSchemeDesc::ImplicitEulerType:
+              case FdmSchemeDesc::ExplicitEulerType:
+                return 1;
+              case FdmSchemeDesc::DouglasType:
+              case FdmSchemeDesc::CrankNicolsonType:
+                return (close_enough(desc.theta, 0.5)) ? 2 : 1;
+              default:
+                return 2;
+            }
+        }
+    }
+
+    template <class Scheme>
+    void FdmBackwardSolver::rollbackImpl(Scheme& scheme, array_type& rhs,
+                                         Time from, Time to, Size steps) {
+
+        if (schemeDesc_.errorTolerance == Null<Real>()) {
+            FiniteDifferenceModel<Scheme>
+                model(scheme, condition_->stoppingTimes());
+            model.rollback(rhs, from, to, steps, *condition_);
+            steps_ += steps;
+        }
+        else {
+            rollbackAdaptively(scheme, schemeOrder(schemeDesc_),
+                               rhs, from, to, Null<Size>());
+        }
+    }
+
+    template <class Scheme>
+    Time FdmBackwardSolver::rollbackAdaptively(Scheme& scheme, Size order,
+                                               array_type& rhs,
+                                               Time from, Time to,
+                                               Size maxSteps) {
+        std::vector<Time> stoppingTimes = condition_->stoppingTimes();
+        std::sort(stoppingTimes.begin(), stoppingTimes.end());
+
+        const Real tol = schemeDesc_.errorTolerance;
+        // the difference between one step and two half steps
+        // overestimates the error of the latter by 2^order-1
+        const Real errorScale = 1.0/((1 << order) - 1);
+        const Real exponent = -1.0/(order + 1);
+
+        Time t = from;
+        Size accepted = 0;
+        array_type full, half;
+
+        while (t > to && accepted < maxSteps) {
+            // next stopping time or the end of the rollback
+            Time target = to;
+            for (auto iter = stoppingTimes.rbegin();
+                 iter != stoppingTimes.rend(); ++iter) {
+                if (*iter < t) {
+                    target = std::max(*iter, to);
+                    break;
+                }
+            }
+
+            Time h = dt_;
+            bool hit = false;
+            if (t - h < target + 0.01*h) {
+                h = t - target;
+                hit = true;
+            }
+            const Time next = hit ? target : t - h;
+
+            full = rhs;
+            scheme.setStep(h);
+            scheme.step(full, t);
+            condition_->applyTo(full, next);
+
+            half = rhs;
+            scheme.setStep(0.5*h);
+            scheme.step(half, t);
+            condition_->applyTo(half, t - 0.5*h);
+            scheme.step(half, t - 0.5*h);
+            condition_->applyTo(half, next);
+
+            Real error = 0.0;
+            for (Size i=0; i < half.size(); ++i)
+                error = std::max(error, std::fabs(half[i] - full[i])
+                                        / (1.0 + std::fabs(half[i])));
+            error *= errorScale/tol;
+
+            const Real factor = (error > 0.0)
+                ? std::min(5.0, std::max(0.2, 0.9*std::pow(error, exponent)))
+                : 5.0;
+
+            if (error <= 1.0 || h <= minStep_) {
+                rhs.swap(half);
+                t = next;
+                ++steps_;
+                ++accepted;
+                // a shortened step to a stopping time doesn't limit
+                // the size of the next one
+                dt_ = hit ? std::max(dt_, factor*h) : factor*h;
+            }
+            else {
+                ++rejected_;
+                dt_ = std::max(factor*h, minStep_);
+            }
+        }
+
+        return t;
+    }
 
     void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs, 
                                      Time from, Time to,
                                      Size steps, Size dampingSteps) {
 
+        // the operators split their sweeps across the current pool
+        const FdmThreadPool::Scope scope(
+            schemeDesc_.threads > 1 ? &FdmThreadPool::shared(schemeDesc_.threads)
+                                    : nullptr);
+
+        steps_ = rejected_ = 0;
+
         const Time deltaT = from - to;
         const Size allSteps = steps + dampingSteps;
-        const Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
+        Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
+
+        if (schemeDesc_.errorTolerance != Null<Real>()) {
+            QL_REQUIRE(from >= to,
+                       "trying to roll back from " << from << " to " << to);
+            QL_REQUIRE(allSteps > 0, "at least one time step required");
+
+            dt_ = deltaT/allSteps;
+            minStep_ = 1e-8*deltaT;
+
+            const std::vector<Time>& stoppingTimes
+                = condition_->stoppingTimes();
+            if (std::find(stoppingTimes.begin(), stoppingTimes.end(), from)
+                    != stoppingTimes.end())
+                condition_->applyTo(rhs, from);
+        }
 
         if ((dampingSteps != 0U) && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
-            ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
-            FiniteDifferenceModel<ImplicitEulerScheme> 
+            ImplicitEulerScheme implicitEvolver(map_, bcSet_, 1e-8,
+                                                schemeDesc_.solverType);
+            if (schemeDesc_.errorTolerance == Null<Real>()) {
+                FiniteDifferenceModel<ImplicitEulerScheme>
                     dampingModel(implicitEvolver, condition_->stoppingTimes());
-            dampingModel.rollback(rhs, from, dampingTo, 
-                                  dampingSteps, *condition_);
+                dampingModel.rollback(rhs, from, dampingTo,
+                                      dampingSteps, *condition_);
+                steps_ += dampingSteps;
+            }
+            else {
+                // the damping steps are error-controlled as well, so
+                // that they end wherever their accepted sizes lead
+                dampingTo = rollbackAdaptively(implicitEvolver, 1, rhs,
+                                               from, to, dampingSteps);
+            }
         }
 
         switch (schemeDesc_.type) {
@@ -110,35 +275,27 @@ namespace QuantLib {
             {
                 HundsdorferScheme hsEvolver(schemeDesc_.theta, schemeDesc_.mu, 
                                             map_, bcSet_);
-                FiniteDifferenceModel<HundsdorferScheme> 
-                               hsModel(hsEvolver, condition_->stoppingTimes());
-                hsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                rollbackImpl(hsEvolver, rhs, dampingTo, to, steps);
             }
             break;
           case FdmSchemeDesc::DouglasType:
             {
                 DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_);
-                FiniteDifferenceModel<DouglasScheme> 
-                               dsModel(dsEvolver, condition_->stoppingTimes());
-                dsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                rollbackImpl(dsEvolver, rhs, dampingTo, to, steps);
             }
             break;
           case FdmSchemeDesc::CrankNicolsonType:
             {
-              CrankNicolsonScheme cnEvolver(schemeDesc_.theta, map_, bcSet_);
-              FiniteDifferenceModel<CrankNicolsonScheme>
-                             cnModel(cnEvolver, condition_->stoppingTimes());
-              cnModel.rollback(rhs, dampingTo, to, steps, *condition_);
-
+              CrankNicolsonScheme cnEvolver(schemeDesc_.theta, map_, bcSet_,
+                                            1e-8, schemeDesc_.solverType);
+              rollbackImpl(cnEvolver, rhs, dampingTo, to, steps);
             }
             break;
           case FdmSchemeDesc::CraigSneydType:
             {
                 CraigSneydScheme csEvolver(schemeDesc_.theta, schemeDesc_.mu, 
                                            map_, bcSet_);
-                FiniteDifferenceModel<CraigSneydScheme> 
-                               csModel(csEvolver, condition_->stoppingTimes());
-                csModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                rollbackImpl(csEvolver, rhs, dampingTo, to, steps);
             }
             break;
           case FdmSchemeDesc::ModifiedCraigSneydType:
@@ -146,34 +303,27 @@ namespace QuantLib {
                 ModifiedCraigSneydScheme csEvolver(schemeDesc_.theta, 
                                                    schemeDesc_.mu,
                                                    map_, bcSet_);
-                FiniteDifferenceModel<ModifiedCraigSneydScheme> 
-                              mcsModel(csEvolver, condition_->stoppingTimes());
-                mcsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                rollbackImpl(csEvolver, rhs, dampingTo, to, steps);
             }
             break;
           case FdmSchemeDesc::ImplicitEulerType:
             {
-                ImplicitEulerScheme implicitEvolver(map_, bcSet_);
-                FiniteDifferenceModel<ImplicitEulerScheme> 
-                   implicitModel(implicitEvolver, condition_->stoppingTimes());
-                implicitModel.rollback(rhs, from, to, allSteps, *condition_);
+                ImplicitEulerScheme implicitEvolver(map_, bcSet_, 1e-8,
+                                                    schemeDesc_.solverType);
+                rollbackImpl(implicitEvolver, rhs, from, to, allSteps);
             }
             break;
           case FdmSchemeDesc::ExplicitEulerType:
             {
                 ExplicitEulerScheme explicitEvolver(map_, bcSet_);
-                FiniteDifferenceModel<ExplicitEulerScheme> 
-                   explicitModel(explicitEvolver, condition_->stoppingTimes());
-                explicitModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                rollbackImpl(explicitEvolver, rhs, dampingTo, to, steps);
             }
             break;
           case FdmSchemeDesc::MethodOfLinesType:
             {
                 MethodOfLinesScheme methodOfLines(
                     schemeDesc_.theta, schemeDesc_.mu, map_, bcSet_);
-                FiniteDifferenceModel<MethodOfLinesScheme>
-                   molModel(methodOfLines, condition_->stoppingTimes());
-                molModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                rollbackImpl(methodOfLines, rhs, dampingTo, to, steps);
             }
             break;
           case FdmSchemeDesc::TrBDF2Type:
@@ -188,9 +338,7 @@ namespace QuantLib {
                 TrBDF2Scheme<CraigSneydScheme> trBDF2(
                     schemeDesc_.theta, map_, hsEvolver, bcSet_,schemeDesc_.mu);
 
-                FiniteDifferenceModel<TrBDF2Scheme<CraigSneydScheme> >
-                   trBDF2Model(trBDF2, condition_->stoppingTimes());
-                trBDF2Model.rollback(rhs, dampingTo, to, steps, *condition_);
+                rollbackImpl(trBDF2, rhs, dampingTo, to, steps);
             }
             break;
           default:
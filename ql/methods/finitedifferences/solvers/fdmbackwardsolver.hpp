@@ -25,7 +25,9 @@
 #ifndef quantlib_fdm_backward_solver_hpp
 #define quantlib_fdm_backward_solver_hpp
 
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmboundaryconditionset.hpp>
+#include <ql/utilities/null.hpp>
 
 namespace QuantLib {
 
@@ -39,10 +41,34 @@ namespace QuantLib {
                              MethodOfLinesType, TrBDF2Type,
                              CrankNicolsonType };
 
-        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
+        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu,
+                      Size threads = 1,
+                      Real errorTolerance = Null<Real>(),
+                      ImplicitEulerScheme::SolverType solverType
+                          = ImplicitEulerScheme::BiCGstab);
 
         const FdmSchemeType type;
         const Real theta, mu;
+        /*! number of threads used for the line solves and the stencil
+            applications of the operators; see FdmThreadPool.
+        */
+        const Size threads;
+        /*! local error tolerance of the adaptive time stepping, or
+            Null<Real>() for a fixed number of uniform steps.
+        */
+        const Real errorTolerance;
+        /*! linear solver of the implicit steps of the implicit-Euler
+            and Crank-Nicolson schemes, including the damping steps.
+        */
+        const ImplicitEulerScheme::SolverType solverType;
+
+        //! same scheme, using the given number of threads
+        FdmSchemeDesc withThreads(Size threads) const;
+        //! same scheme, with adaptive time steps; see FdmBackwardSolver
+        FdmSchemeDesc withAdaptiveSteps(Real errorTolerance) const;
+        //! same scheme, using the given solver for implicit steps
+        FdmSchemeDesc withSolverType(
+            ImplicitEulerScheme::SolverType solverType) const;
 
         // some default scheme descriptions
         static FdmSchemeDesc Douglas(); //same as Crank-Nicolson in 1 dimension
@@ -58,6 +84,21 @@ namespace QuantLib {
         static FdmSchemeDesc TrBDF2();
     };
         
+    //! rolls back the solution of a finite-difference problem
+    /*! If the scheme description sets an error tolerance, the time
+        steps are chosen adaptively by step doubling: each step is
+        also performed as two half steps and the difference of the
+        two results, scaled by the order of the scheme, estimates the
+        local error.  A step is accepted if this estimate is below
+        the tolerance relative to 1+|u| in every grid point; the next
+        step size is then adjusted to the estimate.  The initial step
+        size is given by the number of steps passed to rollback(),
+        and every stopping time of the step conditions is hit exactly.
+        The damping steps are controlled in the same way, using the
+        first-order error estimate of implicit Euler; the damping
+        phase ends after the given number of accepted steps, so that
+        its length follows from the tolerance.
+    */
     class FdmBackwardSolver {
       public:
         typedef FdmLinearOp::array_type array_type;
@@ -71,11 +112,27 @@ namespace QuantLib {
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
+        //! number of time steps accepted during the last rollback
+        Size numberOfSteps() const { return steps_; }
+        //! number of adaptive time steps rejected during the last rollback
+        Size rejectedSteps() const { return rejected_; }
+
       protected:
+        template <class Scheme>
+        void rollbackImpl(Scheme& scheme, array_type& rhs,
+                          Time from, Time to, Size steps);
+        template <class Scheme>
+        Time rollbackAdaptively(Scheme& scheme, Size order, array_type& rhs,
+                                Time from, Time to, Size maxSteps);
+
+
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
         const ext::shared_ptr<FdmStepConditionComposite> condition_;
         const FdmSchemeDesc schemeDesc_;
+        Size steps_, rejected_;
+        // step size and minimum step size of the adaptive rollback
+        Time dt_, minStep_;
     };
 }
 
@@ -73,4 +73,14 @@ namespace QuantLib {
         return solver_->thetaAt(std::log(s), v);
     }
 
+    Size FdmBatesSolver::numberOfSteps() const {
+        calculate();
+        return solver_->numberOfSteps();
+    }
+
+    Size FdmBatesSolver::rejectedSteps() const {
+        calculate();
+        return solver_->rejectedSteps();
+    }
+
 }
@@ -53,6 +53,11 @@ namespace QuantLib {
         Real deltaAt(Real s, Real v) const;
         Real gammaAt(Real s, Real v) const;
 
+        //! number of time steps accepted during the rollback
+        Size numberOfSteps() const;
+        //! number of adaptive time steps rejected during the rollback
+        Size rejectedSteps() const;
+
       protected:
         void performCalculations() const override;
 
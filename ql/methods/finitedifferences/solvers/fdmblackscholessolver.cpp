@@ -73,4 +73,14 @@ namespace QuantLib {
     Real FdmBlackScholesSolver::thetaAt(Real s) const {
         return solver_->thetaAt(std::log(s));
     }
+
+    Size FdmBlackScholesSolver::numberOfSteps() const {
+        calculate();
+        return solver_->numberOfSteps();
+    }
+
+    Size FdmBlackScholesSolver::rejectedSteps() const {
+        calculate();
+        return solver_->rejectedSteps();
+    }
 }
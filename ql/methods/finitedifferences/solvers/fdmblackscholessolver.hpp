@@ -52,6 +52,11 @@ namespace QuantLib {
         Real gammaAt(Real s) const;
         Real thetaAt(Real s) const;
 
+        //! number of time steps accepted during the rollback
+        Size numberOfSteps() const;
+        //! number of adaptive time steps rejected during the rollback
+        Size rejectedSteps() const;
+
       protected:
         void performCalculations() const override;
 
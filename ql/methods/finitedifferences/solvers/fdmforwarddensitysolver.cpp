@@ -0,0 +1,244 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/instruments/payoffs.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/cranknicolsonscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/expliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmforwarddensitysolver.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmthreadpool.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        class ForwardStepper {
+          public:
+            virtual ~ForwardStepper() = default;
+            virtual void step(Array& p, Time from, Time to) = 0;
+        };
+
+        template <class Scheme>
+        class SchemeStepper : public ForwardStepper {
+          public:
+            explicit SchemeStepper(ext::shared_ptr<Scheme> scheme)
+            : scheme_(std::move(scheme)) {}
+
+            // the schemes evaluate the operator on [t-dt, t], which
+            // makes them usable for forward steps as well
+            void step(Array& p, Time from, Time to) override {
+                scheme_->setStep(to - from);
+                scheme_->step(p, to);
+            }
+
+          private:
+            const ext::shared_ptr<Scheme> scheme_;
+        };
+
+        template <class Scheme>
+        ext::shared_ptr<ForwardStepper> stepper(
+                                    const ext::shared_ptr<Scheme>& scheme) {
+            return ext::make_shared<SchemeStepper<Scheme> >(scheme);
+        }
+
+        ext::shared_ptr<ForwardStepper> forwardStepper(
+            const FdmSchemeDesc& desc,
+            const ext::shared_ptr<FdmLinearOpComposite>& op) {
+
+            switch (desc.type) {
+              case FdmSchemeDesc::HundsdorferType:
+                return stepper(ext::make_shared<HundsdorferScheme>(
+                    desc.theta, desc.mu, op));
+              case FdmSchemeDesc::DouglasType:
+                return stepper(ext::make_shared<DouglasScheme>(
+                    desc.theta, op));
+              case FdmSchemeDesc::CrankNicolsonType:
+                return stepper(ext::make_shared<CrankNicolsonScheme>(
+                    desc.theta, op));
+              case FdmSchemeDesc::CraigSneydType:
+                return stepper(ext::make_shared<CraigSneydScheme>(
+                    desc.theta, desc.mu, op));
+              case FdmSchemeDesc::ModifiedCraigSneydType:
+                return stepper(ext::make_shared<ModifiedCraigSneydScheme>(
+                    desc.theta, desc.mu, op));
+              case FdmSchemeDesc::ImplicitEulerType:
+                return stepper(ext::make_shared<ImplicitEulerScheme>(op));
+              case FdmSchemeDesc::ExplicitEulerType:
+                return stepper(ext::make_shared<ExplicitEulerScheme>(op));
+              default:
+                QL_FAIL("scheme type is not supported "
+                        "by the forward density solver");
+            }
+        }
+
+        Real cellWeight(const ext::shared_ptr<FdmMesher>& mesher,
+                        const FdmLinearOpIterator& iter, Size direction) {
+            const Real dplus = mesher->dplus(iter, direction);
+            const Real dminus = mesher->dminus(iter, direction);
+
+            return 0.5*(  ((dplus != Null<Real>()) ? dplus : 0.0)
+                        + ((dminus != Null<Real>()) ? dminus : 0.0));
+        }
+    }
+
+    FdmForwardDensitySolver::FdmForwardDensitySolver(
+        ext::shared_ptr<FdmMesher> mesher,
+        ext::shared_ptr<FdmLinearOpComposite> fwdOp,
+        Array initialDensity,
+        Time initialTime,
+        std::vector<Time> times,
+        Size timeSteps,
+        Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc)
+    : mesher_(std::move(mesher)), fwdOp_(std::move(fwdOp)),
+      initialDensity_(std::move(initialDensity)), initialTime_(initialTime),
+      times_(std::move(times)), timeSteps_(timeSteps),
+      dampingSteps_(dampingSteps), schemeDesc_(schemeDesc),
+      x_(mesher_->layout()->dim().front()) {
+
+        QL_REQUIRE(!times_.empty(), "no snapshot times given");
+        QL_REQUIRE(timeSteps_ > 0, "at least one time step required");
+        QL_REQUIRE(initialDensity_.size() == mesher_->layout()->size(),
+                   "initial density does not match the mesher");
+
+        std::sort(times_.begin(), times_.end());
+        times_.erase(std::unique(times_.begin(), times_.end(),
+                                 static_cast<bool (*)(Real, Real)>(
+                                     close_enough)),
+                     times_.end());
+        QL_REQUIRE(times_.front() >= initialTime_,
+                   "snapshot times must not precede the initial time");
+
+        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            const std::vector<Size>& c = iter.coordinates();
+            if (std::count(c.begin()+1, c.end(), Size(0))
+                    == std::ptrdiff_t(c.size()-1))
+                x_[c.front()] = mesher_->location(iter, 0);
+        }
+    }
+
+    Size FdmForwardDensitySolver::timeIndex(Time t) const {
+        for (Size i=0; i < times_.size(); ++i)
+            if (close_enough(times_[i], t))
+                return i;
+
+        QL_FAIL("no density snapshot at time " << t);
+    }
+
+    const Array& FdmForwardDensitySolver::density(Size i) const {
+        calculate();
+        QL_REQUIRE(i < densities_.size(),
+                   "snapshot index (" << i << ") out of range");
+        return densities_[i];
+    }
+
+    Real FdmForwardDensitySolver::expectation(
+                                Size i, const Payoff& payoff) const {
+        const Array& p = density(i);
+
+        // kinks and jumps of striked payoffs are put on a cell boundary
+        Real kink = Null<Real>();
+        const auto* striked = dynamic_cast<const StrikedTypePayoff*>(&payoff);
+        if (striked != nullptr && striked->strike() > 0.0)
+            kink = std::log(striked->strike());
+
+        // Simpson's rule on each cell with a linear density
+        const auto integral = [&payoff](Real a, Real b, Real pa, Real pb) {
+            const Real m = 0.5*(a+b);
+            return (b-a)/6.0*(  payoff(std::exp(a))*pa
+                              + 2.0*payoff(std::exp(m))*(pa+pb)
+                              + payoff(std::exp(b))*pb);
+        };
+
+        Real retVal = 0.0;
+        for (Size j=1; j < x_.size(); ++j) {
+            const Real a = x_[j-1], b = x_[j];
+            if (kink != Null<Real>() && a < kink && kink < b) {
+                const Real pk = p[j-1] + (p[j]-p[j-1])*(kink-a)/(b-a);
+                retVal += integral(a, kink, p[j-1], pk)
+                        + integral(kink, b, pk, p[j]);
+            }
+            else {
+                retVal += integral(a, b, p[j-1], p[j]);
+            }
+        }
+
+        return retVal;
+    }
+
+    void FdmForwardDensitySolver::performCalculations() const {
+        const FdmThreadPool::Scope scope(
+            schemeDesc_.threads > 1 ? &FdmThreadPool::shared(schemeDesc_.threads)
+                                    : nullptr);
+
+        const ext::shared_ptr<ForwardStepper> evolver =
+            forwardStepper(schemeDesc_, fwdOp_);
+        const ext::shared_ptr<ForwardStepper> dampingEvolver =
+            stepper(ext::make_shared<ImplicitEulerScheme>(fwdOp_));
+
+        // weights of the directions integrated out of the density
+        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const FdmLinearOpIterator endIter = layout->end();
+        Array weights(layout->size(), 1.0);
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            for (Size d=1; d < layout->dim().size(); ++d)
+                weights[iter.index()] *= cellWeight(mesher_, iter, d);
+        }
+
+        Array p(initialDensity_);
+        densities_.assign(times_.size(), Array(x_.size()));
+
+        const Time span = times_.back() - initialTime_;
+        Time t = initialTime_;
+        Size steps = 0;
+        for (Size i=0; i < times_.size(); ++i) {
+            const Time start = t, dT = times_[i] - start;
+            if (dT > 0.0) {
+                const Size n = std::max(Size(1), Size(std::lround(
+                    timeSteps_*dT/span)));
+                for (Size j=0; j < n; ++j, ++steps) {
+                    const Time to = (j+1 == n) ? times_[i] : start + dT*(j+1)/n;
+                    ((steps < dampingSteps_) ? dampingEvolver : evolver)
+                        ->step(p, t, to);
+                    t = to;
+                }
+            }
+
+            Array& density = densities_[i];
+            std::fill(density.begin(), density.end(), 0.0);
+            for (FdmLinearOpIterator iter = layout->begin();
+                 iter != endIter; ++iter) {
+                const Size idx = iter.index();
+                density[iter.coordinates()[0]] += weights[idx]*p[idx];
+            }
+        }
+    }
+}
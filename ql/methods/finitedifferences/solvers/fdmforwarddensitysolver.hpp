@@ -0,0 +1,98 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmforwarddensitysolver.hpp
+    \brief Fokker-Planck forward solver with density snapshots
+*/
+
+#ifndef quantlib_fdm_forward_density_solver_hpp
+#define quantlib_fdm_forward_density_solver_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class Payoff;
+    class FdmMesher;
+
+    //! Fokker-Planck forward solver with density snapshots
+    /*! Evolves a transition density forward in time with the given
+        forward operator and keeps the marginal density of the
+        log-spot, located in direction 0 of the mesher, at each of
+        the given times.  Integrating payoffs against the snapshots
+        then prices any number of European options per expiry without
+        further solves.
+
+        The density must be given with respect to the mesher
+        coordinates; the remaining directions, e.g. the variance in
+        the Heston model, are integrated out with the trapezoidal
+        rule.
+
+        The time steps are distributed over the intervals between
+        the snapshot times in proportion to their length, with at
+        least one step per interval.  The first dampingSteps steps
+        use the implicit Euler scheme.
+    */
+    class FdmForwardDensitySolver : public LazyObject {
+      public:
+        FdmForwardDensitySolver(ext::shared_ptr<FdmMesher> mesher,
+                                ext::shared_ptr<FdmLinearOpComposite> fwdOp,
+                                Array initialDensity,
+                                Time initialTime,
+                                std::vector<Time> times,
+                                Size timeSteps,
+                                Size dampingSteps = 0,
+                                const FdmSchemeDesc& schemeDesc
+                                    = FdmSchemeDesc::Douglas());
+
+        //! sorted snapshot times
+        const std::vector<Time>& times() const { return times_; }
+        //! index of the given snapshot time
+        Size timeIndex(Time t) const;
+
+        //! log-spot grid
+        const Array& x() const { return x_; }
+        //! marginal density of the log-spot at the i-th snapshot time
+        const Array& density(Size i) const;
+
+        /*! expectation of the payoff of the spot at the i-th snapshot
+            time, i.e. the undiscounted price of the option.  Kinks
+            of striked payoffs are handled exactly.
+        */
+        Real expectation(Size i, const Payoff& payoff) const;
+
+      protected:
+        void performCalculations() const override;
+
+      private:
+        const ext::shared_ptr<FdmMesher> mesher_;
+        const ext::shared_ptr<FdmLinearOpComposite> fwdOp_;
+        const Array initialDensity_;
+        const Time initialTime_;
+        std::vector<Time> times_;
+        const Size timeSteps_, dampingSteps_;
+        const FdmSchemeDesc schemeDesc_;
+
+        Array x_;
+        mutable std::vector<Array> densities_;
+    };
+}
+
+#endif
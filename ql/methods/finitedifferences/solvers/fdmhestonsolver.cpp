@@ -90,4 +90,14 @@ namespace QuantLib {
         calculate();
         return solver_->thetaAt(std::log(s), v);
     }
+
+    Size FdmHestonSolver::numberOfSteps() const {
+        calculate();
+        return solver_->numberOfSteps();
+    }
+
+    Size FdmHestonSolver::rejectedSteps() const {
+        calculate();
+        return solver_->rejectedSteps();
+    }
 }
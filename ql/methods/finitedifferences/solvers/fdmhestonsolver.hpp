@@ -63,6 +63,11 @@ namespace QuantLib {
         Real meanVarianceDeltaAt(Real s, Real v) const;
         Real meanVarianceGammaAt(Real s, Real v) const;
 
+        //! number of time steps accepted during the rollback
+        Size numberOfSteps() const;
+        //! number of adaptive time steps rejected during the rollback
+        Size rejectedSteps() const;
+
       protected:
         void performCalculations() const override;
 
@@ -34,49 +34,89 @@
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 
-#include <numeric>
+#include <algorithm>
 
 namespace QuantLib {
 
+    //! n-dimensional finite-difference solver
+    /*! By default, the rolled back values are interpolated by a
+        MultiCubicSpline on the whole grid, which holds several tables
+        of the size of the grid.  In the Bounded snapshot mode only
+        the values themselves and the theta snapshot are kept and
+        each call to interpolateAt() or thetaAt() fits a natural
+        cubic spline to the 12 grid points per direction around the
+        given point, which then lies in the middle interval.  The
+        effect of the natural end conditions decays by a factor of
+        about 3.7 per grid point, so that, away from the ends of the
+        grid, the local spline reproduces the global one to about
+        0.1% or better.  This keeps the snapshot memory to two values
+        per grid point instead of three, at the cost of a spline fit
+        on \f$ 12^N \f$ points per call.
+
+        snapshotBytesUsed() reports the memory held by the solver for
+        the values, snapshots and interpolation tables only.  The
+        operator, whose band storage and index arrays usually
+        dominate the footprint per grid point, and the location
+        arrays of the mesher are not included.
+    */
     template <Size N>
     class FdmNdimSolver : public LazyObject {
       public:
+        enum SnapshotMode { Full, Bounded };
+
         FdmNdimSolver(const FdmSolverDesc& solverDesc,
                       const FdmSchemeDesc& schemeDesc,
-                      ext::shared_ptr<FdmLinearOpComposite> op);
+                      ext::shared_ptr<FdmLinearOpComposite> op,
+                      SnapshotMode mode = Full);
 
         void performCalculations() const override;
 
         Real interpolateAt(const std::vector<Real>& x) const;
         Real thetaAt(const std::vector<Real>& x) const;
 
+        //! number of time steps accepted during the rollback
+        Size numberOfSteps() const;
+        //! number of adaptive time steps rejected during the rollback
+        Size rejectedSteps() const;
+
+        //! memory of the values and snapshots only, see above
+        Size snapshotBytesUsed() const;
+        Real snapshotBytesPerGridPoint() const;
+
         // template meta programming
         typedef typename MultiCubicSpline<N>::data_table data_table;
         void static setValue(data_table& f,
                              const std::vector<Size>& x, Real value);
 
       private:
+        Real localInterpolation(const Array& values,
+                                const std::vector<Real>& x) const;
+
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const ext::shared_ptr<FdmLinearOpComposite> op_;
+        const SnapshotMode mode_;
 
         const ext::shared_ptr<FdmSnapshotCondition> thetaCondition_;
         const ext::shared_ptr<FdmStepConditionComposite> conditions_;
 
         std::vector<std::vector<Real> > x_;
-        std::vector<Real> initialValues_;
         const std::vector<bool> extrapolation_;
 
+        mutable Array values_;
         mutable ext::shared_ptr<data_table> f_;
         mutable ext::shared_ptr<MultiCubicSpline<N> > interp_;
+        mutable Size steps_ = 0, rejectedSteps_ = 0;
     };
 
 
     template <Size N>
     inline FdmNdimSolver<N>::FdmNdimSolver(const FdmSolverDesc& solverDesc,
                                            const FdmSchemeDesc& schemeDesc,
-                                           ext::shared_ptr<FdmLinearOpComposite> op)
+                                           ext::shared_ptr<FdmLinearOpComposite> op,
+                                           SnapshotMode mode)
     : solverDesc_(solverDesc), schemeDesc_(schemeDesc), op_(std::move(op)),
+      mode_(mode),
       thetaCondition_(new FdmSnapshotCondition(
           0.99 * std::min(1.0 / 365.0,
                           solverDesc.condition->stoppingTimes().empty() ?
@@ -84,7 +124,6 @@ namespace QuantLib {
                               solverDesc.condition->stoppingTimes().front()))),
       conditions_(FdmStepConditionComposite::joinConditions(thetaCondition_, solverDesc.condition)),
       x_(solverDesc.mesher->layout()->dim().size()),
-      initialValues_(solverDesc.mesher->layout()->size()),
       extrapolation_(std::vector<bool>(N, false)) {
 
         const ext::shared_ptr<FdmMesher> mesher = solverDesc.mesher;
@@ -93,42 +132,49 @@ namespace QuantLib {
         QL_REQUIRE(layout->dim().size() == N, "solver dim " << N
                     << "does not fit to layout dim " << layout->size());
 
+        // walk along the axes only instead of over the whole grid
         for (Size i=0; i < N; ++i) {
             x_[i].reserve(layout->dim()[i]);
-        }
 
-        const FdmLinearOpIterator endIter = layout->end();
-        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
-             ++iter) {
-
-            initialValues_[iter.index()] = solverDesc_.calculator
-                                ->avgInnerValue(iter, solverDesc.maturity);
-
-            const std::vector<Size>& c = iter.coordinates();
-            for (Size i=0; i < N; ++i) {
-                if ((std::accumulate(c.begin(), c.end(), 0UL) - c[i]) == 0U) {
-                    x_[i].push_back(mesher->location(iter, i));
-                }
+            std::vector<Size> coordinates(N, 0);
+            for (Size j=0; j < layout->dim()[i]; ++j) {
+                coordinates[i] = j;
+                const FdmLinearOpIterator iter(
+                    layout->dim(), coordinates, j*layout->spacing()[i]);
+                x_[i].push_back(mesher->location(iter, i));
             }
         }
-
-        f_ = ext::shared_ptr<data_table>(new data_table(x_));
     }
 
 
     template <Size N> inline
     void FdmNdimSolver<N>::performCalculations() const {
-        Array rhs(initialValues_.size());
-        std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
-
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-                 .rollback(rhs, solverDesc_.maturity, 0.0,
-                           solverDesc_.timeSteps, solverDesc_.dampingSteps);
-
         const ext::shared_ptr<FdmLinearOpLayout> layout
                                                = solverDesc_.mesher->layout();
 
+        Array rhs(layout->size());
         const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            rhs[iter.index()] = solverDesc_.calculator
+                                ->avgInnerValue(iter, solverDesc_.maturity);
+        }
+
+        FdmBackwardSolver solver(op_, solverDesc_.bcSet, conditions_,
+                                 schemeDesc_);
+        solver.rollback(rhs, solverDesc_.maturity, 0.0,
+                        solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        steps_ = solver.numberOfSteps();
+        rejectedSteps_ = solver.rejectedSteps();
+
+        if (mode_ == Bounded) {
+            values_.swap(rhs);
+            return;
+        }
+
+        if (!f_)
+            f_ = ext::shared_ptr<data_table>(new data_table(x_));
+
         for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
              ++iter) {
             setValue(*f_, iter.coordinates(), rhs[iter.index()]);
@@ -146,6 +192,12 @@ namespace QuantLib {
 
         calculate();
         const Array& rhs = thetaCondition_->getValues();
+
+        if (mode_ == Bounded) {
+            return (localInterpolation(rhs, x) - interpolateAt(x))
+                / thetaCondition_->getTime();
+        }
+
         const ext::shared_ptr<FdmLinearOpLayout> layout
                                             = solverDesc_.mesher->layout();
 
@@ -165,9 +217,88 @@ namespace QuantLib {
     Real FdmNdimSolver<N>::interpolateAt(const std::vector<Real>& x) const {
         calculate();
 
+        if (mode_ == Bounded)
+            return localInterpolation(values_, x);
+
         return (*interp_)(x);
     }
 
+    template <Size N> inline
+    Size FdmNdimSolver<N>::numberOfSteps() const {
+        calculate();
+        return steps_;
+    }
+
+    template <Size N> inline
+    Size FdmNdimSolver<N>::rejectedSteps() const {
+        calculate();
+        return rejectedSteps_;
+    }
+
+    template <Size N> inline
+    Real FdmNdimSolver<N>::localInterpolation(
+        const Array& values, const std::vector<Real>& x) const {
+
+        const std::vector<Size>& spacing
+            = solverDesc_.mesher->layout()->spacing();
+
+        // grid points on each side of the local spline window
+        const Size halfWidth = 6;
+
+        std::vector<std::vector<Real> > xl(N);
+        std::vector<Size> dim(N), offset(N);
+        for (Size i=0; i < N; ++i) {
+            const Size n = x_[i].size();
+            const Size w = std::min(n, 2*halfWidth);
+            const Size j = std::upper_bound(x_[i].begin(), x_[i].end(), x[i])
+                - x_[i].begin();
+
+            // x lies in the middle interval of the window, unless the
+            // window is clipped at the ends of the grid
+            offset[i] = std::min(std::max(j, halfWidth) - halfWidth, n - w);
+            dim[i] = w;
+            xl[i].assign(x_[i].begin() + offset[i],
+                         x_[i].begin() + offset[i] + w);
+        }
+
+        data_table f(xl);
+        const FdmLinearOpLayout local(dim);
+        const FdmLinearOpIterator endIter = local.end();
+        for (FdmLinearOpIterator iter = local.begin(); iter != endIter;
+             ++iter) {
+            const std::vector<Size>& c = iter.coordinates();
+            Size idx = 0;
+            for (Size i=0; i < N; ++i)
+                idx += (offset[i] + c[i])*spacing[i];
+            setValue(f, c, values[idx]);
+        }
+
+        return MultiCubicSpline<N>(xl, f, extrapolation_)(x);
+    }
+
+    template <Size N> inline
+    Size FdmNdimSolver<N>::snapshotBytesUsed() const {
+        calculate();
+
+        const Size size = solverDesc_.mesher->layout()->size();
+        Size reals = thetaCondition_->getValues().size();
+        for (Size i=0; i < N; ++i)
+            reals += x_[i].size();
+
+        if (mode_ == Bounded)
+            reals += values_.size();
+        else
+            // the values and the second derivatives of the spline
+            reals += 2*size;
+
+        return reals*sizeof(Real);
+    }
+
+    template <Size N> inline
+    Real FdmNdimSolver<N>::snapshotBytesPerGridPoint() const {
+        return Real(snapshotBytesUsed())/solverDesc_.mesher->layout()->size();
+    }
+
     template <Size N> inline
     void FdmNdimSolver<N>::setValue(data_table& f,
                                     const std::vector<Size>& x, Real value) {
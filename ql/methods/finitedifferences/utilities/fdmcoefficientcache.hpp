@@ -0,0 +1,82 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmcoefficientcache.hpp
+    \brief detects unchanged operator coefficients between time steps
+*/
+
+#ifndef quantlib_fdm_coefficient_cache_hpp
+#define quantlib_fdm_coefficient_cache_hpp
+
+#include <ql/math/array.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! detects unchanged operator coefficients between time steps
+    /*! The setTime() methods of the operators pass the market data
+        their coefficients are built from, e.g. the forward rates and
+        the variances over the time step.  If these are the same as in
+        the previous step, as it happens on intervals where the term
+        structures are constant in time, the operator keeps the
+        coefficients assembled before.
+
+        Values are considered equal if they differ by less than the
+        given tolerance relative to max(1, |value|), which absorbs
+        the rounding of forward rates implied by discount factors.
+    */
+    class FdmCoefficientCache {
+      public:
+        explicit FdmCoefficientCache(Real tolerance = 1e-12)
+        : tolerance_(tolerance), valid_(false), hits_(0) {}
+
+        /*! returns true and stores the given parameters if they
+            differ from the ones passed in the previous call.
+        */
+        bool update(const Array& parameters) {
+            if (valid_ && parameters.size() == parameters_.size()) {
+                bool same = true;
+                for (Size i=0; i < parameters.size() && same; ++i)
+                    same = std::fabs(parameters[i] - parameters_[i])
+                        <= tolerance_*std::max(1.0, std::fabs(parameters[i]));
+                if (same) {
+                    ++hits_;
+                    return false;
+                }
+            }
+            if (parameters_.size() != parameters.size())
+                parameters_ = Array(parameters.size());
+            std::copy(parameters.begin(), parameters.end(),
+                      parameters_.begin());
+            valid_ = true;
+            return true;
+        }
+
+        //! number of calls which found unchanged parameters
+        Size hits() const { return hits_; }
+
+      private:
+        Real tolerance_;
+        Array parameters_;
+        bool valid_;
+        Size hits_;
+    };
+
+}
+
+#endif
@@ -125,6 +125,41 @@ namespace QuantLib {
     }
 
 
+    FdmMultiPayoffInnerValue::FdmMultiPayoffInnerValue(
+        const std::vector<ext::shared_ptr<Payoff> >& payoffs,
+        const ext::shared_ptr<FdmMesher>& mesher,
+        Size direction,
+        Size payoffDirection)
+    : payoffDirection_(payoffDirection) {
+        QL_REQUIRE(direction != payoffDirection,
+                   "payoff direction must differ from spot direction");
+        QL_REQUIRE(payoffDirection < mesher->layout()->dim().size(),
+                   "payoff direction out of range");
+        QL_REQUIRE(payoffs.size()
+                       == mesher->layout()->dim()[payoffDirection],
+                   "number of payoffs (" << payoffs.size()
+                   << ") differs from the grid size in the payoff direction ("
+                   << mesher->layout()->dim()[payoffDirection] << ")");
+
+        calculators_.reserve(payoffs.size());
+        for (const auto& payoff : payoffs)
+            calculators_.push_back(ext::make_shared<FdmLogInnerValue>(
+                payoff, mesher, direction));
+    }
+
+    Real FdmMultiPayoffInnerValue::innerValue(
+                                const FdmLinearOpIterator& iter, Time t) {
+        return calculators_[iter.coordinates()[payoffDirection_]]
+            ->innerValue(iter, t);
+    }
+
+    Real FdmMultiPayoffInnerValue::avgInnerValue(
+                                const FdmLinearOpIterator& iter, Time t) {
+        return calculators_[iter.coordinates()[payoffDirection_]]
+            ->avgInnerValue(iter, t);
+    }
+
+
     FdmLogBasketInnerValue::FdmLogBasketInnerValue(ext::shared_ptr<BasketPayoff> payoff,
                                                    ext::shared_ptr<FdmMesher> mesher)
     : payoff_(std::move(payoff)), mesher_(std::move(mesher)) {}
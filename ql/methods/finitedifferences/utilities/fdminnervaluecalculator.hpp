@@ -78,6 +78,28 @@ namespace QuantLib {
                          Size direction);
     };
 
+    //! inner values of a strip of payoffs along an index direction
+    /*! The mesher carries one extra direction whose coordinate
+        selects the payoff; the inner value at each point is the one
+        of the selected payoff in the log-spot direction.  This allows
+        to roll back all payoffs at once with a single operator.
+    */
+    class FdmMultiPayoffInnerValue : public FdmInnerValueCalculator {
+      public:
+        FdmMultiPayoffInnerValue(
+            const std::vector<ext::shared_ptr<Payoff> >& payoffs,
+            const ext::shared_ptr<FdmMesher>& mesher,
+            Size direction,
+            Size payoffDirection);
+
+        Real innerValue(const FdmLinearOpIterator& iter, Time t) override;
+        Real avgInnerValue(const FdmLinearOpIterator& iter, Time t) override;
+
+      private:
+        const Size payoffDirection_;
+        std::vector<ext::shared_ptr<FdmInnerValueCalculator> > calculators_;
+    };
+
     class FdmLogBasketInnerValue : public FdmInnerValueCalculator {
       public:
         FdmLogBasketInnerValue(ext::shared_ptr<BasketPayoff> payoff,
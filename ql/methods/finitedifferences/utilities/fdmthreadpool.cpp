@@ -0,0 +1,154 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/utilities/fdmthreadpool.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <map>
+#include <memory>
+
+namespace QuantLib {
+
+    namespace {
+
+        thread_local FdmThreadPool* currentPool = nullptr;
+
+        // pools are never replaced, since a scope might still use them
+        thread_local std::map<Size, std::unique_ptr<FdmThreadPool> >
+            sharedPools;
+
+    }
+
+    FdmThreadPool::FdmThreadPool(Size threads)
+    : task_(nullptr), size_(0), chunks_(0), pending_(0), generation_(0),
+      stop_(false) {
+        QL_REQUIRE(threads > 0, "at least one thread required");
+        workers_.reserve(threads-1);
+        for (Size k=1; k<threads; ++k)
+            workers_.emplace_back([this, k]() { work(k); });
+    }
+
+    FdmThreadPool::~FdmThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+    void FdmThreadPool::parallelFor(Size n,
+                                    const std::function<void(Size, Size)>& f,
+                                    Size grain) {
+        const Size chunks =
+            std::min(threads(), n / std::max<Size>(grain, 1));
+        if (chunks < 2) {
+            if (n > 0)
+                f(0, n);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &f;
+            size_ = n;
+            chunks_ = chunks;
+            pending_ = workers_.size();
+            error_ = std::exception_ptr();
+            ++generation_;
+        }
+        start_.notify_all();
+
+        run(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]() { return pending_ == 0; });
+        task_ = nullptr;
+        if (error_) {
+            std::exception_ptr error = error_;
+            error_ = std::exception_ptr();
+            std::rethrow_exception(error);
+        }
+    }
+
+    void FdmThreadPool::run(Size chunk) {
+        // size_, chunks_ and task_ don't change until all chunks are done
+        if (chunk < chunks_) {
+            try {
+                (*task_)(size_*chunk/chunks_, size_*(chunk+1)/chunks_);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_)
+                    error_ = std::current_exception();
+            }
+        }
+    }
+
+    void FdmThreadPool::work(Size chunk) {
+        Size generation = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [&]() {
+                    return stop_ || generation_ != generation;
+                });
+                if (stop_)
+                    return;
+                generation = generation_;
+            }
+
+            run(chunk);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0)
+                done_.notify_one();
+        }
+    }
+
+    FdmThreadPool* FdmThreadPool::current() {
+        return currentPool;
+    }
+
+    FdmThreadPool& FdmThreadPool::shared(Size threads) {
+        std::unique_ptr<FdmThreadPool>& pool = sharedPools[threads];
+        if (!pool)
+            pool.reset(new FdmThreadPool(threads));
+        return *pool;
+    }
+
+    FdmThreadPool::Scope::Scope(FdmThreadPool* pool)
+    : previous_(currentPool) {
+        currentPool = pool;
+    }
+
+    FdmThreadPool::Scope::~Scope() {
+        currentPool = previous_;
+    }
+
+
+    void fdmParallelFor(Size n,
+                        const std::function<void(Size, Size)>& f,
+                        Size grain) {
+        FdmThreadPool* pool = FdmThreadPool::current();
+        if (pool != nullptr)
+            pool->parallelFor(n, f, grain);
+        else if (n > 0)
+            f(0, n);
+    }
+
+}
@@ -0,0 +1,111 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmthreadpool.hpp
+    \brief pool of threads for the sweeps of finite-difference operators
+*/
+
+#ifndef quantlib_fdm_thread_pool_hpp
+#define quantlib_fdm_thread_pool_hpp
+
+#include <ql/types.hpp>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace QuantLib {
+
+    //! pool of threads for the sweeps of finite-difference operators
+    /*! The line solves of TripleBandLinearOp and the stencil
+        applications of TripleBandLinearOp and NinePointLinearOp are
+        split across the pool made current in the calling thread by
+        an FdmThreadPool::Scope; without one, they run serially.
+        FdmBackwardSolver does this for the duration of a rollback
+        when its FdmSchemeDesc asks for more than one thread, using
+        the pool returned by shared() so that successive rollbacks
+        don't start new threads.
+
+        The threads are started by the constructor and wait for work
+        until the pool is destroyed.
+
+        \warning a pool must not be used by several threads at the
+                 same time.
+    */
+    class FdmThreadPool {
+      public:
+        //! \param threads  number of threads, including the calling one
+        explicit FdmThreadPool(Size threads);
+        ~FdmThreadPool();
+        FdmThreadPool(const FdmThreadPool&) = delete;
+        FdmThreadPool& operator=(const FdmThreadPool&) = delete;
+
+        Size threads() const { return workers_.size() + 1; }
+        /*! calls f(begin, end) on consecutive chunks of [0, n), at
+            most one per thread and not smaller than the given grain,
+            and returns when all of them are done.  The calling thread
+            takes the first chunk.  If any call throws, the first
+            exception is rethrown.
+        */
+        void parallelFor(Size n,
+                         const std::function<void(Size, Size)>& f,
+                         Size grain = 1);
+
+        //! pool of the innermost scope in the calling thread, if any
+        static FdmThreadPool* current();
+        /*! pool with the given number of threads owned by the calling
+            thread; it's created on first use and kept until the
+            calling thread exits.
+        */
+        static FdmThreadPool& shared(Size threads);
+
+        //! makes a pool current in the calling thread
+        class Scope {
+          public:
+            explicit Scope(FdmThreadPool* pool);
+            ~Scope();
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+          private:
+            FdmThreadPool* previous_;
+        };
+
+      private:
+        void run(Size chunk);
+        void work(Size chunk);
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable start_, done_;
+        const std::function<void(Size, Size)>* task_;
+        Size size_, chunks_, pending_, generation_;
+        bool stop_;
+        std::exception_ptr error_;
+    };
+
+    /*! calls FdmThreadPool::parallelFor on the current pool, or f on
+        the whole range if there is none.
+    */
+    void fdmParallelFor(Size n,
+                        const std::function<void(Size, Size)>& f,
+                        Size grain = 1);
+
+}
+
+
+#endif
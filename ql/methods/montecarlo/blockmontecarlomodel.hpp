@@ -0,0 +1,126 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file blockmontecarlomodel.hpp
+    \brief Monte Carlo model for blocks of single-factor paths
+*/
+
+#ifndef quantlib_montecarlo_block_model_hpp
+#define quantlib_montecarlo_block_model_hpp
+
+#include <ql/methods/montecarlo/blockpathgenerator.hpp>
+#include <ql/methods/montecarlo/blockpathpricer.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Monte Carlo model for blocks of single-factor paths
+    /*! This class is the counterpart of MonteCarloModel for block
+        path generators and pricers.  The samples are the same as
+        the ones of the corresponding MonteCarloModel, but they are
+        added to the accumulator passed to addSamples(), so that the
+        model can be shared by simulations using different
+        statistics.
+
+        \ingroup mcarlo
+    */
+    template <class RNG>
+    class BlockMonteCarloModel {
+      public:
+        typedef RNG rng_traits;
+        typedef BlockPathGenerator<typename RNG::rsg_type>
+            path_generator_type;
+        typedef BlockPathPricer path_pricer_type;
+        typedef Real result_type;
+        BlockMonteCarloModel(
+            ext::shared_ptr<path_generator_type> pathGenerator,
+            ext::shared_ptr<path_pricer_type> pathPricer,
+            bool antitheticVariate,
+            ext::shared_ptr<path_pricer_type> cvPathPricer =
+                ext::shared_ptr<path_pricer_type>(),
+            result_type cvOptionValue = result_type())
+        : pathGenerator_(std::move(pathGenerator)),
+          pathPricer_(std::move(pathPricer)),
+          isAntitheticVariate_(antitheticVariate),
+          cvPathPricer_(std::move(cvPathPricer)),
+          cvOptionValue_(cvOptionValue),
+          isControlVariate_(static_cast<bool>(cvPathPricer_)),
+          values_(pathGenerator_->pathsPerBlock()),
+          antitheticValues_(isAntitheticVariate_ ?
+                            pathGenerator_->pathsPerBlock() : 0),
+          cvValues_(isControlVariate_ ?
+                    pathGenerator_->pathsPerBlock() : 0) {}
+        //! adds the given number of samples to the accumulator
+        template <class Accumulator>
+        void addSamples(Size samples, Accumulator& accumulator);
+        const ext::shared_ptr<path_generator_type>& pathGenerator() const {
+            return pathGenerator_;
+        }
+      private:
+        void price(const PathBlock& paths, std::vector<Real>& values);
+        ext::shared_ptr<path_generator_type> pathGenerator_;
+        ext::shared_ptr<path_pricer_type> pathPricer_;
+        bool isAntitheticVariate_;
+        ext::shared_ptr<path_pricer_type> cvPathPricer_;
+        result_type cvOptionValue_;
+        bool isControlVariate_;
+        std::vector<Real> values_, antitheticValues_, cvValues_;
+    };
+
+    // inline definitions
+    template <class RNG>
+    template <class Accumulator>
+    inline void BlockMonteCarloModel<RNG>::addSamples(
+                                   Size samples, Accumulator& accumulator) {
+        while (samples > 0) {
+            Size paths = std::min(samples, pathGenerator_->pathsPerBlock());
+
+            const PathBlock& block = pathGenerator_->next(paths);
+            price(block, values_);
+
+            if (isAntitheticVariate_) {
+                const PathBlock& atBlock = pathGenerator_->antithetic();
+                price(atBlock, antitheticValues_);
+                const Real* weights = atBlock.weights();
+                for (Size j=0; j<paths; ++j)
+                    accumulator.add((values_[j]+antitheticValues_[j])/2.0,
+                                    weights[j]);
+            } else {
+                const Real* weights = block.weights();
+                for (Size j=0; j<paths; ++j)
+                    accumulator.add(values_[j], weights[j]);
+            }
+
+            samples -= paths;
+        }
+    }
+
+    template <class RNG>
+    inline void BlockMonteCarloModel<RNG>::price(const PathBlock& paths,
+                                                 std::vector<Real>& values) {
+        (*pathPricer_)(paths, values);
+        if (isControlVariate_) {
+            (*cvPathPricer_)(paths, cvValues_);
+            for (Size j=0; j<paths.size(); ++j)
+                values[j] += cvOptionValue_-cvValues_[j];
+        }
+    }
+
+}
+
+
+#endif
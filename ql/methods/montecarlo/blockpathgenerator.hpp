@@ -0,0 +1,220 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file blockpathgenerator.hpp
+    \brief Generates blocks of random paths
+*/
+
+#ifndef quantlib_montecarlo_block_path_generator_hpp
+#define quantlib_montecarlo_block_path_generator_hpp
+
+#include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/processes/geometricbrownianprocess.hpp>
+#include <algorithm>
+#include <typeinfo>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Generates blocks of random paths using a sequence generator
+    /*! This class draws the same sequences as PathGenerator, one per
+        path, and stores the resulting paths in a PathBlock.
+
+        When the process is a Black-Scholes process with exact
+        log-normal evolution (see
+        GeneralizedBlackScholesProcess::hasExactEvolution) or a
+        GeometricBrownianMotionProcess, the parameters of each step
+        are calculated once per block and the paths are evolved with
+        a loop over contiguous memory; the results are the same as
+        the ones of PathGenerator.  For other processes, the evolve()
+        method of the process is called for each path and step.
+
+        \ingroup mcarlo
+    */
+    template <class GSG>
+    class BlockPathGenerator {
+      public:
+        typedef PathBlock sample_type;
+        BlockPathGenerator(const ext::shared_ptr<StochasticProcess>&,
+                           TimeGrid timeGrid,
+                           GSG generator,
+                           bool brownianBridge,
+                           Size pathsPerBlock);
+        //! \name inspectors
+        //@{
+        //! draws the next block of paths
+        const sample_type& next(Size paths) const;
+        //! returns the antithetic paths of the last block
+        const sample_type& antithetic() const;
+        Size size() const { return dimension_; }
+        Size pathsPerBlock() const { return pathsPerBlock_; }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //@}
+      private:
+        enum Evolution { Generic, LogNormal, Euler };
+        void evolve(bool antithetic) const;
+        bool brownianBridge_;
+        GSG generator_;
+        Size dimension_, pathsPerBlock_;
+        TimeGrid timeGrid_;
+        ext::shared_ptr<StochasticProcess1D> process_;
+        mutable sample_type next_;
+        mutable std::vector<Real> increments_, temp_;
+        BrownianBridge bb_;
+        Evolution evolution_;
+        std::vector<Real> drift_, diffusion_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    BlockPathGenerator<GSG>::BlockPathGenerator(
+                          const ext::shared_ptr<StochasticProcess>& process,
+                          TimeGrid timeGrid,
+                          GSG generator,
+                          bool brownianBridge,
+                          Size pathsPerBlock)
+    : brownianBridge_(brownianBridge), generator_(std::move(generator)),
+      dimension_(generator_.dimension()), pathsPerBlock_(pathsPerBlock),
+      timeGrid_(std::move(timeGrid)),
+      process_(ext::dynamic_pointer_cast<StochasticProcess1D>(process)),
+      next_(timeGrid_, pathsPerBlock), increments_(dimension_*pathsPerBlock),
+      temp_(dimension_), bb_(timeGrid_), evolution_(Generic),
+      drift_(dimension_), diffusion_(dimension_) {
+        QL_REQUIRE(process_, "1-D stochastic process required");
+        QL_REQUIRE(dimension_==timeGrid_.size()-1,
+                   "sequence generator dimensionality (" << dimension_
+                   << ") != timeSteps (" << timeGrid_.size()-1 << ")");
+
+        // derived classes might override evolve(), hence the
+        // check on the exact type of the process
+        const std::type_info& type = typeid(*process_);
+        if (type == typeid(GeneralizedBlackScholesProcess)
+            || type == typeid(BlackScholesProcess)
+            || type == typeid(BlackScholesMertonProcess)
+            || type == typeid(BlackProcess)
+            || type == typeid(GarmanKohlagenProcess)) {
+            ext::shared_ptr<GeneralizedBlackScholesProcess> bs =
+                ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                                                                   process_);
+            if (bs->hasExactEvolution()) {
+                evolution_ = LogNormal;
+                // same calculations as GeneralizedBlackScholesProcess::evolve
+                for (Size i=0; i<dimension_; ++i) {
+                    Time t = timeGrid_[i], dt = timeGrid_.dt(i);
+                    Real var = bs->variance(t, bs->x0(), dt);
+                    drift_[i] =
+                        (bs->riskFreeRate()->forwardRate(t, t + dt,
+                                                         Continuous,
+                                                         NoFrequency, true) -
+                         bs->dividendYield()->forwardRate(t, t + dt,
+                                                          Continuous,
+                                                          NoFrequency, true)) *
+                            dt -
+                        0.5 * var;
+                    diffusion_[i] = std::sqrt(var);
+                }
+            }
+        } else if (type == typeid(GeometricBrownianMotionProcess)) {
+            evolution_ = Euler;
+            // drift and diffusion are proportional to the state
+            for (Size i=0; i<dimension_; ++i) {
+                Time t = timeGrid_[i];
+                drift_[i] = process_->drift(t, 1.0);
+                diffusion_[i] = process_->diffusion(t, 1.0);
+            }
+        }
+    }
+
+    template <class GSG>
+    const typename BlockPathGenerator<GSG>::sample_type&
+    BlockPathGenerator<GSG>::next(Size paths) const {
+        next_.resize(paths);
+        Real* weights = next_.weights();
+        for (Size j=0; j<paths; ++j) {
+            typedef typename GSG::sample_type sequence_type;
+            const sequence_type& sequence_ = generator_.nextSequence();
+
+            if (brownianBridge_) {
+                bb_.transform(sequence_.value.begin(),
+                              sequence_.value.end(),
+                              temp_.begin());
+            } else {
+                std::copy(sequence_.value.begin(),
+                          sequence_.value.end(),
+                          temp_.begin());
+            }
+
+            for (Size i=0; i<dimension_; ++i)
+                increments_[i*pathsPerBlock_+j] = temp_[i];
+            weights[j] = sequence_.weight;
+        }
+
+        evolve(false);
+        return next_;
+    }
+
+    template <class GSG>
+    const typename BlockPathGenerator<GSG>::sample_type&
+    BlockPathGenerator<GSG>::antithetic() const {
+        evolve(true);
+        return next_;
+    }
+
+    template <class GSG>
+    void BlockPathGenerator<GSG>::evolve(bool antithetic) const {
+        const Size paths = next_.size();
+        const Real sign = antithetic ? -1.0 : 1.0;
+
+        std::fill(next_.values(0), next_.values(0)+paths, process_->x0());
+
+        for (Size i=1; i<next_.length(); i++) {
+            const Real* x = next_.values(i-1);
+            const Real* dw = &increments_[(i-1)*pathsPerBlock_];
+            Real* y = next_.values(i);
+            Time t = timeGrid_[i-1];
+            Time dt = timeGrid_.dt(i-1);
+            switch (evolution_) {
+              case LogNormal: {
+                  const Real drift = drift_[i-1];
+                  const Real sigma = sign*diffusion_[i-1];
+                  for (Size j=0; j<paths; ++j)
+                      y[j] = x[j] * std::exp(sigma*dw[j] + drift);
+                  break;
+              }
+              case Euler: {
+                  const Real mu = drift_[i-1];
+                  const Real sigma = diffusion_[i-1];
+                  const Real sqrtdt = sign*std::sqrt(dt);
+                  for (Size j=0; j<paths; ++j)
+                      y[j] = x[j] + mu*x[j]*dt + sigma*x[j]*sqrtdt*dw[j];
+                  break;
+              }
+              default:
+                for (Size j=0; j<paths; ++j)
+                    y[j] = process_->evolve(t, x[j], dt, sign*dw[j]);
+            }
+        }
+    }
+
+}
+
+
+#endif
@@ -27,8 +27,10 @@
 #define quantlib_longstaff_schwartz_path_pricer_hpp
 
 #include <ql/functional.hpp>
+#include <ql/math/comparison.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/matrixutilities/svd.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
@@ -53,6 +55,9 @@ namespace QuantLib {
     class LongstaffSchwartzPathPricer : public PathPricer<PathType> {
       public:
         typedef typename EarlyExerciseTraits<PathType>::StateType StateType;
+        typedef ext::function<void(const PathType&)> PathVisitor;
+        //! passes the same sequence of calibration paths to the visitor
+        typedef ext::function<void(const PathVisitor&)> PathRegenerator;
 
         LongstaffSchwartzPathPricer(const TimeGrid& times,
                                     ext::shared_ptr<EarlyExercisePathPricer<PathType> >,
@@ -60,6 +65,29 @@ namespace QuantLib {
 
         Real operator()(const PathType& path) const override;
         virtual void calibrate();
+        /*! calibrates without storing the calibration paths.  For
+            every exercise date, the paths are regenerated and the
+            normal equations of the regression are accumulated.  The
+            exercise date of the strategy determined so far is carried
+            forward for each path, so that its cash flow costs a
+            single payoff evaluation per path and date.  The memory
+            needed is thus one index per path instead of the paths
+            themselves, at the cost of regenerating the paths once per
+            exercise date.
+
+            \pre the regenerator must pass the same paths on every
+                 call; this is checked on the exercise values.
+
+            \note post_processing() is not called in this mode.
+
+            \warning solving the normal equations squares the
+                     condition number of the regression compared with
+                     the least-squares fit on the stored paths, so
+                     that badly conditioned basis systems, e.g.
+                     high-order monomials of unscaled states, lose
+                     accuracy.
+        */
+        void calibrate(const PathRegenerator& regenerate);
 
         Real exerciseProbability() const;
 
@@ -68,6 +96,8 @@ namespace QuantLib {
                                      const std::vector<StateType> &state,
                                      const std::vector<Real> &price,
                                      const std::vector<Real> &exercise) {}
+        Real continuationValue(const StateType& state, Size i) const;
+
         bool  calibrationPhase_;
         const ext::shared_ptr<EarlyExercisePathPricer<PathType> >
             pathPricer_;
@@ -120,12 +150,7 @@ namespace QuantLib {
             if (exercise > 0.0) {
                 const StateType regValue = pathPricer_->state(path, i);
 
-                Real continuationValue = 0.0;
-                for (Size l=0; l<v_.size(); ++l) {
-                    continuationValue += coeff_[i-1][l] * v_[l](regValue);
-                }
-
-                if (continuationValue < exercise) {
+                if (continuationValue(regValue, i) < exercise) {
                     price = exercise;
 
                     // Exercised
@@ -205,6 +230,98 @@ namespace QuantLib {
         calibrationPhase_ = false;
     }
 
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::calibrate(
+                                        const PathRegenerator& regenerate) {
+        const Size m = v_.size();
+        Matrix A(m, m);
+        Array b(m), basis(m);
+
+        // discount factors from the first time of the grid
+        std::vector<DiscountFactor> discount(len_, 1.0);
+        for (Size k=1; k<len_; ++k)
+            discount[k] = discount[k-1]*dF_[k-1];
+
+        // exercise date of the calibrated strategy for every path
+        std::vector<Size> exerciseIndex;
+        // exercise value at the date of the previous pass, used to
+        // check that the same paths are regenerated
+        std::vector<Real> previousValue;
+
+        for (Size i=len_-2; i>0; --i) {
+            std::fill(A.begin(), A.end(), 0.0);
+            std::fill(b.begin(), b.end(), 0.0);
+            Size itm = 0, j = 0;
+
+            regenerate([&](const PathType& path) {
+                const Real value = (*pathPricer_)(path, i);
+                if (i == len_-2) {
+                    exerciseIndex.push_back(len_-1);
+                    previousValue.push_back(value);
+                } else {
+                    QL_REQUIRE(j < exerciseIndex.size(),
+                               "inconsistent number of regenerated paths");
+                    // apply the decision calibrated at the previous date
+                    const Real exercise = (*pathPricer_)(path, i+1);
+                    QL_REQUIRE(close_enough(exercise, previousValue[j]),
+                               "regenerated path " << j
+                               << " differs from the previous pass");
+                    previousValue[j] = value;
+                    if (exercise > 0.0
+                        && continuationValue(
+                               pathPricer_->state(path, i+1), i+1)
+                            < exercise)
+                        exerciseIndex[j] = i+1;
+                }
+
+                if (value > 0.0) {
+                    const StateType regValue = pathPricer_->state(path, i);
+                    for (Size l=0; l<m; ++l)
+                        basis[l] = v_[l](regValue);
+
+                    const Size k = exerciseIndex[j];
+                    const Real y = (*pathPricer_)(path, k)
+                        * discount[k]/discount[i];
+                    for (Size r=0; r<m; ++r) {
+                        for (Size l=r; l<m; ++l)
+                            A[r][l] += basis[r]*basis[l];
+                        b[r] += basis[r]*y;
+                    }
+                    ++itm;
+                }
+                ++j;
+            });
+
+            QL_REQUIRE(j == exerciseIndex.size(),
+                       "inconsistent number of regenerated paths");
+
+            if (m <= itm) {
+                for (Size k=0; k<m; ++k)
+                    for (Size l=0; l<k; ++l)
+                        A[k][l] = A[l][k];
+                coeff_[i-1] = SVD(A).solveFor(b);
+            }
+            else {
+            // if number of itm paths is smaller then the number of
+            // calibration functions then early exercise if exerciseValue > 0
+                coeff_[i-1] = Array(m, 0.0);
+            }
+        }
+
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
+
+    template <class PathType> inline
+    Real LongstaffSchwartzPathPricer<PathType>::continuationValue(
+                                    const StateType& state, Size i) const {
+        Real value = 0.0;
+        for (Size l=0; l<v_.size(); ++l) {
+            value += coeff_[i-1][l] * v_[l](state);
+        }
+        return value;
+    }
+
     template <class PathType> inline
     Real LongstaffSchwartzPathPricer<PathType>::exerciseProbability() const {
         return exerciseProbability_.mean();
@@ -75,6 +75,16 @@ namespace QuantLib {
             isControlVariate_ = static_cast<bool>(cvPathPricer_);
         }
         void addSamples(Size samples);
+        /*! adds samples simulated elsewhere (e.g., by the models
+            of a block-parallel simulation) and stored as a sequence
+            of (value, weight) pairs.
+        */
+        template <class Iterator>
+        void addSamples(Iterator begin, Iterator end);
+        /*! adds the samples collected by another accumulator; the
+            statistics class must provide a merge() method.
+        */
+        void mergeSamples(const stats_type& samples);
         const stats_type& sampleAccumulator() const;
       private:
         ext::shared_ptr<path_generator_type> pathGenerator_;
@@ -124,6 +134,20 @@ namespace QuantLib {
         }
     }
 
+    template <template <class> class MC, class RNG, class S>
+    template <class Iterator>
+    inline void MonteCarloModel<MC,RNG,S>::addSamples(Iterator begin,
+                                                      Iterator end) {
+        for (; begin != end; ++begin)
+            sampleAccumulator_.add(begin->first, begin->second);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::mergeSamples(
+                                                const stats_type& samples) {
+        sampleAccumulator_.merge(samples);
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline const typename MonteCarloModel<MC,RNG,S>::stats_type&
     MonteCarloModel<MC,RNG,S>::sampleAccumulator() const {
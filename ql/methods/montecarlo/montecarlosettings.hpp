@@ -0,0 +1,59 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file montecarlosettings.hpp
+    \brief global settings for Monte Carlo simulations
+*/
+
+#ifndef quantlib_montecarlo_settings_hpp
+#define quantlib_montecarlo_settings_hpp
+
+#include <ql/patterns/singleton.hpp>
+#include <ql/types.hpp>
+
+namespace QuantLib {
+
+    //! global settings for Monte Carlo simulations
+    /*! When samplesPerBlock() is not null, engines deriving from
+        McSimulation split the requested samples in blocks of the
+        given size.  Each block is simulated with its own path
+        generator and pricer on an independent random stream (see
+        RandomStreamSelector) and blocks are run in parallel when
+        QuantLib is compiled with OpenMP support.  The results only
+        depend on the block size and not on the number of threads;
+        for low-discrepancy sequences and counter-based generators
+        such as PhiloxUniformRng, they also match the ones of the
+        serial simulation.
+
+        \ingroup mcarlo
+    */
+    class MonteCarloSettings : public Singleton<MonteCarloSettings> {
+        friend class Singleton<MonteCarloSettings>;
+      private:
+        MonteCarloSettings() = default;
+      public:
+        //! number of samples in each block, or 0 for serial simulation
+        Size& samplesPerBlock() { return samplesPerBlock_; }
+        Size samplesPerBlock() const { return samplesPerBlock_; }
+      private:
+        Size samplesPerBlock_ = 0;
+    };
+
+}
+
+
+#endif
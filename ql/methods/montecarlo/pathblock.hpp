@@ -0,0 +1,90 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathblock.hpp
+    \brief block of single-factor random walks
+*/
+
+#ifndef quantlib_montecarlo_path_block_hpp
+#define quantlib_montecarlo_path_block_hpp
+
+#include <ql/errors.hpp>
+#include <ql/timegrid.hpp>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! block of single-factor random walks
+    /*! The paths are stored in structure-of-arrays, time-major
+        layout: the values of all the paths at a given time of the
+        grid are contiguous in memory.  This allows block pricers to
+        process all the paths with simple loops which compilers can
+        vectorize.
+
+        \ingroup mcarlo
+
+        \note as for Path, each path includes the initial asset value
+              as its first point.
+    */
+    class PathBlock {
+      public:
+        PathBlock(TimeGrid timeGrid, Size capacity)
+        : timeGrid_(std::move(timeGrid)), capacity_(capacity), size_(0),
+          values_(timeGrid_.size()*capacity), weights_(capacity, 1.0) {
+            QL_REQUIRE(capacity_ > 0, "null block capacity");
+        }
+        //! \name inspectors
+        //@{
+        //! number of paths currently in the block
+        Size size() const { return size_; }
+        //! maximum number of paths in the block
+        Size capacity() const { return capacity_; }
+        //! number of points in each path
+        Size length() const { return timeGrid_.size(); }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //! values of all the paths at the i-th time of the grid
+        const Real* values(Size i) const { return &values_[i*capacity_]; }
+        //! value of the j-th path at the i-th time of the grid
+        Real operator()(Size i, Size j) const {
+            return values_[i*capacity_+j];
+        }
+        //! weights of the paths
+        const Real* weights() const { return &weights_[0]; }
+        //@}
+        //! \name modifiers
+        //@{
+        Real* values(Size i) { return &values_[i*capacity_]; }
+        Real& operator()(Size i, Size j) { return values_[i*capacity_+j]; }
+        Real* weights() { return &weights_[0]; }
+        void resize(Size paths) {
+            QL_REQUIRE(paths <= capacity_,
+                       "number of paths (" << paths
+                       << ") exceeds block capacity (" << capacity_ << ")");
+            size_ = paths;
+        }
+        //@}
+      private:
+        TimeGrid timeGrid_;
+        Size capacity_, size_;
+        std::vector<Real> values_, weights_;
+    };
+
+}
+
+
+#endif
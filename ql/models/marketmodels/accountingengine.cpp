@@ -18,6 +18,7 @@
 */
 
 #include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/blocksimulation.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/evolutiondescription.hpp>
@@ -119,4 +120,54 @@ namespace QuantLib {
         }
     }
 
+
+    ParallelAccountingEngine::ParallelAccountingEngine(
+                              EvolverFactory evolverFactory,
+                              const Clone<MarketModelMultiProduct>& product,
+                              Real initialNumeraireValue,
+                              Size pathsPerBlock)
+    : evolverFactory_(std::move(evolverFactory)), product_(product),
+      initialNumeraireValue_(initialNumeraireValue),
+      pathsPerBlock_(pathsPerBlock), simulatedPaths_(0) {
+        QL_REQUIRE(pathsPerBlock_ > 0, "null number of paths per block");
+    }
+
+    void ParallelAccountingEngine::multiplePathValues(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths) {
+        detail::simulateInBlocks(
+            simulatedPaths_, numberOfPaths, pathsPerBlock_,
+            [&]() {
+                return ext::make_shared<
+                    detail::PathValuesBlock<AccountingEngine> >(
+                        ext::make_shared<AccountingEngine>(
+                            evolverFactory_(), product_,
+                            initialNumeraireValue_),
+                        product_->numberOfProducts());
+            },
+            [&](const detail::PathValuesBlock<AccountingEngine>& block) {
+                block.addTo(stats);
+            });
+        simulatedPaths_ += numberOfPaths;
+    }
+
+    void ParallelAccountingEngine::multiplePathValues(
+                                          SequenceStatisticsMergeable& stats,
+                                          Size numberOfPaths) {
+        typedef detail::PathStatisticsBlock<AccountingEngine> block;
+        detail::simulateInBlocks(
+            simulatedPaths_, numberOfPaths, pathsPerBlock_,
+            [&]() {
+                return ext::make_shared<block>(
+                    ext::make_shared<AccountingEngine>(
+                        evolverFactory_(), product_,
+                        initialNumeraireValue_),
+                    product_->numberOfProducts());
+            },
+            [&](const block& b) {
+                b.mergeInto(stats);
+            });
+        simulatedPaths_ += numberOfPaths;
+    }
+
 }
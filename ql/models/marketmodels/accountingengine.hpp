@@ -28,6 +28,7 @@
 #include <ql/math/statistics/sequencestatistics.hpp>
 
 #include <ql/utilities/clone.hpp>
+#include <ql/functional.hpp>
 #include <ql/types.hpp>
 #include <vector>
 
@@ -48,9 +49,9 @@ namespace QuantLib {
                          Real initialNumeraireValue);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
-      private:
+        //! simulates a path and returns its weight
         Real singlePathValues(std::vector<Real>& values);
-
+      private:
         ext::shared_ptr<MarketModelEvolver> evolver_;
         Clone<MarketModelMultiProduct> product_;
 
@@ -66,6 +67,52 @@ namespace QuantLib {
 
     };
 
+    //! Accounting engine simulating blocks of paths in parallel
+    /*! Each block of paths is simulated by an AccountingEngine with
+        its own copy of the product and its own evolver, built by
+        the given factory while RandomStreamSelector selects the
+        stream starting at the first path of the block.  The
+        Brownian-generator factories position the generators on
+        the selected stream; thus, with SobolBrownianGeneratorFactory
+        the results are the same as those of the serial engine,
+        while with MTBrownianGeneratorFactory they depend on the
+        block size but not on the number of threads.
+
+        Blocks are run in parallel when QuantLib is compiled with
+        OpenMP support; the path values are then added to the
+        statistics in the same order as in a serial simulation.
+
+        \warning the evolvers returned by the factory must not share
+                 any mutable state.
+    */
+    class ParallelAccountingEngine {
+      public:
+        typedef ext::function<ext::shared_ptr<MarketModelEvolver>()>
+            EvolverFactory;
+        ParallelAccountingEngine(EvolverFactory evolverFactory,
+                                 const Clone<MarketModelMultiProduct>& product,
+                                 Real initialNumeraireValue,
+                                 Size pathsPerBlock);
+        /*! The values of each block of paths are stored until
+            they can be added to the statistics in order, since
+            SequenceStatisticsInc can't be merged.
+        */
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+        /*! Each block of paths is collected into its own statistics,
+            which are merged in order; the path values are not
+            stored.
+        */
+        void multiplePathValues(SequenceStatisticsMergeable& stats,
+                                Size numberOfPaths);
+      private:
+        EvolverFactory evolverFactory_;
+        Clone<MarketModelMultiProduct> product_;
+        Real initialNumeraireValue_;
+        Size pathsPerBlock_;
+        Size simulatedPaths_;
+    };
+
 }
 
 #endif
@@ -0,0 +1,175 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file blocksimulation.hpp
+    \brief parallel simulation of blocks of market-model paths
+*/
+
+#ifndef quantlib_market_model_block_simulation_hpp
+#define quantlib_market_model_block_simulation_hpp
+
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace QuantLib {
+
+    namespace detail {
+
+        /* Simulates the given number of paths in blocks of the given
+           size.  For each block, makeBlock() is called on the calling
+           thread while RandomStreamSelector selects the stream
+           starting at its first path, so that the Brownian generators
+           created by its evolvers are positioned accordingly; the
+           offset of the first block is the number of paths simulated
+           before.  The blocks are then asked to simulate(n) their
+           paths, concurrently if QuantLib is compiled with OpenMP
+           support, and are passed to mergeBlock() in their order.
+
+           As in McSimulation, the first block is simulated before
+           the others are started, and the results only depend on the
+           block size and not on the number of threads.
+        */
+        template <class MakeBlock, class MergeBlock>
+        void simulateInBlocks(Size offset,
+                              Size paths,
+                              Size pathsPerBlock,
+                              const MakeBlock& makeBlock,
+                              const MergeBlock& mergeBlock) {
+            QL_REQUIRE(pathsPerBlock > 0, "null number of paths per block");
+            typedef decltype(makeBlock()) block_type;
+
+            #ifdef _OPENMP
+            const Size blocksPerBatch = 4*Size(omp_get_max_threads());
+            #else
+            const Size blocksPerBatch = 1;
+            #endif
+
+            bool firstBatch = true;
+            while (paths > 0) {
+                std::vector<block_type> blocks;
+                std::vector<Size> sizes;
+                while (paths > 0 && sizes.size() < blocksPerBatch) {
+                    Size n = std::min(paths, pathsPerBlock);
+                    RandomStreamSelector stream(offset);
+                    blocks.push_back(makeBlock());
+                    sizes.push_back(n);
+                    offset += n;
+                    paths -= n;
+                }
+
+                Size first = 0;
+                if (firstBatch) {
+                    blocks[0]->simulate(sizes[0]);
+                    first = 1;
+                    firstBatch = false;
+                }
+                std::vector<std::string> errors(sizes.size());
+                #ifdef _OPENMP
+                #pragma omp parallel for schedule(dynamic)
+                #endif
+                for (long i=long(first); i<long(sizes.size()); ++i) {
+                    try {
+                        blocks[i]->simulate(sizes[i]);
+                    } catch (std::exception& e) {
+                        errors[i] = e.what();
+                    } catch (...) {
+                        errors[i] = "unknown error";
+                    }
+                }
+
+                for (Size i=0; i<sizes.size(); ++i) {
+                    QL_REQUIRE(errors[i].empty(),
+                               "error in market-model block: " << errors[i]);
+                    mergeBlock(*blocks[i]);
+                }
+            }
+        }
+
+        /* Block storing the values and weights of the paths
+           simulated by an accounting engine, so that they can be
+           added to the statistics in the order of simulation.  This
+           is needed by statistics that can't be merged, such as
+           SequenceStatisticsInc; the storage is released after each
+           batch of blocks, so it grows with the block size and the
+           number of threads but not with the number of paths. */
+        template <class Engine>
+        class PathValuesBlock {
+          public:
+            PathValuesBlock(ext::shared_ptr<Engine> engine,
+                            Size numberOfValues)
+            : engine_(std::move(engine)), numberOfValues_(numberOfValues) {}
+            void simulate(Size paths) {
+                values_.resize(paths*numberOfValues_);
+                weights_.resize(paths);
+                std::vector<Real> values(numberOfValues_);
+                for (Size i=0; i<paths; ++i) {
+                    weights_[i] = engine_->singlePathValues(values);
+                    std::copy(values.begin(), values.end(),
+                              values_.begin() + i*numberOfValues_);
+                }
+            }
+            void addTo(SequenceStatisticsInc& stats) const {
+                for (Size i=0; i<weights_.size(); ++i) {
+                    std::vector<Real>::const_iterator v =
+                        values_.begin() + i*numberOfValues_;
+                    stats.add(v, v+numberOfValues_, weights_[i]);
+                }
+            }
+          private:
+            ext::shared_ptr<Engine> engine_;
+            Size numberOfValues_;
+            std::vector<Real> values_, weights_;
+        };
+
+        /* Block collecting the values of the paths simulated by an
+           accounting engine into its own statistics, which are then
+           merged; the paths are not stored. */
+        template <class Engine>
+        class PathStatisticsBlock {
+          public:
+            PathStatisticsBlock(ext::shared_ptr<Engine> engine,
+                                Size numberOfValues)
+            : engine_(std::move(engine)), stats_(numberOfValues) {}
+            void simulate(Size paths) {
+                std::vector<Real> values(stats_.size());
+                for (Size i=0; i<paths; ++i) {
+                    Real weight = engine_->singlePathValues(values);
+                    stats_.add(values, weight);
+                }
+            }
+            void mergeInto(SequenceStatisticsMergeable& stats) const {
+                stats.merge(stats_);
+            }
+          private:
+            ext::shared_ptr<Engine> engine_;
+            SequenceStatisticsMergeable stats_;
+        };
+
+    }
+
+}
+
+
+#endif
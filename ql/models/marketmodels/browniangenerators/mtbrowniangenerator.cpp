@@ -18,6 +18,7 @@
 */
 
 #include <ql/models/marketmodels/browniangenerators/mtbrowniangenerator.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
 #include <algorithm>
 
 namespace QuantLib {
@@ -64,7 +65,10 @@ namespace QuantLib {
     ext::shared_ptr<BrownianGenerator>
     MTBrownianGeneratorFactory::create(Size factors, Size steps) const {
         return ext::shared_ptr<BrownianGenerator>(
-                              new MTBrownianGenerator(factors, steps, seed_));
+                new MTBrownianGenerator(
+                    factors, steps,
+                    RandomStreamSelector::seed(
+                        seed_, RandomStreamSelector::offset())));
     }
 
 }
@@ -18,6 +18,7 @@
 */
 
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
 #include <boost/iterator/permutation_iterator.hpp>
 
 namespace QuantLib {
@@ -114,7 +115,7 @@ namespace QuantLib {
                                         unsigned long seed,
                                         SobolRsg::DirectionIntegers integers)
     : factors_(factors), steps_(steps), ordering_(ordering),
-      generator_(SobolRsg(factors*steps, seed, integers),
+      generator_(SobolBlockRsg(factors*steps, seed, integers),
                  InverseCumulativeNormal()),
       bridge_(steps), lastStep_(0),
       orderedIndices_(factors, std::vector<Size>(steps)),
@@ -137,7 +138,7 @@ namespace QuantLib {
 
 
     Real SobolBrownianGenerator::nextPath() {
-        typedef InverseCumulativeRsg<SobolRsg,
+        typedef InverseCumulativeRsg<SobolBlockRsg,
                                      InverseCumulativeNormal>::sample_type
             sample_type;
 
@@ -208,6 +209,10 @@ namespace QuantLib {
 
     Size SobolBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    void SobolBrownianGenerator::skipTo(boost::uint_least32_t n) {
+        generator_.skipTo(n);
+    }
+
 
 
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
@@ -218,9 +223,13 @@ namespace QuantLib {
 
     ext::shared_ptr<BrownianGenerator>
     SobolBrownianGeneratorFactory::create(Size factors, Size steps) const {
-        return ext::shared_ptr<BrownianGenerator>(
+        ext::shared_ptr<SobolBrownianGenerator> g(
                          new SobolBrownianGenerator(factors, steps, ordering_,
                                                     seed_, integers_));
+        BigNatural offset = RandomStreamSelector::offset();
+        if (offset != 0)
+            g->skipTo(boost::uint_least32_t(offset));
+        return g;
     }
 
 }
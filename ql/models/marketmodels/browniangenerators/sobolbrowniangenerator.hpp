@@ -23,7 +23,7 @@
 
 #include <ql/models/marketmodels/browniangenerator.hpp>
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
-#include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/sobolblockrsg.hpp>
 #include <ql/methods/montecarlo/brownianbridge.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <vector>
@@ -60,6 +60,9 @@ namespace QuantLib {
         Size numberOfFactors() const override;
         Size numberOfSteps() const override;
 
+        //! skips to the n-th path of the underlying Sobol sequence
+        void skipTo(boost::uint_least32_t n);
+
         // test interface
         const std::vector<std::vector<Size> >& orderedIndices() const;
         std::vector<std::vector<Real> > transform(
@@ -68,7 +71,7 @@ namespace QuantLib {
       private:
         Size factors_, steps_;
         Ordering ordering_;
-        InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal> generator_;
+        InverseCumulativeRsg<SobolBlockRsg,InverseCumulativeNormal> generator_;
         BrownianBridge bridge_;
         // work variables
         Size lastStep_;
@@ -76,6 +79,11 @@ namespace QuantLib {
         std::vector<std::vector<Real> > bridgedVariates_;
     };
 
+    /*! The generators are positioned on the path selected by
+        RandomStreamSelector, if any, so that blocks of paths can be
+        simulated separately and still use the same points that a
+        single generator would return.
+    */
     class SobolBrownianGeneratorFactory : public BrownianGeneratorFactory {
       public:
         SobolBrownianGeneratorFactory(
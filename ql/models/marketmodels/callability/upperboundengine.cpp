@@ -20,6 +20,7 @@
 
 #include <ql/auto_ptr.hpp>
 #include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/blocksimulation.hpp>
 #include <ql/models/marketmodels/callability/exercisevalue.hpp>
 #include <ql/models/marketmodels/callability/upperboundengine.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
@@ -345,5 +346,75 @@ namespace QuantLib {
         return numeraireUnits/principalInNumerairePortfolio;
     }
 
-}
 
+    namespace {
+
+        class UpperBoundBlock {
+          public:
+            UpperBoundBlock(ext::shared_ptr<UpperBoundEngine> engine,
+                            Size innerPaths)
+            : engine_(std::move(engine)), innerPaths_(innerPaths) {}
+            void simulate(Size outerPaths) {
+                engine_->multiplePathValues(stats_, outerPaths,
+                                            innerPaths_);
+            }
+            const Statistics& statistics() const { return stats_; }
+          private:
+            ext::shared_ptr<UpperBoundEngine> engine_;
+            Size innerPaths_;
+            Statistics stats_;
+        };
+
+    }
+
+
+    ParallelUpperBoundEngine::ParallelUpperBoundEngine(
+        EvolverFactory evolverFactory,
+        InnerEvolversFactory innerEvolversFactory,
+        const Clone<MarketModelMultiProduct>& underlying,
+        const Clone<MarketModelExerciseValue>& rebate,
+        const Clone<MarketModelMultiProduct>& hedge,
+        const Clone<MarketModelExerciseValue>& hedgeRebate,
+        const Clone<ExerciseStrategy<CurveState> >& hedgeStrategy,
+        Real initialNumeraireValue,
+        Size outerPathsPerBlock)
+    : evolverFactory_(std::move(evolverFactory)),
+      innerEvolversFactory_(std::move(innerEvolversFactory)),
+      underlying_(underlying), rebate_(rebate), hedge_(hedge),
+      hedgeRebate_(hedgeRebate), hedgeStrategy_(hedgeStrategy),
+      initialNumeraireValue_(initialNumeraireValue),
+      outerPathsPerBlock_(outerPathsPerBlock), simulatedPaths_(0) {
+        QL_REQUIRE(outerPathsPerBlock_ > 0,
+                   "null number of outer paths per block");
+    }
+
+    void ParallelUpperBoundEngine::multiplePathValues(Statistics& stats,
+                                                      Size outerPaths,
+                                                      Size innerPaths) {
+        detail::simulateInBlocks(
+            simulatedPaths_, outerPaths, outerPathsPerBlock_,
+            [&]() {
+                ext::shared_ptr<MarketModelEvolver> evolver =
+                    evolverFactory_();
+                // each outer path runs the given number of paths on
+                // each inner evolver
+                std::vector<ext::shared_ptr<MarketModelEvolver> > inner;
+                {
+                    RandomStreamSelector innerStream(
+                        RandomStreamSelector::offset() * innerPaths);
+                    inner = innerEvolversFactory_();
+                }
+                return ext::make_shared<UpperBoundBlock>(
+                    ext::make_shared<UpperBoundEngine>(
+                        evolver, inner, *underlying_, *rebate_, *hedge_,
+                        *hedgeRebate_, *hedgeStrategy_,
+                        initialNumeraireValue_),
+                    innerPaths);
+            },
+            [&](const UpperBoundBlock& block) {
+                stats.merge(block.statistics());
+            });
+        simulatedPaths_ += outerPaths;
+    }
+
+}
@@ -26,6 +26,7 @@
 #include <ql/methods/montecarlo/exercisestrategy.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/utilities/clone.hpp>
+#include <ql/functional.hpp>
 #include <utility>
 #include <valarray>
 
@@ -78,6 +79,55 @@ namespace QuantLib {
         std::vector<MarketModelDiscounter> discounters_;
     };
 
+
+    //! Upper-bound %engine simulating blocks of outer paths in parallel
+    /*! Each block of outer paths is simulated by an UpperBoundEngine
+        with its own copies of the products and its own outer and
+        inner evolvers, built by the given factories.  The outer
+        evolvers are built while RandomStreamSelector selects the
+        stream starting at the first outer path of the block, and the
+        inner ones while it selects the stream starting at the first
+        inner path it will simulate; the statistics of the blocks are
+        then merged in order.
+
+        With Brownian generators supporting skip-ahead (e.g., the one
+        built by SobolBrownianGeneratorFactory) the results are the
+        same as the ones of a serial UpperBoundEngine using evolvers
+        built by the same factories.
+    */
+    class ParallelUpperBoundEngine {
+      public:
+        typedef ext::function<ext::shared_ptr<MarketModelEvolver>()>
+            EvolverFactory;
+        typedef ext::function<
+            std::vector<ext::shared_ptr<MarketModelEvolver> >()>
+            InnerEvolversFactory;
+        ParallelUpperBoundEngine(
+            EvolverFactory evolverFactory,
+            InnerEvolversFactory innerEvolversFactory,
+            const Clone<MarketModelMultiProduct>& underlying,
+            const Clone<MarketModelExerciseValue>& rebate,
+            const Clone<MarketModelMultiProduct>& hedge,
+            const Clone<MarketModelExerciseValue>& hedgeRebate,
+            const Clone<ExerciseStrategy<CurveState> >& hedgeStrategy,
+            Real initialNumeraireValue,
+            Size outerPathsPerBlock);
+        void multiplePathValues(Statistics& stats,
+                                Size outerPaths,
+                                Size innerPaths);
+      private:
+        EvolverFactory evolverFactory_;
+        InnerEvolversFactory innerEvolversFactory_;
+        Clone<MarketModelMultiProduct> underlying_;
+        Clone<MarketModelExerciseValue> rebate_;
+        Clone<MarketModelMultiProduct> hedge_;
+        Clone<MarketModelExerciseValue> hedgeRebate_;
+        Clone<ExerciseStrategy<CurveState> > hedgeStrategy_;
+        Real initialNumeraireValue_;
+        Size outerPathsPerBlock_;
+        Size simulatedPaths_;
+    };
+
 }
 
 #endif
@@ -23,6 +23,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeuler.hpp>
 #include <ql/models/marketmodels/marketmodel.hpp>
 #include <ql/models/marketmodels/pathwiseaccountingengine.hpp>
+#include <ql/models/marketmodels/blocksimulation.hpp>
 #include <algorithm>
 #include <utility>
 
@@ -320,6 +321,62 @@ namespace QuantLib {
         }
     }
 
+
+    ParallelPathwiseAccountingEngine::ParallelPathwiseAccountingEngine(
+        EvolverFactory evolverFactory,
+        const Clone<MarketModelPathwiseMultiProduct>& product,
+        ext::shared_ptr<MarketModel> pseudoRootStructure,
+        Real initialNumeraireValue,
+        Size pathsPerBlock)
+    : evolverFactory_(std::move(evolverFactory)), product_(product),
+      pseudoRootStructure_(std::move(pseudoRootStructure)),
+      initialNumeraireValue_(initialNumeraireValue),
+      pathsPerBlock_(pathsPerBlock), simulatedPaths_(0) {
+        QL_REQUIRE(pathsPerBlock_ > 0, "null number of paths per block");
+    }
+
+    void ParallelPathwiseAccountingEngine::multiplePathValues(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths) {
+        typedef detail::PathValuesBlock<PathwiseAccountingEngine> block;
+        const Size numberOfValues = product_->numberOfProducts() *
+            (pseudoRootStructure_->numberOfRates() + 1);
+        detail::simulateInBlocks(
+            simulatedPaths_, numberOfPaths, pathsPerBlock_,
+            [&]() {
+                return ext::make_shared<block>(
+                    ext::make_shared<PathwiseAccountingEngine>(
+                        evolverFactory_(), product_, pseudoRootStructure_,
+                        initialNumeraireValue_),
+                    numberOfValues);
+            },
+            [&](const block& b) {
+                b.addTo(stats);
+            });
+        simulatedPaths_ += numberOfPaths;
+    }
+
+    void ParallelPathwiseAccountingEngine::multiplePathValues(
+                                          SequenceStatisticsMergeable& stats,
+                                          Size numberOfPaths) {
+        typedef detail::PathStatisticsBlock<PathwiseAccountingEngine> block;
+        const Size numberOfValues = product_->numberOfProducts() *
+            (pseudoRootStructure_->numberOfRates() + 1);
+        detail::simulateInBlocks(
+            simulatedPaths_, numberOfPaths, pathsPerBlock_,
+            [&]() {
+                return ext::make_shared<block>(
+                    ext::make_shared<PathwiseAccountingEngine>(
+                        evolverFactory_(), product_, pseudoRootStructure_,
+                        initialNumeraireValue_),
+                    numberOfValues);
+            },
+            [&](const block& b) {
+                b.mergeInto(stats);
+            });
+        simulatedPaths_ += numberOfPaths;
+    }
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
  
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -28,6 +28,7 @@
 #include <ql/models/marketmodels/pathwisegreeks/ratepseudorootjacobian.hpp>
 
 #include <ql/utilities/clone.hpp>
+#include <ql/functional.hpp>
 #include <ql/types.hpp>
 #include <vector>
 
@@ -53,9 +54,9 @@ namespace QuantLib {
 
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
+        //! simulates a path and returns its weight
+        Real singlePathValues(std::vector<Real>& values);
       private:
-          Real singlePathValues(std::vector<Real>& values);
-
         ext::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
         ext::shared_ptr<MarketModel> pseudoRootStructure_;
@@ -100,6 +101,38 @@ namespace QuantLib {
     };
 
 
+    //! Pathwise accounting engine simulating blocks of paths in parallel
+    /*! Each block of paths is simulated by a PathwiseAccountingEngine
+        with its own copy of the product and its own evolver, built
+        by the given factory; see ParallelAccountingEngine for the
+        selection of the random streams.
+    */
+    class ParallelPathwiseAccountingEngine {
+      public:
+        typedef ext::function<ext::shared_ptr<LogNormalFwdRateEuler>()>
+            EvolverFactory;
+        ParallelPathwiseAccountingEngine(
+            EvolverFactory evolverFactory,
+            const Clone<MarketModelPathwiseMultiProduct>& product,
+            ext::shared_ptr<MarketModel> pseudoRootStructure,
+            Real initialNumeraireValue,
+            Size pathsPerBlock);
+        //! see ParallelAccountingEngine::multiplePathValues
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+        //! see ParallelAccountingEngine::multiplePathValues
+        void multiplePathValues(SequenceStatisticsMergeable& stats,
+                                Size numberOfPaths);
+      private:
+        EvolverFactory evolverFactory_;
+        Clone<MarketModelPathwiseMultiProduct> product_;
+        ext::shared_ptr<MarketModel> pseudoRootStructure_;
+        Real initialNumeraireValue_;
+        Size pathsPerBlock_;
+        Size simulatedPaths_;
+    };
+
+
    //! Engine collecting cash flows along a market-model simulation for doing pathwise computation of Deltas and vegas
     // using Giles--Glasserman smoking adjoints method
     // note only works with displaced LMM, 
@@ -0,0 +1,317 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/patterns/dependencyprofiler.hpp>
+#include <ql/patterns/observable.hpp>
+#include <boost/core/demangle.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <typeindex>
+
+namespace QuantLib {
+
+    namespace {
+
+        double now() {
+            return std::chrono::duration<double>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // innermost running timer in the current thread
+        thread_local DependencyProfiler::Timer* currentTimer = nullptr;
+
+        std::string escaped(const std::string& s) {
+            std::string result;
+            for (char c : s) {
+                if (c == '"' || c == '\\')
+                    result += '\\';
+                result += c;
+            }
+            return result;
+        }
+
+    }
+
+    class DependencyProfiler::Data {
+      public:
+        struct Counters {
+            Size updates = 0, calculations = 0;
+            double updateTime = 0.0, calculationTime = 0.0, selfTime = 0.0;
+        };
+        std::mutex mutex;
+        std::map<std::type_index, Counters> types;
+        std::map<const Observer*, Counters> objects;
+        std::map<const Observer*, std::set<const Observable*> > observed;
+        std::map<const Observable*, std::set<const Observer*> > observers;
+    };
+
+    DependencyProfiler::DependencyProfiler() : data_(new Data) {}
+
+    void DependencyProfiler::enable() {
+        #if defined(QL_ENABLE_DEPENDENCY_PROFILING)
+        enabled_ = true;
+        #else
+        QL_FAIL("dependency profiling not available");
+        #endif
+    }
+
+    void DependencyProfiler::reset() {
+        std::lock_guard<std::mutex> lock(data_->mutex);
+        data_->types.clear();
+        data_->objects.clear();
+    }
+
+
+    DependencyProfiler::Timer::Timer(Event event, const Observer* observer)
+    : event_(event),
+      observer_(DependencyProfiler::instance().enabled() ? observer : nullptr) {
+        if (observer_ != nullptr) {
+            // the observer might be destroyed during its update
+            type_ = &typeid(*observer_);
+            parent_ = currentTimer;
+            currentTimer = this;
+            start_ = now();
+        }
+    }
+
+    DependencyProfiler::Timer::~Timer() {
+        if (observer_ != nullptr) {
+            double time = now() - start_;
+            currentTimer = parent_;
+            if (parent_ != nullptr)
+                parent_->nested_ += time;
+            DependencyProfiler::instance().record(event_, observer_, *type_,
+                                                  time, time - nested_);
+        }
+    }
+
+    void DependencyProfiler::record(Event event, const Observer* observer,
+                                    const std::type_info& type,
+                                    double time, double selfTime) {
+        std::lock_guard<std::mutex> lock(data_->mutex);
+        Data::Counters& byType = data_->types[std::type_index(type)];
+        Data::Counters& byObject = data_->objects[observer];
+        for (Data::Counters* c : {&byType, &byObject}) {
+            if (event == Update) {
+                ++c->updates;
+                c->updateTime += time;
+            } else {
+                ++c->calculations;
+                c->calculationTime += time;
+            }
+            c->selfTime += selfTime;
+        }
+    }
+
+
+    void DependencyProfiler::registerDependency(const Observable* observable,
+                                                const Observer* observer) {
+        if (!enabled_ || observable == nullptr)
+            return;
+        std::lock_guard<std::mutex> lock(data_->mutex);
+        data_->observed[observer].insert(observable);
+        data_->observers[observable].insert(observer);
+    }
+
+    void DependencyProfiler::unregisterDependency(
+                                              const Observable* observable,
+                                              const Observer* observer) {
+        std::lock_guard<std::mutex> lock(data_->mutex);
+        auto i = data_->observed.find(observer);
+        if (i == data_->observed.end())
+            return;
+        i->second.erase(observable);
+        if (i->second.empty())
+            data_->observed.erase(i);
+        auto j = data_->observers.find(observable);
+        if (j != data_->observers.end()) {
+            j->second.erase(observer);
+            if (j->second.empty())
+                data_->observers.erase(j);
+        }
+    }
+
+    void DependencyProfiler::unregisterObserver(const Observer* observer) {
+        std::lock_guard<std::mutex> lock(data_->mutex);
+        // the counters of the type are kept; the ones of the object
+        // are removed, since the address might be reused
+        data_->objects.erase(observer);
+        auto i = data_->observed.find(observer);
+        if (i == data_->observed.end())
+            return;
+        for (const Observable* observable : i->second) {
+            auto j = data_->observers.find(observable);
+            if (j != data_->observers.end()) {
+                j->second.erase(observer);
+                if (j->second.empty())
+                    data_->observers.erase(j);
+            }
+        }
+        data_->observed.erase(i);
+    }
+
+    void DependencyProfiler::unregisterObservable(
+                                              const Observable* observable) {
+        std::lock_guard<std::mutex> lock(data_->mutex);
+        auto j = data_->observers.find(observable);
+        if (j == data_->observers.end())
+            return;
+        for (const Observer* observer : j->second) {
+            auto i = data_->observed.find(observer);
+            if (i != data_->observed.end()) {
+                i->second.erase(observable);
+                if (i->second.empty())
+                    data_->observed.erase(i);
+            }
+        }
+        data_->observers.erase(j);
+    }
+
+
+    std::vector<DependencyProfiler::Statistics>
+    DependencyProfiler::statistics() const {
+        std::vector<Statistics> results;
+        {
+            std::lock_guard<std::mutex> lock(data_->mutex);
+            for (const auto& t : data_->types) {
+                Statistics s;
+                s.type = boost::core::demangle(t.first.name());
+                s.updates = t.second.updates;
+                s.calculations = t.second.calculations;
+                s.updateTime = t.second.updateTime;
+                s.calculationTime = t.second.calculationTime;
+                s.selfTime = t.second.selfTime;
+                results.push_back(s);
+            }
+        }
+        std::stable_sort(results.begin(), results.end(),
+                         [](const Statistics& a, const Statistics& b) {
+                             return a.selfTime > b.selfTime;
+                         });
+        return results;
+    }
+
+    Size DependencyProfiler::dependencies() const {
+        std::lock_guard<std::mutex> lock(data_->mutex);
+        Size n = 0;
+        for (const auto& i : data_->observed)
+            n += i.second.size();
+        return n;
+    }
+
+    void DependencyProfiler::writeHotSpots(std::ostream& out,
+                                           Size rows) const {
+        std::vector<Statistics> results = statistics();
+        const int width = 40;
+        out << std::left << std::setw(width) << "type" << std::right
+            << std::setw(10) << "updates" << std::setw(12) << "time [ms]"
+            << std::setw(10) << "calcs" << std::setw(12) << "time [ms]"
+            << std::setw(12) << "self [ms]" << "\n";
+        out << std::fixed << std::setprecision(3);
+        for (Size i=0; i<std::min(rows, results.size()); ++i) {
+            const Statistics& s = results[i];
+            out << std::left << std::setw(width) << s.type << std::right
+                << std::setw(10) << s.updates
+                << std::setw(12) << s.updateTime*1000.0
+                << std::setw(10) << s.calculations
+                << std::setw(12) << s.calculationTime*1000.0
+                << std::setw(12) << s.selfTime*1000.0 << "\n";
+        }
+    }
+
+    void DependencyProfiler::writeGraph(std::ostream& out,
+                                        GraphFormat format) const {
+        std::lock_guard<std::mutex> lock(data_->mutex);
+
+        // objects deriving from both Observer and Observable are
+        // identified by the address of the complete object
+        struct Node {
+            Size id;
+            std::string type;
+            Size updates, calculations;
+        };
+        std::map<const void*, Node> nodes;
+        auto node = [&nodes](const void* address, const std::type_info& type)
+            -> Node& {
+            auto i = nodes.find(address);
+            if (i == nodes.end()) {
+                Node n = {nodes.size(), boost::core::demangle(type.name()),
+                          0, 0};
+                i = nodes.insert(std::make_pair(address, n)).first;
+            }
+            return i->second;
+        };
+
+        std::vector<std::pair<Size, Size> > edges;
+        for (const auto& i : data_->observers) {
+            const Observable* observable = i.first;
+            Size from = node(dynamic_cast<const void*>(observable),
+                             typeid(*observable)).id;
+            for (const Observer* observer : i.second) {
+                Node& n = node(dynamic_cast<const void*>(observer),
+                               typeid(*observer));
+                auto c = data_->objects.find(observer);
+                if (c != data_->objects.end()) {
+                    n.updates = c->second.updates;
+                    n.calculations = c->second.calculations;
+                }
+                edges.emplace_back(from, n.id);
+            }
+        }
+        std::vector<const Node*> sorted(nodes.size());
+        for (const auto& i : nodes)
+            sorted[i.second.id] = &i.second;
+
+        if (format == Dot) {
+            out << "digraph dependencies {\n";
+            for (const Node* n : sorted) {
+                out << "    n" << n->id << " [label=\"" << escaped(n->type);
+                if (n->updates > 0)
+                    out << "\\nupdates: " << n->updates;
+                if (n->calculations > 0)
+                    out << "\\ncalculations: " << n->calculations;
+                out << "\"];\n";
+            }
+            for (const auto& e : edges)
+                out << "    n" << e.first << " -> n" << e.second << ";\n";
+            out << "}\n";
+        } else {
+            out << "{\n  \"nodes\": [";
+            for (Size i=0; i<sorted.size(); ++i) {
+                const Node* n = sorted[i];
+                out << (i == 0 ? "\n" : ",\n")
+                    << "    {\"id\": " << n->id
+                    << ", \"type\": \"" << escaped(n->type) << "\""
+                    << ", \"updates\": " << n->updates
+                    << ", \"calculations\": " << n->calculations << "}";
+            }
+            out << "\n  ],\n  \"edges\": [";
+            for (Size i=0; i<edges.size(); ++i) {
+                out << (i == 0 ? "\n" : ",\n")
+                    << "    {\"from\": " << edges[i].first
+                    << ", \"to\": " << edges[i].second << "}";
+            }
+            out << "\n  ]\n}\n";
+        }
+    }
+
+}
@@ -0,0 +1,209 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file dependencyprofiler.hpp
+    \brief profiling of the observer/observable dependency graph
+*/
+
+#ifndef quantlib_dependency_profiler_hpp
+#define quantlib_dependency_profiler_hpp
+
+#include <ql/types.hpp>
+#include <ql/patterns/singleton.hpp>
+#include <iosfwd>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace QuantLib {
+
+    class Observable;
+    class Observer;
+
+    //! Profiler for the dependency graph of observers and observables
+    /*! When the library is compiled with
+        QL_ENABLE_DEPENDENCY_PROFILING and the profiler is enabled,
+        this class records the live registrations between observables
+        and observers; it also counts the calls to Observer::update()
+        made by observables and the calls to
+        LazyObject::performCalculations(), and measures their
+        wall-clock time.  Statistics are collected by object type,
+        while the graph reports the number of calls for each object.
+
+        The graph can be written in DOT or JSON format, and the
+        statistics as a hot-spot table sorted by self time, i.e., the
+        time not spent in nested updates or calculations.
+
+        When the macro is not defined, the instrumentation is removed
+        by the preprocessor and enable() raises an exception.
+
+        \ingroup patterns
+    */
+    class DependencyProfiler : public Singleton<DependencyProfiler> {
+        friend class Singleton<DependencyProfiler>;
+      private:
+        DependencyProfiler();
+      public:
+        enum Event { Update, Calculation };
+        enum GraphFormat { Dot, Json };
+
+        //! statistics for a given object type
+        struct Statistics {
+            std::string type;
+            Size updates = 0, calculations = 0;
+            //! wall-clock times in seconds
+            double updateTime = 0.0, calculationTime = 0.0, selfTime = 0.0;
+        };
+
+        //! measures the duration of an update or a calculation
+        class Timer {
+          public:
+            Timer(Event event, const Observer* observer);
+            ~Timer();
+            Timer(const Timer&) = delete;
+            Timer& operator=(const Timer&) = delete;
+          private:
+            Event event_;
+            const Observer* observer_;
+            const std::type_info* type_ = nullptr;
+            double start_ = 0.0, nested_ = 0.0;
+            Timer* parent_ = nullptr;
+        };
+
+        //! \name Settings
+        //@{
+        void enable();
+        void disable() { enabled_ = false; }
+        bool enabled() const { return enabled_; }
+        //! clears the statistics; the dependency graph is kept
+        void reset();
+        //@}
+
+        //! \name Results
+        //@{
+        //! statistics by object type, sorted by decreasing self time
+        std::vector<Statistics> statistics() const;
+        //! number of recorded registrations
+        Size dependencies() const;
+        //! writes the first rows of the statistics as a table
+        void writeHotSpots(std::ostream& out, Size rows = 20) const;
+        //! writes the dependency graph of the live objects
+        /*! Edges go from observables to their observers, i.e., in
+            the direction of notifications.
+        */
+        void writeGraph(std::ostream& out, GraphFormat format = Dot) const;
+        //@}
+
+        //! \name Instrumentation
+        /*! These methods are called through the QL_PROFILE macros. */
+        //@{
+        void registerDependency(const Observable*, const Observer*);
+        void unregisterDependency(const Observable*, const Observer*);
+        void unregisterObserver(const Observer*);
+        void unregisterObservable(const Observable*);
+        //@}
+      private:
+        void record(Event event, const Observer* observer,
+                    const std::type_info& type, double time, double selfTime);
+        // the containers are hidden in order not to include them
+        // wherever the observer pattern is used
+        class Data;
+        ext::shared_ptr<Data> data_;
+        bool enabled_ = false;
+    };
+
+}
+
+/*! \addtogroup macros
+    @{
+*/
+
+/*! \defgroup profilingMacros Profiling macros
+
+    The following macros instrument the observer pattern and lazy
+    objects for the DependencyProfiler.  If profiling was disabled
+    during configuration, they are removed by the preprocessor;
+    otherwise, whether anything is recorded depends on the profiler
+    being enabled at run time.
+
+    @{
+*/
+
+/*! \def QL_PROFILE_UPDATE
+    \brief times the update of an observer until the end of the scope
+*/
+
+/*! \def QL_PROFILE_CALCULATION
+    \brief times the calculations of a lazy object until the end of the scope
+*/
+
+/*! \def QL_PROFILE_REGISTRATION
+    \brief records the registration of an observer with an observable
+*/
+
+/*! \def QL_PROFILE_UNREGISTRATION
+    \brief records the unregistration of an observer from an observable
+*/
+
+/*! \def QL_PROFILE_OBSERVER_DESTRUCTION
+    \brief removes a destroyed observer from the dependency graph
+*/
+
+/*! \def QL_PROFILE_OBSERVABLE_DESTRUCTION
+    \brief removes a destroyed observable from the dependency graph
+*/
+
+/*! @} */
+
+/*! @} */
+
+#if defined(QL_ENABLE_DEPENDENCY_PROFILING)
+
+#define QL_DEFAULT_PROFILER QuantLib::DependencyProfiler::instance()
+
+#define QL_PROFILE_UPDATE(observer) \
+QuantLib::DependencyProfiler::Timer ql_profile_timer( \
+    QuantLib::DependencyProfiler::Update, observer)
+
+#define QL_PROFILE_CALCULATION(object) \
+QuantLib::DependencyProfiler::Timer ql_profile_timer( \
+    QuantLib::DependencyProfiler::Calculation, object)
+
+#define QL_PROFILE_REGISTRATION(observable, observer) \
+QL_DEFAULT_PROFILER.registerDependency(observable, observer)
+
+#define QL_PROFILE_UNREGISTRATION(observable, observer) \
+QL_DEFAULT_PROFILER.unregisterDependency(observable, observer)
+
+#define QL_PROFILE_OBSERVER_DESTRUCTION(observer) \
+QL_DEFAULT_PROFILER.unregisterObserver(observer)
+
+#define QL_PROFILE_OBSERVABLE_DESTRUCTION(observable) \
+QL_DEFAULT_PROFILER.unregisterObservable(observable)
+
+#else
+
+#define QL_PROFILE_UPDATE(observer)
+#define QL_PROFILE_CALCULATION(object)
+#define QL_PROFILE_REGISTRATION(observable, observer)
+#define QL_PROFILE_UNREGISTRATION(observable, observer)
+#define QL_PROFILE_OBSERVER_DESTRUCTION(observer)
+#define QL_PROFILE_OBSERVABLE_DESTRUCTION(observable)
+
+#endif
+
+#endif
@@ -83,6 +83,12 @@ namespace QuantLib {
                      behavior.
         */
         void alwaysForwardNotifications();
+        /*! This method returns whether calculate() would return the
+            presently cached results without performing any
+            calculation, i.e., whether the object was calculated
+            since its last notification or it is frozen.
+        */
+        bool isCalculated() const;
       protected:
         /*! This method performs all needed calculations by calling
             the <i><b>performCalculations</b></i> method.
@@ -161,11 +167,16 @@ namespace QuantLib {
         alwaysForward_ = true;
     }
 
+    inline bool LazyObject::isCalculated() const {
+        return calculated_ || frozen_;
+    }
+
     inline void LazyObject::calculate() const {
         if (!calculated_ && !frozen_) {
             calculated_ = true;   // prevent infinite recursion in
                                   // case of bootstrapping
             try {
+                QL_PROFILE_CALCULATION(this);
                 performCalculations();
             } catch (...) {
                 calculated_ = false;
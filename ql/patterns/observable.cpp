@@ -20,8 +20,11 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 
 #include <ql/patterns/observable.hpp>
+#include <algorithm>
+#include <vector>
 
-#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#if !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) && \
+    !defined(QL_ENABLE_RCU_OBSERVER_PATTERN)
 
 namespace QuantLib {
 
@@ -36,6 +39,7 @@ namespace QuantLib {
 
             for (auto* deferredObserver : deferredObservers_) {
                 try {
+                    QL_PROFILE_UPDATE(deferredObserver);
                     deferredObserver->update();
                 } catch (std::exception& e) {
                     successful = false;
@@ -52,17 +56,108 @@ namespace QuantLib {
         }
     }
 
+    void ObservableSettings::commitTransaction() {
+        QL_REQUIRE(transactionDepth_ > 0, "no transaction in progress");
+        if (transactionDepth_ > 1) {
+            --transactionDepth_;
+            return;
+        }
+
+        // Depth-first search from the observers of the notified
+        // observables; the reverse of the post-order is a topological
+        // order in which each observer follows the ones it depends on.
+        // Observers which are also observables are followed through
+        // their own observers.
+        struct Node {
+            Observer* observer;
+            set_type::const_iterator next, end;
+        };
+        const set_type none;
+        auto node = [&none](Observer* o) {
+            auto* observable = dynamic_cast<Observable*>(o);
+            return observable != nullptr ?
+                Node{o, observable->observers_.begin(),
+                     observable->observers_.end()} :
+                Node{o, none.begin(), none.end()};
+        };
+
+        std::vector<Observer*> order;
+        set_type visited;
+        std::vector<Node> stack;
+        for (auto* observable : notifiedObservables_) {
+            for (auto* root : observable->observers_) {
+                pendingObservers_.insert(root);
+                if (!visited.insert(root).second)
+                    continue;
+                stack.push_back(node(root));
+                while (!stack.empty()) {
+                    Node& current = stack.back();
+                    if (current.next != current.end) {
+                        Observer* o = *(current.next++);
+                        if (visited.insert(o).second)
+                            stack.push_back(node(o));
+                    } else {
+                        order.push_back(current.observer);
+                        stack.pop_back();
+                    }
+                }
+            }
+        }
+        notifiedObservables_.clear();
+        std::reverse(order.begin(), order.end());
+
+        // Only the observers actually notified, either by the
+        // collected observables or by the updated observers, are
+        // updated; notifications sent while updating are collected
+        // in the pending set.  Observers unregistering in the
+        // meantime are removed from it.
+        committing_ = true;
+        bool successful = true;
+        std::string errMsg;
+        auto update = [&](Observer* o) {
+            ++sentNotifications_;
+            try {
+                QL_PROFILE_UPDATE(o);
+                o->update();
+            } catch (std::exception& e) {
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        };
+        for (auto* o : order) {
+            if (pendingObservers_.erase(o) != 0)
+                update(o);
+        }
+        // observers registered during the transaction
+        while (!pendingObservers_.empty()) {
+            Observer* o = *pendingObservers_.begin();
+            pendingObservers_.erase(pendingObservers_.begin());
+            update(o);
+        }
+        committing_ = false;
+        --transactionDepth_;
+
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
 
     void Observable::notifyObservers() {
         if (!settings_.updatesEnabled()) {
             // if updates are only deferred, flag this for later notification
             // these are held centrally by the settings singleton
             settings_.registerDeferredObservers(observers_);
+        } else if (settings_.inTransaction()) {
+            // observers will be notified when the transaction is committed
+            settings_.registerTransactionNotification(this);
         } else if (!observers_.empty()) {
             bool successful = true;
             std::string errMsg;
             for (auto* observer : observers_) {
                 try {
+                    QL_PROFILE_UPDATE(observer);
                     observer->update();
                 } catch (std::exception& e) {
                     // quite a dilemma. If we don't catch the exception,
@@ -85,7 +180,7 @@ namespace QuantLib {
 
 }
 
-#else
+#elif defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
 
 #include <ql/functional.hpp>
 
@@ -201,4 +296,384 @@ namespace QuantLib {
 
 }
 
+
+#else
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <thread>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* Epoch-based reclamation of observer lists and observers.
+           Threads announce the global epoch in which they start
+           notifying observers and clear it when they are done.  A
+           list retired in a given epoch is deleted once no thread is
+           still notifying from an older epoch; similarly, the
+           destructor of an observer waits until the notifications
+           that might still call it are completed. */
+        class ObserverEpochs {
+            struct Record {
+                std::atomic<std::uint64_t> epoch{0};
+                std::atomic<bool> used{true};
+                Size depth = 0;
+                Record* next = nullptr;
+            };
+
+          public:
+            typedef std::vector<Observer*> list_type;
+
+            // read-side critical section; sections can be nested
+            class Section {
+              public:
+                Section() : record_(ObserverEpochs::instance().record()) {
+                    if (record_.depth++ == 0)
+                        record_.epoch.store(
+                            ObserverEpochs::instance().epoch_.load());
+                }
+                ~Section() {
+                    if (--record_.depth == 0) {
+                        record_.epoch.store(0, std::memory_order_release);
+                        std::vector<ext::shared_ptr<Observer> >& r =
+                            released();
+                        while (!r.empty()) {
+                            // might be the last reference; the observer
+                            // is destroyed here, outside the section
+                            ext::shared_ptr<Observer> o = std::move(r.back());
+                            r.pop_back();
+                        }
+                    }
+                }
+                Section(const Section&) = delete;
+                Section& operator=(const Section&) = delete;
+                /* Observers locked for notification are released when
+                   the outermost section ends; otherwise, two threads
+                   destroying observers inside their sections would
+                   wait for each other. */
+                void release(ext::shared_ptr<Observer>&& observer) {
+                    released().push_back(std::move(observer));
+                }
+              private:
+                static std::vector<ext::shared_ptr<Observer> >& released() {
+                    static thread_local
+                        std::vector<ext::shared_ptr<Observer> > observers;
+                    return observers;
+                }
+                Record& record_;
+            };
+
+            // never destroyed, since observables might outlive it
+            static ObserverEpochs& instance() {
+                static auto* epochs = new ObserverEpochs;
+                return *epochs;
+            }
+
+            void retire(const list_type* observers) {
+                if (observers == nullptr)
+                    return;
+
+                std::uint64_t epoch = epoch_.fetch_add(1) + 1;
+                std::vector<const list_type*> expired;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    retired_.emplace_back(epoch, observers);
+                    std::uint64_t oldest = oldestEpoch(nullptr);
+                    auto i = std::partition(
+                        retired_.begin(), retired_.end(),
+                        [oldest](const std::pair<std::uint64_t,
+                                                 const list_type*>& r) {
+                            return r.first > oldest;
+                        });
+                    for (auto j = i; j != retired_.end(); ++j)
+                        expired.push_back(j->second);
+                    retired_.erase(i, retired_.end());
+                }
+                for (auto* l : expired)
+                    delete l;
+            }
+
+            /* Waits for the notifications started by other threads
+               before the call.  The current thread is skipped, since
+               an update() method might destroy an observer during a
+               notification. */
+            void synchronize() {
+                const Record* self = &record();
+                std::uint64_t epoch = epoch_.fetch_add(1) + 1;
+                while (oldestEpoch(self) < epoch)
+                    std::this_thread::yield();
+            }
+
+          private:
+            // releases the record of a thread when the thread exits
+            struct RecordHolder {
+                Record* record = nullptr;
+                ~RecordHolder() {
+                    if (record != nullptr)
+                        record->used.store(false, std::memory_order_release);
+                }
+            };
+
+            ObserverEpochs() = default;
+
+            Record& record() {
+                static thread_local RecordHolder holder;
+                if (holder.record == nullptr) {
+                    // reuse the record of a terminated thread if possible
+                    for (Record* r = records_.load(); r != nullptr;
+                         r = r->next) {
+                        bool used = false;
+                        if (r->used.compare_exchange_strong(used, true)) {
+                            holder.record = r;
+                            return *r;
+                        }
+                    }
+                    auto* r = new Record;
+                    r->next = records_.load();
+                    while (!records_.compare_exchange_weak(r->next, r)) {}
+                    holder.record = r;
+                }
+                return *holder.record;
+            }
+
+            std::uint64_t oldestEpoch(const Record* skipped) const {
+                std::uint64_t oldest =
+                    std::numeric_limits<std::uint64_t>::max();
+                for (Record* r = records_.load(); r != nullptr; r = r->next) {
+                    std::uint64_t epoch = r->epoch.load();
+                    if (r != skipped && epoch != 0)
+                        oldest = std::min(oldest, epoch);
+                }
+                return oldest;
+            }
+
+            std::atomic<std::uint64_t> epoch_{1};
+            std::atomic<Record*> records_{nullptr};
+            std::mutex mutex_;
+            std::vector<std::pair<std::uint64_t, const list_type*> > retired_;
+        };
+
+        void notify(Observer* observer,
+                    ObserverEpochs::Section* section = nullptr) {
+            // c++17 is required if used with std::shared_ptr<T>
+            const ext::weak_ptr<Observer> o = observer->weak_from_this();
+
+            // check for empty weak reference; observers owned by a
+            // shared pointer are skipped when being destroyed
+            const ext::weak_ptr<Observer> empty;
+            if (o.owner_before(empty) || empty.owner_before(o)) {
+                ext::shared_ptr<Observer> obs(o.lock());
+                if (obs) {
+                    QL_PROFILE_UPDATE(observer);
+                    obs->update();
+                    if (section != nullptr)
+                        section->release(std::move(obs));
+                }
+            } else {
+                QL_PROFILE_UPDATE(observer);
+                observer->update();
+            }
+        }
+
+    }
+
+    void ObservableSettings::enableUpdates() {
+        set_type deferredObservers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            updatesEnabled_  = true;
+            updatesDeferred_ = false;
+            deferredObservers.swap(deferredObservers_);
+        }
+
+        // if there are outstanding deferred updates, do the notification
+        if (!deferredObservers.empty()) {
+            bool successful = true;
+            std::string errMsg;
+
+            for (auto* deferredObserver : deferredObservers) {
+                try {
+                    notify(deferredObserver);
+                } catch (std::exception& e) {
+                    successful = false;
+                    errMsg = e.what();
+                } catch (...) {
+                    successful = false;
+                }
+            }
+
+            QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+        }
+    }
+
+    void ObservableSettings::registerDeferredObservers(
+                                    const std::vector<Observer*>& observers) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (updatesDeferred_)
+            deferredObservers_.insert(observers.begin(), observers.end());
+    }
+
+    void ObservableSettings::unregisterDeferredObserver(Observer* o) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        deferredObservers_.erase(o);
+    }
+
+
+    Observable::Observable()
+    : observers_(nullptr), settings_(ObservableSettings::instance()) {}
+
+    Observable::Observable(const Observable&)
+    : observers_(nullptr), settings_(ObservableSettings::instance()) {
+        // the observer set is not copied; no observer asked to
+        // register with this object
+    }
+
+    Observable::~Observable() {
+        ObserverEpochs::instance().retire(observers_.load());
+        QL_PROFILE_OBSERVABLE_DESTRUCTION(this);
+    }
+
+    void Observable::notifyObservers() {
+        // observables without observers don't need to enter the
+        // critical section
+        if (observers_.load(std::memory_order_relaxed) == nullptr)
+            return;
+
+        ObserverEpochs::Section section;
+        const list_type* observers = observers_.load();
+        if (observers == nullptr)
+            return;
+
+        if (!settings_.updatesEnabled()) {
+            // if updates are only deferred, flag this for later notification
+            // these are held centrally by the settings singleton
+            settings_.registerDeferredObservers(*observers);
+            return;
+        }
+
+        bool successful = true;
+        std::string errMsg;
+        for (auto* observer : *observers) {
+            try {
+                notify(observer, &section);
+            } catch (std::exception& e) {
+                // as in the default implementation, try and notify all
+                // observers and raise an exception afterwards
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
+    void Observable::registerObserver(Observer* o) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const list_type* observers =
+            observers_.load(std::memory_order_relaxed);
+        if (observers != nullptr &&
+            std::find(observers->begin(), observers->end(), o)
+                != observers->end())
+            return;
+
+        auto* updated =
+            observers != nullptr ? new list_type(*observers) : new list_type;
+        updated->push_back(o);
+        observers_.store(updated);
+        ObserverEpochs::instance().retire(observers);
+    }
+
+    Size Observable::unregisterObserver(Observer* o) {
+        if (settings_.updatesDeferred())
+            settings_.unregisterDeferredObserver(o);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        const list_type* observers =
+            observers_.load(std::memory_order_relaxed);
+        if (observers == nullptr ||
+            std::find(observers->begin(), observers->end(), o)
+                == observers->end())
+            return 0;
+
+        list_type* updated = nullptr;
+        if (observers->size() > 1) {
+            updated = new list_type;
+            updated->reserve(observers->size()-1);
+            std::remove_copy(observers->begin(), observers->end(),
+                             std::back_inserter(*updated), o);
+        }
+        observers_.store(updated);
+        ObserverEpochs::instance().retire(observers);
+        return 1;
+    }
+
+
+    Observer::Observer(const Observer& o)
+    : ext::enable_shared_from_this<Observer>(),
+      observables_(o.observables_), registered_(!observables_.empty()) {
+        for (const auto& observable : observables_) {
+            observable->registerObserver(this);
+            QL_PROFILE_REGISTRATION(observable.get(), this);
+        }
+    }
+
+    Observer& Observer::operator=(const Observer& o) {
+        for (const auto& observable : observables_) {
+            observable->unregisterObserver(this);
+            QL_PROFILE_UNREGISTRATION(observable.get(), this);
+        }
+        observables_ = o.observables_;
+        for (const auto& observable : observables_) {
+            observable->registerObserver(this);
+            QL_PROFILE_REGISTRATION(observable.get(), this);
+            registered_ = true;
+        }
+        return *this;
+    }
+
+    Observer::~Observer() {
+        for (const auto& observable : observables_)
+            observable->unregisterObserver(this);
+        QL_PROFILE_OBSERVER_DESTRUCTION(this);
+        // notifications started before unregistering might still
+        // reach this observer
+        if (registered_)
+            ObserverEpochs::instance().synchronize();
+    }
+
+    std::pair<Observer::iterator, bool>
+    Observer::registerWith(const ext::shared_ptr<Observable>& h) {
+        if (h != nullptr) {
+            h->registerObserver(this);
+            QL_PROFILE_REGISTRATION(h.get(), this);
+            registered_ = true;
+            return observables_.insert(h);
+        }
+        return std::make_pair(observables_.end(), false);
+    }
+
+    Size Observer::unregisterWith(const ext::shared_ptr<Observable>& h) {
+        if (h != nullptr) {
+            h->unregisterObserver(this);
+            QL_PROFILE_UNREGISTRATION(h.get(), this);
+        }
+        return observables_.erase(h);
+    }
+
+    void Observer::unregisterWithAll() {
+        for (const auto& observable : observables_) {
+            observable->unregisterObserver(this);
+            QL_PROFILE_UNREGISTRATION(observable.get(), this);
+        }
+        observables_.clear();
+    }
+
+}
+
 #endif
@@ -31,13 +31,15 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #include <ql/errors.hpp>
 #include <ql/types.hpp>
+#include <ql/patterns/dependencyprofiler.hpp>
 #include <ql/patterns/singleton.hpp>
 
 #include <ql/shared_ptr.hpp>
 #include <boost/unordered_set.hpp>
 
 
-#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#if !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) && \
+    !defined(QL_ENABLE_RCU_OBSERVER_PATTERN)
 
 namespace QuantLib {
 
@@ -58,6 +60,40 @@ namespace QuantLib {
         bool updatesEnabled() const { return updatesEnabled_; }
         bool updatesDeferred() const { return updatesDeferred_; }
 
+        /*! \name Transactions
+
+            Between beginTransaction() and commitTransaction(),
+            observables notifying their changes are collected instead
+            of notifying their observers.  When the transaction is
+            committed, the observers depending on the collected
+            observables are sorted in topological order, so that each
+            observer is updated after the ones it depends on, and each
+            of them is updated at most once; further notifications
+            sent from their update() methods are coalesced in the
+            same way.  Transactions can be nested, in which case the
+            notifications are sent when the outermost one is
+            committed.  See also NotificationTransaction.
+        */
+        //@{
+        void beginTransaction() { ++transactionDepth_; }
+        void commitTransaction();
+        bool inTransaction() const { return transactionDepth_ > 0; }
+        //! notifications requested by observables during transactions
+        Size requestedNotifications() const {
+            return requestedNotifications_;
+        }
+        //! notifications sent when committing transactions
+        Size sentNotifications() const { return sentNotifications_; }
+        //! notifications saved by coalescing
+        Size savedNotifications() const {
+            return requestedNotifications_ > sentNotifications_ ?
+                requestedNotifications_ - sentNotifications_ : 0;
+        }
+        void resetNotificationCounters() {
+            requestedNotifications_ = sentNotifications_ = 0;
+        }
+        //@}
+
       private:
         ObservableSettings()
 
@@ -66,24 +102,33 @@ namespace QuantLib {
         void registerDeferredObservers(
             const boost::unordered_set<Observer*>& observers);
         void unregisterDeferredObserver(Observer*);
+        void registerTransactionNotification(Observable*);
+        void unregisterTransactionObservable(Observable*);
 
         typedef boost::unordered_set<Observer*> set_type;
         typedef set_type::iterator iterator;
         set_type deferredObservers_;
 
         bool updatesEnabled_ = true, updatesDeferred_ = false;
+
+        boost::unordered_set<Observable*> notifiedObservables_;
+        set_type pendingObservers_;
+        Size transactionDepth_ = 0;
+        bool committing_ = false;
+        Size requestedNotifications_ = 0, sentNotifications_ = 0;
     };
 
     //! Object that notifies its changes to a set of observers
     /*! \ingroup patterns */
     class Observable {
         friend class Observer;
+        friend class ObservableSettings;
       public:
         // constructors, assignment, destructor
         Observable() : settings_(ObservableSettings::instance()) {}
         Observable(const Observable&);
         Observable& operator=(const Observable&);
-        virtual ~Observable() = default;
+        virtual ~Observable();
         /*! This method should be called at the end of non-const methods
             or when the programmer desires to notify any changes.
         */
@@ -119,6 +164,8 @@ namespace QuantLib {
         void registerWithObservables(const ext::shared_ptr<Observer>&);
         Size unregisterWith(const ext::shared_ptr<Observable>&);
         void unregisterWithAll();
+        //! observables the instance is registered with
+        const set_type& observables() const { return observables_; }
 
         /*! This method must be implemented in derived classes. An
             instance of %Observer does not call this method directly:
@@ -149,6 +196,24 @@ namespace QuantLib {
 
     inline void ObservableSettings::unregisterDeferredObserver(Observer* o) {
         deferredObservers_.erase(o);
+        pendingObservers_.erase(o);
+    }
+
+    inline void ObservableSettings::registerTransactionNotification(
+                                                        Observable* o) {
+        if (o->observers_.empty())
+            return;
+        requestedNotifications_ += o->observers_.size();
+        if (committing_)
+            pendingObservers_.insert(o->observers_.begin(),
+                                     o->observers_.end());
+        else
+            notifiedObservables_.insert(o);
+    }
+
+    inline void ObservableSettings::unregisterTransactionObservable(
+                                                        Observable* o) {
+        notifiedObservables_.erase(o);
     }
 
     inline Observable::Observable(const Observable&)
@@ -173,13 +238,19 @@ namespace QuantLib {
         return *this;
     }
 
+    inline Observable::~Observable() {
+        if (settings_.inTransaction())
+            settings_.unregisterTransactionObservable(this);
+        QL_PROFILE_OBSERVABLE_DESTRUCTION(this);
+    }
+
     inline std::pair<boost::unordered_set<Observer*>::iterator, bool>
     Observable::registerObserver(Observer* o) {
         return observers_.insert(o);
     }
 
     inline Size Observable::unregisterObserver(Observer* o) {
-        if (settings_.updatesDeferred())
+        if (settings_.updatesDeferred() || settings_.inTransaction())
             settings_.unregisterDeferredObserver(o);
 
         return observers_.erase(o);
@@ -188,29 +259,37 @@ namespace QuantLib {
 
     inline Observer::Observer(const Observer& o)
     : observables_(o.observables_) {
-        for (const auto& observable : observables_)
+        for (const auto& observable : observables_) {
             observable->registerObserver(this);
+            QL_PROFILE_REGISTRATION(observable.get(), this);
+        }
     }
 
     inline Observer& Observer::operator=(const Observer& o) {
         iterator i;
-        for (i=observables_.begin(); i!=observables_.end(); ++i)
+        for (i=observables_.begin(); i!=observables_.end(); ++i) {
             (*i)->unregisterObserver(this);
+            QL_PROFILE_UNREGISTRATION(i->get(), this);
+        }
         observables_ = o.observables_;
-        for (i=observables_.begin(); i!=observables_.end(); ++i)
+        for (i=observables_.begin(); i!=observables_.end(); ++i) {
             (*i)->registerObserver(this);
+            QL_PROFILE_REGISTRATION(i->get(), this);
+        }
         return *this;
     }
 
     inline Observer::~Observer() {
         for (const auto& observable : observables_)
             observable->unregisterObserver(this);
+        QL_PROFILE_OBSERVER_DESTRUCTION(this);
     }
 
     inline std::pair<Observer::iterator, bool>
     Observer::registerWith(const ext::shared_ptr<Observable>& h) {
         if (h != nullptr) {
             h->registerObserver(this);
+            QL_PROFILE_REGISTRATION(h.get(), this);
             return observables_.insert(h);
         }
         return std::make_pair(observables_.end(), false);
@@ -227,14 +306,18 @@ namespace QuantLib {
 
     inline
     Size Observer::unregisterWith(const ext::shared_ptr<Observable>& h) {
-        if (h != nullptr)
+        if (h != nullptr) {
             h->unregisterObserver(this);
+            QL_PROFILE_UNREGISTRATION(h.get(), this);
+        }
         return observables_.erase(h);
     }
 
     inline void Observer::unregisterWithAll() {
-        for (const auto& observable : observables_)
+        for (const auto& observable : observables_) {
             observable->unregisterObserver(this);
+            QL_PROFILE_UNREGISTRATION(observable.get(), this);
+        }
         observables_.clear();
     }
 
@@ -244,7 +327,7 @@ namespace QuantLib {
 
 }
 
-#else
+#elif defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
 
 #include <boost/atomic.hpp>
 #include <boost/thread/locks.hpp>
@@ -282,6 +365,11 @@ namespace QuantLib {
         void registerWithObservables(const ext::shared_ptr<Observer>&);
         Size unregisterWith(const ext::shared_ptr<Observable>&);
         void unregisterWithAll();
+        //! observables the instance is registered with
+        /*! \warning the returned set is not protected against
+                     concurrent registrations.
+        */
+        const set_type& observables() const { return observables_; }
 
         /*! This method must be implemented in derived classes. An
             instance of %Observer does not call this method directly:
@@ -308,6 +396,7 @@ namespace QuantLib {
             void update() const {
                 boost::lock_guard<boost::recursive_mutex> lock(mutex_);
                 if (active_) {
+                    QL_PROFILE_UPDATE(observer_);
                     // c++17 is required if used with std::shared_ptr<T>
                     const ext::weak_ptr<Observer> o
                         = observer_->weak_from_this();
@@ -360,7 +449,9 @@ namespace QuantLib {
         Observable();
         Observable(const Observable&);
         Observable& operator=(const Observable&);
-        virtual ~Observable() {}
+        virtual ~Observable() {
+            QL_PROFILE_OBSERVABLE_DESTRUCTION(this);
+        }
         /*! This method should be called at the end of non-const methods
             or when the programmer desires to notify any changes.
         */
@@ -480,8 +571,10 @@ namespace QuantLib {
              observables_ = o.observables_;
         }
 
-        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
+        for (iterator i=observables_.begin(); i!=observables_.end(); ++i) {
             (*i)->registerObserver(proxy_);
+            QL_PROFILE_REGISTRATION(i->get(), this);
+        }
     }
 
     inline Observer& Observer::operator=(const Observer& o) {
@@ -491,15 +584,19 @@ namespace QuantLib {
         }
 
         iterator i;
-        for (i=observables_.begin(); i!=observables_.end(); ++i)
+        for (i=observables_.begin(); i!=observables_.end(); ++i) {
             (*i)->unregisterObserver(proxy_, true);
+            QL_PROFILE_UNREGISTRATION(i->get(), this);
+        }
 
         {
             boost::lock_guard<boost::recursive_mutex> lock(o.mutex_);
             observables_ = o.observables_;
         }
-        for (i=observables_.begin(); i!=observables_.end(); ++i)
+        for (i=observables_.begin(); i!=observables_.end(); ++i) {
             (*i)->registerObserver(proxy_);
+            QL_PROFILE_REGISTRATION(i->get(), this);
+        }
 
         return *this;
     }
@@ -511,6 +608,7 @@ namespace QuantLib {
 
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
             (*i)->unregisterObserver(proxy_, false);
+        QL_PROFILE_OBSERVER_DESTRUCTION(this);
     }
 
     inline std::pair<Observer::iterator, bool>
@@ -522,6 +620,7 @@ namespace QuantLib {
 
         if (h) {
             h->registerObserver(proxy_);
+            QL_PROFILE_REGISTRATION(h.get(), this);
             return observables_.insert(h);
         }
         return std::make_pair(observables_.end(), false);
@@ -544,6 +643,7 @@ namespace QuantLib {
 
         if (h && proxy_)  {
             h->unregisterObserver(proxy_, true);
+            QL_PROFILE_UNREGISTRATION(h.get(), this);
         }
 
         return observables_.erase(h);
@@ -552,8 +652,10 @@ namespace QuantLib {
     inline void Observer::unregisterWithAll() {
         boost::lock_guard<boost::recursive_mutex> lock(mutex_);
 
-        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
+        for (iterator i=observables_.begin(); i!=observables_.end(); ++i) {
             (*i)->unregisterObserver(proxy_, true);
+            QL_PROFILE_UNREGISTRATION(i->get(), this);
+        }
 
         observables_.clear();
     }
@@ -562,5 +664,229 @@ namespace QuantLib {
         update();
     }
 }
+
+#else
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace QuantLib {
+
+    class Observer;
+    class Observable;
+
+    //! global repository for run-time library settings
+    class ObservableSettings : public Singleton<ObservableSettings> {
+        friend class Singleton<ObservableSettings>;
+        friend class Observable;
+      public:
+        void disableUpdates(bool deferred=false) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            updatesDeferred_ = deferred;
+            updatesEnabled_  = false;
+        }
+        /*! \warning observers whose notification was deferred must
+                     not be destroyed while this method runs.
+        */
+        void enableUpdates();
+
+        bool updatesEnabled() const { return updatesEnabled_; }
+        bool updatesDeferred() const { return updatesDeferred_; }
+
+      private:
+        ObservableSettings() = default;
+
+        void registerDeferredObservers(const std::vector<Observer*>& observers);
+        void unregisterDeferredObserver(Observer*);
+
+        typedef boost::unordered_set<Observer*> set_type;
+        set_type deferredObservers_;
+        std::mutex mutex_;
+
+        std::atomic<bool> updatesEnabled_{true}, updatesDeferred_{false};
+    };
+
+    //! Object that notifies its changes to a set of observers
+    /*! The observers are kept in an immutable list which is replaced
+        (copy on write) when an observer registers or unregisters.
+        Notification reads the current list without locking; retired
+        lists are deleted, and the destructor of a registered observer
+        returns, only after all the notifications that could still
+        reach them are completed.  This makes notification cheap and
+        safe from multiple threads at the price of slower registration.
+
+        \ingroup patterns
+    */
+    class Observable {
+        friend class Observer;
+      public:
+        // constructors, assignment, destructor
+        Observable();
+        Observable(const Observable&);
+        Observable& operator=(const Observable&);
+        virtual ~Observable();
+        /*! This method should be called at the end of non-const methods
+            or when the programmer desires to notify any changes.
+        */
+        void notifyObservers();
+      private:
+        typedef std::vector<Observer*> list_type;
+        void registerObserver(Observer*);
+        Size unregisterObserver(Observer*);
+        std::atomic<const list_type*> observers_;
+        std::mutex mutex_;
+        ObservableSettings& settings_;
+    };
+
+    //! Object that gets notified when a given observable changes
+    /*! As in the thread-safe observer pattern, observers owned by a
+        shared pointer are not notified once their destruction begins.
+
+        \warning the registration methods of a given observer must
+                 not be called concurrently from different threads.
+
+        \ingroup patterns
+    */
+    class Observer : public ext::enable_shared_from_this<Observer> {
+        friend class Observable;
+      public:
+        typedef boost::unordered_set<ext::shared_ptr<Observable> > set_type;
+        typedef set_type::iterator iterator;
+
+        // constructors, assignment, destructor
+        Observer() = default;
+        Observer(const Observer&);
+        Observer& operator=(const Observer&);
+        virtual ~Observer();
+
+        // observer interface
+        std::pair<iterator, bool>
+            registerWith(const ext::shared_ptr<Observable>&);
+
+        /*! register with all observables of a given observer. Note
+            that this does not include registering with the observer
+            itself. */
+        void registerWithObservables(const ext::shared_ptr<Observer>&);
+        Size unregisterWith(const ext::shared_ptr<Observable>&);
+        void unregisterWithAll();
+        //! observables the instance is registered with
+        const set_type& observables() const { return observables_; }
+
+        /*! This method must be implemented in derived classes. An
+            instance of %Observer does not call this method directly:
+            instead, it will be called by the observables the instance
+            registered with when they need to notify any changes.
+        */
+        virtual void update() = 0;
+
+        /*! This method allows to explicitly update the instance itself
+          and nested observers. If notifications are disabled a call to
+          this method ensures an update of such nested observers. It
+          should be implemented in derived classes whenever applicable */
+        virtual void deepUpdate();
+
+      private:
+        set_type observables_;
+        bool registered_ = false;
+    };
+
+
+    // inline definitions
+
+    /*! \warning notification is sent before the copy constructor has
+                 a chance of actually change the data
+                 members. Therefore, observers whose update() method
+                 tries to use their observables will not see the
+                 updated values. It is suggested that the update()
+                 method just raise a flag in order to trigger
+                 a later recalculation.
+    */
+    inline Observable& Observable::operator=(const Observable& o) {
+        // as above, the observer set is not copied. Moreover,
+        // observers of this object must be notified of the change
+        if (&o != this)
+            notifyObservers();
+        return *this;
+    }
+
+    inline void
+    Observer::registerWithObservables(const ext::shared_ptr<Observer> &o) {
+        if (o != nullptr) {
+            iterator i;
+            for (i = o->observables_.begin(); i != o->observables_.end(); ++i)
+                registerWith(*i);
+        }
+    }
+
+    inline void Observer::deepUpdate() {
+        update();
+    }
+
+}
+
 #endif
+
+namespace QuantLib {
+
+    //! Scope object for a notification transaction
+    /*! The constructor begins a transaction and commit() sends the
+        collected notifications; see ObservableSettings.  If commit()
+        is not called, the destructor commits the transaction and
+        discards any exception raised by the observers.
+
+        \warning With the thread-safe and RCU observer patterns,
+                  transactions are not available; this class disables
+                  updates in deferred mode instead, which sends each
+                  notification once but not in topological order, and
+                  nested scopes are not supported.
+
+        \ingroup patterns
+    */
+    class NotificationTransaction {
+      public:
+        NotificationTransaction();
+        ~NotificationTransaction();
+        NotificationTransaction(const NotificationTransaction&) = delete;
+        NotificationTransaction& operator=(const NotificationTransaction&)
+            = delete;
+        //! sends the collected notifications
+        void commit();
+      private:
+        bool committed_ = false;
+    };
+
+
+    // inline definitions
+
+    inline NotificationTransaction::NotificationTransaction() {
+        #if !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) && \
+            !defined(QL_ENABLE_RCU_OBSERVER_PATTERN)
+        ObservableSettings::instance().beginTransaction();
+        #else
+        ObservableSettings::instance().disableUpdates(true);
+        #endif
+    }
+
+    inline NotificationTransaction::~NotificationTransaction() {
+        if (!committed_) {
+            try {
+                commit();
+            } catch (...) {}
+        }
+    }
+
+    inline void NotificationTransaction::commit() {
+        QL_REQUIRE(!committed_, "transaction already committed");
+        committed_ = true;
+        #if !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) && \
+            !defined(QL_ENABLE_RCU_OBSERVER_PATTERN)
+        ObservableSettings::instance().commitTransaction();
+        #else
+        ObservableSettings::instance().enableUpdates();
+        #endif
+    }
+
+}
+
 #endif
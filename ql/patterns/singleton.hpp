@@ -65,6 +65,9 @@
     #pragma managed(pop)
 #endif
 #include <map>
+#if defined(QL_ENABLE_SESSIONS)
+#include <mutex>
+#endif
 
 
 #if (_MANAGED == 1) || (_M_CEE == 1)
@@ -181,6 +184,19 @@ namespace QuantLib {
 
         #if defined(QL_ENABLE_SESSIONS)
         ThreadKey id = sessionId();
+        #if (QL_MANAGED == 0)
+        // instances are never removed from the map, so the one last
+        // returned to this thread can be returned again without
+        // locking as long as the thread stays in the same session
+        static thread_local ThreadKey lastId;
+        static thread_local T* last = nullptr;
+        if (last != nullptr && lastId == id)
+            return *last;
+        #endif
+        // threads running different sessions might access the map
+        // concurrently
+        static std::mutex mutex;
+        std::lock_guard<std::mutex> lock(mutex);
         #else
         ThreadKey id = 0;
         #endif
@@ -189,6 +205,11 @@ namespace QuantLib {
         if (!instance)
             instance = ext::shared_ptr<T>(new T);
 
+        #if defined(QL_ENABLE_SESSIONS) && (QL_MANAGED == 0)
+        lastId = id;
+        last = instance.get();
+        #endif
+
         #endif
 
         return *instance;
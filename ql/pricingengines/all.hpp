@@ -5,7 +5,9 @@
 #include <ql/pricingengines/americanpayoffathit.hpp>
 #include <ql/pricingengines/blackcalculator.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/blackformulabatch.hpp>
 #include <ql/pricingengines/blackscholescalculator.hpp>
+#include <ql/pricingengines/fdrichardsonextrapolationengine.hpp>
 #include <ql/pricingengines/genericmodelengine.hpp>
 #include <ql/pricingengines/greeks.hpp>
 #include <ql/pricingengines/latticeshortratemodelengine.hpp>
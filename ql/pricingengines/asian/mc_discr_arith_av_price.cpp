@@ -51,4 +51,47 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+
+    ArithmeticAPOBlockPathPricer::ArithmeticAPOBlockPathPricer(
+                                         Option::Type type,
+                                         Real strike, DiscountFactor discount,
+                                         Real runningSum, Size pastFixings)
+    : type_(type), strike_(strike), discount_(discount),
+      runningSum_(runningSum), pastFixings_(pastFixings) {
+        QL_REQUIRE(strike>=0.0,
+            "strike less than zero not allowed");
+    }
+
+    void ArithmeticAPOBlockPathPricer::operator()(
+                                   const PathBlock& paths,
+                                   std::vector<Real>& values) const {
+        Size n = paths.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        const Size m = paths.size();
+        Size first, fixings;
+        if (paths.timeGrid().mandatoryTimes()[0]==0.0) {
+            // include initial fixing
+            first = 0;
+            fixings = pastFixings_ + n;
+        } else {
+            first = 1;
+            fixings = pastFixings_ + n - 1;
+        }
+
+        std::fill(values.begin(), values.begin()+m, runningSum_);
+        for (Size i=first; i<n; i++) {
+            const Real* x = paths.values(i);
+            for (Size j=0; j<m; ++j)
+                values[j] += x[j];
+        }
+
+        for (Size j=0; j<m; ++j) {
+            Real averagePrice = values[j]/fixings;
+            values[j] = discount_ * (type_ == Option::Call ?
+                                     std::max<Real>(averagePrice-strike_, 0.0) :
+                                     std::max<Real>(strike_-averagePrice, 0.0));
+        }
+    }
+
 }
@@ -57,7 +57,13 @@ namespace QuantLib {
             path_pricer_type;
         typedef typename MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>::stats_type
             stats_type;
+        typedef typename MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>::
+            block_path_generator_type block_path_generator_type;
         // constructor
+        /*! If pathsPerBlock is not null, the paths are generated
+            and priced in blocks of the given size (see
+            BlockPathGenerator.)
+        */
         MCDiscreteArithmeticAPEngine(
              const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
              bool brownianBridge,
@@ -66,10 +72,16 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size pathsPerBlock = 0);
       protected:
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
         ext::shared_ptr<path_pricer_type> controlPathPricer() const override;
+        ext::shared_ptr<BlockPathPricer> blockPathPricer() const override;
+        ext::shared_ptr<BlockPathPricer>
+        controlBlockPathPricer() const override;
+        ext::shared_ptr<block_path_generator_type>
+        blockPathGenerator() const override;
         ext::shared_ptr<PricingEngine> controlPricingEngine() const override {
             ext::shared_ptr<GeneralizedBlackScholesProcess> process =
                 ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
@@ -78,6 +90,7 @@ namespace QuantLib {
             return ext::shared_ptr<PricingEngine>(new
                 AnalyticDiscreteGeometricAveragePriceAsianEngine(process));
         }
+        Size pathsPerBlock_;
     };
 
 
@@ -97,6 +110,25 @@ namespace QuantLib {
         Size pastFixings_;
     };
 
+    //! block counterpart of ArithmeticAPOPathPricer
+    class ArithmeticAPOBlockPathPricer : public BlockPathPricer {
+      public:
+        ArithmeticAPOBlockPathPricer(Option::Type type,
+                                     Real strike,
+                                     DiscountFactor discount,
+                                     Real runningSum = 0.0,
+                                     Size pastFixings = 0);
+        void operator()(const PathBlock& paths,
+                        std::vector<Real>& values) const override;
+
+      private:
+        Option::Type type_;
+        Real strike_;
+        DiscountFactor discount_;
+        Real runningSum_;
+        Size pastFixings_;
+    };
+
 
     // inline definitions
 
@@ -110,7 +142,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             Size pathsPerBlock)
     : MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>(process,
                                                               brownianBridge,
                                                               antitheticVariate,
@@ -118,7 +151,8 @@ namespace QuantLib {
                                                               requiredSamples,
                                                               requiredTolerance,
                                                               maxSamples,
-                                                              seed) {}
+                                                              seed),
+      pathsPerBlock_(pathsPerBlock) {}
 
     template <class RNG, class S>
     inline
@@ -183,6 +217,70 @@ namespace QuantLib {
               process->riskFreeRate()->discount(this->timeGrid().back())));
     }
 
+    template <class RNG, class S>
+    inline ext::shared_ptr<BlockPathPricer>
+    MCDiscreteArithmeticAPEngine<RNG,S>::blockPathPricer() const {
+        if (pathsPerBlock_ == 0)
+            return ext::shared_ptr<BlockPathPricer>();
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        ext::shared_ptr<EuropeanExercise> exercise =
+            ext::dynamic_pointer_cast<EuropeanExercise>(
+                this->arguments_.exercise);
+        QL_REQUIRE(exercise, "wrong exercise given");
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+            ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+
+        return ext::shared_ptr<BlockPathPricer>(
+                new ArithmeticAPOBlockPathPricer(
+                    payoff->optionType(),
+                    payoff->strike(),
+                    process->riskFreeRate()->discount(exercise->lastDate()),
+                    this->arguments_.runningAccumulator,
+                    this->arguments_.pastFixings));
+    }
+
+    template <class RNG, class S>
+    inline ext::shared_ptr<BlockPathPricer>
+    MCDiscreteArithmeticAPEngine<RNG,S>::controlBlockPathPricer() const {
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+            ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+
+        // same as controlPathPricer()
+        return ext::shared_ptr<BlockPathPricer>(
+            new GeometricAPOBlockPathPricer(
+              payoff->optionType(),
+              payoff->strike(),
+              process->riskFreeRate()->discount(this->timeGrid().back())));
+    }
+
+    template <class RNG, class S>
+    inline ext::shared_ptr<
+        typename MCDiscreteArithmeticAPEngine<RNG,S>::block_path_generator_type>
+    MCDiscreteArithmeticAPEngine<RNG,S>::blockPathGenerator() const {
+        TimeGrid grid = this->timeGrid();
+        typename RNG::rsg_type generator =
+            RNG::make_sequence_generator(grid.size()-1, this->seed_);
+        return ext::make_shared<block_path_generator_type>(
+                   this->process_, grid, generator,
+                   this->brownianBridge_, pathsPerBlock_);
+    }
+
     template <class RNG = PseudoRandom, class S = Statistics>
     class MakeMCDiscreteArithmeticAPEngine {
       public:
@@ -196,6 +294,7 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticAPEngine& withAntitheticVariate(bool b = true);
         MakeMCDiscreteArithmeticAPEngine& withControlVariate(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withPathBlocks(Size pathsPerBlock);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -205,6 +304,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size pathsPerBlock_;
     };
 
     template <class RNG, class S>
@@ -212,7 +312,7 @@ namespace QuantLib {
         ext::shared_ptr<GeneralizedBlackScholesProcess> process)
     : process_(std::move(process)), antithetic_(false), controlVariate_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()), tolerance_(Null<Real>()),
-      brownianBridge_(true), seed_(0) {}
+      brownianBridge_(true), seed_(0), pathsPerBlock_(0) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
@@ -271,6 +371,14 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withPathBlocks(
+                                                       Size pathsPerBlock) {
+        pathsPerBlock_ = pathsPerBlock;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -281,7 +389,8 @@ namespace QuantLib {
                                                 antithetic_, controlVariate_,
                                                 samples_, tolerance_,
                                                 maxSamples_,
-                                                seed_));
+                                                seed_,
+                                                pathsPerBlock_));
     }
 
 
@@ -58,4 +58,45 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+
+    GeometricAPOBlockPathPricer::GeometricAPOBlockPathPricer(
+                                         Option::Type type,
+                                         Real strike, DiscountFactor discount,
+                                         Real runningProduct, Size pastFixings)
+    : type_(type), strike_(strike), discount_(discount),
+      runningProduct_(runningProduct), pastFixings_(pastFixings) {
+        QL_REQUIRE(strike>=0.0, "negative strike given");
+    }
+
+    void GeometricAPOBlockPathPricer::operator()(
+                                   const PathBlock& paths,
+                                   std::vector<Real>& values) const {
+        Size n = paths.length() - 1;
+        QL_REQUIRE(n>0, "the path cannot be empty");
+
+        const Size m = paths.size();
+        Size fixings = n+pastFixings_;
+        Size first = 1;
+        if (paths.timeGrid().mandatoryTimes()[0]==0.0) {
+            fixings += 1;
+            first = 0;
+        }
+
+        // sum of the logarithms of the fixings, which can't overflow
+        std::fill(values.begin(), values.begin()+m,
+                  std::log(runningProduct_));
+        for (Size i=first; i<n+1; i++) {
+            const Real* x = paths.values(i);
+            for (Size j=0; j<m; ++j)
+                values[j] += std::log(x[j]);
+        }
+
+        for (Size j=0; j<m; ++j) {
+            Real averagePrice = std::exp(values[j]/fixings);
+            values[j] = discount_ * (type_ == Option::Call ?
+                                     std::max<Real>(averagePrice-strike_, 0.0) :
+                                     std::max<Real>(strike_-averagePrice, 0.0));
+        }
+    }
+
 }
@@ -27,6 +27,7 @@
 #define quantlib_mc_discrete_geometric_average_price_asian_engine_h
 
 #include <ql/exercise.hpp>
+#include <ql/methods/montecarlo/blockpathpricer.hpp>
 #include <ql/pricingengines/asian/mcdiscreteasianenginebase.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
@@ -83,6 +84,28 @@ namespace QuantLib {
         Size pastFixings_;
     };
 
+    /*! block counterpart of GeometricAPOPathPricer; the average is
+        calculated as the exponential of the average logarithm, so
+        that results might differ by rounding errors.
+    */
+    class GeometricAPOBlockPathPricer : public BlockPathPricer {
+      public:
+        GeometricAPOBlockPathPricer(Option::Type type,
+                                    Real strike,
+                                    DiscountFactor discount,
+                                    Real runningProduct = 1.0,
+                                    Size pastFixings = 0);
+        void operator()(const PathBlock& paths,
+                        std::vector<Real>& values) const override;
+
+      private:
+        Option::Type type_;
+        Real strike_;
+        DiscountFactor discount_;
+        Real runningProduct_;
+        Size pastFixings_;
+    };
+
 
     // inline definitions
 
@@ -24,6 +24,46 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // values of the paths given the first node at which the
+        // barrier was crossed (null if it wasn't)
+        void barrierValues(Barrier::Type barrierType,
+                           Real rebate,
+                           const PlainVanillaPayoff& payoff,
+                           const std::vector<DiscountFactor>& discounts,
+                           const std::vector<Size>& knockNodes,
+                           const PathBlock& paths,
+                           std::vector<Real>& values) {
+            static Size null = Null<Size>();
+            const Real* asset_price = paths.values(paths.length()-1);
+            const Size m = paths.size();
+            switch (barrierType) {
+              case Barrier::UpIn:
+              case Barrier::DownIn:
+                for (Size j=0; j<m; ++j) {
+                    if (knockNodes[j] != null)
+                        values[j] = payoff(asset_price[j]) * discounts.back();
+                    else
+                        values[j] = rebate*discounts.back();
+                }
+                break;
+              case Barrier::UpOut:
+              case Barrier::DownOut:
+                for (Size j=0; j<m; ++j) {
+                    if (knockNodes[j] == null)
+                        values[j] = payoff(asset_price[j]) * discounts.back();
+                    else
+                        values[j] = rebate*discounts[knockNodes[j]];
+                }
+                break;
+              default:
+                QL_FAIL("unknown barrier type");
+            }
+        }
+
+    }
+
     BarrierPathPricer::BarrierPathPricer(Barrier::Type barrierType,
                                          Real barrier,
                                          Real rebate,
@@ -156,6 +196,84 @@ namespace QuantLib {
     }
 
 
+    BarrierBlockPathPricer::BarrierBlockPathPricer(
+                                    Barrier::Type barrierType,
+                                    Real barrier,
+                                    Real rebate,
+                                    Option::Type type,
+                                    Real strike,
+                                    std::vector<DiscountFactor> discounts,
+                                    ext::shared_ptr<StochasticProcess1D> diffProcess,
+                                    PseudoRandom::ursg_type sequenceGen)
+    : barrierType_(barrierType), barrier_(barrier), rebate_(rebate),
+      diffProcess_(std::move(diffProcess)), stateIndependentDiffusion_(false),
+      sequenceGen_(std::move(sequenceGen)), payoff_(type, strike),
+      discounts_(std::move(discounts)) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+        QL_REQUIRE(barrier>0.0,
+                   "barrier less/equal zero not allowed");
+        ext::shared_ptr<GeneralizedBlackScholesProcess> bs =
+            ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                                                               diffProcess_);
+        if (bs != nullptr)
+            stateIndependentDiffusion_ = bs->hasExactEvolution();
+    }
+
+
+    void BarrierBlockPathPricer::operator()(const PathBlock& paths,
+                                            std::vector<Real>& values) const {
+        static Size null = Null<Size>();
+        Size n = paths.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        const Size m = paths.size();
+        const TimeGrid& timeGrid = paths.timeGrid();
+
+        // one sequence per path, as in the path-by-path pricer
+        u_.resize((n-1)*m);
+        for (Size j=0; j<m; ++j) {
+            const std::vector<Real>& u = sequenceGen_.nextSequence().value;
+            for (Size i=0; i<n-1; ++i)
+                u_[i*m+j] = u[i];
+        }
+        knockNodes_.assign(m, null);
+
+        const bool up = (barrierType_ == Barrier::UpIn ||
+                         barrierType_ == Barrier::UpOut);
+        for (Size i=0; i<n-1; i++) {
+            const Real* asset_price = paths.values(i);
+            const Real* new_asset_price = paths.values(i+1);
+            const Real* u = &u_[i*m];
+            Time dt = timeGrid.dt(i);
+            Volatility vol = stateIndependentDiffusion_ ?
+                diffProcess_->diffusion(timeGrid[i], diffProcess_->x0()) :
+                Null<Volatility>();
+            for (Size j=0; j<m; ++j) {
+                // terminal or initial vol?
+                if (!stateIndependentDiffusion_)
+                    vol = diffProcess_->diffusion(timeGrid[i],
+                                                  asset_price[j]);
+                Real x = std::log(new_asset_price[j] / asset_price[j]);
+                Real y;
+                bool crossed;
+                if (up) {
+                    y = 0.5*(x + std::sqrt(x*x - 2*vol*vol*dt*std::log((1-u[j]))));
+                    crossed = asset_price[j] * std::exp(y) >= barrier_;
+                } else {
+                    y = 0.5*(x - std::sqrt(x*x - 2*vol*vol*dt*std::log(u[j])));
+                    crossed = asset_price[j] * std::exp(y) <= barrier_;
+                }
+                if (crossed && knockNodes_[j] == null)
+                    knockNodes_[j] = i+1;
+            }
+        }
+
+        barrierValues(barrierType_, rebate_, payoff_, discounts_,
+                      knockNodes_, paths, values);
+    }
+
+
     BiasedBarrierPathPricer::BiasedBarrierPathPricer(Barrier::Type barrierType,
                                                      Real barrier,
                                                      Real rebate,
@@ -246,4 +364,47 @@ namespace QuantLib {
         }
     }
 
+
+    BiasedBarrierBlockPathPricer::BiasedBarrierBlockPathPricer(
+                                    Barrier::Type barrierType,
+                                    Real barrier,
+                                    Real rebate,
+                                    Option::Type type,
+                                    Real strike,
+                                    std::vector<DiscountFactor> discounts)
+    : barrierType_(barrierType), barrier_(barrier), rebate_(rebate), payoff_(type, strike),
+      discounts_(std::move(discounts)) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+        QL_REQUIRE(barrier>0.0,
+                   "barrier less/equal zero not allowed");
+    }
+
+
+    void BiasedBarrierBlockPathPricer::operator()(
+                                   const PathBlock& paths,
+                                   std::vector<Real>& values) const {
+        static Size null = Null<Size>();
+        Size n = paths.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        const Size m = paths.size();
+        knockNodes_.assign(m, null);
+
+        const bool up = (barrierType_ == Barrier::UpIn ||
+                         barrierType_ == Barrier::UpOut);
+        for (Size i=1; i<n; i++) {
+            const Real* asset_price = paths.values(i);
+            for (Size j=0; j<m; ++j) {
+                bool crossed = up ? asset_price[j] >= barrier_
+                                  : asset_price[j] <= barrier_;
+                if (crossed && knockNodes_[j] == null)
+                    knockNodes_[j] = i;
+            }
+        }
+
+        barrierValues(barrierType_, rebate_, payoff_, discounts_,
+                      knockNodes_, paths, values);
+    }
+
 }
@@ -28,6 +28,7 @@
 
 #include <ql/exercise.hpp>
 #include <ql/instruments/barrieroption.hpp>
+#include <ql/methods/montecarlo/blockpathpricer.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <utility>
@@ -64,7 +65,13 @@ namespace QuantLib {
             path_pricer_type;
         typedef typename McSimulation<SingleVariate,RNG,S>::stats_type
             stats_type;
+        typedef typename McSimulation<SingleVariate,RNG,S>::
+            block_path_generator_type block_path_generator_type;
         // constructor
+        /*! If pathsPerBlock is not null, the paths are generated
+            and priced in blocks of the given size (see
+            BlockPathGenerator.)
+        */
         MCBarrierEngine(ext::shared_ptr<GeneralizedBlackScholesProcess> process,
                         Size timeSteps,
                         Size timeStepsPerYear,
@@ -74,7 +81,8 @@ namespace QuantLib {
                         Real requiredTolerance,
                         Size maxSamples,
                         bool isBiased,
-                        BigNatural seed);
+                        BigNatural seed,
+                        Size pathsPerBlock = 0);
         void calculate() const override {
             Real spot = process_->x0();
             QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
@@ -100,6 +108,15 @@ namespace QuantLib {
                                                  grid, gen, brownianBridge_));
         }
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
+        ext::shared_ptr<BlockPathPricer> blockPathPricer() const override;
+        ext::shared_ptr<block_path_generator_type>
+        blockPathGenerator() const override {
+            TimeGrid grid = timeGrid();
+            typename RNG::rsg_type gen =
+                RNG::make_sequence_generator(grid.size()-1,seed_);
+            return ext::make_shared<block_path_generator_type>(
+                       process_, grid, gen, brownianBridge_, pathsPerBlock_);
+        }
         // data members
         ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_, timeStepsPerYear_;
@@ -108,6 +125,7 @@ namespace QuantLib {
         bool isBiased_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size pathsPerBlock_;
     };
 
 
@@ -126,6 +144,7 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withPathBlocks(Size pathsPerBlock);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -134,6 +153,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size pathsPerBlock_;
     };
 
 
@@ -160,6 +180,41 @@ namespace QuantLib {
     };
 
 
+    /*! block counterpart of BarrierPathPricer.  The uniform
+        deviates used for the barrier-crossing check are drawn in a
+        different order, so that results are different from (but
+        statistically equivalent to) the ones of the path-by-path
+        simulation.  For Black-Scholes processes with exact
+        evolution, the diffusion doesn't depend on the state and is
+        calculated once per time step.
+    */
+    class BarrierBlockPathPricer : public BlockPathPricer {
+      public:
+        BarrierBlockPathPricer(Barrier::Type barrierType,
+                               Real barrier,
+                               Real rebate,
+                               Option::Type type,
+                               Real strike,
+                               std::vector<DiscountFactor> discounts,
+                               ext::shared_ptr<StochasticProcess1D> diffProcess,
+                               PseudoRandom::ursg_type sequenceGen);
+        void operator()(const PathBlock& paths,
+                        std::vector<Real>& values) const override;
+
+      private:
+        Barrier::Type barrierType_;
+        Real barrier_;
+        Real rebate_;
+        ext::shared_ptr<StochasticProcess1D> diffProcess_;
+        bool stateIndependentDiffusion_;
+        PseudoRandom::ursg_type sequenceGen_;
+        PlainVanillaPayoff payoff_;
+        std::vector<DiscountFactor> discounts_;
+        mutable std::vector<Real> u_;
+        mutable std::vector<Size> knockNodes_;
+    };
+
+
     class BiasedBarrierPathPricer : public PathPricer<Path> {
       public:
         BiasedBarrierPathPricer(Barrier::Type barrierType,
@@ -179,6 +234,28 @@ namespace QuantLib {
     };
 
 
+    //! block counterpart of BiasedBarrierPathPricer
+    class BiasedBarrierBlockPathPricer : public BlockPathPricer {
+      public:
+        BiasedBarrierBlockPathPricer(Barrier::Type barrierType,
+                                     Real barrier,
+                                     Real rebate,
+                                     Option::Type type,
+                                     Real strike,
+                                     std::vector<DiscountFactor> discounts);
+        void operator()(const PathBlock& paths,
+                        std::vector<Real>& values) const override;
+
+      private:
+        Barrier::Type barrierType_;
+        Real barrier_;
+        Real rebate_;
+        PlainVanillaPayoff payoff_;
+        std::vector<DiscountFactor> discounts_;
+        mutable std::vector<Size> knockNodes_;
+    };
+
+
 
     // template definitions
 
@@ -193,11 +270,12 @@ namespace QuantLib {
         Real requiredTolerance,
         Size maxSamples,
         bool isBiased,
-        BigNatural seed)
+        BigNatural seed,
+        Size pathsPerBlock)
     : McSimulation<SingleVariate, RNG, S>(antitheticVariate, false), process_(std::move(process)),
       timeSteps_(timeSteps), timeStepsPerYear_(timeStepsPerYear), requiredSamples_(requiredSamples),
       maxSamples_(maxSamples), requiredTolerance_(requiredTolerance), isBiased_(isBiased),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      brownianBridge_(brownianBridge), seed_(seed), pathsPerBlock_(pathsPerBlock) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -253,8 +331,11 @@ namespace QuantLib {
                        payoff->strike(),
                        discounts));
         } else {
-            PseudoRandom::ursg_type sequenceGen(grid.size()-1,
-                                                PseudoRandom::urng_type(5));
+            // in block mode, each block draws its own uniform deviates
+            PseudoRandom::ursg_type sequenceGen(
+                grid.size()-1,
+                PseudoRandom::urng_type(RandomStreamSelector::seed(
+                    5, RandomStreamSelector::offset())));
             return ext::shared_ptr<
                         typename MCBarrierEngine<RNG,S>::path_pricer_type>(
                 new BarrierPathPricer(
@@ -270,12 +351,57 @@ namespace QuantLib {
     }
 
 
+    template <class RNG, class S>
+    inline ext::shared_ptr<BlockPathPricer>
+    MCBarrierEngine<RNG,S>::blockPathPricer() const {
+        if (pathsPerBlock_ == 0)
+            return ext::shared_ptr<BlockPathPricer>();
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        TimeGrid grid = timeGrid();
+        std::vector<DiscountFactor> discounts(grid.size());
+        for (Size i=0; i<grid.size(); i++)
+            discounts[i] = process_->riskFreeRate()->discount(grid[i]);
+
+        if (isBiased_) {
+            return ext::shared_ptr<BlockPathPricer>(
+                new BiasedBarrierBlockPathPricer(
+                       arguments_.barrierType,
+                       arguments_.barrier,
+                       arguments_.rebate,
+                       payoff->optionType(),
+                       payoff->strike(),
+                       discounts));
+        } else {
+            // in block mode, each block draws its own uniform deviates
+            PseudoRandom::ursg_type sequenceGen(
+                grid.size()-1,
+                PseudoRandom::urng_type(RandomStreamSelector::seed(
+                    5, RandomStreamSelector::offset())));
+            return ext::shared_ptr<BlockPathPricer>(
+                new BarrierBlockPathPricer(
+                    arguments_.barrierType,
+                    arguments_.barrier,
+                    arguments_.rebate,
+                    payoff->optionType(),
+                    payoff->strike(),
+                    discounts,
+                    process_,
+                    sequenceGen));
+        }
+    }
+
+
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG, S>::MakeMCBarrierEngine(
         ext::shared_ptr<GeneralizedBlackScholesProcess> process)
     : process_(std::move(process)), brownianBridge_(false), antithetic_(false), biased_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()), samples_(Null<Size>()),
-      maxSamples_(Null<Size>()), tolerance_(Null<Real>()), seed_(0) {}
+      maxSamples_(Null<Size>()), tolerance_(Null<Real>()), seed_(0),
+      pathsPerBlock_(0) {}
 
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>&
@@ -347,6 +473,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withPathBlocks(Size pathsPerBlock) {
+        pathsPerBlock_ = pathsPerBlock;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -364,7 +497,8 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    biased_,
-                                   seed_));
+                                   seed_,
+                                   pathsPerBlock_));
     }
 
 }
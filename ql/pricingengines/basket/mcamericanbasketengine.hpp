@@ -61,7 +61,8 @@ namespace QuantLib {
                                Size nCalibrationSamples = Null<Size>(),
                                Size polynomOrder = 2,
                                LsmBasisSystem::PolynomType
-                                   polynomType = LsmBasisSystem::Monomial);
+                                   polynomType = LsmBasisSystem::Monomial,
+                               bool streamingCalibration = false);
       protected:
         ext::shared_ptr<LongstaffSchwartzPathPricer<MultiPath> > lsmPathPricer() const override;
 
@@ -89,6 +90,7 @@ namespace QuantLib {
         MakeMCAmericanBasketEngine& withPolynomialOrder(Size polynmOrder);
         MakeMCAmericanBasketEngine&
             withBasisSystem(LsmBasisSystem::PolynomType polynomType);
+        MakeMCAmericanBasketEngine& withStreamingCalibration(bool b = true);
 
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
@@ -100,6 +102,7 @@ namespace QuantLib {
         LsmBasisSystem::PolynomType polynomType_;
         Real tolerance_;
         BigNatural seed_;
+        bool streamingCalibration_;
     };
 
 
@@ -140,7 +143,8 @@ namespace QuantLib {
                    BigNatural seed,
                    Size nCalibrationSamples,
                    Size polynomOrder,
-                   LsmBasisSystem::PolynomType polynomType)
+                   LsmBasisSystem::PolynomType polynomType,
+                   bool streamingCalibration)
         : MCLongstaffSchwartzEngine<BasketOption::engine,
                                     MultiVariate,RNG>(processes,
                                                       timeSteps,
@@ -152,7 +156,11 @@ namespace QuantLib {
                                                       requiredTolerance,
                                                       maxSamples,
                                                       seed,
-                                                      nCalibrationSamples),
+                                                      nCalibrationSamples,
+                                                      boost::none,
+                                                      boost::none,
+                                                      Null<Size>(),
+                                                      streamingCalibration),
           polynomOrder_(polynomOrder), polynomType_(polynomType) {}
 
     template <class RNG>
@@ -197,7 +205,8 @@ namespace QuantLib {
     : process_(std::move(process)), brownianBridge_(false), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()), samples_(Null<Size>()),
       maxSamples_(Null<Size>()), calibrationSamples_(Null<Size>()), polynomOrder_(2),
-      polynomType_(LsmBasisSystem::Monomial), tolerance_(Null<Real>()), seed_(0) {}
+      polynomType_(LsmBasisSystem::Monomial), tolerance_(Null<Real>()), seed_(0),
+      streamingCalibration_(false) {}
 
     template <class RNG>
     inline MakeMCAmericanBasketEngine<RNG>&
@@ -284,6 +293,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG>
+    inline MakeMCAmericanBasketEngine<RNG>&
+    MakeMCAmericanBasketEngine<RNG>::withStreamingCalibration(bool b) {
+        streamingCalibration_ = b;
+        return *this;
+    }
+
     template <class RNG>
     inline
     MakeMCAmericanBasketEngine<RNG>::operator
@@ -304,7 +320,8 @@ namespace QuantLib {
                                         seed_,
                                         calibrationSamples_,
                                         polynomOrder_,
-                                        polynomType_));
+                                        polynomType_,
+                                        streamingCalibration_));
     }
 
 }
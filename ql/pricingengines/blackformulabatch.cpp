@@ -0,0 +1,368 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/blackformulabatch.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        // Arguments of a batch, with one value for each option.
+        // Arguments passed with a single value are expanded.
+        class BatchArguments {
+          public:
+            explicit BatchArguments(Size size) : size_(size) {
+                buffers_.reserve(6);
+            }
+            static Size size(std::initializer_list<Size> sizes) {
+                return std::max(sizes);
+            }
+            const Real* values(const Array& a, const char* name) {
+                if (a.size() == size_)
+                    return a.begin();
+                QL_REQUIRE(a.size() == 1,
+                           "wrong number of " << name << " (" << a.size()
+                           << "); " << size_ << " or 1 required");
+                buffers_.emplace_back(size_, a[0]);
+                return buffers_.back().begin();
+            }
+            const Real* values(const std::vector<Option::Type>& types) {
+                QL_REQUIRE(types.size() == size_ || types.size() == 1,
+                           "wrong number of option types (" << types.size()
+                           << "); " << size_ << " or 1 required");
+                buffers_.emplace_back(size_);
+                Array& signs = buffers_.back();
+                for (Size i=0; i<size_; ++i)
+                    signs[i] = types.size() == 1 ? types[0] : types[i];
+                return signs.begin();
+            }
+          private:
+            Size size_;
+            std::vector<Array> buffers_;
+        };
+
+        void checkParameters(Size i, Real strike, Real forward,
+                             Real displacement, Real discount) {
+            QL_REQUIRE(displacement >= 0.0,
+                       "displacement (" << displacement
+                       << ") must be non-negative for option " << i);
+            QL_REQUIRE(strike + displacement >= 0.0,
+                       "strike + displacement (" << strike << " + "
+                       << displacement
+                       << ") must be non-negative for option " << i);
+            QL_REQUIRE(forward + displacement > 0.0,
+                       "forward + displacement (" << forward << " + "
+                       << displacement
+                       << ") must be positive for option " << i);
+            QL_REQUIRE(discount > 0.0,
+                       "discount (" << discount
+                       << ") must be positive for option " << i);
+        }
+
+        void checkStdDev(Size i, Real stdDev) {
+            QL_REQUIRE(stdDev >= 0.0,
+                       "stdDev (" << stdDev
+                       << ") must be non-negative for option " << i);
+        }
+
+        // d1 for a null standard deviation is calculated with the
+        // smallest positive one, which gives the correct limits of
+        // the cumulative normal distribution
+        void calculateD1(Size n, const Real* strikes, const Real* forwards,
+                         const Real* stdDevs, const Real* displacements,
+                         Real* d1) {
+            for (Size i=0; i<n; ++i) {
+                const Real s = std::max(stdDevs[i], QL_MIN_POSITIVE_REAL);
+                d1[i] = std::log((forwards[i] + displacements[i]) /
+                                 (strikes[i] + displacements[i])) / s
+                    + 0.5*s;
+            }
+        }
+
+    }
+
+    Array blackFormula(const std::vector<Option::Type>& optionTypes,
+                       const Array& strikes,
+                       const Array& forwards,
+                       const Array& stdDevs,
+                       const Array& discounts,
+                       const Array& displacements) {
+        const Size n = BatchArguments::size(
+            {optionTypes.size(), strikes.size(), forwards.size(),
+             stdDevs.size(), discounts.size(), displacements.size()});
+        BatchArguments args(n);
+        const Real* w = args.values(optionTypes);
+        const Real* K = args.values(strikes, "strikes");
+        const Real* F = args.values(forwards, "forwards");
+        const Real* s = args.values(stdDevs, "standard deviations");
+        const Real* df = args.values(discounts, "discounts");
+        const Real* dd = args.values(displacements, "displacements");
+
+        for (Size i=0; i<n; ++i) {
+            checkParameters(i, K[i], F[i], dd[i], df[i]);
+            checkStdDev(i, s[i]);
+        }
+
+        Array d1(n), d2(n), result(n);
+        calculateD1(n, K, F, s, dd, d1.begin());
+        for (Size i=0; i<n; ++i) {
+            d2[i] = w[i]*(d1[i] - s[i]);
+            d1[i] = w[i]*d1[i];
+        }
+        const CumulativeNormalDistribution phi;
+        phi.transform(d1.begin(), d1.end(), d1.begin());
+        phi.transform(d2.begin(), d2.end(), d2.begin());
+        for (Size i=0; i<n; ++i)
+            result[i] = df[i] * w[i] *
+                ((F[i] + dd[i])*d1[i] - (K[i] + dd[i])*d2[i]);
+        return result;
+    }
+
+    Array blackFormulaForwardDerivative(
+                       const std::vector<Option::Type>& optionTypes,
+                       const Array& strikes,
+                       const Array& forwards,
+                       const Array& stdDevs,
+                       const Array& discounts,
+                       const Array& displacements) {
+        const Size n = BatchArguments::size(
+            {optionTypes.size(), strikes.size(), forwards.size(),
+             stdDevs.size(), discounts.size(), displacements.size()});
+        BatchArguments args(n);
+        const Real* w = args.values(optionTypes);
+        const Real* K = args.values(strikes, "strikes");
+        const Real* F = args.values(forwards, "forwards");
+        const Real* s = args.values(stdDevs, "standard deviations");
+        const Real* df = args.values(discounts, "discounts");
+        const Real* dd = args.values(displacements, "displacements");
+
+        for (Size i=0; i<n; ++i) {
+            checkParameters(i, K[i], F[i], dd[i], df[i]);
+            checkStdDev(i, s[i]);
+        }
+
+        Array d1(n), result(n);
+        calculateD1(n, K, F, s, dd, d1.begin());
+        for (Size i=0; i<n; ++i)
+            d1[i] *= w[i];
+        CumulativeNormalDistribution().transform(d1.begin(), d1.end(),
+                                                 d1.begin());
+        for (Size i=0; i<n; ++i) {
+            // at-the-money options without volatility have null delta
+            const bool null = s[i] == 0.0 && F[i] == K[i];
+            result[i] = null ? 0.0 : w[i] * d1[i] * df[i];
+        }
+        return result;
+    }
+
+    Array blackFormulaStdDevDerivative(const Array& strikes,
+                                       const Array& forwards,
+                                       const Array& stdDevs,
+                                       const Array& discounts,
+                                       const Array& displacements) {
+        const Size n = BatchArguments::size(
+            {strikes.size(), forwards.size(), stdDevs.size(),
+             discounts.size(), displacements.size()});
+        BatchArguments args(n);
+        const Real* K = args.values(strikes, "strikes");
+        const Real* F = args.values(forwards, "forwards");
+        const Real* s = args.values(stdDevs, "standard deviations");
+        const Real* df = args.values(discounts, "discounts");
+        const Real* dd = args.values(displacements, "displacements");
+
+        for (Size i=0; i<n; ++i) {
+            checkParameters(i, K[i], F[i], dd[i], df[i]);
+            checkStdDev(i, s[i]);
+        }
+
+        Array d1(n), result(n);
+        calculateD1(n, K, F, s, dd, d1.begin());
+        for (Size i=0; i<n; ++i) {
+            const Real d = std::min(std::fabs(d1[i]), Real(40.0));
+            const Real vega = df[i] * (F[i] + dd[i])
+                * M_SQRT_2 * M_1_SQRTPI * std::exp(-0.5*d*d);
+            const bool null = s[i] == 0.0 || K[i] + dd[i] == 0.0;
+            result[i] = null ? 0.0 : vega;
+        }
+        return result;
+    }
+
+    Array blackFormulaImpliedStdDev(
+                       const std::vector<Option::Type>& optionTypes,
+                       const Array& strikes,
+                       const Array& forwards,
+                       const Array& blackPrices,
+                       const Array& discounts,
+                       const Array& displacements,
+                       Real accuracy,
+                       Natural maxIterations) {
+        const Size n = BatchArguments::size(
+            {optionTypes.size(), strikes.size(), forwards.size(),
+             blackPrices.size(), discounts.size(), displacements.size()});
+        BatchArguments args(n);
+        const Real* w = args.values(optionTypes);
+        const Real* K = args.values(strikes, "strikes");
+        const Real* F = args.values(forwards, "forwards");
+        const Real* p = args.values(blackPrices, "prices");
+        const Real* df = args.values(discounts, "discounts");
+        const Real* dd = args.values(displacements, "displacements");
+
+        for (Size i=0; i<n; ++i) {
+            checkParameters(i, K[i], F[i], dd[i], df[i]);
+            QL_REQUIRE(p[i] >= 0.0,
+                       "option price (" << p[i]
+                       << ") must be non-negative for option " << i);
+            QL_REQUIRE(p[i] - w[i]*(F[i]-K[i])*df[i] >= 0.0,
+                       "negative price implied by put-call parity"
+                       " for option " << i);
+        }
+
+        // The problem is normalized as in P. Jaeckel, "Let's be
+        // rational", 2013: with x = ln(F/K), the out-of-the-money
+        // price divided by sqrt(FK) is
+        //   b(s) = e^{x/2} N(x/s + s/2) - e^{-x/2} N(x/s - s/2)
+        // for calls and -b(s) with opposite x for puts.
+        Array x(n), theta(n), beta(n), stdDev(n);
+        for (Size i=0; i<n; ++i) {
+            const Real f = F[i] + dd[i], k = K[i] + dd[i];
+            const bool itm = w[i]*(f - k) > 0.0;
+            const Real otm = p[i]/df[i] - (itm ? w[i]*(f - k) : 0.0);
+            theta[i] = itm ? -w[i] : w[i];
+            x[i] = std::log(f/k);
+            beta[i] = otm / std::sqrt(f*k);
+
+            // Radoicic-Stefanica guess, as in
+            // blackFormulaImpliedStdDevApproximationRS; the guess is
+            // replaced by the inflection point of b(s) when not usable
+            const Real ey = f/k, ey2 = ey*ey, y = x[i];
+            const Real alpha = p[i]/(k*df[i]);
+            const Real R = 2.0*alpha + w[i]*(1.0 - ey);
+            const Real R2 = R*R;
+            const Real a = std::exp((1.0-M_2_PI)*y);
+            const Real A = (a - 1.0/a)*(a - 1.0/a);
+            const Real b = std::exp(M_2_PI*y);
+            const Real B = 4.0*(b + 1.0/b)
+                - 2.0/ey*(a + 1.0/a)*(ey2 + 1.0 - R2);
+            const Real C =
+                (R2 - (ey-1.0)*(ey-1.0))*((ey+1.0)*(ey+1.0) - R2)/ey2;
+            const Real g =
+                -M_PI_2*std::log(2.0*C/(B + std::sqrt(B*B + 4.0*A*C)));
+            const Real ay = std::fabs(y);
+            const Real root = std::sqrt(1.0 - std::exp(-2.0*M_2_PI*ay));
+            // price divided by the strike at the inflection point
+            const Real M0 = y >= 0.0
+                ? (w[i] > 0.0 ? 0.5*ey*(1.0 + root) - 0.5
+                              : 0.5 - 0.5*ey*(1.0 - root))
+                : (w[i] > 0.0 ? 0.5*ey - 0.5*(1.0 - root)
+                              : 0.5*(1.0 + root) - 0.5*ey);
+            const Real guess = alpha <= M0
+                ? std::sqrt(g + ay) - std::sqrt(g - ay)
+                : std::sqrt(g + y) + std::sqrt(g - y);
+            const bool valid = guess > 0.0 && guess < QL_MAX_REAL;
+            stdDev[i] = valid ? guess : std::max(std::sqrt(2.0*ay), Real(0.1));
+        }
+
+        // Halley iterations on the whole batch; options already
+        // converged stay at the solution
+        std::vector<char> converged(n, 0);
+        Size remaining = n;
+        Array d1(n), d2(n), ex(n);
+        for (Size i=0; i<n; ++i)
+            ex[i] = std::exp(0.5*x[i]);
+        const CumulativeNormalDistribution phi;
+        const Natural passes = std::min<Natural>(maxIterations, 10);
+        for (Natural k=0; k<passes && remaining>0; ++k) {
+            for (Size i=0; i<n; ++i) {
+                const Real s = stdDev[i];
+                d1[i] = theta[i]*(x[i]/s + 0.5*s);
+                d2[i] = theta[i]*(x[i]/s - 0.5*s);
+            }
+            phi.transform(d1.begin(), d1.end(), d1.begin());
+            phi.transform(d2.begin(), d2.end(), d2.begin());
+            remaining = 0;
+            for (Size i=0; i<n; ++i) {
+                const Real s = stdDev[i], x2 = x[i]*x[i];
+                const Real b = theta[i]*(ex[i]*d1[i] - d2[i]/ex[i]);
+                const Real vega = M_SQRT_2 * M_1_SQRTPI
+                    * std::exp(-0.5*(x2/(s*s) + 0.25*s*s));
+                const Real newton = (b - beta[i])/vega;
+                const Real h = x2/(s*s*s) - 0.25*s;
+                const Real d = 1.0 - 0.5*newton*h;
+                const Real step = d > 0.5 ? newton/d : newton;
+                const Real next = s - step;
+                const bool done = std::fabs(step) <= accuracy;
+                stdDev[i] = next > 0.0 ? next : 0.5*s;
+                converged[i] = done ? 1 : 0;
+                remaining += done ? 0 : 1;
+            }
+        }
+
+        for (Size i=0; i<n; ++i) {
+            if (beta[i] == 0.0) {
+                stdDev[i] = 0.0;
+            } else if (!converged[i]) {
+                stdDev[i] = QuantLib::blackFormulaImpliedStdDev(
+                    w[i] > 0.0 ? Option::Call : Option::Put,
+                    K[i], F[i], p[i], df[i], dd[i], Null<Real>(),
+                    accuracy, maxIterations);
+            }
+        }
+        return stdDev;
+    }
+
+    Array bachelierBlackFormula(const std::vector<Option::Type>& optionTypes,
+                                const Array& strikes,
+                                const Array& forwards,
+                                const Array& stdDevs,
+                                const Array& discounts) {
+        const Size n = BatchArguments::size(
+            {optionTypes.size(), strikes.size(), forwards.size(),
+             stdDevs.size(), discounts.size()});
+        BatchArguments args(n);
+        const Real* w = args.values(optionTypes);
+        const Real* K = args.values(strikes, "strikes");
+        const Real* F = args.values(forwards, "forwards");
+        const Real* s = args.values(stdDevs, "standard deviations");
+        const Real* df = args.values(discounts, "discounts");
+
+        for (Size i=0; i<n; ++i) {
+            checkStdDev(i, s[i]);
+            QL_REQUIRE(df[i] > 0.0,
+                       "discount (" << df[i]
+                       << ") must be positive for option " << i);
+        }
+
+        Array h(n), result(n);
+        for (Size i=0; i<n; ++i)
+            h[i] = w[i]*(F[i] - K[i])
+                / std::max(s[i], QL_MIN_POSITIVE_REAL);
+        for (Size i=0; i<n; ++i) {
+            const Real d = std::min(std::fabs(h[i]), Real(40.0));
+            result[i] = df[i] * s[i]
+                * M_SQRT_2 * M_1_SQRTPI * std::exp(-0.5*d*d);
+        }
+        CumulativeNormalDistribution().transform(h.begin(), h.end(),
+                                                 h.begin());
+        for (Size i=0; i<n; ++i)
+            result[i] += df[i] * w[i]*(F[i] - K[i]) * h[i];
+        return result;
+    }
+
+}
@@ -0,0 +1,102 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file blackformulabatch.hpp
+    \brief Black formulas for batches of options
+*/
+
+#ifndef quantlib_blackformula_batch_hpp
+#define quantlib_blackformula_batch_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/option.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    /*! \defgroup batchblackformulas Black formulas for batches of options
+
+        These functions evaluate the corresponding functions in
+        blackformula.hpp for a batch of options.  Each argument can
+        contain either one value for each option or a single value
+        used for all of them.
+
+        The arguments are checked once, before any calculation; the
+        calculations are then performed in loops over contiguous
+        arrays without branches, which compilers can vectorize, and
+        the cumulative normal distribution is calculated by
+        CumulativeNormalDistribution::transform.
+
+        @{
+    */
+
+    //! Black 1976 formula
+    Array blackFormula(const std::vector<Option::Type>& optionTypes,
+                       const Array& strikes,
+                       const Array& forwards,
+                       const Array& stdDevs,
+                       const Array& discounts = Array(1, 1.0),
+                       const Array& displacements = Array(1, 0.0));
+
+    //! Black 1976 formula, derivative with respect to the forward
+    Array blackFormulaForwardDerivative(
+                       const std::vector<Option::Type>& optionTypes,
+                       const Array& strikes,
+                       const Array& forwards,
+                       const Array& stdDevs,
+                       const Array& discounts = Array(1, 1.0),
+                       const Array& displacements = Array(1, 0.0));
+
+    //! Black 1976 formula, derivative with respect to the standard deviation
+    Array blackFormulaStdDevDerivative(
+                       const Array& strikes,
+                       const Array& forwards,
+                       const Array& stdDevs,
+                       const Array& discounts = Array(1, 1.0),
+                       const Array& displacements = Array(1, 0.0));
+
+    //! Black 1976 implied standard deviation
+    /*! The initial guess is given by the approximation of Radoicic
+        and Stefanica (see blackFormulaImpliedStdDevApproximationRS)
+        and is refined by Halley iterations on the normalized Black
+        price, performed on the whole batch until all the options
+        converge.  The few options which don't converge within the
+        given number of iterations are solved one by one by
+        blackFormulaImpliedStdDev.
+    */
+    Array blackFormulaImpliedStdDev(
+                       const std::vector<Option::Type>& optionTypes,
+                       const Array& strikes,
+                       const Array& forwards,
+                       const Array& blackPrices,
+                       const Array& discounts = Array(1, 1.0),
+                       const Array& displacements = Array(1, 0.0),
+                       Real accuracy = 1.0e-6,
+                       Natural maxIterations = 100);
+
+    //! Bachelier formula
+    Array bachelierBlackFormula(const std::vector<Option::Type>& optionTypes,
+                                const Array& strikes,
+                                const Array& forwards,
+                                const Array& stdDevs,
+                                const Array& discounts = Array(1, 1.0));
+
+    /*! @} */
+
+}
+
+#endif
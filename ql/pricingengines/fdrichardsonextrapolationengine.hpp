@@ -0,0 +1,216 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdrichardsonextrapolationengine.hpp
+    \brief Richardson extrapolation of two finite-difference engines
+*/
+
+#ifndef quantlib_fd_richardson_extrapolation_engine_hpp
+#define quantlib_fd_richardson_extrapolation_engine_hpp
+
+#include <ql/instrument.hpp>
+#include <ql/math/richardsonextrapolation.hpp>
+#include <ql/option.hpp>
+#include <ql/pricingengine.hpp>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Richardson extrapolation of a coarse and a fine finite-difference engine
+    /*! The instrument is priced by two instances of the same
+        finite-difference engine, the fine one using grids that are
+        finer by the given scaling factor in every direction, e.g.
+        FdBlackScholesVanillaEngine(process, 50, 100) and
+        FdBlackScholesVanillaEngine(process, 100, 200).  The value and
+        the available greeks are then extrapolated to a vanishing grid
+        size assuming the given order of convergence, and the error
+        estimate is set to the difference between the extrapolated
+        and the fine result.  The results of the fine and of the
+        coarse engine are returned as the additional results
+        "fineValue" and "coarseValue".
+
+        If requested, the coarse solve runs in a separate thread
+        while the fine one runs in the calling thread.  As the
+        engines register with their processes while calculating,
+        this requires either QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN or
+        QL_ENABLE_RCU_OBSERVER_PATTERN.  The
+        sweeps of each solve can be multi-threaded in any case by
+        passing FdmSchemeDesc::withThreads() to the wrapped engines.
+
+        The argument and result types must be the ones of the wrapped
+        engines, e.g. DividendVanillaOption::arguments and
+        DividendVanillaOption::results for FdBlackScholesVanillaEngine
+        and FdHestonVanillaEngine, or Swaption::arguments and
+        Swaption::results for FdG2SwaptionEngine.
+
+        \warning the concurrent solves are only safe if the
+                 calculations of both engines don't modify other
+                 shared objects, e.g. lazy term structures which
+                 haven't been calculated before.
+
+        \ingroup engines
+    */
+    template <class ArgumentsType, class ResultsType>
+    class FdRichardsonExtrapolationEngine
+        : public GenericEngine<ArgumentsType, ResultsType> {
+      public:
+        FdRichardsonExtrapolationEngine(
+            ext::shared_ptr<PricingEngine> coarseEngine,
+            ext::shared_ptr<PricingEngine> fineEngine,
+            Real scalingFactor = 2.0,
+            Real order = 2.0,
+            bool concurrent = false);
+
+        void calculate() const override;
+
+      private:
+        void solve(PricingEngine& engine) const;
+        Real extrapolate(Real coarse, Real fine) const;
+
+        template <class R>
+        void extrapolateGreeks(const R&, const R&, std::false_type) const {}
+        template <class R>
+        void extrapolateGreeks(const R& coarse, const R& fine,
+                               std::true_type) const;
+
+        const ext::shared_ptr<PricingEngine> coarseEngine_, fineEngine_;
+        const Real scalingFactor_, order_;
+        const bool concurrent_;
+    };
+
+
+    template <class ArgumentsType, class ResultsType>
+    inline FdRichardsonExtrapolationEngine<ArgumentsType, ResultsType>::
+    FdRichardsonExtrapolationEngine(
+        ext::shared_ptr<PricingEngine> coarseEngine,
+        ext::shared_ptr<PricingEngine> fineEngine,
+        Real scalingFactor, Real order, bool concurrent)
+    : coarseEngine_(std::move(coarseEngine)),
+      fineEngine_(std::move(fineEngine)),
+      scalingFactor_(scalingFactor), order_(order),
+      concurrent_(concurrent) {
+        QL_REQUIRE(coarseEngine_ && fineEngine_, "null engine given");
+        QL_REQUIRE(coarseEngine_ != fineEngine_,
+                   "coarse and fine engine must be different instances");
+        QL_REQUIRE(scalingFactor_ > 1.0,
+                   "scaling factor must be greater than 1");
+        QL_REQUIRE(order_ > 0.0, "positive order of convergence required");
+        #if !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) && \
+            !defined(QL_ENABLE_RCU_OBSERVER_PATTERN)
+        QL_REQUIRE(!concurrent_, "concurrent solves require "
+                   "QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN or "
+                   "QL_ENABLE_RCU_OBSERVER_PATTERN");
+        #endif
+
+        this->registerWith(coarseEngine_);
+        this->registerWith(fineEngine_);
+    }
+
+    template <class ArgumentsType, class ResultsType>
+    inline void
+    FdRichardsonExtrapolationEngine<ArgumentsType, ResultsType>::solve(
+        PricingEngine& engine) const {
+        auto* arguments =
+            dynamic_cast<ArgumentsType*>(engine.getArguments());
+        QL_REQUIRE(arguments != nullptr, "wrong engine argument type");
+
+        *arguments = this->arguments_;
+        engine.reset();
+        engine.calculate();
+    }
+
+    template <class ArgumentsType, class ResultsType>
+    inline Real
+    FdRichardsonExtrapolationEngine<ArgumentsType, ResultsType>::extrapolate(
+        Real coarse, Real fine) const {
+        if (coarse == Null<Real>() || fine == Null<Real>())
+            return Null<Real>();
+
+        return RichardsonExtrapolation(
+            [=](Real h) { return (h == 1.0) ? coarse : fine; },
+            1.0, order_)(scalingFactor_);
+    }
+
+    template <class ArgumentsType, class ResultsType>
+    template <class R>
+    inline void
+    FdRichardsonExtrapolationEngine<ArgumentsType, ResultsType>::
+    extrapolateGreeks(const R& coarse, const R& fine,
+                      std::true_type) const {
+        this->results_.delta = extrapolate(coarse.delta, fine.delta);
+        this->results_.gamma = extrapolate(coarse.gamma, fine.gamma);
+        this->results_.theta = extrapolate(coarse.theta, fine.theta);
+        this->results_.vega = extrapolate(coarse.vega, fine.vega);
+        this->results_.rho = extrapolate(coarse.rho, fine.rho);
+        this->results_.dividendRho =
+            extrapolate(coarse.dividendRho, fine.dividendRho);
+    }
+
+    template <class ArgumentsType, class ResultsType>
+    inline void
+    FdRichardsonExtrapolationEngine<ArgumentsType, ResultsType>::calculate()
+        const {
+
+        if (concurrent_) {
+            std::exception_ptr error;
+            std::thread coarse([&]() {
+                try {
+                    solve(*coarseEngine_);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            });
+            try {
+                solve(*fineEngine_);
+            } catch (...) {
+                coarse.join();
+                throw;
+            }
+            coarse.join();
+            if (error)
+                std::rethrow_exception(error);
+        } else {
+            solve(*coarseEngine_);
+            solve(*fineEngine_);
+        }
+
+        const auto* coarse =
+            dynamic_cast<const ResultsType*>(coarseEngine_->getResults());
+        const auto* fine =
+            dynamic_cast<const ResultsType*>(fineEngine_->getResults());
+        QL_REQUIRE(coarse != nullptr && fine != nullptr,
+                   "wrong engine result type");
+
+        this->results_.value = extrapolate(coarse->value, fine->value);
+        this->results_.errorEstimate =
+            (this->results_.value != Null<Real>())
+            ? std::fabs(this->results_.value - fine->value)
+            : Null<Real>();
+        this->results_.valuationDate = fine->valuationDate;
+        this->results_.additionalResults["coarseValue"] = coarse->value;
+        this->results_.additionalResults["fineValue"] = fine->value;
+
+        extrapolateGreeks(*coarse, *fine,
+                          std::is_base_of<Greeks, ResultsType>());
+    }
+
+}
+
+#endif
@@ -30,6 +30,7 @@
 #include <ql/exercise.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
 #include <ql/methods/montecarlo/longstaffschwartzpathpricer.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
 
 
 namespace QuantLib {
@@ -68,7 +69,11 @@ namespace QuantLib {
           calibration and pricing; note however that this has no effect
           for low discrepancy RNGs usually, it is therefore recommended
           to use pseudo random generators for the calibration phase always
-          (and possibly quasi monte carlo in the subsequent pricing). */
+          (and possibly quasi monte carlo in the subsequent pricing).
+
+          If streamingCalibration is set, the calibration paths are not
+          stored but regenerated from the calibration seed for every
+          exercise date; see LongstaffSchwartzPathPricer::calibrate. */
         MCLongstaffSchwartzEngine(ext::shared_ptr<StochasticProcess> process,
                                   Size timeSteps,
                                   Size timeStepsPerYear,
@@ -82,7 +87,8 @@ namespace QuantLib {
                                   Size nCalibrationSamples = Null<Size>(),
                                   boost::optional<bool> brownianBridgeCalibration = boost::none,
                                   boost::optional<bool> antitheticVariateCalibration = boost::none,
-                                  BigNatural seedCalibration = Null<Size>());
+                                  BigNatural seedCalibration = Null<Size>(),
+                                  bool streamingCalibration = false);
 
         void calculate() const override;
 
@@ -93,6 +99,8 @@ namespace QuantLib {
         TimeGrid timeGrid() const override;
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
         ext::shared_ptr<path_generator_type> pathGenerator() const override;
+        // the calibrated path pricer is shared and collects statistics
+        bool allowsParallelSimulation() const override { return false; }
 
         ext::shared_ptr<StochasticProcess> process_;
         const Size timeSteps_;
@@ -106,6 +114,7 @@ namespace QuantLib {
         const bool brownianBridgeCalibration_;
         const bool antitheticVariateCalibration_;
         const BigNatural seedCalibration_;
+        const bool streamingCalibration_;
 
         mutable ext::shared_ptr<LongstaffSchwartzPathPricer<path_type> >
             pathPricer_;
@@ -133,7 +142,8 @@ namespace QuantLib {
                                   Size nCalibrationSamples,
                                   boost::optional<bool> brownianBridgeCalibration,
                                   boost::optional<bool> antitheticVariateCalibration,
-                                  BigNatural seedCalibration)
+                                  BigNatural seedCalibration,
+                                  bool streamingCalibration)
     : McSimulation<MC, RNG, S>(antitheticVariate, controlVariate), process_(std::move(process)),
       timeSteps_(timeSteps), timeStepsPerYear_(timeStepsPerYear), brownianBridge_(brownianBridge),
       requiredSamples_(requiredSamples), requiredTolerance_(requiredTolerance),
@@ -146,7 +156,8 @@ namespace QuantLib {
           // NOLINTNEXTLINE(readability-implicit-bool-conversion)
           antitheticVariateCalibration ? *antitheticVariateCalibration : antitheticVariate),
       seedCalibration_(seedCalibration != Null<Real>() ? seedCalibration :
-                                                         (seed == 0 ? 0 : seed + 1768237423L)) {
+                                                         (seed == 0 ? 0 : seed + 1768237423L)),
+      streamingCalibration_(streamingCalibration) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -181,21 +192,44 @@ namespace QuantLib {
         pathPricer_ = this->lsmPathPricer();
         Size dimensions = process_->factors();
         TimeGrid grid = this->timeGrid();
-        typename RNG_Calibration::rsg_type generator =
-            RNG_Calibration::make_sequence_generator(
-                dimensions * (grid.size() - 1), seedCalibration_);
-        ext::shared_ptr<path_generator_type_calibration>
-            pathGeneratorCalibration =
-                ext::make_shared<path_generator_type_calibration>(
-                    process_, grid, generator, brownianBridgeCalibration_);
-        mcModelCalibration_ =
-            ext::shared_ptr<MonteCarloModel<MC, RNG_Calibration, S> >(
-                new MonteCarloModel<MC, RNG_Calibration, S>(
-                    pathGeneratorCalibration, pathPricer_, stats_type(),
-                    this->antitheticVariateCalibration_));
+        if (streamingCalibration_) {
+            // a null seed would draw a new one on each regeneration;
+            // we draw it once, so that every pass sees the same paths
+            const BigNatural seed = (seedCalibration_ != 0)
+                ? seedCalibration_
+                : SeedGenerator::instance().get();
+            const auto regenerate = [&](
+                const typename LongstaffSchwartzPathPricer<
+                    path_type>::PathVisitor& visit) {
+                path_generator_type_calibration generator(
+                    process_, grid,
+                    RNG_Calibration::make_sequence_generator(
+                        dimensions * (grid.size() - 1), seed),
+                    brownianBridgeCalibration_);
+                for (Size i=0; i<nCalibrationSamples_; ++i) {
+                    visit(generator.next().value);
+                    if (antitheticVariateCalibration_)
+                        visit(generator.antithetic().value);
+                }
+            };
+            pathPricer_->calibrate(regenerate);
+        } else {
+            typename RNG_Calibration::rsg_type generator =
+                RNG_Calibration::make_sequence_generator(
+                    dimensions * (grid.size() - 1), seedCalibration_);
+            ext::shared_ptr<path_generator_type_calibration>
+                pathGeneratorCalibration =
+                    ext::make_shared<path_generator_type_calibration>(
+                        process_, grid, generator, brownianBridgeCalibration_);
+            mcModelCalibration_ =
+                ext::shared_ptr<MonteCarloModel<MC, RNG_Calibration, S> >(
+                    new MonteCarloModel<MC, RNG_Calibration, S>(
+                        pathGeneratorCalibration, pathPricer_, stats_type(),
+                        this->antitheticVariateCalibration_));
 
-        mcModelCalibration_->addSamples(nCalibrationSamples_);
-        pathPricer_->calibrate();
+            mcModelCalibration_->addSamples(nCalibrationSamples_);
+            pathPricer_->calibrate();
+        }
         // pricing
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
                                           requiredSamples_,
@@ -27,16 +27,84 @@
 #define quantlib_montecarlo_engine_hpp
 
 #include <ql/grid.hpp>
+#include <ql/methods/montecarlo/blockmontecarlomodel.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
+#include <ql/methods/montecarlo/montecarlosettings.hpp>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace QuantLib {
 
+    namespace detail {
+
+        /* Accumulator storing the samples of a block of a parallel
+           simulation, so that they can be added to the main
+           accumulator in a deterministic order once the block is
+           done. */
+        template <class T>
+        class McSampleBlock {
+          public:
+            typedef T value_type;
+            void add(const T& value, Real weight = 1.0) {
+                data_.emplace_back(value, weight);
+            }
+            Size samples() const { return data_.size(); }
+            const std::vector<std::pair<T,Real> >& data() const {
+                return data_;
+            }
+            void reset() { data_.clear(); }
+          private:
+            std::vector<std::pair<T,Real> > data_;
+        };
+
+        // true if the statistics class provides a merge() method
+        template <class S, class = void>
+        struct McMergeableStatistics : std::false_type {};
+
+        template <class S>
+        struct McMergeableStatistics<
+            S, decltype(std::declval<S&>().merge(std::declval<const S&>()))>
+            : std::true_type {};
+
+    }
+
     //! base class for Monte Carlo engines
     /*! Eventually this class might offer greeks methods.  Deriving a
         class from McSimulation gives an easy way to write a Monte
         Carlo engine.
 
         See McVanillaEngine as an example.
+
+        Engines with scalar results can also provide a block path
+        generator and pricer (see BlockPathGenerator and
+        BlockPathPricer); when blockPathPricer() returns a non-null
+        pricer, the samples are simulated in blocks of paths by a
+        BlockMonteCarloModel.  The samples are the same as the ones
+        of the path-by-path simulation; only the way they are
+        calculated changes.
+
+        If MonteCarloSettings::samplesPerBlock() is set, the samples
+        are simulated in independent blocks, each using its own path
+        generator and pricer obtained from the corresponding
+        factory methods; see MonteCarloSettings for details.  If
+        the statistics class provides a merge() method (see, e.g.,
+        MergeableStatistics) each block collects its samples in its
+        own accumulator, which is then merged into the main one;
+        otherwise, the samples of each block are stored and added to
+        the main accumulator one by one.
+
+        \warning in block mode, the path generators and pricers of
+                 different blocks run concurrently and must not share
+                 any mutable state; engines which can't guarantee that
+                 must override allowsParallelSimulation().  The first
+                 block is simulated on the calling thread before the
+                 others are started, so that lazy objects used by the
+                 process or the pricer are calculated beforehand.
     */
 
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -49,6 +117,8 @@ namespace QuantLib {
         typedef typename MonteCarloModel<MC,RNG,S>::stats_type
             stats_type;
         typedef typename MonteCarloModel<MC,RNG,S>::result_type result_type;
+        typedef typename BlockMonteCarloModel<RNG>::path_generator_type
+            block_path_generator_type;
 
         virtual ~McSimulation() = default;
         //! add samples until the required absolute tolerance is reached
@@ -87,6 +157,23 @@ namespace QuantLib {
         virtual result_type controlVariateValue() const {
             return Null<result_type>();
         }
+        //! pricer of blocks of paths, or null if not available
+        virtual ext::shared_ptr<BlockPathPricer> blockPathPricer() const {
+            return ext::shared_ptr<BlockPathPricer>();
+        }
+        //! used together with blockPathPricer()
+        virtual ext::shared_ptr<block_path_generator_type>
+        blockPathGenerator() const {
+            return ext::shared_ptr<block_path_generator_type>();
+        }
+        virtual ext::shared_ptr<BlockPathPricer>
+        controlBlockPathPricer() const {
+            return ext::shared_ptr<BlockPathPricer>();
+        }
+        //! whether blocks of samples can be simulated concurrently
+        virtual bool allowsParallelSimulation() const {
+            return true;
+        }
         template <class Sequence>
         static Real maxError(const Sequence& sequence) {
             return *std::max_element(sequence.begin(), sequence.end());
@@ -97,6 +184,44 @@ namespace QuantLib {
         
         mutable ext::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+      private:
+        typedef detail::McSampleBlock<Real> path_block_samples;
+        void addSamples(Size samples) const;
+        template <class T>
+        ext::shared_ptr<MonteCarloModel<MC,RNG,T> > makeModel() const;
+        // block models are only available for scalar results
+        ext::shared_ptr<BlockMonteCarloModel<RNG> > makeBlockModel() const {
+            return makeBlockModel(std::is_same<result_type,Real>());
+        }
+        ext::shared_ptr<BlockMonteCarloModel<RNG> >
+        makeBlockModel(std::true_type) const;
+        ext::shared_ptr<BlockMonteCarloModel<RNG> >
+        makeBlockModel(std::false_type) const {
+            return ext::shared_ptr<BlockMonteCarloModel<RNG> >();
+        }
+        void addBlockSamples(const path_block_samples& samples) const {
+            addBlockSamples(samples, std::is_same<result_type,Real>());
+        }
+        void addBlockSamples(const path_block_samples& samples,
+                             std::true_type) const {
+            mcModel_->addSamples(samples.data().begin(),
+                                 samples.data().end());
+        }
+        void addBlockSamples(const path_block_samples&,
+                             std::false_type) const {
+            QL_FAIL("block path pricers require scalar results");
+        }
+        void mergeSamples(const detail::McSampleBlock<result_type>& samples)
+                                                                    const {
+            mcModel_->addSamples(samples.data().begin(),
+                                 samples.data().end());
+        }
+        template <class T>
+        void mergeSamples(const T& samples) const {
+            mcModel_->mergeSamples(samples);
+        }
+        mutable result_type controlVariateValue_;
+        mutable ext::shared_ptr<BlockMonteCarloModel<RNG> > blockModel_;
     };
 
 
@@ -109,7 +234,7 @@ namespace QuantLib {
         Size sampleNumber =
             mcModel_->sampleAccumulator().samples();
         if (sampleNumber<minSamples) {
-            mcModel_->addSamples(minSamples-sampleNumber);
+            addSamples(minSamples-sampleNumber);
             sampleNumber = mcModel_->sampleAccumulator().samples();
         }
 
@@ -131,7 +256,7 @@ namespace QuantLib {
             // do not exceed maxSamples
             nextBatch = std::min(nextBatch, maxSamples-sampleNumber);
             sampleNumber += nextBatch;
-            mcModel_->addSamples(nextBatch);
+            addSamples(nextBatch);
             error = result_type(mcModel_->sampleAccumulator().errorEstimate());
         }
 
@@ -149,7 +274,7 @@ namespace QuantLib {
                    "number of already simulated samples (" << sampleNumber
                    << ") greater than requested samples (" << samples << ")");
 
-        mcModel_->addSamples(samples-sampleNumber);
+        addSamples(samples-sampleNumber);
 
         return result_type(mcModel_->sampleAccumulator().mean());
     }
@@ -166,46 +291,178 @@ namespace QuantLib {
 
         //! Initialize the one-factor Monte Carlo
         if (this->controlVariate_) {
-
-            result_type controlVariateValue = this->controlVariateValue();
-            QL_REQUIRE(controlVariateValue != Null<result_type>(),
+            controlVariateValue_ = this->controlVariateValue();
+            QL_REQUIRE(controlVariateValue_ != Null<result_type>(),
                        "engine does not provide "
                        "control-variation price");
+        }
+        this->mcModel_ = makeModel<S>();
+        this->blockModel_ = makeBlockModel();
+
+        if (requiredTolerance != Null<Real>()) {
+            if (maxSamples != Null<Size>())
+                this->value(requiredTolerance, maxSamples);
+            else
+                this->value(requiredTolerance);
+        } else {
+            this->valueWithSamples(requiredSamples);
+        }
+
+    }
 
+    template <template <class> class MC, class RNG, class S>
+    template <class T>
+    inline ext::shared_ptr<MonteCarloModel<MC,RNG,T> >
+    McSimulation<MC,RNG,S>::makeModel() const {
+        if (this->controlVariate_) {
             ext::shared_ptr<path_pricer_type> controlPP =
                 this->controlPathPricer();
             QL_REQUIRE(controlPP,
                        "engine does not provide "
                        "control-variation path pricer");
 
-            ext::shared_ptr<path_generator_type> controlPG = 
+            ext::shared_ptr<path_generator_type> controlPG =
                 this->controlPathGenerator();
 
-            this->mcModel_ =
-                ext::shared_ptr<MonteCarloModel<MC,RNG,S> >(
-                    new MonteCarloModel<MC,RNG,S>(
-                           pathGenerator(), this->pathPricer(), stats_type(),
+            return ext::make_shared<MonteCarloModel<MC,RNG,T> >(
+                           pathGenerator(), this->pathPricer(), T(),
                            this->antitheticVariate_, controlPP,
-                           controlVariateValue, controlPG));
+                           controlVariateValue_, controlPG);
         } else {
-            this->mcModel_ =
-                ext::shared_ptr<MonteCarloModel<MC,RNG,S> >(
-                    new MonteCarloModel<MC,RNG,S>(
-                           pathGenerator(), this->pathPricer(), S(),
-                           this->antitheticVariate_));
+            return ext::make_shared<MonteCarloModel<MC,RNG,T> >(
+                           pathGenerator(), this->pathPricer(), T(),
+                           this->antitheticVariate_);
         }
+    }
 
-        if (requiredTolerance != Null<Real>()) {
-            if (maxSamples != Null<Size>())
-                this->value(requiredTolerance, maxSamples);
-            else
-                this->value(requiredTolerance);
+
+    template <template <class> class MC, class RNG, class S>
+    inline ext::shared_ptr<BlockMonteCarloModel<RNG> >
+    McSimulation<MC,RNG,S>::makeBlockModel(std::true_type) const {
+        ext::shared_ptr<BlockPathPricer> pricer = this->blockPathPricer();
+        if (!pricer)
+            return ext::shared_ptr<BlockMonteCarloModel<RNG> >();
+
+        ext::shared_ptr<block_path_generator_type> generator =
+            this->blockPathGenerator();
+        QL_REQUIRE(generator,
+                   "engine does not provide block path generator");
+
+        if (this->controlVariate_) {
+            ext::shared_ptr<BlockPathPricer> controlPP =
+                this->controlBlockPathPricer();
+            QL_REQUIRE(controlPP,
+                       "engine does not provide "
+                       "control-variation block path pricer");
+            return ext::make_shared<BlockMonteCarloModel<RNG> >(
+                           generator, pricer, this->antitheticVariate_,
+                           controlPP, controlVariateValue_);
         } else {
-            this->valueWithSamples(requiredSamples);
+            return ext::make_shared<BlockMonteCarloModel<RNG> >(
+                           generator, pricer, this->antitheticVariate_);
         }
+    }
 
+
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::addSamples(Size samples) const {
+        const Size blockSize =
+            MonteCarloSettings::instance().samplesPerBlock();
+        if (blockSize == 0 || !this->allowsParallelSimulation()) {
+            if (blockModel_) {
+                // samples are merged after each block of paths so
+                // that the storage doesn't grow with their number
+                const Size paths =
+                    blockModel_->pathGenerator()->pathsPerBlock();
+                path_block_samples data;
+                while (samples > 0) {
+                    Size n = std::min(samples, paths);
+                    blockModel_->addSamples(n, data);
+                    addBlockSamples(data);
+                    data.reset();
+                    samples -= n;
+                }
+            } else {
+                mcModel_->addSamples(samples);
+            }
+            return;
+        }
+
+        typedef typename std::conditional<
+            detail::McMergeableStatistics<S>::value,
+            S, detail::McSampleBlock<result_type> >::type block_type;
+        typedef MonteCarloModel<MC,RNG,block_type> block_model;
+
+        #ifdef _OPENMP
+        const Size blocksPerBatch = 4*Size(omp_get_max_threads());
+        #else
+        const Size blocksPerBatch = 1;
+        #endif
+
+        // the offset of each block in the random sequence only
+        // depends on the samples simulated before, which makes
+        // results independent of the scheduling of the blocks.
+        Size offset = mcModel_->sampleAccumulator().samples();
+        bool firstBatch = true;
+        while (samples > 0) {
+            // generators and pricers are created on the calling thread...
+            std::vector<ext::shared_ptr<block_model> > models;
+            std::vector<ext::shared_ptr<BlockMonteCarloModel<RNG> > >
+                blockModels;
+            std::vector<Size> sizes;
+            while (samples > 0 && sizes.size() < blocksPerBatch) {
+                Size n = std::min(samples, blockSize);
+                RandomStreamSelector stream(offset);
+                if (blockModel_)
+                    blockModels.push_back(makeBlockModel());
+                else
+                    models.push_back(makeModel<block_type>());
+                sizes.push_back(n);
+                offset += n;
+                samples -= n;
+            }
+            std::vector<path_block_samples> blockData(blockModels.size());
+
+            // ...and the blocks are simulated concurrently.
+            auto simulate = [&](Size i) {
+                if (blockModel_)
+                    blockModels[i]->addSamples(sizes[i], blockData[i]);
+                else
+                    models[i]->addSamples(sizes[i]);
+            };
+            Size first = 0;
+            if (firstBatch) {
+                simulate(0);
+                first = 1;
+                firstBatch = false;
+            }
+            std::vector<std::string> errors(sizes.size());
+            #ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic)
+            #endif
+            for (long i=long(first); i<long(sizes.size()); ++i) {
+                try {
+                    simulate(i);
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                } catch (...) {
+                    errors[i] = "unknown error";
+                }
+            }
+
+            for (Size i=0; i<sizes.size(); ++i) {
+                QL_REQUIRE(errors[i].empty(),
+                           "error in Monte Carlo block: " << errors[i]);
+                if (blockModel_) {
+                    addBlockSamples(blockData[i]);
+                } else {
+                    mergeSamples(models[i]->sampleAccumulator());
+                }
+            }
+        }
     }
 
+
     template <template <class> class MC, class RNG, class S>
     inline typename McSimulation<MC,RNG,S>::result_type
         McSimulation<MC,RNG,S>::errorEstimate() const {
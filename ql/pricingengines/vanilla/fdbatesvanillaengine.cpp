@@ -66,5 +66,8 @@ namespace QuantLib {
         results_.delta = solver->deltaAt(spot, v0);
         results_.gamma = solver->gammaAt(spot, v0);
         results_.theta = solver->thetaAt(spot, v0);
+        results_.additionalResults["timeSteps"] = solver->numberOfSteps();
+        results_.additionalResults["rejectedTimeSteps"] =
+            solver->rejectedSteps();
     }
 }
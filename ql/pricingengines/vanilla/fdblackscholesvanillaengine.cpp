@@ -21,14 +21,19 @@
 
 #include <ql/exercise.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmultistrikemesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/predefined1dmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/solvers/fdm1dimmultipayoffsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmquantohelper.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -70,6 +75,25 @@ namespace QuantLib {
 
     void FdBlackScholesVanillaEngine::calculate() const {
 
+        // cache lookup for precalculated results
+        for (auto& cachedArgs2result : cachedArgs2results_) {
+            if (cachedArgs2result.first.exercise->type() == arguments_.exercise->type() &&
+                cachedArgs2result.first.exercise->dates() == arguments_.exercise->dates() &&
+                arguments_.cashFlow.empty()) {
+                ext::shared_ptr<PlainVanillaPayoff> p1 =
+                    ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                            arguments_.payoff);
+                ext::shared_ptr<PlainVanillaPayoff> p2 =
+                    ext::dynamic_pointer_cast<PlainVanillaPayoff>(cachedArgs2result.first.payoff);
+
+                if ((p1 != nullptr) && p1->strike() == p2->strike() &&
+                    p1->optionType() == p2->optionType()) {
+                    results_ = cachedArgs2result.second;
+                    return;
+                }
+            }
+        }
+
         // 0. Cash dividend model
         const Date exerciseDate = arguments_.exercise->lastDate();
         const Time maturity = process_->time(exerciseDate);
@@ -114,6 +138,12 @@ namespace QuantLib {
         const ext::shared_ptr<StrikedTypePayoff> payoff =
             ext::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
 
+        if (!strikes_.empty() && arguments_.cashFlow.empty()
+            && ext::dynamic_pointer_cast<PlainVanillaPayoff>(payoff)) {
+            calculateMultipleStrikes(payoff, maturity);
+            return;
+        }
+
         const ext::shared_ptr<Fdm1dMesher> equityMesher(
             new FdmBlackScholesMesher(
                     xGrid_, process_, maturity, payoff->strike(), 
@@ -156,6 +186,100 @@ namespace QuantLib {
         results_.delta = solver->deltaAt(spot);
         results_.gamma = solver->gammaAt(spot);
         results_.theta = solver->thetaAt(spot);
+        results_.additionalResults["timeSteps"] = solver->numberOfSteps();
+        results_.additionalResults["rejectedTimeSteps"] =
+            solver->rejectedSteps();
+    }
+
+    void FdBlackScholesVanillaEngine::calculateMultipleStrikes(
+        const ext::shared_ptr<StrikedTypePayoff>& payoff,
+        Time maturity) const {
+
+        std::vector<Real> strikes(strikes_);
+        if (std::find(strikes.begin(), strikes.end(), payoff->strike())
+                == strikes.end())
+            strikes.push_back(payoff->strike());
+
+        std::vector<ext::shared_ptr<Payoff> > payoffs;
+        payoffs.reserve(strikes.size());
+        for (Real strike : strikes)
+            payoffs.push_back(ext::make_shared<PlainVanillaPayoff>(
+                payoff->optionType(), strike));
+
+        // 1. Mesher, with the payoff index as second, static direction
+        const ext::shared_ptr<Fdm1dMesher> equityMesher(
+            new FdmBlackScholesMultiStrikeMesher(
+                xGrid_, process_, maturity, strikes, 0.0001, 1.5,
+                std::pair<Real, Real>(payoff->strike(), 0.1)));
+
+        std::vector<Real> payoffIndex(strikes.size());
+        for (Size i=0; i < payoffIndex.size(); ++i)
+            payoffIndex[i] = Real(i);
+
+        const ext::shared_ptr<FdmMesher> mesher(
+            new FdmMesherComposite(
+                equityMesher,
+                ext::make_shared<Predefined1dMesher>(payoffIndex)));
+
+        // 2. Calculator
+        const ext::shared_ptr<FdmInnerValueCalculator> calculator(
+            new FdmMultiPayoffInnerValue(payoffs, mesher, 0, 1));
+
+        // 3. Step conditions
+        const ext::shared_ptr<FdmStepConditionComposite> conditions =
+            FdmStepConditionComposite::vanillaComposite(
+                DividendSchedule(), arguments_.exercise, mesher, calculator,
+                process_->riskFreeRate()->referenceDate(),
+                process_->riskFreeRate()->dayCounter());
+
+        // 4. Boundary conditions
+        const FdmBoundaryConditionSet boundaries;
+
+        // 5. Solver
+        FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
+                                     maturity, tGrid_, dampingSteps_ };
+
+        const ext::shared_ptr<FdmLinearOpComposite> op(
+            ext::make_shared<FdmBlackScholesOp>(
+                mesher, process_, strikes, 1, localVol_,
+                illegalLocalVolOverwrite_, 0, quantoHelper_));
+
+        const Fdm1DimMultiPayoffSolver solver(solverDesc, schemeDesc_, op);
+
+        const Real spot = process_->x0();
+        const Real x = std::log(spot);
+
+        cachedArgs2results_.resize(strikes.size());
+        for (Size i=0; i < strikes.size(); ++i) {
+            cachedArgs2results_[i].first.exercise = arguments_.exercise;
+            cachedArgs2results_[i].first.payoff = payoffs[i];
+
+            DividendVanillaOption::results&
+                                results = cachedArgs2results_[i].second;
+
+            const Real dX = solver.derivativeX(i, x);
+            results.value = solver.interpolateAt(i, x);
+            results.delta = dX/spot;
+            results.gamma = (solver.derivativeXX(i, x) - dX)/(spot*spot);
+            results.theta = solver.thetaAt(i, x);
+            results.additionalResults["timeSteps"] = solver.numberOfSteps();
+            results.additionalResults["rejectedTimeSteps"] =
+                solver.rejectedSteps();
+
+            if (strikes[i] == payoff->strike())
+                results_ = results;
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::update() {
+        cachedArgs2results_.clear();
+        DividendVanillaOption::engine::update();
+    }
+
+    void FdBlackScholesVanillaEngine::enableMultipleStrikesCaching(
+                                        const std::vector<Real>& strikes) {
+        strikes_ = strikes;
+        cachedArgs2results_.clear();
     }
 
     MakeFdBlackScholesVanillaEngine::MakeFdBlackScholesVanillaEngine(
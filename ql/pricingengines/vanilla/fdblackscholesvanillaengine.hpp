@@ -70,7 +70,21 @@ namespace QuantLib {
 
         void calculate() const override;
 
+        void update() override;
+
+        /*! rolls back the options with the given strikes together
+            with the one being priced, in a single backward solve,
+            and caches their results for later calculations of options
+            with the same exercise and option type.  Options with
+            discrete dividends are priced one at a time.
+        */
+        void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
+
       private:
+        void calculateMultipleStrikes(
+            const ext::shared_ptr<StrikedTypePayoff>& payoff,
+            Time maturity) const;
+
         const ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         const Size tGrid_, xGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
@@ -78,6 +92,11 @@ namespace QuantLib {
         const Real illegalLocalVolOverwrite_;
         const ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
         const CashDividendModel cashDividendModel_;
+
+        std::vector<Real> strikes_;
+        mutable std::vector<std::pair<DividendVanillaOption::arguments,
+                                      DividendVanillaOption::results> >
+                                                            cachedArgs2results_;
     };
 
 
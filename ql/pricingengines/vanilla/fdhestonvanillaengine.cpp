@@ -176,6 +176,9 @@ namespace QuantLib {
         results_.delta = solver->deltaAt(spot, v0);
         results_.gamma = solver->gammaAt(spot, v0);
         results_.theta = solver->thetaAt(spot, v0);
+        results_.additionalResults["timeSteps"] = solver->numberOfSteps();
+        results_.additionalResults["rejectedTimeSteps"] =
+            solver->rejectedSteps();
         
         cachedArgs2results_.resize(strikes_.size());
         const ext::shared_ptr<StrikedTypePayoff> payoff =
@@ -193,6 +196,7 @@ namespace QuantLib {
             results.delta = solver->deltaAt(spot*d, v0);
             results.gamma = solver->gammaAt(spot*d, v0)*d;
             results.theta = solver->thetaAt(spot*d, v0)/d;                
+            results.additionalResults = results_.additionalResults;
         }
     }
     
@@ -64,7 +64,8 @@ namespace QuantLib {
                          LsmBasisSystem::PolynomType polynomType,
                          Size nCalibrationSamples = Null<Size>(),
                          const boost::optional<bool>& antitheticVariateCalibration = boost::none,
-                         BigNatural seedCalibration = Null<Size>());
+                         BigNatural seedCalibration = Null<Size>(),
+                         bool streamingCalibration = false);
 
         void calculate() const override;
 
@@ -120,6 +121,7 @@ namespace QuantLib {
         MakeMCAmericanEngine& withCalibrationSamples(Size calibrationSamples);
         MakeMCAmericanEngine& withAntitheticVariateCalibration(bool b = true);
         MakeMCAmericanEngine& withSeedCalibration(BigNatural seed);
+        MakeMCAmericanEngine& withStreamingCalibration(bool b = true);
 
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
@@ -134,6 +136,7 @@ namespace QuantLib {
         LsmBasisSystem::PolynomType polynomType_;
         boost::optional<bool> antitheticCalibration_;
         BigNatural seedCalibration_;
+        bool streamingCalibration_;
     };
 
     template <class RNG, class S, class RNG_Calibration>
@@ -151,7 +154,8 @@ namespace QuantLib {
         LsmBasisSystem::PolynomType polynomType,
         Size nCalibrationSamples,
         const boost::optional<bool>& antitheticVariateCalibration,
-        BigNatural seedCalibration)
+        BigNatural seedCalibration,
+        bool streamingCalibration)
     : MCLongstaffSchwartzEngine<VanillaOption::engine, SingleVariate, RNG, S, RNG_Calibration>(
           process,
           timeSteps,
@@ -166,7 +170,8 @@ namespace QuantLib {
           nCalibrationSamples,
           false,
           antitheticVariateCalibration,
-          seedCalibration),
+          seedCalibration,
+          streamingCalibration),
       polynomOrder_(polynomOrder), polynomType_(polynomType) {}
 
     template <class RNG, class S, class RNG_Calibration>
@@ -269,7 +274,7 @@ namespace QuantLib {
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()), samples_(Null<Size>()),
       maxSamples_(Null<Size>()), calibrationSamples_(2048), tolerance_(Null<Real>()), seed_(0),
       polynomOrder_(2), polynomType_(LsmBasisSystem::Monomial), antitheticCalibration_(boost::none),
-      seedCalibration_(Null<Size>()) {}
+      seedCalibration_(Null<Size>()), streamingCalibration_(false) {}
 
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
@@ -377,6 +382,14 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withStreamingCalibration(
+        bool b) {
+        streamingCalibration_ = b;
+        return *this;
+    }
+
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration>::
     operator ext::shared_ptr<PricingEngine>() const {
@@ -397,7 +410,8 @@ namespace QuantLib {
                                      polynomType_,
                                      calibrationSamples_,
                                      antitheticCalibration_,
-                                     seedCalibration_));
+                                     seedCalibration_,
+                                     streamingCalibration_));
     }
 
 }
@@ -26,6 +26,7 @@
 #ifndef quantlib_montecarlo_european_engine_hpp
 #define quantlib_montecarlo_european_engine_hpp
 
+#include <ql/methods/montecarlo/blockpathpricer.hpp>
 #include <ql/pricingengines/vanilla/mcvanillaengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
@@ -50,7 +51,13 @@ namespace QuantLib {
             path_pricer_type;
         typedef typename MCVanillaEngine<SingleVariate,RNG,S>::stats_type
             stats_type;
+        typedef typename MCVanillaEngine<SingleVariate,RNG,S>::
+            block_path_generator_type block_path_generator_type;
         // constructor
+        /*! If pathsPerBlock is not null, the paths are generated
+            and priced in blocks of the given size (see
+            BlockPathGenerator.)
+        */
         MCEuropeanEngine(
              const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
              Size timeSteps,
@@ -60,9 +67,14 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size pathsPerBlock = 0);
       protected:
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
+        ext::shared_ptr<BlockPathPricer> blockPathPricer() const override;
+        ext::shared_ptr<block_path_generator_type>
+        blockPathGenerator() const override;
+        Size pathsPerBlock_;
     };
 
     //! Monte Carlo European engine factory
@@ -79,6 +91,7 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanEngine& withPathBlocks(Size pathsPerBlock);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -88,6 +101,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size pathsPerBlock_;
     };
 
     class EuropeanPathPricer : public PathPricer<Path> {
@@ -102,6 +116,20 @@ namespace QuantLib {
         DiscountFactor discount_;
     };
 
+    class EuropeanBlockPathPricer : public BlockPathPricer {
+      public:
+        EuropeanBlockPathPricer(Option::Type type,
+                                Real strike,
+                                DiscountFactor discount);
+        void operator()(const PathBlock& paths,
+                        std::vector<Real>& values) const override;
+
+      private:
+        Option::Type type_;
+        Real strike_;
+        DiscountFactor discount_;
+    };
+
 
     // inline definitions
 
@@ -116,7 +144,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             Size pathsPerBlock)
     : MCVanillaEngine<SingleVariate,RNG,S>(process,
                                            timeSteps,
                                            timeStepsPerYear,
@@ -126,7 +155,8 @@ namespace QuantLib {
                                            requiredSamples,
                                            requiredTolerance,
                                            maxSamples,
-                                           seed) {}
+                                           seed),
+      pathsPerBlock_(pathsPerBlock) {}
 
 
     template <class RNG, class S>
@@ -153,12 +183,50 @@ namespace QuantLib {
     }
 
 
+    template <class RNG, class S>
+    inline ext::shared_ptr<BlockPathPricer>
+    MCEuropeanEngine<RNG,S>::blockPathPricer() const {
+        if (pathsPerBlock_ == 0)
+            return ext::shared_ptr<BlockPathPricer>();
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+            ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+
+        return ext::shared_ptr<BlockPathPricer>(
+          new EuropeanBlockPathPricer(
+              payoff->optionType(),
+              payoff->strike(),
+              process->riskFreeRate()->discount(this->timeGrid().back())));
+    }
+
+
+    template <class RNG, class S>
+    inline ext::shared_ptr<
+        typename MCEuropeanEngine<RNG,S>::block_path_generator_type>
+    MCEuropeanEngine<RNG,S>::blockPathGenerator() const {
+        TimeGrid grid = this->timeGrid();
+        typename RNG::rsg_type generator =
+            RNG::make_sequence_generator(grid.size()-1, this->seed_);
+        return ext::make_shared<block_path_generator_type>(
+                   this->process_, grid, generator,
+                   this->brownianBridge_, pathsPerBlock_);
+    }
+
+
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG, S>::MakeMCEuropeanEngine(
         ext::shared_ptr<GeneralizedBlackScholesProcess> process)
     : process_(std::move(process)), antithetic_(false), steps_(Null<Size>()),
       stepsPerYear_(Null<Size>()), samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0),
+      pathsPerBlock_(0) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
@@ -223,6 +291,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withPathBlocks(Size pathsPerBlock) {
+        pathsPerBlock_ = pathsPerBlock;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -239,7 +314,8 @@ namespace QuantLib {
                                     antithetic_,
                                     samples_, tolerance_,
                                     maxSamples_,
-                                    seed_));
+                                    seed_,
+                                    pathsPerBlock_));
     }
 
 
@@ -257,6 +333,35 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+
+    inline EuropeanBlockPathPricer::EuropeanBlockPathPricer(
+                                                   Option::Type type,
+                                                   Real strike,
+                                                   DiscountFactor discount)
+    : type_(type), strike_(strike), discount_(discount) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+    }
+
+    inline void EuropeanBlockPathPricer::operator()(
+                                   const PathBlock& paths,
+                                   std::vector<Real>& values) const {
+        const Real* x = paths.values(paths.length()-1);
+        const Size n = paths.size();
+        switch (type_) {
+          case Option::Call:
+            for (Size j=0; j<n; ++j)
+                values[j] = std::max<Real>(x[j]-strike_, 0.0) * discount_;
+            break;
+          case Option::Put:
+            for (Size j=0; j<n; ++j)
+                values[j] = std::max<Real>(strike_-x[j], 0.0) * discount_;
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
 }
 
 
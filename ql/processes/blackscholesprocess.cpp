@@ -224,6 +224,12 @@ namespace QuantLib {
     }
 
 
+    bool GeneralizedBlackScholesProcess::hasExactEvolution() const {
+        localVolatility(); // trigger update
+        return isStrikeIndependent_ && !forceDiscretization_;
+    }
+
+
     // specific models
 
     BlackScholesProcess::BlackScholesProcess(
@@ -96,6 +96,13 @@ namespace QuantLib {
         const Handle<YieldTermStructure>& riskFreeRate() const;
         const Handle<BlackVolTermStructure>& blackVolatility() const;
         const Handle<LocalVolTermStructure>& localVolatility() const;
+        /*! returns whether evolve() uses the exact log-normal
+            transition, i.e., whether the volatility is
+            strike-independent and no discretization is forced.
+            In this case, the parameters of the transition only
+            depend on the time and not on the state of the process.
+        */
+        bool hasExactEvolution() const;
         //@}
       private:
         Handle<Quote> x0_;
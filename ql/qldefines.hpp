@@ -116,6 +116,15 @@
     #endif
 #endif
 
+#ifdef QL_ENABLE_RCU_OBSERVER_PATTERN
+    #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+        #error The thread-safe and RCU observer patterns cannot be enabled together
+    #endif
+    #if BOOST_VERSION < 105800
+        #error Boost version 1.58 or higher is required for the RCU observer pattern
+    #endif
+#endif
+
 #ifdef QL_ENABLE_PARALLEL_UNIT_TEST_RUNNER
     #if BOOST_VERSION < 105900
         #error Boost version 1.59 or higher is required for the parallel unit test runner
@@ -36,6 +36,11 @@ namespace QuantLib {
 
     class MultiCurveSensitivities;
 
+    namespace detail {
+        template <class PiecewiseCurve>
+        class PiecewiseCurvePillars;
+    }
+
     //! Piecewise yield term structure
     /*! This term structure is bootstrapped on a number of interest
         rate instruments which are passed as a vector of pointers to
@@ -265,6 +270,7 @@ namespace QuantLib {
         // it would increase the complexity---which is high enough
         // already.
         friend class MultiCurveSensitivities;
+        friend class detail::PiecewiseCurvePillars<this_curve>;
         friend class Bootstrap<this_curve>;
         friend class BootstrapError<this_curve> ;
         friend class PenaltyFunction<this_curve>;
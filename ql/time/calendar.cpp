@@ -24,9 +24,388 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <ql/utilities/null.hpp>
+#include <bitset>
 
 namespace QuantLib {
 
+    /* Layout of the cache entries.  Each word holds in its
+       highest 24 bits the tag of the version of the holidays for
+       which it was filled, so that entries filled for an earlier
+       version, possibly after the holidays changed, are ignored.
+
+       businessDays: bits 0-31 flag the business days of the block;
+                     bit 32 is set if the calendar rejects any of
+                     its days, e.g., before an exchange was
+                     established, in which case they are flagged in
+                     invalidDays.
+       invalidDays:  bits 0-31 flag the days rejected by the calendar.
+       counts:       bits 0-19 and 20-39 hold the number of business
+                     days and of rejected days between the counts
+                     origin and the block, negative if the block
+                     precedes the origin.  The origin is the first
+                     block for which counts were asked, so that they
+                     are only filled from there on.
+    */
+
+    namespace {
+
+        const Date::serial_type firstBlock =
+            Date::minDate().serialNumber() >> 5;
+        const Date::serial_type lastBlock =
+            Date::maxDate().serialNumber() >> 5;
+
+        const std::uint64_t invalidDaysFlag = std::uint64_t(1) << 32;
+        const std::uint64_t blockMask = (std::uint64_t(1) << 40) - 1;
+        const Integer countsBias = 1 << 19;
+
+        Integer countBits(std::uint32_t x) {
+            return Integer(std::bitset<32>(x).count());
+        }
+
+        bool hasTag(std::uint64_t word, std::uint64_t tag) {
+            return (word >> 40) == (tag >> 40);
+        }
+
+        // whether all the days of a block filled for the given tag
+        // can be read from its flags
+        bool isComplete(std::uint64_t flags, std::uint64_t tag) {
+            return hasTag(flags, tag) && (flags & invalidDaysFlag) == 0;
+        }
+
+        std::uint64_t packCounts(Integer businessDays,
+                                 Integer invalidDays,
+                                 std::uint64_t tag) {
+            return std::uint64_t(businessDays + countsBias)
+                | (std::uint64_t(invalidDays + countsBias) << 20)
+                | tag;
+        }
+
+        Integer businessDayCount(std::uint64_t counts) {
+            return Integer(counts & 0xFFFFF) - countsBias;
+        }
+
+        Integer invalidDayCount(std::uint64_t counts) {
+            return Integer((counts >> 20) & 0xFFFFF) - countsBias;
+        }
+
+        // index of the lowest set bit; x must not be null
+        Integer lowestBit(std::uint32_t x) {
+            #if defined(__GNUC__)
+            return __builtin_ctz(x);
+            #else
+            Integer i = 0;
+            while ((x & 1U) == 0U) {
+                x >>= 1;
+                ++i;
+            }
+            return i;
+            #endif
+        }
+
+        // index of the highest set bit; x must not be null
+        Integer highestBit(std::uint32_t x) {
+            #if defined(__GNUC__)
+            return 31 - __builtin_clz(x);
+            #else
+            Integer i = 31;
+            while ((x & 0x80000000U) == 0U) {
+                x <<= 1;
+                --i;
+            }
+            return i;
+            #endif
+        }
+
+        // index of the n-th lowest set bit, starting from 1
+        Integer nthLowestBit(std::uint32_t x, Integer n) {
+            while (--n > 0)
+                x &= x - 1;
+            return lowestBit(x);
+        }
+
+    }
+
+    Calendar::Impl::Cache::Cache(const Cache& other)
+    : version(other.version.load(std::memory_order_acquire)) {}
+
+    Calendar::Impl::Cache&
+    Calendar::Impl::Cache::operator=(const Cache& other) {
+        // the business days of the target might change with the
+        // assigned holidays, so its entries are tagged as stale
+        if (this != &other)
+            version.fetch_add(1, std::memory_order_acq_rel);
+        return *this;
+    }
+
+    Calendar::Impl::Cache::~Cache() {
+        delete[] blocks.load();
+    }
+
+    unsigned long Calendar::Impl::holidaysVersion() const {
+        return cache_.version.load(std::memory_order_acquire);
+    }
+
+    void Calendar::clearCachedBusinessDays() {
+        impl_->cache_.version.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    unsigned long Calendar::holidaysVersion(const Calendar& c) {
+        QL_REQUIRE(c.impl_, "no calendar implementation provided");
+        return c.impl_->holidaysVersion();
+    }
+
+    bool Calendar::isBusinessDayUncached(const Date& d) const {
+#ifdef QL_HIGH_RESOLUTION_DATE
+        const Date _d(d.dayOfMonth(), d.month(), d.year());
+#else
+        const Date& _d = d;
+#endif
+
+        if (!impl_->addedHolidays.empty() &&
+            impl_->addedHolidays.find(_d) != impl_->addedHolidays.end())
+            return false;
+
+        if (!impl_->removedHolidays.empty() &&
+            impl_->removedHolidays.find(_d) != impl_->removedHolidays.end())
+            return true;
+
+        return impl_->isBusinessDay(_d);
+    }
+
+    bool Calendar::isBusinessDayInBlock(const Date& d,
+                                        std::uint64_t flags,
+                                        std::uint64_t tag) const {
+        const Date::serial_type serial = d.serialNumber();
+        if (hasTag(flags, tag)) {
+            const std::uint64_t invalidDays =
+                cachedBlocks()[serial >> 5].invalidDays.load(
+                                                 std::memory_order_acquire);
+            // rejected days are passed to the calendar again, so
+            // that it raises the corresponding error
+            if (hasTag(invalidDays, tag)
+                && ((invalidDays >> (serial & 31)) & 1U) == 0U)
+                return ((flags >> (serial & 31)) & 1U) != 0U;
+        }
+        return isBusinessDayUncached(d);
+    }
+
+    Calendar::Impl::CachedBlock* Calendar::cachedBlocks() const {
+        Impl::CachedBlock* cache =
+            impl_->cache_.blocks.load(std::memory_order_acquire);
+        if (cache == nullptr) {
+            // the entries of the last block+1 hold the total counts
+            auto* newCache = new Impl::CachedBlock[lastBlock + 2];
+            if (impl_->cache_.blocks.compare_exchange_strong(
+                    cache, newCache, std::memory_order_acq_rel)) {
+                cache = newCache;
+            } else {
+                // another thread got there first
+                delete[] newCache;
+            }
+        }
+        return cache;
+    }
+
+    std::uint64_t Calendar::fillBusinessDays(Date::serial_type block,
+                                             std::uint64_t tag) const {
+        Impl::CachedBlock* cache = cachedBlocks();
+        if (block < firstBlock || block > lastBlock)
+            return 0;
+
+        // dates out of range are flagged as holidays
+        std::uint64_t flags = 0, invalidDays = 0;
+        const Date::serial_type first =
+            std::max(block << 5, Date::minDate().serialNumber());
+        const Date::serial_type last =
+            std::min((block << 5) + 31, Date::maxDate().serialNumber());
+        for (Date::serial_type i=first; i<=last; ++i) {
+            try {
+                if (isBusinessDayUncached(Date(i)))
+                    flags |= std::uint64_t(1) << (i & 31);
+            } catch (Error&) {
+                invalidDays |= std::uint64_t(1) << (i & 31);
+            }
+        }
+        if (invalidDays != 0) {
+            // stored first, so that it's there when the flags are read
+            cache[block].invalidDays.store(invalidDays | tag,
+                                           std::memory_order_release);
+            flags |= invalidDaysFlag;
+        }
+        flags |= tag;
+        cache[block].businessDays.store(flags, std::memory_order_release);
+        return flags;
+    }
+
+    Date::serial_type Calendar::countsOrigin(Date::serial_type block,
+                                             std::uint64_t tag) const {
+        std::uint64_t origin =
+            impl_->cache_.countsOrigin.load(std::memory_order_acquire);
+        while (!hasTag(origin, tag)) {
+            if (impl_->cache_.countsOrigin.compare_exchange_weak(
+                    origin, block | tag, std::memory_order_acq_rel))
+                return block;
+        }
+        return Date::serial_type(origin & blockMask);
+    }
+
+    std::uint64_t Calendar::blockCounts(Date::serial_type block,
+                                        std::uint64_t tag) const {
+        Impl::CachedBlock* cache = cachedBlocks();
+        std::uint64_t counts =
+            cache[block].counts.load(std::memory_order_acquire);
+        if (hasTag(counts, tag))
+            return counts;
+
+        // the counts are filled from the nearest block that has them,
+        // or from the origin, to the given one
+        const Date::serial_type origin = countsOrigin(block, tag);
+        Date::serial_type i = block;
+        if (block >= origin) {
+            while (i > origin && !hasTag(cache[i].counts.load(
+                                   std::memory_order_acquire), tag))
+                --i;
+        } else {
+            while (i < origin && !hasTag(cache[i].counts.load(
+                                   std::memory_order_acquire), tag))
+                ++i;
+        }
+        counts = cache[i].counts.load(std::memory_order_acquire);
+        Integer business = 0, invalid = 0;
+        if (hasTag(counts, tag)) {
+            business = businessDayCount(counts);
+            invalid = invalidDayCount(counts);
+        } else {
+            cache[i].counts.store(packCounts(0, 0, tag),
+                                  std::memory_order_release);
+        }
+
+        auto add = [&](Date::serial_type b, Integer sign) {
+            const std::uint64_t flags = businessDays(b, tag);
+            business += sign * countBits(std::uint32_t(flags));
+            if ((flags & invalidDaysFlag) != 0)
+                invalid += sign * countBits(std::uint32_t(
+                    cache[b].invalidDays.load(std::memory_order_acquire)));
+        };
+        for (; i < block; ++i) {
+            add(i, 1);
+            cache[i+1].counts.store(
+                packCounts(business, invalid, tag),
+                std::memory_order_release);
+        }
+        for (; i > block; --i) {
+            add(i-1, -1);
+            cache[i-1].counts.store(
+                packCounts(business, invalid, tag),
+                std::memory_order_release);
+        }
+        return packCounts(business, invalid, tag);
+    }
+
+    Date::serial_type Calendar::nextBusinessDay(Date::serial_type d,
+                                                bool backwards) const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        const std::uint64_t tag = cacheTag();
+        Date::serial_type block = d >> 5;
+        const Integer offset = Integer(d & 31);
+        std::uint64_t cached = businessDays(block, tag);
+        if (!isComplete(cached, tag))
+            return Null<Date::serial_type>();
+        std::uint32_t flags = std::uint32_t(cached);
+        if (backwards) {
+            flags &= 0xFFFFFFFFU >> (31 - offset);
+            while (flags == 0) {
+                if (block <= firstBlock)
+                    return Null<Date::serial_type>();
+                cached = businessDays(--block, tag);
+                if (!isComplete(cached, tag))
+                    return Null<Date::serial_type>();
+                flags = std::uint32_t(cached);
+            }
+            return (block << 5) + highestBit(flags);
+        } else {
+            flags &= 0xFFFFFFFFU << offset;
+            while (flags == 0) {
+                if (block >= lastBlock)
+                    return Null<Date::serial_type>();
+                cached = businessDays(++block, tag);
+                if (!isComplete(cached, tag))
+                    return Null<Date::serial_type>();
+                flags = std::uint32_t(cached);
+            }
+            return (block << 5) + lowestBit(flags);
+        }
+    }
+
+    Date::serial_type Calendar::advanceBusinessDays(Date::serial_type d,
+                                                    Integer n) const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        const std::uint64_t tag = cacheTag();
+        const Date::serial_type block = d >> 5;
+        const Integer offset = Integer(d & 31);
+        const std::uint64_t cached = businessDays(block, tag);
+        if (!isComplete(cached, tag))
+            return Null<Date::serial_type>();
+        const std::uint32_t flags = std::uint32_t(cached);
+
+        // index of the target among the business days counted from
+        // the origin; the first business day after d is at the
+        // index of the business days up to d included, the first
+        // one before d at the index of those before d minus one
+        const Integer before = countBits(
+            offset == 0 ? 0U : flags & (0xFFFFFFFFU >> (32 - offset)));
+        const Integer target =
+            businessDayCount(blockCounts(block, tag)) + before
+            + (n > 0 ? Integer((flags >> offset) & 1U) + n - 1 : n);
+
+        // the target is in the block lo such that count(lo) <= target
+        // and count(lo+1) > target; hi is advanced (or lo moved back)
+        // in growing steps until it brackets it, and the bracket is
+        // then bisected
+        auto count = [&](Date::serial_type b) {
+            return businessDayCount(blockCounts(b, tag));
+        };
+        Date::serial_type lo = block, hi = block + 1;
+        Date::serial_type step = 1;
+        if (n > 0) {
+            while (count(hi) <= target) {
+                if (hi > lastBlock)
+                    return Null<Date::serial_type>();
+                lo = hi;
+                hi = std::min(hi + step, lastBlock + 1);
+                step *= 2;
+            }
+        } else {
+            while (count(lo) > target) {
+                if (lo <= firstBlock)
+                    return Null<Date::serial_type>();
+                hi = lo;
+                lo = lo > firstBlock + step ? lo - step : firstBlock;
+                step *= 2;
+            }
+        }
+        while (hi - lo > 1) {
+            const Date::serial_type mid = lo + (hi - lo) / 2;
+            if (count(mid) <= target)
+                lo = mid;
+            else
+                hi = mid;
+        }
+
+        // days rejected by the calendar between d and the target are
+        // left to the loops in advance, which raise the errors
+        const Date::serial_type b1 = std::min(block, lo),
+                                b2 = std::max(block, lo);
+        if (invalidDayCount(blockCounts(b2 + 1, tag))
+            != invalidDayCount(blockCounts(b1, tag)))
+            return Null<Date::serial_type>();
+
+        const Integer index = target - count(lo);
+        return (lo << 5)
+            + nthLowestBit(std::uint32_t(businessDays(lo, tag)), index + 1);
+    }
+
     void Calendar::addHoliday(const Date& d) {
         QL_REQUIRE(impl_, "no calendar implementation provided");
 
@@ -42,6 +421,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(_d))
             impl_->addedHolidays.insert(_d);
+        clearCachedBusinessDays();
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -59,6 +439,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(_d))
             impl_->removedHolidays.insert(_d);
+        clearCachedBusinessDays();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -68,6 +449,28 @@ namespace QuantLib {
         if (c == Unadjusted)
             return d;
 
+        // the cached business days are searched directly for the
+        // most common conventions; the loops below are used for the
+        // others, as well as close to the ends of the date range,
+        // where they raise the corresponding errors
+        const Date::serial_type s = d.serialNumber();
+        if (c == Following || c == Preceding) {
+            Date::serial_type s1 = nextBusinessDay(s, c == Preceding);
+            if (s1 != Null<Date::serial_type>())
+                return d + (s1 - s);
+        } else if (c == ModifiedFollowing || c == ModifiedPreceding
+                   || c == HalfMonthModifiedFollowing) {
+            if (isBusinessDay(d))
+                return d;
+        } else if (c == Nearest) {
+            Date::serial_type s1 = nextBusinessDay(s, false),
+                              s2 = nextBusinessDay(s, true);
+            if (s1 != Null<Date::serial_type>()
+                && s2 != Null<Date::serial_type>()) {
+                return s1 - s <= s - s2 ? d + (s1 - s) : d - (s - s2);
+            }
+        }
+
         Date d1 = d;
         if (c == Following || c == ModifiedFollowing 
             || c == HalfMonthModifiedFollowing) {
@@ -115,6 +518,10 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
+            const Date::serial_type s = d.serialNumber(),
+                                    s1 = advanceBusinessDays(s, n);
+            if (s1 != Null<Date::serial_type>())
+                return d + (s1 - s);
             Date d1 = d;
             if (n > 0) {
                 while (n > 0) {
@@ -157,24 +564,41 @@ namespace QuantLib {
                                                     const Date& to,
                                                     bool includeFirst,
                                                     bool includeLast) const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
         Date::serial_type wd = 0;
         if (from != to) {
-            if (from < to) {
-                // the last one is treated separately to avoid
-                // incrementing Date::maxDate()
-                for (Date d = from; d < to; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(to))
-                    ++wd;
-            } else if (from > to) {
-                for (Date d = to; d < from; ++d) {
-                    if (isBusinessDay(d))
+            // business days between the earlier and the later date,
+            // both included
+            const Date::serial_type first =
+                std::min(from, to).serialNumber();
+            const Date::serial_type last =
+                std::max(from, to).serialNumber();
+            const Date::serial_type b1 = first >> 5, b2 = last >> 5;
+            const std::uint64_t tag = cacheTag();
+            const std::uint64_t flags1 = businessDays(b1, tag),
+                                flags2 = businessDays(b2, tag);
+            bool cached = hasTag(flags1, tag) && hasTag(flags2, tag);
+            if (cached) {
+                // the counts of the blocks, less the days in the first
+                // and last blocks which are out of the range
+                const std::uint64_t counts1 = blockCounts(b1, tag),
+                                    counts2 = blockCounts(b2 + 1, tag);
+                cached = invalidDayCount(counts2) == invalidDayCount(counts1);
+                const std::uint32_t head = ~(0xFFFFFFFFU << (first & 31)),
+                                    tail = (last & 31) == 31 ? 0U :
+                                        0xFFFFFFFFU << ((last & 31) + 1);
+                wd = businessDayCount(counts2) - businessDayCount(counts1)
+                    - countBits(std::uint32_t(flags1) & head)
+                    - countBits(std::uint32_t(flags2) & tail);
+            }
+            if (!cached) {
+                // some days are rejected by the calendar; count them one
+                // by one, so that the errors are raised if needed
+                wd = 0;
+                for (Date::serial_type s=first; s<=last; ++s) {
+                    if (isBusinessDay(Date(s)))
                         ++wd;
                 }
-                if (isBusinessDay(from))
-                    ++wd;
             }
 
             if (isBusinessDay(from) && !includeFirst)
@@ -32,6 +32,8 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <ql/shared_ptr.hpp>
+#include <atomic>
+#include <cstdint>
 #include <set>
 #include <vector>
 #include <string>
@@ -52,6 +54,16 @@ namespace QuantLib {
         or for general country holiday schedule. Legacy city holiday schedule
         calendars will be moved to the exchange/country convention.
 
+        Business days are cached by the calendar implementation, so
+        that the methods above don't evaluate the holiday rules more
+        than once for the same date; the cache is filled on demand
+        and invalidated when holidays are added or removed.  The
+        cache also keeps cumulative counts of business days, so that
+        businessDaysBetween and advance by days take a fixed number
+        of lookups after the days involved were cached.  As for the
+        holidays themselves, holidays should not be changed while
+        the calendar is used by other threads.
+
         \ingroup datetime
 
         \test the methods for adding and removing holidays are tested
@@ -67,9 +79,47 @@ namespace QuantLib {
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
+            /*! Changes whenever the business days of the calendar
+                change.  Implementations depending on other calendars
+                must add the versions of the latter to their own.
+            */
+            virtual unsigned long holidaysVersion() const;
             std::set<Date> addedHolidays, removedHolidays;
+          private:
+            friend class Calendar;
+            /* Entries of the cache, one for each block of 32 days
+               starting from the null date; see calendar.cpp for
+               their layout. */
+            struct CachedBlock {
+                std::atomic<std::uint64_t> businessDays{0};
+                std::atomic<std::uint64_t> invalidDays{0};
+                std::atomic<std::uint64_t> counts{0};
+            };
+            /* Copies start with an empty cache, and assignment
+               invalidates the cache of the target, so that
+               implementations can still be copied. */
+            class Cache {
+              public:
+                Cache() = default;
+                Cache(const Cache&);
+                Cache& operator=(const Cache&);
+                ~Cache();
+                std::atomic<CachedBlock*> blocks{nullptr};
+                // block from which the business days are counted
+                std::atomic<std::uint64_t> countsOrigin{0};
+                std::atomic<unsigned long> version{0};
+            };
+            mutable Cache cache_;
         };
         ext::shared_ptr<Impl> impl_;
+        /*! Calendars whose implementation can change after
+            construction must call this method after each change, so
+            that the cached business days are recalculated; this is
+            done by addHoliday and removeHoliday.
+        */
+        void clearCachedBusinessDays();
+        //! version of the business days of the given calendar
+        static unsigned long holidaysVersion(const Calendar&);
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -167,6 +217,37 @@ namespace QuantLib {
                                               bool includeLast = false) const;
         //@}
 
+      private:
+        // tag marking the cache entries filled for the current
+        // version of the holidays
+        std::uint64_t cacheTag() const;
+        Impl::CachedBlock* cachedBlocks() const;
+        // business days in the given block of 32 days, as bit flags
+        // in the lower word, and tag of the entry; the tag is null
+        // if the block is out of the date range
+        std::uint64_t businessDays(Date::serial_type block,
+                                   std::uint64_t tag) const;
+        std::uint64_t fillBusinessDays(Date::serial_type block,
+                                       std::uint64_t tag) const;
+        // business days and days rejected by the calendar in the
+        // blocks between the counts origin and the given block
+        std::uint64_t blockCounts(Date::serial_type block,
+                                  std::uint64_t tag) const;
+        Date::serial_type countsOrigin(Date::serial_type block,
+                                       std::uint64_t tag) const;
+        // isBusinessDay for blocks which are not entirely cached
+        bool isBusinessDayInBlock(const Date&, std::uint64_t flags,
+                                  std::uint64_t tag) const;
+        bool isBusinessDayUncached(const Date&) const;
+        // the first business day on or after (on or before, if
+        // backwards) the given date, or Null if none is cached
+        Date::serial_type nextBusinessDay(Date::serial_type,
+                                          bool backwards) const;
+        // the n-th business day after (before, if negative) the given
+        // date, or Null if none is cached
+        Date::serial_type advanceBusinessDays(Date::serial_type,
+                                              Integer n) const;
+
       protected:
         //! partial calendar implementation
         /*! This class provides the means of determining the Easter
@@ -228,24 +309,34 @@ namespace QuantLib {
         return impl_->removedHolidays;
     }
 
-    inline bool Calendar::isBusinessDay(const Date& d) const {
-        QL_REQUIRE(impl_, "no calendar implementation provided");
-
-#ifdef QL_HIGH_RESOLUTION_DATE
-        const Date _d(d.dayOfMonth(), d.month(), d.year());
-#else
-        const Date& _d = d;
-#endif
-
-        if (!impl_->addedHolidays.empty() &&
-            impl_->addedHolidays.find(_d) != impl_->addedHolidays.end())
-            return false;
+    inline std::uint64_t Calendar::cacheTag() const {
+        // 24 bits, never null
+        return (std::uint64_t(impl_->holidaysVersion() % 0xFFFFFFUL) + 1)
+            << 40;
+    }
 
-        if (!impl_->removedHolidays.empty() &&
-            impl_->removedHolidays.find(_d) != impl_->removedHolidays.end())
-            return true;
+    inline std::uint64_t Calendar::businessDays(Date::serial_type block,
+                                                std::uint64_t tag) const {
+        const Impl::CachedBlock* cache =
+            impl_->cache_.blocks.load(std::memory_order_acquire);
+        if (cache != nullptr) {
+            const std::uint64_t flags =
+                cache[block].businessDays.load(std::memory_order_acquire);
+            if ((flags >> 40) == (tag >> 40))
+                return flags;
+        }
+        return fillBusinessDays(block, tag);
+    }
 
-        return impl_->isBusinessDay(_d);
+    inline bool Calendar::isBusinessDay(const Date& d) const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        const Date::serial_type serial = d.serialNumber();
+        const std::uint64_t tag = cacheTag();
+        const std::uint64_t flags = businessDays(serial >> 5, tag);
+        // blocks out of range or with days rejected by the calendar
+        if ((flags >> 40) != (tag >> 40) || ((flags >> 32) & 1U) != 0U)
+            return isBusinessDayInBlock(d, flags, tag);
+        return ((flags >> (serial & 31)) & 1U) != 0U;
     }
 
     inline bool Calendar::isEndOfMonth(const Date& d) const {
@@ -100,6 +100,14 @@ namespace QuantLib {
         }
     }
 
+    unsigned long JointCalendar::Impl::holidaysVersion() const {
+        // changes whenever the business days of a component do
+        unsigned long version = Calendar::Impl::holidaysVersion();
+        for (const auto& calendar : calendars_)
+            version += Calendar::holidaysVersion(calendar);
+        return version;
+    }
+
     bool JointCalendar::Impl::isBusinessDay(const Date& date) const {
         std::vector<Calendar>::const_iterator i;
         switch (rule_) {
@@ -47,6 +47,12 @@
 //#   define QL_ENABLE_TRACING
 #endif
 
+/* Define this if the dependency graph of observers should be profiled
+   (whether it actually is will depend on run-time settings.) */
+#ifndef QL_ENABLE_DEPENDENCY_PROFILING
+//#   define QL_ENABLE_DEPENDENCY_PROFILING
+#endif
+
 /* Define this if extra safety checks should be performed. This can degrade
    performance. */
 #ifndef QL_EXTRA_SAFETY_CHECKS
@@ -75,6 +81,14 @@
 //#    define QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 #endif
 
+/* Define this to enable the lock-free (read-copy-update) observer
+   pattern. It is thread-safe as the above, but notification doesn't
+   lock and registration copies the list of observers. Only one of
+   the two macros can be defined. */
+#ifndef QL_ENABLE_RCU_OBSERVER_PATTERN
+//#    define QL_ENABLE_RCU_OBSERVER_PATTERN
+#endif
+
 /* Define this to enable a date resolution down to microseconds and
    allow for accurate intraday pricing.*/
 #ifndef QL_HIGH_RESOLUTION_DATE
@@ -604,6 +604,155 @@ void AmericanOptionTest::testFDShoutNPV() {
     }
 }
 
+void AmericanOptionTest::testFdMultipleStrikes() {
+    BOOST_TEST_MESSAGE("Testing finite-differences engine "
+                       "with multiple strikes...");
+
+    SavedSettings backup;
+
+    const auto dc = Actual365Fixed();
+    const auto today = Date(22, March, 2021);
+    Settings::instance().evaluationDate() = today;
+
+    const auto spot = Handle<Quote>(ext::make_shared<SimpleQuote>(100.0));
+    const auto q = Handle<YieldTermStructure>(flatRate(0.02, dc));
+    const auto r = Handle<YieldTermStructure>(flatRate(0.05, dc));
+
+    const auto volTS = Handle<BlackVolTermStructure>(flatVol(0.3, dc));
+    const auto process = ext::make_shared<BlackScholesMertonProcess>(
+            spot, q, r, volTS);
+
+    const std::vector<Real> strikes = { 70, 80, 90, 100, 110, 120, 130 };
+    const Option::Type types[] = { Option::Put, Option::Call };
+
+    const ext::shared_ptr<Exercise> exercises[] = {
+        ext::make_shared<AmericanExercise>(today + Period(1, Years)),
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years))
+    };
+
+    // damping steps avoid the oscillations of the greeks at the strike
+    const auto singleStrikeEngine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(process, 100, 400, 2);
+    const auto multiStrikeEngine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(process, 100, 400, 2);
+    multiStrikeEngine->enableMultipleStrikesCaching(strikes);
+
+    const Real tol = 5e-3;
+    for (const auto& exercise : exercises) {
+        for (auto type : types) {
+            for (Real strike : strikes) {
+                VanillaOption option(
+                    ext::make_shared<PlainVanillaPayoff>(type, strike),
+                    exercise);
+
+                option.setPricingEngine(multiStrikeEngine);
+                const Real npvCalculated = option.NPV();
+                const Real deltaCalculated = option.delta();
+                const Real gammaCalculated = option.gamma();
+                const Real thetaCalculated = option.theta();
+
+                option.setPricingEngine(singleStrikeEngine);
+                const Real npvExpected = option.NPV();
+                const Real deltaExpected = option.delta();
+                const Real gammaExpected = option.gamma();
+                const Real thetaExpected = option.theta();
+
+                const Real calculated[] = {
+                    npvCalculated, deltaCalculated,
+                    gammaCalculated, thetaCalculated };
+                const Real expected[] = {
+                    npvExpected, deltaExpected,
+                    gammaExpected, thetaExpected };
+                const std::string names[] = {
+                    "value", "delta", "gamma", "theta" };
+
+                for (Size i=0; i < 4; ++i) {
+                    const Real diff = std::fabs(calculated[i]-expected[i]);
+                    if (diff > tol*std::max(1.0, std::fabs(expected[i])))
+                        BOOST_FAIL("failed to reproduce " << names[i]
+                                   << " with multiple strikes engine"
+                                   << "\n    strike:      " << strike
+                                   << "\n    option type: " << type
+                                   << "\n    exercise:    "
+                                   << ((exercise->type() == Exercise::American)
+                                       ? "American" : "European")
+                                   << "\n    calculated:  " << calculated[i]
+                                   << "\n    expected:    " << expected[i]
+                                   << "\n    difference:  " << diff);
+                }
+            }
+        }
+    }
+}
+
+void AmericanOptionTest::testFdAdaptiveTimeSteps() {
+    BOOST_TEST_MESSAGE("Testing time steps reported by "
+                       "finite-differences engine...");
+
+    SavedSettings backup;
+
+    const auto dc = Actual365Fixed();
+    const auto today = Date(22, March, 2021);
+    Settings::instance().evaluationDate() = today;
+
+    const auto spot = Handle<Quote>(ext::make_shared<SimpleQuote>(100.0));
+    const auto q = Handle<YieldTermStructure>(flatRate(0.02, dc));
+    const auto r = Handle<YieldTermStructure>(flatRate(0.05, dc));
+
+    const auto volTS = Handle<BlackVolTermStructure>(flatVol(0.3, dc));
+    const auto process = ext::make_shared<BlackScholesMertonProcess>(
+            spot, q, r, volTS);
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        ext::make_shared<AmericanExercise>(today + Period(1, Years)));
+
+    const Size tGrid = 1000, dampingSteps = 2;
+    option.setPricingEngine(ext::make_shared<FdBlackScholesVanillaEngine>(
+        process, tGrid, 400, dampingSteps));
+    const Real expected = option.NPV();
+    const Size fixedSteps = option.result<Size>("timeSteps");
+
+    if (fixedSteps < tGrid || option.result<Size>("rejectedTimeSteps") != 0)
+        BOOST_FAIL("unexpected time steps of the fixed time grid"
+                   << "\n    time grid: " << tGrid
+                   << "\n    steps:     " << fixedSteps
+                   << "\n    rejected:  "
+                   << option.result<Size>("rejectedTimeSteps"));
+
+    // the adaptive rollback starts from a coarse time grid
+    const auto adaptiveEngine = ext::make_shared<FdBlackScholesVanillaEngine>(
+        process, 10, 400, dampingSteps,
+        FdmSchemeDesc::Douglas().withAdaptiveSteps(1e-5));
+    option.setPricingEngine(adaptiveEngine);
+    const Real calculated = option.NPV();
+    const Size steps = option.result<Size>("timeSteps");
+    const Size rejected = option.result<Size>("rejectedTimeSteps");
+
+    if (steps <= dampingSteps || steps >= fixedSteps
+        || std::fabs(calculated - expected) > 5e-3)
+        BOOST_FAIL("failed to reproduce the price with adaptive time steps"
+                   << "\n    steps:      " << steps
+                   << "\n    rejected:   " << rejected
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected);
+
+    // the cached results of multiple strikes carry the same counts
+    adaptiveEngine->enableMultipleStrikesCaching({ 90.0, 100.0, 110.0 });
+    option.recalculate();
+    const Size multipleStrikesSteps = option.result<Size>("timeSteps");
+    VanillaOption other(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 110.0),
+        option.exercise());
+    other.setPricingEngine(adaptiveEngine);
+    if (other.result<Size>("timeSteps") != multipleStrikesSteps
+        || other.result<Size>("rejectedTimeSteps")
+               != option.result<Size>("rejectedTimeSteps"))
+        BOOST_FAIL("time steps not reported for cached strikes"
+                   << "\n    steps:    " << multipleStrikesSteps
+                   << "\n    reported: " << other.result<Size>("timeSteps"));
+}
+
 test_suite* AmericanOptionTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("American option tests");
 
@@ -613,6 +762,8 @@ test_suite* AmericanOptionTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdValues));
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdAmericanGreeks));
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFDShoutNPV));
+    suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdMultipleStrikes));
+    suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdAdaptiveTimeSteps));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdShoutGreeks));
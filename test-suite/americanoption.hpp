@@ -37,6 +37,8 @@ class AmericanOptionTest {
     static void testFdAmericanGreeks();
     static void testFdShoutGreeks();
     static void testFDShoutNPV();
+    static void testFdMultipleStrikes();
+    static void testFdAdaptiveTimeSteps();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
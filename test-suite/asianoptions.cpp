@@ -1527,6 +1527,73 @@ void AsianOptionTest::testPastFixings() {
 }
 
 
+void AsianOptionTest::testMCDiscreteArithmeticAveragePricePathBlocks() {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo arithmetic average-price Asian "
+                       "options with path blocks...");
+
+    DayCounter dc = Actual360();
+    Date today = Settings::instance().evaluationDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.03, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.20, dc);
+
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    ext::shared_ptr<StrikedTypePayoff> payoff(
+                                  new PlainVanillaPayoff(Option::Call, 100.0));
+    ext::shared_ptr<Exercise> exercise(new EuropeanExercise(today + 1*Years));
+
+    // with and without the fixing at the evaluation date
+    for (Integer first=0; first<=1; ++first) {
+        std::vector<Date> fixingDates;
+        for (Integer i=first; i<=12; ++i)
+            fixingDates.push_back(today + i*Months);
+
+        DiscreteAveragingAsianOption option(Average::Arithmetic, 150.0, 2,
+                                            fixingDates, payoff, exercise);
+
+        for (Integer controlVariate=0; controlVariate<=1; ++controlVariate) {
+            option.setPricingEngine(
+                MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+                .withAntitheticVariate()
+                .withControlVariate(controlVariate != 0)
+                .withSamples(5000)
+                .withSeed(42));
+            Real expected = option.NPV();
+
+            option.setPricingEngine(
+                MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+                .withAntitheticVariate()
+                .withControlVariate(controlVariate != 0)
+                .withSamples(5000)
+                .withSeed(42)
+                .withPathBlocks(1024));
+            Real calculated = option.NPV();
+
+            // the geometric average of the control variate is
+            // calculated differently and can differ by rounding
+            Real tolerance = controlVariate != 0 ? 1.0e-10 : 0.0;
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("failed to reproduce path-by-path result"
+                            << "\n    initial fixing:   "
+                            << (first == 0 ? "yes" : "no")
+                            << "\n    control variate:  "
+                            << (controlVariate != 0 ? "yes" : "no")
+                            << std::setprecision(12)
+                            << "\n    path by path:     " << expected
+                            << "\n    path blocks:      " << calculated);
+        }
+    }
+}
+
+
 void AsianOptionTest::testAllFixingsInThePast() {
 
     BOOST_TEST_MESSAGE(
@@ -2006,6 +2073,7 @@ test_suite* AsianOptionTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&AsianOptionTest::testAnalyticDiscreteGeometricAveragePriceGreeks));
     suite->add(QUANTLIB_TEST_CASE(&AsianOptionTest::testPastFixings));
     suite->add(QUANTLIB_TEST_CASE(&AsianOptionTest::testAllFixingsInThePast));
+    suite->add(QUANTLIB_TEST_CASE(&AsianOptionTest::testMCDiscreteArithmeticAveragePricePathBlocks));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&AsianOptionTest::testMCDiscreteArithmeticAveragePrice));
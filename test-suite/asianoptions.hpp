@@ -42,6 +42,7 @@ class AsianOptionTest {
     static void testMCDiscreteArithmeticAveragePrice();
     static void testMCDiscreteArithmeticAveragePriceHeston();
     static void testMCDiscreteArithmeticAverageStrike();
+    static void testMCDiscreteArithmeticAveragePricePathBlocks();
     static void testAnalyticDiscreteGeometricAveragePriceGreeks();
     static void testPastFixings();
     static void testAllFixingsInThePast();
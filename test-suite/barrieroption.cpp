@@ -31,6 +31,7 @@
 #include <ql/instruments/barrieroption.hpp>
 #include <ql/instruments/dividendbarrieroption.hpp>
 #include <ql/instruments/europeanoption.hpp>
+#include <ql/methods/montecarlo/montecarlosettings.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/pricingengines/barrier/analyticbarrierengine.hpp>
 #include <ql/pricingengines/barrier/binomialbarrierengine.hpp>
@@ -1243,6 +1244,172 @@ void BarrierOptionTest::testDividendBarrierOption() {
     }
 }
 
+void BarrierOptionTest::testMcPathBlocks() {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo barrier engine with path blocks...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    ext::shared_ptr<SimpleQuote> underlying =
+        ext::make_shared<SimpleQuote>(100.0);
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.20, dc);
+
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        ext::make_shared<BlackScholesMertonProcess>(
+                                  Handle<Quote>(underlying),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS));
+
+    ext::shared_ptr<StrikedTypePayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0);
+    ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(today + 1*Years);
+
+    struct {
+        Barrier::Type type;
+        Real barrier;
+    } cases[] = {
+        { Barrier::DownOut, 90.0 },
+        { Barrier::DownIn,  90.0 },
+        { Barrier::UpOut,  120.0 },
+        { Barrier::UpIn,   120.0 }
+    };
+
+    for (auto& c : cases) {
+        BarrierOption option(c.type, c.barrier, 3.0, payoff, exercise);
+
+        // biased engines check the barrier on the same paths and
+        // must reproduce the path-by-path results
+        option.setPricingEngine(MakeMCBarrierEngine<PseudoRandom>(stochProcess)
+                                .withSteps(12)
+                                .withAntitheticVariate()
+                                .withSamples(5000)
+                                .withBias()
+                                .withSeed(42));
+        Real expected = option.NPV();
+
+        option.setPricingEngine(MakeMCBarrierEngine<PseudoRandom>(stochProcess)
+                                .withSteps(12)
+                                .withAntitheticVariate()
+                                .withSamples(5000)
+                                .withBias()
+                                .withSeed(42)
+                                .withPathBlocks(1000));
+        Real calculated = option.NPV();
+        if (calculated != expected)
+            BOOST_ERROR("failed to reproduce biased path-by-path result"
+                        << "\n    barrier type: " << c.type
+                        << std::setprecision(12)
+                        << "\n    path by path: " << expected
+                        << "\n    path blocks:  " << calculated);
+
+        // the crossing probabilities use different uniform deviates,
+        // so that the results are only statistically equivalent
+        option.setPricingEngine(MakeMCBarrierEngine<PseudoRandom>(stochProcess)
+                                .withSteps(12)
+                                .withSamples(20000)
+                                .withSeed(42));
+        expected = option.NPV();
+        Real expectedError = option.errorEstimate();
+
+        option.setPricingEngine(MakeMCBarrierEngine<PseudoRandom>(stochProcess)
+                                .withSteps(12)
+                                .withSamples(20000)
+                                .withSeed(42)
+                                .withPathBlocks(1000));
+        calculated = option.NPV();
+        Real error = option.errorEstimate();
+        Real tolerance = 3.0*std::sqrt(error*error + expectedError*expectedError);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("unbiased path-block result out of tolerance"
+                        << "\n    barrier type: " << c.type
+                        << "\n    path by path: " << expected
+                        << "\n    path blocks:  " << calculated
+                        << "\n    tolerance:    " << tolerance);
+    }
+}
+
+void BarrierOptionTest::testMcBlockSimulation() {
+
+    BOOST_TEST_MESSAGE("Testing block-parallel Monte Carlo barrier engine...");
+
+    SavedSettings backup;
+
+    struct BlockSizeGuard {
+        ~BlockSizeGuard() {
+            MonteCarloSettings::instance().samplesPerBlock() = 0;
+        }
+    } guard;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    ext::shared_ptr<SimpleQuote> underlying =
+        ext::make_shared<SimpleQuote>(100.0);
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.20, dc);
+
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        ext::make_shared<BlackScholesMertonProcess>(
+                                  Handle<Quote>(underlying),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS));
+
+    ext::shared_ptr<StrikedTypePayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0);
+    ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(today + 1*Years);
+
+    BarrierOption option(Barrier::UpOut, 120.0, 3.0, payoff, exercise);
+
+    // the unbiased engine corrects for crossings between the steps,
+    // so that its results converge to the continuous-barrier ones
+    option.setPricingEngine(
+        ext::make_shared<AnalyticBarrierEngine>(stochProcess));
+    Real analytic = option.NPV();
+
+    option.setPricingEngine(MakeMCBarrierEngine<PseudoRandom>(stochProcess)
+                            .withSteps(12)
+                            .withSamples(20000)
+                            .withSeed(42));
+    Real serial = option.NPV();
+    Real serialError = option.errorEstimate();
+
+    // each block uses its own Gaussian and uniform streams; reusing
+    // the uniform deviates in every block would correlate them
+    MonteCarloSettings::instance().samplesPerBlock() = 2500;
+    option.recalculate();
+    Real blocks = option.NPV();
+    Real blocksError = option.errorEstimate();
+
+    option.recalculate();
+    if (option.NPV() != blocks)
+        BOOST_ERROR("failed to reproduce block Monte Carlo result"
+                    << std::setprecision(12)
+                    << "\n    first run:  " << blocks
+                    << "\n    second run: " << option.NPV());
+
+    Real tolerance =
+        3.0*std::sqrt(serialError*serialError + blocksError*blocksError);
+    if (std::fabs(blocks - serial) > tolerance)
+        BOOST_ERROR("block result not consistent with serial one"
+                    << "\n    serial:     " << serial << " +/- " << serialError
+                    << "\n    blocks:     " << blocks << " +/- " << blocksError
+                    << "\n    tolerance:  " << tolerance);
+    if (std::fabs(blocks - analytic) > 3.0*blocksError + 0.02)
+        BOOST_ERROR("block result not consistent with analytic one"
+                    << "\n    analytic:   " << analytic
+                    << "\n    blocks:     " << blocks << " +/- " << blocksError);
+}
+
 test_suite* BarrierOptionTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Barrier option tests");
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testParity));
@@ -1253,6 +1420,8 @@ test_suite* BarrierOptionTest::suite() {
         &BarrierOptionTest::testLocalVolAndHestonComparison));
     suite->add(QUANTLIB_TEST_CASE(
         &BarrierOptionTest::testDividendBarrierOption));
+    suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testMcPathBlocks));
+    suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testMcBlockSimulation));
     return suite;
 }
 
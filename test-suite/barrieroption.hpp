@@ -36,6 +36,8 @@ class BarrierOptionTest {
     static void testVannaVolgaSimpleBarrierValues();
     static void testVannaVolgaDoubleBarrierValues();
     static void testDividendBarrierOption();
+    static void testMcPathBlocks();
+    static void testMcBlockSimulation();
 
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
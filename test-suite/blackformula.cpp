@@ -24,6 +24,7 @@
 #include "blackformula.hpp"
 #include "utilities.hpp"
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/blackformulabatch.hpp>
 
 #include <boost/math/special_functions/fpclassify.hpp>
 
@@ -435,6 +436,178 @@ void BlackFormulaTest::testBachelierBlackFormulaForwardDerivativeWithZeroVolatil
     assertBachelierBlackFormulaForwardDerivative(Option::Put, strikes, vol);
 }
 
+void BlackFormulaTest::testBatchBlackFormula() {
+
+    BOOST_TEST_MESSAGE("Testing batch Black formulas...");
+
+    std::vector<Option::Type> types;
+    std::vector<Real> strikes, stdDevs;
+    for (Real strike = 0.0; strike <= 300.0; strike += 5.0) {
+        for (Real stdDev = 0.0; stdDev <= 2.0; stdDev += 0.05) {
+            for (Integer type = -1; type <= 1; type += 2) {
+                types.push_back(Option::Type(type));
+                strikes.push_back(strike);
+                stdDevs.push_back(stdDev);
+            }
+        }
+    }
+    const Real forward = 100.0, discount = 0.95, displacement = 0.01;
+    const Array K(strikes.begin(), strikes.end());
+    const Array s(stdDevs.begin(), stdDevs.end());
+    const Array F(1, forward), df(1, discount), dd(1, displacement);
+
+    const Array prices = blackFormula(types, K, F, s, df, dd);
+    const Array deltas = blackFormulaForwardDerivative(types, K, F, s, df, dd);
+    const Array vegas = blackFormulaStdDevDerivative(K, F, s, df, dd);
+    const Array bachelier = bachelierBlackFormula(types, K, F, s*100.0, df);
+
+    const Real tolerance = 1.0e-10;
+    for (Size i=0; i<types.size(); ++i) {
+        const Real price = blackFormula(types[i], K[i], forward, s[i],
+                                        discount, displacement);
+        const Real delta = blackFormulaForwardDerivative(
+            types[i], K[i], forward, s[i], discount, displacement);
+        const Real vega = blackFormulaStdDevDerivative(
+            K[i], forward, s[i], discount, displacement);
+        const Real bachelierPrice = bachelierBlackFormula(
+            types[i], K[i], forward, s[i]*100.0, discount);
+        if (std::fabs(prices[i] - price) > tolerance
+            || std::fabs(deltas[i] - delta) > tolerance
+            || std::fabs(vegas[i] - vega) > tolerance
+            || std::fabs(bachelier[i] - bachelierPrice) > tolerance)
+            BOOST_ERROR("failed to reproduce the Black formulas"
+                        << "\n    option type: " << types[i]
+                        << "\n    strike:      " << K[i]
+                        << "\n    std dev:     " << s[i]
+                        << "\n    price:       " << prices[i]
+                        << " instead of " << price
+                        << "\n    delta:       " << deltas[i]
+                        << " instead of " << delta
+                        << "\n    vega:        " << vegas[i]
+                        << " instead of " << vega
+                        << "\n    Bachelier:   " << bachelier[i]
+                        << " instead of " << bachelierPrice);
+    }
+
+    BOOST_CHECK_THROW(blackFormula(types, Array(2, 100.0), F, s), Error);
+}
+
+namespace {
+
+    // repetitions of the batch and scalar implied standard deviation
+    // tests, long enough for them to be timed in the benchmark suite
+    const Size repetitions = 10;
+
+    // options whose price is sensitive to the volatility, used by
+    // the batch and scalar implied standard deviation tests
+    struct QuotedOptions {
+        std::vector<Option::Type> types;
+        Array strikes, stdDevs;
+        Real forward, discount;
+    };
+
+    QuotedOptions quotedOptions() {
+        std::vector<Option::Type> types;
+        std::vector<Real> strikes, stdDevs;
+        for (Real strike = 20.0; strike <= 400.0; strike += 2.0) {
+            for (Real stdDev = 0.01; stdDev <= 3.0; stdDev += 0.05) {
+                for (Integer type = -1; type <= 1; type += 2) {
+                    types.push_back(Option::Type(type));
+                    strikes.push_back(strike);
+                    stdDevs.push_back(stdDev);
+                }
+            }
+        }
+        QuotedOptions quoted;
+        quoted.forward = 100.0;
+        quoted.discount = 0.95;
+        const Array K(strikes.begin(), strikes.end());
+        const Array s(stdDevs.begin(), stdDevs.end());
+        const Array F(1, quoted.forward), df(1, quoted.discount);
+
+        const Array prices = blackFormula(types, K, F, s, df);
+        const Array vegas = blackFormulaStdDevDerivative(K, F, s, df);
+        std::vector<Size> selected;
+        for (Size i=0; i<types.size(); ++i) {
+            const Real intrinsic =
+                std::max(types[i]*(quoted.forward - K[i]), 0.0)
+                * quoted.discount;
+            if (prices[i] - intrinsic > 1.0e-6 && vegas[i] > 1.0e-4)
+                selected.push_back(i);
+        }
+        quoted.types.resize(selected.size());
+        quoted.strikes = Array(selected.size());
+        quoted.stdDevs = Array(selected.size());
+        for (Size j=0; j<selected.size(); ++j) {
+            quoted.types[j] = types[selected[j]];
+            quoted.strikes[j] = K[selected[j]];
+            quoted.stdDevs[j] = s[selected[j]];
+        }
+        return quoted;
+    }
+
+    void checkImpliedStdDevs(const QuotedOptions& quoted,
+                             const Array& prices,
+                             const Array& implied) {
+        const Real tolerance = 1.0e-8;
+        for (Size j=0; j<quoted.types.size(); ++j) {
+            const Real expected = quoted.stdDevs[j];
+            if (std::fabs(implied[j] - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce standard deviation"
+                            << "\n    option type: " << quoted.types[j]
+                            << "\n    strike:      " << quoted.strikes[j]
+                            << "\n    price:       " << prices[j]
+                            << "\n    implied:     " << implied[j]
+                            << "\n    expected:    " << expected);
+        }
+    }
+
+}
+
+void BlackFormulaTest::testBatchImpliedStdDev() {
+
+    BOOST_TEST_MESSAGE("Testing batch Black implied standard deviation...");
+
+    const QuotedOptions quoted = quotedOptions();
+    const Array F(1, quoted.forward), df(1, quoted.discount);
+
+    Array prices, implied;
+    for (Size k=0; k<repetitions; ++k) {
+        prices = blackFormula(quoted.types, quoted.strikes, F,
+                              quoted.stdDevs, df);
+        implied = blackFormulaImpliedStdDev(quoted.types, quoted.strikes,
+                                            F, prices, df, Array(1, 0.0),
+                                            1.0e-10);
+    }
+
+    checkImpliedStdDevs(quoted, prices, implied);
+}
+
+void BlackFormulaTest::testScalarImpliedStdDev() {
+
+    BOOST_TEST_MESSAGE("Testing Black implied standard deviation "
+                       "on the batch test options one by one...");
+
+    // same options and checks as testBatchImpliedStdDev, so that the
+    // two can be timed against each other in the benchmark suite
+    const QuotedOptions quoted = quotedOptions();
+    const Size n = quoted.types.size();
+
+    Array prices(n), implied(n);
+    for (Size k=0; k<repetitions; ++k) {
+        for (Size j=0; j<n; ++j)
+            prices[j] = blackFormula(quoted.types[j], quoted.strikes[j],
+                                     quoted.forward, quoted.stdDevs[j],
+                                     quoted.discount);
+        for (Size j=0; j<n; ++j)
+            implied[j] = blackFormulaImpliedStdDev(
+                quoted.types[j], quoted.strikes[j], quoted.forward,
+                prices[j], quoted.discount, 0.0, Null<Real>(), 1.0e-10);
+    }
+
+    checkImpliedStdDevs(quoted, prices, implied);
+}
+
 test_suite* BlackFormulaTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Black formula tests");
 
@@ -458,6 +631,12 @@ test_suite* BlackFormulaTest::suite() {
         &BlackFormulaTest::testBachelierBlackFormulaForwardDerivative));
     suite->add(QUANTLIB_TEST_CASE(
         &BlackFormulaTest::testBachelierBlackFormulaForwardDerivativeWithZeroVolatility));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testBatchBlackFormula));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testBatchImpliedStdDev));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testScalarImpliedStdDev));
 
     return suite;
 }
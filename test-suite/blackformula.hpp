@@ -38,6 +38,9 @@ class BlackFormulaTest {
     static void testBlackFormulaForwardDerivativeWithZeroVolatility();
     static void testBachelierBlackFormulaForwardDerivative();
     static void testBachelierBlackFormulaForwardDerivativeWithZeroVolatility();
+    static void testBatchBlackFormula();
+    static void testBatchImpliedStdDev();
+    static void testScalarImpliedStdDev();
 
     static boost::unit_test_framework::test_suite* suite();
 };
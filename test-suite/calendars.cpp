@@ -2137,6 +2137,175 @@ void CalendarTest::testDayLists() {
     }
 }
 
+namespace {
+
+    // user calendar whose implementation can be copied
+    class CopyableCalendar : public Calendar {
+      private:
+        class Impl : public Calendar::WesternImpl {
+          public:
+            std::string name() const override { return "copyable"; }
+            bool isBusinessDay(const Date& d) const override {
+                return !isWeekend(d.weekday());
+            }
+        };
+      public:
+        CopyableCalendar() { impl_ = ext::make_shared<Impl>(); }
+        //! returns a calendar with a copy of the implementation
+        CopyableCalendar clone() const {
+            CopyableCalendar c;
+            c.impl_ = ext::make_shared<Impl>(
+                dynamic_cast<const Impl&>(*impl_));
+            return c;
+        }
+        //! assigns the implementation of another calendar
+        void assign(const CopyableCalendar& other) {
+            dynamic_cast<Impl&>(*impl_) =
+                dynamic_cast<const Impl&>(*other.impl_);
+        }
+    };
+
+}
+
+void CalendarTest::testCachedBusinessDays() {
+
+    BOOST_TEST_MESSAGE("Testing cached business days...");
+
+    // bespoke calendars are used so that global calendars are not modified
+    BespokeCalendar c1("one"), c2("two");
+    c1.addWeekend(Saturday);
+    c1.addWeekend(Sunday);
+    Calendar c12h = JointCalendar(c1, c2, JoinHolidays),
+             c12b = JointCalendar(c1, c2, JoinBusinessDays);
+
+    Date holiday(15, March, 2023);  // a Wednesday
+    Date saturday(18, March, 2023);
+
+    // fill the caches
+    BOOST_CHECK(c1.isBusinessDay(holiday));
+    BOOST_CHECK(c12h.isBusinessDay(holiday));
+    BOOST_CHECK(c12b.isBusinessDay(saturday));
+
+    c2.addHoliday(holiday);
+    if (!c12b.isBusinessDay(holiday) || c12h.isBusinessDay(holiday))
+        BOOST_FAIL("holiday added to component not seen by joint calendars");
+    c2.addWeekend(Saturday);
+    if (c12b.isBusinessDay(saturday))
+        BOOST_FAIL("weekend added to component not seen by joint calendar");
+    c2.removeHoliday(holiday);
+    if (!c12h.isBusinessDay(holiday))
+        BOOST_FAIL("holiday removed from component not seen by joint calendar");
+
+    // the cached business days are used by the other methods; compare
+    // them to the same calculations done one day at a time
+    c1.addHoliday(Date(10, April, 2023));
+    c1.addHoliday(Date(1, May, 2023));
+    Calendar calendars[] = { c1, c12h, TARGET(), UnitedStates(UnitedStates::NYSE) };
+    for (auto& calendar : calendars) {
+        for (Date d = Date(1, December, 2022); d < Date(1, June, 2023); d++) {
+            for (Integer n = -40; n <= 40; n += 7) {
+                Date expected = d;
+                for (Integer i = 0; i < std::abs(n); ++i) {
+                    do {
+                        expected += n > 0 ? 1 : -1;
+                    } while (calendar.isHoliday(expected));
+                }
+                if (n == 0)
+                    expected = calendar.adjust(d);
+                Date calculated = calendar.advance(d, n, Days);
+                if (calculated != expected)
+                    BOOST_FAIL(calendar.name() << ": advancing " << d << " by " << n
+                                               << " business days:\n"
+                                               << "    calculated: " << calculated << "\n"
+                                               << "    expected:   " << expected);
+
+                Date::serial_type count = 0;
+                for (Date x = std::min(d, d + n); x <= std::max(d, d + n); ++x) {
+                    if (calendar.isBusinessDay(x))
+                        ++count;
+                }
+                if (n != 0 && calendar.businessDaysBetween(std::min(d, d + n),
+                                                           std::max(d, d + n),
+                                                           true, true) != count)
+                    BOOST_FAIL(calendar.name() << ": wrong number of business days between "
+                                               << d << " and " << d + n);
+            }
+
+            Date following = d, preceding = d;
+            while (calendar.isHoliday(following))
+                ++following;
+            while (calendar.isHoliday(preceding))
+                --preceding;
+            if (calendar.adjust(d, Following) != following ||
+                calendar.adjust(d, Preceding) != preceding)
+                BOOST_FAIL(calendar.name() << ": wrong adjustment of " << d);
+        }
+    }
+
+    // business days are counted from the first block asked for; check
+    // long ranges on both sides of it
+    Calendar target = TARGET();
+    Date start(15, March, 2023);
+    Date::serial_type inRange = target.businessDaysBetween(start, start + 10);
+    BOOST_CHECK_EQUAL(inRange, 8);
+    const Date ranges[][2] = { { Date(17, June, 1955), Date(3, August, 2010) },
+                               { Date(2, May, 2030), Date(12, November, 2150) } };
+    for (const auto& range : ranges) {
+        Date::serial_type count = 0;
+        for (Date x = range[0]; x <= range[1]; ++x) {
+            if (target.isBusinessDay(x))
+                ++count;
+        }
+        if (target.businessDaysBetween(range[0], range[1], true, true) != count ||
+            target.businessDaysBetween(range[1], range[0], true, true) != -count)
+            BOOST_FAIL("wrong number of business days between "
+                       << range[0] << " and " << range[1]);
+        Date first = target.adjust(range[0], Following),
+             last = target.adjust(range[1], Preceding);
+        if (target.advance(first, Integer(count) - 1, Days) != last ||
+            target.advance(last, 1 - Integer(count), Days) != first)
+            BOOST_FAIL("wrong result advancing across "
+                       << range[0] << " and " << range[1]);
+    }
+
+    // MOEX rejects dates before 2012; the days it accepts in the same
+    // blocks are still available, and the rejected ones raise errors
+    Calendar moex = Russia(Russia::MOEX);
+    for (Size i = 0; i < 2; ++i) {
+        BOOST_CHECK_THROW(moex.isBusinessDay(Date(30, December, 2011)), Error);
+        BOOST_CHECK(moex.isBusinessDay(Date(10, January, 2012)));
+        BOOST_CHECK(!moex.isBusinessDay(Date(14, January, 2012)));
+    }
+    BOOST_CHECK_THROW(moex.businessDaysBetween(Date(20, December, 2011),
+                                               Date(20, January, 2012)),
+                      Error);
+    BOOST_CHECK_THROW(moex.advance(Date(10, January, 2012), -10, Days), Error);
+    BOOST_CHECK_EQUAL(moex.advance(Date(10, January, 2012), 3, Days),
+                      Date(13, January, 2012));
+    BOOST_CHECK_EQUAL(moex.businessDaysBetween(Date(10, January, 2012),
+                                               Date(10, February, 2012)),
+                      23);
+
+    // copies of calendar implementations don't share their caches
+    CopyableCalendar original;
+    Date first(3, April, 2023), second(4, April, 2023);
+    BOOST_CHECK(original.isBusinessDay(first));
+    original.addHoliday(first);
+    CopyableCalendar copy = original.clone();
+    BOOST_CHECK(copy.isHoliday(first));
+    BOOST_CHECK(copy.isBusinessDay(second));
+    copy.addHoliday(second);
+    if (original.isHoliday(second))
+        BOOST_FAIL("holiday added to copy seen by original calendar");
+    BOOST_CHECK_EQUAL(original.businessDaysBetween(first, first + 7), 4);
+    BOOST_CHECK_EQUAL(copy.businessDaysBetween(first, first + 7), 3);
+    // assignment invalidates the cached days of the target
+    original.assign(copy);
+    if (original.isBusinessDay(second))
+        BOOST_FAIL("holiday assigned to calendar not seen");
+    BOOST_CHECK_EQUAL(original.businessDaysBetween(first, first + 7), 3);
+}
+
 test_suite* CalendarTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Calendar tests");
 
@@ -2170,6 +2339,7 @@ test_suite* CalendarTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testModifiedCalendars));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testJointCalendars));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBespokeCalendars));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testCachedBusinessDays));
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
@@ -57,6 +57,7 @@ class CalendarTest {
     static void testModifiedCalendars();
     static void testJointCalendars();
     static void testBespokeCalendars();
+    static void testCachedBusinessDays();
 
     static void testEndOfMonth();
     static void testBusinessDaysBetween();
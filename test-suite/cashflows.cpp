@@ -20,6 +20,7 @@
 #include "cashflows.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
@@ -29,6 +30,9 @@
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
@@ -504,6 +508,152 @@ void CashFlowsTest::testPartialScheduleLegConstruction() {
     BOOST_CHECK_EQUAL(lastCpnF3->referencePeriodEnd(), Date(30, Sep, 2020));
 }
 
+void CashFlowsTest::testCompiledLeg() {
+    BOOST_TEST_MESSAGE("Testing compiled legs against cash-flow analysis...");
+
+    SavedSettings backup;
+
+    Date today(15, March, 2021);
+    Settings::instance().evaluationDate() = today;
+    Date settlement = TARGET().advance(today, 2, Days);
+    DayCounter dayCounter = Actual360();
+
+    RelinkableHandle<YieldTermStructure> forwardingCurve;
+    forwardingCurve.linkTo(flatRate(today, 0.02, dayCounter));
+    ext::shared_ptr<IborIndex> index(new Euribor6M(forwardingCurve));
+
+    Schedule schedule = MakeSchedule()
+                            .from(Date(10, February, 2021))
+                            .to(Date(10, February, 2031))
+                            .withFrequency(Semiannual)
+                            .withCalendar(TARGET())
+                            .withConvention(Following);
+
+    Leg leg = FixedRateLeg(schedule)
+                  .withNotionals(100.0)
+                  .withCouponRates(0.03, Thirty360());
+    Leg floating = IborLeg(schedule, index)
+                       .withNotionals(100.0)
+                       .withSpreads(0.001)
+                       .withFixingDays(2);
+    // capped coupons are not stored and are asked for their amounts
+    Leg capped = IborLeg(schedule, index)
+                     .withNotionals(50.0)
+                     .withCaps(0.025)
+                     .withFixingDays(2);
+    setCouponPricer(floating,
+                    ext::make_shared<BlackIborCouponPricer>());
+    ext::shared_ptr<IborCouponPricer> cappedPricer =
+        ext::make_shared<BlackIborCouponPricer>(
+            Handle<OptionletVolatilityStructure>(
+                ext::make_shared<ConstantOptionletVolatility>(
+                    today, TARGET(), Following, 0.20, dayCounter)));
+    setCouponPricer(capped, cappedPricer);
+    // the first floating coupon already fixed
+    index->addFixing(index->fixingDate(schedule.startDate()), 0.015);
+
+    leg.insert(leg.end(), floating.begin(), floating.end());
+    leg.insert(leg.end(), capped.begin(), capped.end());
+    leg.push_back(ext::make_shared<SimpleCashFlow>(100.0, schedule.endDate()));
+    // yield calculations assume that cash flows are sorted by date
+    std::stable_sort(leg.begin(), leg.end(),
+                     earlier_than<ext::shared_ptr<CashFlow> >());
+
+    CompiledLeg compiled(leg, false, settlement, dayCounter, today);
+
+    if (compiled.genericCashFlows() != capped.size() + 1)
+        BOOST_ERROR("unexpected number of generic cash flows:"
+                    << "\n    calculated: " << compiled.genericCashFlows()
+                    << "\n    expected:   " << capped.size() + 1);
+
+    Real tolerance = 1.0e-10;
+
+    #define CHECK_COMPILED(what, calculated, expected) \
+    if (std::fabs((calculated) - (expected)) > tolerance) { \
+        BOOST_ERROR("compiled leg " << what << " mismatch:" \
+                    << std::setprecision(12) \
+                    << "\n    calculated: " << (calculated) \
+                    << "\n    expected:   " << (expected)); \
+    }
+
+    ext::shared_ptr<YieldTermStructure> discountCurves[] = {
+        // same reference date and day counter: cached times are used
+        flatRate(today, 0.025, dayCounter),
+        // different ones: the discount factors are taken from the dates
+        flatRate(settlement, 0.03, Actual365Fixed())
+    };
+    for (const auto& discountCurve : discountCurves) {
+        CHECK_COMPILED("NPV",
+                       compiled.npv(*discountCurve),
+                       CashFlows::npv(leg, *discountCurve, false, settlement));
+        CHECK_COMPILED("BPS",
+                       compiled.bps(*discountCurve),
+                       CashFlows::bps(leg, *discountCurve, false, settlement));
+        Real npv, bps, expectedNPV, expectedBPS = 0.0;
+        compiled.npvbps(*discountCurve, settlement, npv, bps);
+        CashFlows::npvbps(leg, *discountCurve, false, settlement, settlement,
+                          expectedNPV, expectedBPS);
+        CHECK_COMPILED("NPV", npv, expectedNPV);
+        CHECK_COMPILED("BPS", bps, expectedBPS);
+    }
+
+    // forecasting the stored Ibor coupons on another curve is the
+    // same as relinking their index; capped coupons would still be
+    // asked for their amounts, so they're left out of the check
+    ext::shared_ptr<YieldTermStructure> discountCurve =
+        flatRate(today, 0.025, dayCounter);
+    ext::shared_ptr<YieldTermStructure> forecastCurve =
+        flatRate(today, 0.018, dayCounter);
+    CompiledLeg compiledFloating(floating, false, settlement,
+                                 dayCounter, today);
+    Real forecastNPV = compiledFloating.npv(*discountCurve, *forecastCurve);
+    forwardingCurve.linkTo(forecastCurve);
+    CompiledLeg relinked(leg, false, settlement, dayCounter, today);
+    CHECK_COMPILED("forecast NPV",
+                   forecastNPV,
+                   CashFlows::npv(floating, *discountCurve, false, settlement));
+    CHECK_COMPILED("relinked NPV",
+                   relinked.npv(*discountCurve),
+                   CashFlows::npv(leg, *discountCurve, false, settlement));
+
+    InterestRate y(0.03, ActualActual(ActualActual::ISMA),
+                   Compounded, Semiannual);
+    CHECK_COMPILED("yield NPV",
+                   relinked.npv(y),
+                   CashFlows::npv(leg, y, false, settlement));
+    CHECK_COMPILED("yield BPS",
+                   relinked.bps(y),
+                   CashFlows::bps(leg, y, false, settlement));
+    Duration::Type types[] = { Duration::Simple, Duration::Modified,
+                               Duration::Macaulay };
+    for (auto type : types) {
+        CHECK_COMPILED("duration",
+                       relinked.duration(y, type),
+                       CashFlows::duration(leg, y, type, false, settlement));
+    }
+
+    Real price = CashFlows::npv(leg, y, false, settlement);
+    Rate calculated = relinked.yield(price, y.dayCounter(),
+                                     y.compounding(), y.frequency());
+    CHECK_COMPILED("yield", calculated, y.rate());
+
+    // an emptied forwarding curve is reported, unless another
+    // curve is given for the forecast; the coupon already fixed is
+    // left out, since its pricer would still use the curve
+    Leg projected(floating.begin()+1, floating.end());
+    CompiledLeg compiledProjected(projected, false, settlement,
+                                  dayCounter, today);
+    Real projectedNPV = compiledProjected.npv(*discountCurve,
+                                              *forecastCurve);
+    forwardingCurve.linkTo(ext::shared_ptr<YieldTermStructure>());
+    BOOST_CHECK_THROW(compiledProjected.npv(*discountCurve), Error);
+    CHECK_COMPILED("forecast NPV",
+                   compiledProjected.npv(*discountCurve, *forecastCurve),
+                   projectedNPV);
+
+    #undef CHECK_COMPILED
+}
+
 test_suite* CashFlowsTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
@@ -519,5 +669,6 @@ test_suite* CashFlowsTest::suite() {
                              &CashFlowsTest::testIrregularLastCouponReferenceDatesAtEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(
                              &CashFlowsTest::testPartialScheduleLegConstruction));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testCompiledLeg));
     return suite;
 }
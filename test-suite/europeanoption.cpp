@@ -32,6 +32,7 @@
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/experimental/variancegamma/fftvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
+#include <ql/methods/montecarlo/montecarlosettings.hpp>
 #include <ql/pricingengines/vanilla/integralengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
@@ -1253,6 +1254,183 @@ void EuropeanOptionTest::testQmcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testMcBlockSimulation() {
+
+    BOOST_TEST_MESSAGE("Testing block-parallel Monte Carlo simulation...");
+
+    SavedSettings backup;
+
+    struct BlockSizeGuard {
+        ~BlockSizeGuard() {
+            MonteCarloSettings::instance().samplesPerBlock() = 0;
+        }
+    } guard;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    ext::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    ext::shared_ptr<StrikedTypePayoff> payoff(
+        new PlainVanillaPayoff(Option::Call, 105.0));
+    ext::shared_ptr<Exercise> exercise(
+        new EuropeanExercise(today + Period(1, Years)));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(
+        ext::make_shared<AnalyticEuropeanEngine>(process));
+    Real expected = option.NPV();
+
+    // low-discrepancy sequences are split exactly; the blocks
+    // reproduce the serial results regardless of the block size
+    option.setPricingEngine(MakeMCEuropeanEngine<LowDiscrepancy>(process)
+                            .withSteps(4)
+                            .withSamples(10000));
+    Real serial = option.NPV();
+
+    Size blockSizes[] = { 1000, 1023, 4096, 20000 };
+    for (Size blockSize : blockSizes) {
+        MonteCarloSettings::instance().samplesPerBlock() = blockSize;
+        option.recalculate();
+        if (option.NPV() != serial)
+            BOOST_ERROR("failed to reproduce serial quasi-Monte Carlo result"
+                        << "\n    block size: " << blockSize
+                        << std::setprecision(12)
+                        << "\n    serial:     " << serial
+                        << "\n    blocks:     " << option.NPV());
+    }
+
+    // pseudo-random blocks use independent streams; results must be
+    // reproducible and consistent with the analytic value
+    MonteCarloSettings::instance().samplesPerBlock() = 2500;
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withAntitheticVariate()
+                            .withSamples(40000)
+                            .withSeed(42));
+    Real first = option.NPV();
+    Real error = option.errorEstimate();
+    option.recalculate();
+    Real second = option.NPV();
+    if (first != second)
+        BOOST_ERROR("failed to reproduce block Monte Carlo result"
+                    << std::setprecision(12)
+                    << "\n    first run:  " << first
+                    << "\n    second run: " << second);
+    if (std::fabs(first - expected) > 3.0*error)
+        BOOST_ERROR("block Monte Carlo result out of tolerance"
+                    << "\n    calculated: " << first
+                    << "\n    expected:   " << expected
+                    << "\n    error est.: " << error);
+
+    // tolerance-driven simulations add samples in several batches
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withAbsoluteTolerance(0.05)
+                            .withSeed(42));
+    Real calculated = option.NPV();
+    if (std::fabs(calculated - expected) > 3.0*option.errorEstimate())
+        BOOST_ERROR("block Monte Carlo result out of tolerance"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected
+                    << "\n    error est.: " << option.errorEstimate());
+}
+
+void EuropeanOptionTest::testMcPathBlocks() {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo simulation with path blocks...");
+
+    SavedSettings backup;
+
+    struct BlockSizeGuard {
+        ~BlockSizeGuard() {
+            MonteCarloSettings::instance().samplesPerBlock() = 0;
+        }
+    } guard;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    Handle<BlackVolTermStructure> volTS(flatVol(today, 0.25, dc));
+
+    // the second process uses the discretized evolution, which
+    // block path generators delegate to the process
+    ext::shared_ptr<GeneralizedBlackScholesProcess> processes[] = {
+        ext::make_shared<BlackScholesMertonProcess>(
+                                  Handle<Quote>(spot), qTS, rTS, volTS),
+        ext::make_shared<GeneralizedBlackScholesProcess>(
+            Handle<Quote>(spot), qTS, rTS, volTS,
+            ext::make_shared<EulerDiscretization>(), true)
+    };
+
+    ext::shared_ptr<StrikedTypePayoff> payoff(
+        new PlainVanillaPayoff(Option::Put, 95.0));
+    ext::shared_ptr<Exercise> exercise(
+        new EuropeanExercise(today + Period(1, Years)));
+    EuropeanOption option(payoff, exercise);
+
+    // the samples are the same as in the path-by-path simulation
+    Size blockSizes[] = { 0, 2500 };
+    for (auto& process : processes) {
+        for (Size blockSize : blockSizes) {
+            MonteCarloSettings::instance().samplesPerBlock() = blockSize;
+
+            option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                                    .withSteps(4)
+                                    .withAntitheticVariate()
+                                    .withSamples(10000)
+                                    .withSeed(42));
+            Real expected = option.NPV();
+
+            option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                                    .withSteps(4)
+                                    .withAntitheticVariate()
+                                    .withSamples(10000)
+                                    .withSeed(42)
+                                    .withPathBlocks(768));
+            Real calculated = option.NPV();
+            if (calculated != expected)
+                BOOST_ERROR("failed to reproduce path-by-path "
+                            "pseudo-random result"
+                            << "\n    samples per block: " << blockSize
+                            << std::setprecision(12)
+                            << "\n    path by path:      " << expected
+                            << "\n    path blocks:       " << calculated);
+
+            option.setPricingEngine(MakeMCEuropeanEngine<LowDiscrepancy>(process)
+                                    .withSteps(4)
+                                    .withBrownianBridge()
+                                    .withSamples(10000));
+            expected = option.NPV();
+
+            option.setPricingEngine(MakeMCEuropeanEngine<LowDiscrepancy>(process)
+                                    .withSteps(4)
+                                    .withBrownianBridge()
+                                    .withSamples(10000)
+                                    .withPathBlocks(1000));
+            calculated = option.NPV();
+            if (calculated != expected)
+                BOOST_ERROR("failed to reproduce path-by-path "
+                            "quasi-random result"
+                            << "\n    samples per block: " << blockSize
+                            << std::setprecision(12)
+                            << "\n    path by path:      " << expected
+                            << "\n    path blocks:       " << calculated);
+        }
+    }
+}
+
 void EuropeanOptionTest::testFFTEngines() {
 
     BOOST_TEST_MESSAGE("Testing FFT European engines "
@@ -1766,6 +1944,8 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcBlockSimulation));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcPathBlocks));
 
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
 
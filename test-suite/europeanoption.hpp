@@ -44,6 +44,8 @@ class EuropeanOptionTest {
     static void testIntegralEngines();
     static void testQmcEngines();
     static void testMcEngines();
+    static void testMcBlockSimulation();
+    static void testMcPathBlocks();
     static void testFFTEngines();
     static void testLocalVolatility();
     static void testAnalyticEngineDiscountCurve();
@@ -34,6 +34,7 @@
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmhestonvariancemesher.hpp>
+#include <ql/pricingengines/fdrichardsonextrapolationengine.hpp>
 #include <ql/pricingengines/barrier/analyticbarrierengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
@@ -979,6 +980,289 @@ void FdHestonTest::testSpuriousOscillations() {
     }
 }
 
+void FdHestonTest::testParallelAdiSweeps() {
+
+    BOOST_TEST_MESSAGE("Testing multi-threaded ADI sweeps in FDM Heston "
+                       "engines...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(28, March, 2004);
+    Date exerciseDate(28, March, 2005);
+
+    Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.01, Actual365Fixed()));
+
+    const ext::shared_ptr<HestonModel> model = ext::make_shared<HestonModel>(
+        ext::make_shared<HestonProcess>(rTS, qTS, s0,
+                                        0.04, 2.5, 0.04, 0.66, -0.8));
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        ext::make_shared<AmericanExercise>(exerciseDate));
+
+    const FdmSchemeDesc schemes[] = {
+        FdmSchemeDesc::Hundsdorfer(), FdmSchemeDesc::Douglas(),
+        FdmSchemeDesc::CraigSneyd(), FdmSchemeDesc::ModifiedCraigSneyd()
+    };
+
+    for (const auto& scheme : schemes) {
+        option.setPricingEngine(MakeFdHestonVanillaEngine(model)
+                                .withTGrid(50).withXGrid(200).withVGrid(100)
+                                .withFdmSchemeDesc(scheme));
+        const Real npv = option.NPV();
+        const Real delta = option.delta();
+        const Real gamma = option.gamma();
+
+        for (Size threads=2; threads <= 4; ++threads) {
+            option.setPricingEngine(MakeFdHestonVanillaEngine(model)
+                                    .withTGrid(50).withXGrid(200).withVGrid(100)
+                                    .withFdmSchemeDesc(
+                                        scheme.withThreads(threads)));
+
+            const Real tol = 1e-12;
+            if (std::fabs(option.NPV() - npv) > tol
+                || std::fabs(option.delta() - delta) > tol
+                || std::fabs(option.gamma() - gamma) > tol) {
+                BOOST_ERROR("multi-threaded results differ from "
+                            "single-threaded ones"
+                            << "\n    scheme type: " << scheme.type
+                            << "\n    threads:     " << threads
+                            << std::setprecision(12)
+                            << "\n    npv:         " << option.NPV()
+                            << "\n    expected:    " << npv
+                            << "\n    delta:       " << option.delta()
+                            << "\n    expected:    " << delta
+                            << "\n    gamma:       " << option.gamma()
+                            << "\n    expected:    " << gamma);
+            }
+        }
+    }
+}
+
+namespace {
+
+    // American put priced by the Heston engine with the given number
+    // of threads; the serial and threaded benchmarks time this on
+    // the same grid
+    void checkAdiPricing(Size threads) {
+        SavedSettings backup;
+
+        Settings::instance().evaluationDate() = Date(28, March, 2004);
+        Date exerciseDate(28, March, 2005);
+
+        Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+        Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+        Handle<YieldTermStructure> qTS(flatRate(0.01, Actual365Fixed()));
+
+        const ext::shared_ptr<HestonModel> model =
+            ext::make_shared<HestonModel>(
+                ext::make_shared<HestonProcess>(rTS, qTS, s0,
+                                                0.04, 2.5, 0.04, 0.66, -0.8));
+
+        VanillaOption option(
+            ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+            ext::make_shared<AmericanExercise>(exerciseDate));
+        option.setPricingEngine(
+            MakeFdHestonVanillaEngine(model)
+            .withTGrid(100).withXGrid(400).withVGrid(100)
+            .withFdmSchemeDesc(FdmSchemeDesc::Douglas().withThreads(threads)));
+
+        const Real expected = 5.83327431272;
+        const Real tol = 1e-8;
+        if (std::fabs(option.NPV() - expected) > tol)
+            BOOST_ERROR("failed to reproduce American put price"
+                        << "\n    threads:    " << threads
+                        << std::setprecision(12)
+                        << "\n    calculated: " << option.NPV()
+                        << "\n    expected:   " << expected);
+    }
+
+}
+
+void FdHestonTest::testSerialAdiPricing() {
+    BOOST_TEST_MESSAGE("Testing FDM Heston engine on a single thread...");
+    checkAdiPricing(1);
+}
+
+void FdHestonTest::testThreadedAdiPricing() {
+    BOOST_TEST_MESSAGE("Testing FDM Heston engine on four threads...");
+    checkAdiPricing(4);
+}
+
+void FdHestonTest::testRichardsonExtrapolationEngine() {
+
+    BOOST_TEST_MESSAGE("Testing Richardson extrapolation of "
+                       "finite-difference engines...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(28, March, 2004);
+    Date exerciseDate(28, March, 2005);
+
+    const ext::shared_ptr<SimpleQuote> spot =
+        ext::make_shared<SimpleQuote>(100.0);
+    Handle<Quote> s0(spot);
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.01, Actual365Fixed()));
+
+    typedef FdRichardsonExtrapolationEngine<
+        DividendVanillaOption::arguments,
+        DividendVanillaOption::results> RichardsonEngine;
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        ext::make_shared<EuropeanExercise>(exerciseDate));
+
+    // Black-Scholes
+    const ext::shared_ptr<BlackScholesMertonProcess> bsProcess =
+        ext::make_shared<BlackScholesMertonProcess>(
+            s0, qTS, rTS, Handle<BlackVolTermStructure>(
+                flatVol(0.2, Actual365Fixed())));
+
+    option.setPricingEngine(
+        ext::make_shared<AnalyticEuropeanEngine>(bsProcess));
+    const Real bsExpected = option.NPV();
+    const Real bsExpectedDelta = option.delta();
+
+    const ext::shared_ptr<PricingEngine> bsCoarse =
+        ext::make_shared<FdBlackScholesVanillaEngine>(bsProcess, 20, 50);
+    const ext::shared_ptr<PricingEngine> bsFine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(bsProcess, 40, 100);
+
+    // Heston
+    const ext::shared_ptr<HestonModel> model = ext::make_shared<HestonModel>(
+        ext::make_shared<HestonProcess>(rTS, qTS, s0,
+                                        0.04, 2.5, 0.04, 0.66, -0.8));
+
+    option.setPricingEngine(ext::make_shared<AnalyticHestonEngine>(model));
+    const Real hestonExpected = option.NPV();
+    // the analytic engine doesn't provide greeks
+    const Real h = 0.01;
+    spot->setValue(100.0 + h);
+    const Real npvUp = option.NPV();
+    spot->setValue(100.0 - h);
+    const Real npvDown = option.NPV();
+    spot->setValue(100.0);
+    const Real hestonExpectedDelta = (npvUp - npvDown)/(2*h);
+
+    const ext::shared_ptr<PricingEngine> hestonCoarse =
+        MakeFdHestonVanillaEngine(model)
+        .withTGrid(20).withXGrid(50).withVGrid(20);
+    const ext::shared_ptr<PricingEngine> hestonFine =
+        MakeFdHestonVanillaEngine(model)
+        .withTGrid(40).withXGrid(100).withVGrid(40);
+
+    const struct {
+        const char* model;
+        ext::shared_ptr<PricingEngine> coarse, fine;
+        Real expected, expectedDelta;
+    } testCases[] = {
+        { "Black-Scholes", bsCoarse, bsFine, bsExpected, bsExpectedDelta },
+        { "Heston", hestonCoarse, hestonFine,
+          hestonExpected, hestonExpectedDelta }
+    };
+
+    for (const auto& testCase : testCases) {
+        option.setPricingEngine(testCase.fine);
+        const Real fineNPV = option.NPV();
+
+        option.setPricingEngine(ext::make_shared<RichardsonEngine>(
+            testCase.coarse, testCase.fine));
+        const Real npv = option.NPV();
+        const Real delta = option.delta();
+
+        const Real fineError = std::fabs(fineNPV - testCase.expected);
+        const Real error = std::fabs(npv - testCase.expected);
+
+        if (error > 0.5*fineError
+            || std::fabs(delta - testCase.expectedDelta) > 1e-3
+            || std::fabs(option.result<Real>("fineValue") - fineNPV) > 1e-12
+            || std::fabs(option.errorEstimate() - std::fabs(npv - fineNPV))
+                > 1e-12) {
+            BOOST_ERROR("failed to improve the accuracy by "
+                        "Richardson extrapolation"
+                        << "\n    model:          " << testCase.model
+                        << std::setprecision(8)
+                        << "\n    fine npv:       " << fineNPV
+                        << "\n    extrapolated:   " << npv
+                        << "\n    expected:       " << testCase.expected
+                        << "\n    error estimate: " << option.errorEstimate()
+                        << "\n    delta:          " << delta
+                        << "\n    expected delta: "
+                        << testCase.expectedDelta);
+        }
+    }
+}
+
+void FdHestonTest::testConcurrentRichardsonExtrapolation() {
+
+    BOOST_TEST_MESSAGE("Testing concurrent Richardson extrapolation of "
+                       "finite-difference engines...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(28, March, 2004);
+    Date exerciseDate(28, March, 2005);
+
+    Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.01, Actual365Fixed()));
+
+    typedef FdRichardsonExtrapolationEngine<
+        DividendVanillaOption::arguments,
+        DividendVanillaOption::results> RichardsonEngine;
+
+    const ext::shared_ptr<HestonModel> model = ext::make_shared<HestonModel>(
+        ext::make_shared<HestonProcess>(rTS, qTS, s0,
+                                        0.04, 2.5, 0.04, 0.66, -0.8));
+
+    const ext::shared_ptr<PricingEngine> coarse =
+        MakeFdHestonVanillaEngine(model)
+        .withTGrid(20).withXGrid(50).withVGrid(20);
+    const ext::shared_ptr<PricingEngine> fine =
+        MakeFdHestonVanillaEngine(model)
+        .withTGrid(40).withXGrid(100).withVGrid(40);
+
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) || \
+    defined(QL_ENABLE_RCU_OBSERVER_PATTERN)
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        ext::make_shared<AmericanExercise>(
+            Settings::instance().evaluationDate(), exerciseDate));
+
+    option.setPricingEngine(
+        ext::make_shared<RichardsonEngine>(coarse, fine, 2.0, 2.0, false));
+    const Real expected = option.NPV();
+    const Real expectedDelta = option.delta();
+
+    option.setPricingEngine(
+        ext::make_shared<RichardsonEngine>(coarse, fine, 2.0, 2.0, true));
+
+    for (Size i=0; i < 5; ++i) {
+        option.recalculate();
+        const Real npv = option.NPV();
+        const Real delta = option.delta();
+
+        if (std::fabs(npv - expected) > 1e-12
+            || std::fabs(delta - expectedDelta) > 1e-12) {
+            BOOST_FAIL("concurrent and sequential Richardson "
+                       "extrapolation differ"
+                       << std::setprecision(12)
+                       << "\n    sequential npv:   " << expected
+                       << "\n    concurrent npv:   " << npv
+                       << "\n    sequential delta: " << expectedDelta
+                       << "\n    concurrent delta: " << delta);
+        }
+    }
+#else
+    BOOST_CHECK_THROW(
+        RichardsonEngine(coarse, fine, 2.0, 2.0, true), Error);
+#endif
+}
+
 test_suite* FdHestonTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Finite Difference Heston tests");
 
@@ -992,6 +1276,13 @@ test_suite* FdHestonTest::suite(SpeedLevel speed) {
         &FdHestonTest::testFdmHestonIntradayPricing));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testMethodOfLinesAndCN));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testSpuriousOscillations));
+    suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testParallelAdiSweeps));
+    suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testSerialAdiPricing));
+    suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testThreadedAdiPricing));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdHestonTest::testRichardsonExtrapolationEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdHestonTest::testConcurrentRichardsonExtrapolation));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
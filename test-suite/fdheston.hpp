@@ -40,6 +40,11 @@ public:
     static void testFdmHestonIntradayPricing();
     static void testMethodOfLinesAndCN();
     static void testSpuriousOscillations();
+    static void testParallelAdiSweeps();
+    static void testSerialAdiPricing();
+    static void testThreadedAdiPricing();
+    static void testRichardsonExtrapolationEngine();
+    static void testConcurrentRichardsonExtrapolation();
 
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
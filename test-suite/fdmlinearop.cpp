@@ -41,9 +41,11 @@
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/cranknicolsonscheme.hpp>
 #include <ql/methods/finitedifferences/meshers/uniformgridmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/uniform1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
@@ -52,6 +54,7 @@
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmmesherintegral.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmthreadpool.hpp>
 #include <ql/methods/finitedifferences/operators/numericaldifferentiation.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
@@ -143,6 +146,14 @@ namespace {
         V operator()(T t, U u) { return t*u;}
     };
 
+    Real maxDiff(const Array& x, const Array& y) {
+        QL_REQUIRE(x.size() == y.size(), "arrays with different sizes");
+        Real diff = 0.0;
+        for (Size i=0; i < x.size(); ++i)
+            diff = std::max(diff, std::fabs(x[i] - y[i]));
+        return diff;
+    }
+
 }
 
 void FdmLinearOpTest::testFdmLinearOpLayout() {
@@ -736,6 +747,116 @@ void FdmLinearOpTest::testTripleBandMapSolve() {
 }
 
 
+void FdmLinearOpTest::testBatchedTripleBandSolve() {
+
+    BOOST_TEST_MESSAGE("Testing batched triple-band solutions...");
+
+    // line counts which aren't multiples of the batch sizes
+    const std::vector<Size> dim = {13, 70, 5};
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    std::vector<std::pair<Real, Real> > boundaries = {
+        {0.0, 1.0}, {-1.0, 2.0}, {0.5, 1.5}
+    };
+    ext::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Array u(layout->size());
+    for (Size i=0; i < u.size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    const Real a = -0.1, b = 1.0;
+    FdmThreadPool pool(3);
+
+    for (Size direction=0; direction < dim.size(); ++direction) {
+        SecondDerivativeOp op(direction, mesher);
+        op.axpyb(Array(1, 0.3), FirstDerivativeOp(direction, mesher),
+                 op, Array(1, -0.05));
+
+        for (Size threads=1; threads <= pool.threads(); threads += 2) {
+            const FdmThreadPool::Scope scope(threads > 1 ? &pool : nullptr);
+
+            const Array x = op.solve_splitting(u, a, b);
+            const Array r = a*op.apply(x) + b*x;
+
+            for (Size i=0; i < u.size(); ++i) {
+                if (std::fabs(u[i] - r[i]) > 1e-10) {
+                    BOOST_FAIL("batched solve and apply are not consistent"
+                               << "\n direction     : " << direction
+                               << "\n threads       : " << threads
+                               << "\n expected      : " << u[i]
+                               << "\n calculated    : " << r[i]);
+                }
+            }
+        }
+    }
+}
+
+void FdmLinearOpTest::testInPlaceOperators() {
+
+    BOOST_TEST_MESSAGE("Testing in-place application of linear operators...");
+
+    SavedSettings backup;
+
+    const std::vector<Size> dim = {50, 30};
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    std::vector<std::pair<Real, Real> > boundaries = {{3.8, 4.9}, {0.0, 1.0}};
+    ext::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+    ext::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    FdmHestonOp hestonOp(mesher, hestonProcess);
+    hestonOp.setTime(0.5, 0.6);
+
+    Array u(layout->size());
+    for (Size i=0; i < u.size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    const Real tol = 1e-12;
+    // the result is resized when needed and overwritten when reused
+    Array result, calculated;
+
+    hestonOp.apply_into(u, result);
+    hestonOp.apply_into(u, result);
+    if (maxDiff(result, hestonOp.apply(u)) > tol)
+        BOOST_FAIL("in-place and allocating apply differ");
+
+    calculated = Array(3, 42.0);
+    hestonOp.apply_mixed_into(u, calculated);
+    if (maxDiff(calculated, hestonOp.apply_mixed(u)) > tol)
+        BOOST_FAIL("in-place and allocating apply_mixed differ");
+
+    for (Size direction=0; direction < 2; ++direction) {
+        hestonOp.apply_direction_into(direction, u, result);
+        if (maxDiff(result, hestonOp.apply_direction(direction, u)) > tol)
+            BOOST_FAIL("in-place and allocating apply_direction differ"
+                       << "\n    direction: " << direction);
+
+        hestonOp.solve_splitting_into(direction, u, -0.05, result);
+        if (maxDiff(result, hestonOp.solve_splitting(direction, u, -0.05))
+            > tol)
+            BOOST_FAIL("in-place and allocating solve_splitting differ"
+                       << "\n    direction: " << direction);
+    }
+
+    hestonOp.preconditioner_into(u, 0.05, result);
+    if (maxDiff(result, hestonOp.preconditioner(u, 0.05)) > tol)
+        BOOST_FAIL("in-place and allocating preconditioner differ");
+
+    // the triple-band solver can overwrite its right-hand side
+    SecondDerivativeOp dxx(0, mesher);
+    const Array expected = dxx.solve_splitting(u, -0.05, 1.0);
+    Array scratch;
+    calculated = u;
+    dxx.solve_splitting_into(calculated, -0.05, 1.0, calculated, scratch);
+    if (maxDiff(calculated, expected) > tol)
+        BOOST_FAIL("in-place triple-band solution differs");
+}
+
 void FdmLinearOpTest::testFdmHestonBarrier() {
 
     BOOST_TEST_MESSAGE("Testing FDM with barrier option in Heston model...");
@@ -1205,6 +1326,69 @@ void FdmLinearOpTest::testFdmHestonHullWhiteOp() {
     }
 }
 
+void FdmLinearOpTest::testFdmNdimSolverBoundedSnapshots() {
+    BOOST_TEST_MESSAGE("Testing memory-bounded snapshots of the "
+                       "n-dimensional FDM solver...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+    const Time maturity = 1.0;
+
+    const std::vector<Size> dim = {31, 15, 15};
+    const ext::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+        = createHestonHullWhite(maturity);
+    const FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+
+    const ext::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+        = jointProcess->hullWhiteProcess();
+    const ext::shared_ptr<FdmLinearOpComposite> linearOp =
+        ext::make_shared<FdmHestonHullWhiteOp>(
+            desc.mesher, jointProcess->hestonProcess(),
+            ext::make_shared<HullWhiteProcess>(
+                jointProcess->hestonProcess()->riskFreeRate(),
+                hwFwdProcess->a(), hwFwdProcess->sigma()),
+            jointProcess->eta());
+
+    const FdmNdimSolver<3> full(
+        desc, FdmSchemeDesc::Hundsdorfer(), linearOp);
+    const FdmNdimSolver<3> bounded(
+        desc, FdmSchemeDesc::Hundsdorfer(), linearOp,
+        FdmNdimSolver<3>::Bounded);
+
+    const Real v0 = jointProcess->hestonProcess()->v0();
+    const Real spots[] = { 80.0, 100.0, 140.0, 160.0, 200.0 };
+    for (Real spot : spots) {
+        const std::vector<Real> x = { std::log(spot), v0, 0.0 };
+
+        const Real expected = full.interpolateAt(x);
+        const Real calculated = bounded.interpolateAt(x);
+        const Real expectedTheta = full.thetaAt(x);
+        const Real calculatedTheta = bounded.thetaAt(x);
+
+        const Real tol = 1e-3;
+        if (std::fabs(calculated - expected) > tol*std::max(1.0, expected)
+            || std::fabs(calculatedTheta - expectedTheta)
+                > tol*std::max(1.0, std::fabs(expectedTheta))) {
+            BOOST_FAIL("bounded snapshots differ from full snapshots"
+                       << "\n spot:       " << spot
+                       << "\n npv:        " << calculated
+                       << "\n expected:   " << expected
+                       << "\n theta:      " << calculatedTheta
+                       << "\n expected:   " << expectedTheta);
+        }
+    }
+
+    const Real fullBytes = full.snapshotBytesPerGridPoint();
+    const Real boundedBytes = bounded.snapshotBytesPerGridPoint();
+    if (boundedBytes > 2.1*sizeof(Real) || boundedBytes >= fullBytes) {
+        BOOST_FAIL("unexpected memory usage of the bounded snapshots"
+                   << "\n bounded bytes per point: " << boundedBytes
+                   << "\n full bytes per point:    " << fullBytes);
+    }
+}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
 namespace {
     Disposable<Array> axpy(
@@ -1346,6 +1530,187 @@ void FdmLinearOpTest::testGMRES() {
 #endif
 }
 
+void FdmLinearOpTest::testCsrIlu0Solver() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE(
+        "Testing CSR matrix and ILU(0) preconditioned implicit schemes...");
+
+    SavedSettings backup;
+
+    const Size n=41, m=21;
+    const boost::numeric::ublas::compressed_matrix<Real> a
+        = createTestMatrix(n, m, 1.0);
+
+    Array b(n*m);
+    MersenneTwisterUniformRng rng(1234);
+    for (double& i : b) {
+        i = rng.next().value;
+    }
+
+    const Real alpha = -0.5, d = 2.0;
+    const CsrMatrix csr(a, alpha, d);
+    const Array diff = csr.apply(b) - (alpha*axpy(a, b) + d*b);
+    if (std::sqrt(DotProduct(diff, diff)) > 1e-12) {
+        BOOST_FAIL("CSR matrix-vector product differs from ublas product"
+                   << "\n difference: " << std::sqrt(DotProduct(diff, diff)));
+    }
+
+    const CsrMatrix csrA(a);
+    const CsrIlu0Preconditioner ilu(csrA);
+    const Real tol = 1e-10;
+    const Array x = BiCGstab(
+        [&](const Array& _x) { return csrA.apply(_x); }, n*m, tol,
+        [&](const Array& _x) { return ilu.apply(_x); }).solve(b).x;
+
+    const Real error = std::sqrt(DotProduct(b-axpy(a, x),
+                                 b-axpy(a, x))/DotProduct(b,b));
+    if (error > tol) {
+        BOOST_FAIL("Error calculating the inverse using CSR ILU(0)"
+                   << "\n tolerance:  " << tol
+                   << "\n error:      " << error);
+    }
+
+    // implicit schemes on a Heston Hull-White operator,
+    // which has mixed derivatives in all directions
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+    const Time maturity = 1.0;
+
+    const std::vector<Size> dim = {21, 11, 11};
+    const ext::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+        = createHestonHullWhite(maturity);
+    const FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    const ext::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    const ext::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+        = jointProcess->hullWhiteProcess();
+    const ext::shared_ptr<HullWhiteProcess> hwProcess =
+        ext::make_shared<HullWhiteProcess>(
+            jointProcess->hestonProcess()->riskFreeRate(),
+            hwFwdProcess->a(), hwFwdProcess->sigma());
+
+    const ext::shared_ptr<FdmLinearOpComposite> linearOp =
+        ext::make_shared<FdmHestonHullWhiteOp>(
+            mesher, jointProcess->hestonProcess(), hwProcess,
+            jointProcess->eta());
+
+    Array rhs(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        rhs[iter.index()] = desc.calculator->avgInnerValue(iter, maturity);
+    }
+
+    const Size timeSteps = 10;
+    const Real relTol = 1e-10;
+
+    for (Size i=0; i < 2; ++i) {
+        const Real theta = (i == 0) ? 1.0 : 0.5;
+
+        Array expected(rhs), calculated(rhs);
+        CrankNicolsonScheme reference(
+            theta, linearOp, FdmBoundaryConditionSet(), relTol,
+            ImplicitEulerScheme::BiCGstab);
+        CrankNicolsonScheme csrScheme(
+            theta, linearOp, FdmBoundaryConditionSet(), relTol,
+            ImplicitEulerScheme::BiCGstabILU0);
+
+        FiniteDifferenceModel<CrankNicolsonScheme>(reference)
+            .rollback(expected, maturity, 0.0, timeSteps);
+        FiniteDifferenceModel<CrankNicolsonScheme>(csrScheme)
+            .rollback(calculated, maturity, 0.0, timeSteps);
+
+        const Real diff = std::sqrt(
+            DotProduct(expected-calculated, expected-calculated)
+            / DotProduct(expected, expected));
+
+        if (diff > 1e-8) {
+            BOOST_FAIL("ILU(0) preconditioned scheme differs from "
+                       "reference scheme"
+                       << "\n theta:       " << theta
+                       << "\n difference:  " << diff);
+        }
+        if (csrScheme.numberOfIterations() > reference.numberOfIterations()) {
+            BOOST_FAIL("ILU(0) preconditioned scheme needs more iterations "
+                       "than reference scheme"
+                       << "\n theta:       " << theta
+                       << "\n ILU(0):      " << csrScheme.numberOfIterations()
+                       << "\n reference:   " << reference.numberOfIterations());
+        }
+    }
+#endif
+}
+
+namespace {
+
+    // at-the-money Heston Hull-White call, rolled back with the given
+    // scheme, e.g., Crank-Nicolson with a given solver for its
+    // implicit steps
+    Real hestonHullWhiteCall(const FdmSchemeDesc& schemeDesc) {
+        SavedSettings backup;
+        Settings::instance().evaluationDate() = Date(28, March, 2004);
+        const Time maturity = 1.0;
+
+        const std::vector<Size> dim = {41, 21, 21};
+        const ext::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+            = createHestonHullWhite(maturity);
+        const FdmSolverDesc d = createSolverDesc(dim, jointProcess);
+        const FdmSolverDesc desc = {
+            d.mesher, d.bcSet, d.condition, d.calculator,
+            d.maturity, 20, d.dampingSteps };
+
+        const ext::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+            = jointProcess->hullWhiteProcess();
+        const ext::shared_ptr<HullWhiteProcess> hwProcess =
+            ext::make_shared<HullWhiteProcess>(
+                jointProcess->hestonProcess()->riskFreeRate(),
+                hwFwdProcess->a(), hwFwdProcess->sigma());
+        const ext::shared_ptr<FdmLinearOpComposite> linearOp =
+            ext::make_shared<FdmHestonHullWhiteOp>(
+                desc.mesher, jointProcess->hestonProcess(), hwProcess,
+                jointProcess->eta());
+
+        const Fdm3DimSolver solver(desc, schemeDesc, linearOp);
+        return solver.interpolateAt(std::log(160.0), 0.04, 0.0);
+    }
+
+    void checkHestonHullWhiteCall(ImplicitEulerScheme::SolverType solverType) {
+        const Real expected = 13.0416635;
+        const Real calculated = hestonHullWhiteCall(
+            FdmSchemeDesc::CrankNicolson().withSolverType(solverType));
+        if (std::fabs(calculated - expected) > 1e-6)
+            BOOST_ERROR("failed to reproduce Heston Hull-White call price"
+                        << "\n    solver type: " << solverType
+                        << std::setprecision(10)
+                        << "\n    calculated:  " << calculated
+                        << "\n    expected:    " << expected);
+
+        // same grid, different scheme
+        const Real adi = hestonHullWhiteCall(FdmSchemeDesc::Hundsdorfer());
+        if (std::fabs(calculated - adi) > 1e-2)
+            BOOST_ERROR("Crank-Nicolson and Hundsdorfer prices differ"
+                        << "\n    solver type:      " << solverType
+                        << std::setprecision(10)
+                        << "\n    Crank-Nicolson:   " << calculated
+                        << "\n    Hundsdorfer:      " << adi);
+    }
+
+}
+
+void FdmLinearOpTest::testHestonHullWhiteBiCGstab() {
+    BOOST_TEST_MESSAGE("Testing Heston Hull-White Crank-Nicolson scheme "
+                       "with BiCGstab...");
+    checkHestonHullWhiteCall(ImplicitEulerScheme::BiCGstab);
+}
+
+void FdmLinearOpTest::testHestonHullWhiteBiCGstabIlu0() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE("Testing Heston Hull-White Crank-Nicolson scheme "
+                       "with ILU(0) preconditioned BiCGstab...");
+    checkHestonHullWhiteCall(ImplicitEulerScheme::BiCGstabILU0);
+#endif
+}
+
 void FdmLinearOpTest::testCrankNicolsonWithDamping() {
 
     BOOST_TEST_MESSAGE("Testing Crank-Nicolson with initial implicit damping steps "
@@ -1438,6 +1803,235 @@ void FdmLinearOpTest::testCrankNicolsonWithDamping() {
     }
 }
 
+namespace {
+    class RecordingStepCondition : public StepCondition<Array> {
+      public:
+        void applyTo(Array&, Time t) const override { times.push_back(t); }
+        mutable std::vector<Time> times;
+    };
+}
+
+void FdmLinearOpTest::testAdaptiveTimeStepping() {
+
+    BOOST_TEST_MESSAGE("Testing adaptive time stepping of the backward solver...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(22, October, 2020);
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc))));
+
+    ext::shared_ptr<StrikedTypePayoff> payoff(
+                                  new PlainVanillaPayoff(Option::Put, 100));
+
+    const Time maturity = 1.0;
+    VanillaOption opt(payoff, ext::make_shared<EuropeanExercise>(
+                                  today + timeToDays(maturity, 365)));
+    opt.setPricingEngine(ext::make_shared<AnalyticEuropeanEngine>(process));
+    const Real expectedPV = opt.NPV();
+
+    const ext::shared_ptr<FdmMesher> mesher =
+        ext::make_shared<FdmMesherComposite>(
+            ext::make_shared<FdmBlackScholesMesher>(
+                400, process, maturity, payoff->strike(),
+                Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                std::pair<Real, Real>(payoff->strike(), 0.1)));
+
+    const ext::shared_ptr<FdmBlackScholesOp> map =
+        ext::make_shared<FdmBlackScholesOp>(
+            mesher, process, payoff->strike());
+    FdmLogInnerValue calculator(payoff, mesher, 0);
+
+    Array x(mesher->layout()->size()), payoffValues(x.size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        payoffValues[iter.index()] =
+            calculator.avgInnerValue(iter, maturity);
+        x[iter.index()] = mesher->location(iter, 0);
+    }
+
+    const std::vector<Time> stoppingTimes = {0.3, 0.6};
+    const ext::shared_ptr<RecordingStepCondition> recorder =
+        ext::make_shared<RecordingStepCondition>();
+    const ext::shared_ptr<FdmStepConditionComposite> conditions =
+        ext::make_shared<FdmStepConditionComposite>(
+            std::list<std::vector<Time> >(1, stoppingTimes),
+            FdmStepConditionComposite::Conditions(1, recorder));
+
+    Array reference(payoffValues);
+    FdmBackwardSolver(map, FdmBoundaryConditionSet(), conditions,
+                      FdmSchemeDesc::Douglas())
+        .rollback(reference, maturity, 0.0, 1000, 2);
+
+    const Real tol = 1e-5;
+    FdmBackwardSolver solver(map, FdmBoundaryConditionSet(), conditions,
+                             FdmSchemeDesc::Douglas().withAdaptiveSteps(tol));
+
+    recorder->times.clear();
+    Array rhs(payoffValues);
+    solver.rollback(rhs, maturity, 0.0, 10, 2);
+
+    for (Time stoppingTime : stoppingTimes) {
+        if (std::find(recorder->times.begin(), recorder->times.end(),
+                      stoppingTime) == recorder->times.end()) {
+            BOOST_FAIL("adaptive time stepping missed a stopping time"
+                       << "\n stopping time: " << stoppingTime);
+        }
+    }
+
+    if (solver.numberOfSteps() >= 200) {
+        BOOST_FAIL("too many adaptive time steps"
+                   << "\n steps:    " << solver.numberOfSteps()
+                   << "\n rejected: " << solver.rejectedSteps());
+    }
+
+    const Real s = std::log(spot->value());
+    const Real calculatedPV =
+        MonotonicCubicNaturalSpline(x.begin(), x.end(), rhs.begin())(s);
+    const Real referencePV =
+        MonotonicCubicNaturalSpline(x.begin(), x.end(), reference.begin())(s);
+
+    if (std::fabs(calculatedPV - referencePV) > 1e-3
+        || std::fabs(calculatedPV - expectedPV) > 1e-2) {
+        BOOST_FAIL("Error calculating the PV with adaptive time steps"
+                   << "\n steps:      " << solver.numberOfSteps()
+                   << "\n rejected:   " << solver.rejectedSteps()
+                   << "\n calculated: " << calculatedPV
+                   << "\n reference:  " << referencePV
+                   << "\n expected:   " << expectedPV);
+    }
+}
+
+void FdmLinearOpTest::testCoefficientCaching() {
+
+    BOOST_TEST_MESSAGE("Testing reuse of operator coefficients "
+                       "across time steps...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(22, October, 2020);
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<Quote> spot(ext::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.03, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.01, dc));
+
+    const std::vector<Date> dates = {
+        today, today + Period(1, Years), today + Period(2, Years) };
+    const std::vector<Rate> rates = { 0.01, 0.05, 0.07 };
+    const Handle<YieldTermStructure> zeroTS(
+        ext::make_shared<ZeroCurve>(dates, rates, dc));
+
+    const ext::shared_ptr<BlackScholesMertonProcess> flatProcess =
+        ext::make_shared<BlackScholesMertonProcess>(
+            spot, qTS, rTS,
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)));
+    const ext::shared_ptr<BlackScholesMertonProcess> zeroProcess =
+        ext::make_shared<BlackScholesMertonProcess>(
+            spot, qTS, zeroTS,
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)));
+
+    // the second direction only replicates the spot grid
+    const ext::shared_ptr<FdmMesher> mesher =
+        ext::make_shared<FdmMesherComposite>(
+            ext::make_shared<Uniform1dMesher>(
+                std::log(20.0), std::log(500.0), 50),
+            ext::make_shared<Uniform1dMesher>(0.0, 1.0, 3));
+
+    Array u(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        const Real x = mesher->location(iter, 0);
+        u[iter.index()] = std::max(100.0 - std::exp(x), 0.0)
+            + std::sin(x)*(1.0 + mesher->location(iter, 1));
+    }
+
+    const ext::shared_ptr<HestonProcess> hestonProcess =
+        ext::make_shared<HestonProcess>(
+            rTS, qTS, spot, 0.04, 1.0, 0.04, 0.5, -0.7);
+    const ext::shared_ptr<FdmMesher> hestonMesher =
+        ext::make_shared<FdmMesherComposite>(
+            ext::make_shared<Uniform1dMesher>(
+                std::log(20.0), std::log(500.0), 50),
+            ext::make_shared<Uniform1dMesher>(0.0, 1.0, 3));
+
+    FdmBlackScholesOp flatOp(mesher, flatProcess, 100.0);
+    FdmBlackScholesOp localVolOp(mesher, flatProcess, 100.0, true);
+    FdmBlackScholesOp zeroOp(mesher, zeroProcess, 100.0);
+    FdmHestonOp hestonOp(hestonMesher, hestonProcess);
+
+    const Size steps = 10;
+    const Time dt = 0.01;
+    for (Size i=0; i < steps; ++i) {
+        flatOp.setTime(i*dt, (i+1)*dt);
+        localVolOp.setTime(i*dt, (i+1)*dt);
+        zeroOp.setTime(i*dt, (i+1)*dt);
+        hestonOp.setTime(i*dt, (i+1)*dt);
+    }
+
+    if (flatOp.reusedCoefficients() != steps-1
+        || localVolOp.reusedCoefficients() != steps-1
+        || hestonOp.reusedCoefficients() != steps-1) {
+        BOOST_FAIL("coefficients are not reused on flat term structures"
+                   << "\n expected:  " << steps-1
+                   << "\n constant:  " << flatOp.reusedCoefficients()
+                   << "\n local vol: " << localVolOp.reusedCoefficients()
+                   << "\n Heston:    " << hestonOp.reusedCoefficients());
+    }
+    if (zeroOp.reusedCoefficients() != 0) {
+        BOOST_FAIL("coefficients are reused on a time-dependent curve"
+                   << "\n reused: " << zeroOp.reusedCoefficients());
+    }
+
+    const Time t1 = (steps-1)*dt, t2 = steps*dt;
+    FdmBlackScholesOp flatRef(mesher, flatProcess, 100.0);
+    FdmBlackScholesOp zeroRef(mesher, zeroProcess, 100.0);
+    FdmHestonOp hestonRef(hestonMesher, hestonProcess);
+    flatRef.setTime(t1, t2);
+    zeroRef.setTime(t1, t2);
+    hestonRef.setTime(t1, t2);
+
+    const Array flatExpected = flatRef.apply(u);
+    const Array zeroExpected = zeroRef.apply(u);
+    const Array hestonExpected = hestonRef.apply(u);
+    const Array flatCalculated = flatOp.apply(u);
+    const Array localVolCalculated = localVolOp.apply(u);
+    const Array zeroCalculated = zeroOp.apply(u);
+    const Array hestonCalculated = hestonOp.apply(u);
+
+    const Real tol = 1e-10;
+    for (Size i=0; i < u.size(); ++i) {
+        const Real scale = 1.0 + std::fabs(flatExpected[i]);
+        if (std::fabs(flatCalculated[i] - flatExpected[i]) > tol*scale
+            || std::fabs(localVolCalculated[i] - flatExpected[i]) > tol*scale
+            || std::fabs(zeroCalculated[i] - zeroExpected[i])
+                > tol*(1.0 + std::fabs(zeroExpected[i]))
+            || std::fabs(hestonCalculated[i] - hestonExpected[i])
+                > tol*(1.0 + std::fabs(hestonExpected[i]))) {
+            BOOST_FAIL("cached operator differs from a fresh one"
+                       << "\n index:      " << i
+                       << "\n constant:   " << flatCalculated[i]
+                       << "\n local vol:  " << localVolCalculated[i]
+                       << "\n expected:   " << flatExpected[i]
+                       << "\n zero curve: " << zeroCalculated[i]
+                       << "\n expected:   " << zeroExpected[i]
+                       << "\n Heston:     " << hestonCalculated[i]
+                       << "\n expected:   " << hestonExpected[i]);
+        }
+    }
+}
+
 void FdmLinearOpTest::testSpareMatrixReference() {
 #ifndef QL_NO_UBLAS_SUPPORT
     BOOST_TEST_MESSAGE("Testing SparseMatrixReference type...");
@@ -1725,12 +2319,21 @@ test_suite* FdmLinearOpTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testDerivativeWeightsOnNonUniformGrids));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSecondOrderMixedDerivativesMapApply));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapSolve));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testBatchedTripleBandSolve));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testInPlaceOperators));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonBarrier));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonExpress));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testBiCGstab));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testGMRES));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCsrIlu0Solver));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testHestonHullWhiteBiCGstab));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testHestonHullWhiteBiCGstabIlu0));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCrankNicolsonWithDamping));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testAdaptiveTimeStepping));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCoefficientCaching));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSpareMatrixReference));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSparseMatrixZeroAssignment));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmMesherIntegral));
@@ -1739,6 +2342,8 @@ test_suite* FdmLinearOpTest::suite(SpeedLevel speed) {
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonHullWhiteOp));
+        suite->add(QUANTLIB_TEST_CASE(
+            &FdmLinearOpTest::testFdmNdimSolverBoundedSnapshots));
     }
 
     return suite;
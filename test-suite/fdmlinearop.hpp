@@ -37,13 +37,21 @@ public:
     static void testDerivativeWeightsOnNonUniformGrids();
     static void testSecondOrderMixedDerivativesMapApply();
     static void testTripleBandMapSolve();
+    static void testBatchedTripleBandSolve();
+    static void testInPlaceOperators();
     static void testFdmHestonBarrier();
     static void testFdmHestonAmerican();
     static void testFdmHestonExpress();
     static void testFdmHestonHullWhiteOp();
+    static void testFdmNdimSolverBoundedSnapshots();
     static void testBiCGstab();
     static void testGMRES();
+    static void testCsrIlu0Solver();
+    static void testHestonHullWhiteBiCGstab();
+    static void testHestonHullWhiteBiCGstabIlu0();
     static void testCrankNicolsonWithDamping();
+    static void testAdaptiveTimeStepping();
+    static void testCoefficientCaching();
     static void testSpareMatrixReference();
     static void testSparseMatrixZeroAssignment();
     static void testFdmMesherIntegral();
@@ -78,6 +78,8 @@
 #include <ql/experimental/finitedifferences/fdmsquarerootfwdop.hpp>
 #include <ql/experimental/finitedifferences/fdmblackscholesfwdop.hpp>
 #include <ql/experimental/finitedifferences/fdmhestongreensfct.hpp>
+#include <ql/experimental/finitedifferences/fdblackscholesfwddensityengine.hpp>
+#include <ql/experimental/finitedifferences/fdhestonfwddensityengine.hpp>
 #include <ql/methods/finitedifferences/utilities/localvolrndcalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/squarerootprocessrndcalculator.hpp>
 #include <ql/experimental/finitedifferences/fdhestondoublebarrierengine.hpp>
@@ -2577,6 +2579,90 @@ void HestonSLVModelTest::testDiffusionAndDriftSlvProcess() {
     }
 }
 
+void HestonSLVModelTest::testForwardDensityEngines() {
+    BOOST_TEST_MESSAGE("Testing European option surfaces priced "
+                       "with forward density engines...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date todaysDate = Date(15, March, 2021);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Handle<Quote> spot(ext::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(0.03, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.01, dc));
+
+    const ext::shared_ptr<BlackScholesMertonProcess> bsProcess(
+        ext::make_shared<BlackScholesMertonProcess>(
+            spot, qTS, rTS, Handle<BlackVolTermStructure>(flatVol(0.25, dc))));
+
+    const ext::shared_ptr<HestonModel> hestonModel(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                rTS, qTS, spot, 0.05, 1.0, 0.05, std::sqrt(0.05), -0.75)));
+
+    std::vector<Date> expiries = {
+        todaysDate + Period(3, Months),
+        todaysDate + Period(1, Years),
+        todaysDate + Period(2, Years)
+    };
+    const Real strikes[] = { 60, 80, 90, 100, 110, 120, 150 };
+
+    const ext::shared_ptr<FdBlackScholesFwdDensityEngine> bsFwdEngine(
+        ext::make_shared<FdBlackScholesFwdDensityEngine>(bsProcess, 200));
+    const ext::shared_ptr<FdHestonFwdDensityEngine> hestonFwdEngine(
+        ext::make_shared<FdHestonFwdDensityEngine>(hestonModel));
+
+    bsFwdEngine->registerExpiries(expiries);
+    hestonFwdEngine->registerExpiries(expiries);
+
+    // an unregistered expiry is added to the surface
+    expiries.push_back(todaysDate + Period(6, Months));
+
+    const ext::shared_ptr<PricingEngine> bsEngine(
+        ext::make_shared<AnalyticEuropeanEngine>(bsProcess));
+    const ext::shared_ptr<PricingEngine> hestonEngine(
+        ext::make_shared<AnalyticHestonEngine>(hestonModel));
+
+    const ext::shared_ptr<PricingEngine> fwdEngines[] = {
+        bsFwdEngine, hestonFwdEngine };
+    const ext::shared_ptr<PricingEngine> engines[] = {
+        bsEngine, hestonEngine };
+    const std::string names[] = { "Black-Scholes", "Heston" };
+    const Real tol[] = { 0.02, 0.05 };
+
+    for (Size i=0; i < LENGTH(engines); ++i) {
+        for (const auto& expiry : expiries) {
+            for (Real strike : strikes) {
+                VanillaOption option(
+                    ext::make_shared<PlainVanillaPayoff>(
+                        (strike > spot->value()) ? Option::Call : Option::Put,
+                        strike),
+                    ext::make_shared<EuropeanExercise>(expiry));
+
+                option.setPricingEngine(fwdEngines[i]);
+                const Real calculated = option.NPV();
+
+                option.setPricingEngine(engines[i]);
+                const Real expected = option.NPV();
+
+                const Real diff = std::fabs(calculated - expected);
+                if (diff > tol[i]) {
+                    BOOST_ERROR("failed to reproduce European option price "
+                                "with " << names[i] << " forward density engine"
+                                << "\n   expiry:     " << expiry
+                                << "\n   strike:     " << strike
+                                << std::fixed << std::setprecision(8)
+                                << "\n   calculated: " << calculated
+                                << "\n   expected:   " << expected
+                                << "\n   tolerance:  " << tol[i]);
+                }
+            }
+        }
+    }
+}
+
 test_suite* HestonSLVModelTest::experimental(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Heston Stochastic Local Volatility tests");
 
@@ -2589,6 +2675,7 @@ test_suite* HestonSLVModelTest::experimental(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&HestonSLVModelTest::testBarrierPricingViaHestonLocalVol));
     suite->add(QUANTLIB_TEST_CASE(&HestonSLVModelTest::testLocalVolsvSLVPropDensity));
     suite->add(QUANTLIB_TEST_CASE(&HestonSLVModelTest::testDiffusionAndDriftSlvProcess));
+    suite->add(QUANTLIB_TEST_CASE(&HestonSLVModelTest::testForwardDensityEngines));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&HestonSLVModelTest::testHestonFokkerPlanckFwdEquationLogLVLeverage));
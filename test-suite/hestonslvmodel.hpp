@@ -47,6 +47,7 @@ public:
     static void testMoustacheGraph();
     static void testForwardSkewSLV();
     static void testDiffusionAndDriftSlvProcess();
+    static void testForwardDensityEngines();
 
     static boost::unit_test_framework::test_suite* experimental(SpeedLevel);
 
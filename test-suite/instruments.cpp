@@ -22,9 +22,19 @@
 #include <ql/instruments/stock.hpp>
 #include <ql/instruments/compositeinstrument.hpp>
 #include <ql/instruments/europeanoption.hpp>
+#include <ql/instruments/bonds/fixedratebond.hpp>
+#include <ql/instruments/portfoliovaluator.hpp>
+#include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/schedule.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -113,11 +123,202 @@ void InstrumentTest::testCompositeWhenShiftingDates() {
         BOOST_FAIL("Composite didn't recalculate");
 }
 
+void InstrumentTest::testPortfolioValuation() {
+
+    BOOST_TEST_MESSAGE("Testing parallel valuation of a portfolio...");
+
+    SavedSettings backup;
+
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+    DayCounter dc = Actual360();
+
+    // market data shared by all instruments
+    Handle<YieldTermStructure> rTS(flatRate(0.03, dc));
+    Handle<YieldTermStructure> qTS(flatRate(0.01, dc));
+    Handle<BlackVolTermStructure> volTS(flatVol(0.2, dc));
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot), qTS, rTS, volTS));
+
+    Schedule schedule(today, today + 5*Years, Period(Annual), TARGET(),
+                      Unadjusted, Unadjusted, DateGeneration::Backward,
+                      false);
+
+    // options and bonds, each with its own engine except the first
+    // two bonds; the last option has no engine
+    const Size nOptions = 4, nBonds = 3;
+    auto portfolio = [&]() {
+        std::vector<ext::shared_ptr<Instrument> > instruments;
+        for (Size i=0; i<nOptions+1; ++i) {
+            ext::shared_ptr<StrikedTypePayoff> payoff(
+                new PlainVanillaPayoff(Option::Call, 80.0 + 10.0*i));
+            ext::shared_ptr<Exercise> exercise(
+                new EuropeanExercise(today + (i+1)*Months));
+            instruments.push_back(
+                ext::make_shared<EuropeanOption>(payoff, exercise));
+            if (i < nOptions)
+                instruments.back()->setPricingEngine(
+                    ext::make_shared<AnalyticEuropeanEngine>(process));
+        }
+        ext::shared_ptr<PricingEngine> bondEngine =
+            ext::make_shared<DiscountingBondEngine>(rTS);
+        for (Size i=0; i<nBonds; ++i) {
+            instruments.push_back(ext::make_shared<FixedRateBond>(
+                0, 100.0, schedule, std::vector<Rate>(1, 0.02 + 0.01*i),
+                dc));
+            instruments.back()->setPricingEngine(
+                i < 2 ? bondEngine
+                      : ext::make_shared<DiscountingBondEngine>(rTS));
+        }
+        return instruments;
+    };
+
+    std::vector<ext::shared_ptr<Instrument> > reference = portfolio();
+    std::vector<ext::shared_ptr<Instrument> > instruments = portfolio();
+
+    // only the bonds sharing an engine are evaluated together
+    std::vector<std::vector<Size> > groups =
+        PortfolioValuator::partition(instruments);
+    if (groups.size() != instruments.size()-1)
+        BOOST_FAIL("unexpected number of groups:"
+                   << "\n    calculated: " << groups.size()
+                   << "\n    expected:   " << instruments.size()-1);
+    for (const auto& group : groups) {
+        if (group.size() > 1 && (group.size() != 2
+                                 || group[0] != nOptions+1
+                                 || group[1] != nOptions+2))
+            BOOST_FAIL("unexpected group of " << group.size()
+                       << " instruments starting at " << group[0]);
+    }
+
+    std::vector<PortfolioValuator::Result> results =
+        PortfolioValuator(4).valuate(instruments);
+
+    for (Size i=0; i<instruments.size(); ++i) {
+        if (i == nOptions) {
+            if (results[i].successful())
+                BOOST_FAIL("missing error for instrument without engine");
+            continue;
+        }
+        if (!results[i].successful())
+            BOOST_FAIL("instrument " << i << " failed: "
+                       << results[i].error);
+        Real expected = reference[i]->NPV();
+        if (std::fabs(results[i].npv - expected) > 1.0e-10)
+            BOOST_FAIL("unexpected NPV for instrument " << i << ":"
+                       << "\n    calculated: " << results[i].npv
+                       << "\n    expected:   " << expected);
+    }
+}
+
+namespace {
+
+    // records the threads evaluating options; each evaluation waits
+    // until a given number of threads took part, or for a timeout,
+    // so that a serial evaluation is detected instead of hiding
+    // behind the calling thread
+    class ThreadRecorder {
+      public:
+        explicit ThreadRecorder(Size required) : required_(required) {}
+        bool record() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            threads_.insert(std::this_thread::get_id());
+            if (threads_.size() >= required_) {
+                condition_.notify_all();
+                return true;
+            }
+            return condition_.wait_for(
+                lock, std::chrono::seconds(2),
+                [this]() { return threads_.size() >= required_; });
+        }
+        Size threads() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return threads_.size();
+        }
+      private:
+        Size required_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::set<std::thread::id> threads_;
+    };
+
+    class ThreadRecordingEngine : public VanillaOption::engine {
+      public:
+        explicit ThreadRecordingEngine(ThreadRecorder& recorder)
+        : recorder_(recorder) {}
+        void calculate() const override {
+            QL_REQUIRE(recorder_.record(),
+                       "no other thread evaluated the portfolio");
+            const auto payoff =
+                ext::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                    arguments_.payoff);
+            results_.value = payoff->strike();
+        }
+      private:
+        ThreadRecorder& recorder_;
+    };
+
+}
+
+void InstrumentTest::testPortfolioValuationThreads() {
+
+    BOOST_TEST_MESSAGE("Testing worker threads of portfolio valuation...");
+
+    SavedSettings backup;
+
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    // options with separate engines form separate groups
+    const Size threads = 4, nOptions = 16;
+    ThreadRecorder recorder(2);
+    std::vector<ext::shared_ptr<Instrument> > instruments;
+    for (Size i=0; i<nOptions; ++i) {
+        ext::shared_ptr<StrikedTypePayoff> payoff(
+            new PlainVanillaPayoff(Option::Call, 80.0 + i));
+        ext::shared_ptr<Exercise> exercise(
+            new EuropeanExercise(today + 1*Years));
+        instruments.push_back(
+            ext::make_shared<EuropeanOption>(payoff, exercise));
+        instruments.back()->setPricingEngine(
+            ext::make_shared<ThreadRecordingEngine>(recorder));
+    }
+
+    if (PortfolioValuator::partition(instruments).size() != nOptions)
+        BOOST_FAIL("options with separate engines were grouped");
+
+    PortfolioValuator valuator(threads);
+    // the same workers are used by subsequent calls
+    for (Size k=0; k<2; ++k) {
+        for (auto& instrument : instruments)
+            instrument->update();
+        std::vector<PortfolioValuator::Result> results =
+            valuator.valuate(instruments);
+        for (Size i=0; i<nOptions; ++i) {
+            if (!results[i].successful())
+                BOOST_FAIL("instrument " << i << " failed: "
+                           << results[i].error);
+            if (results[i].npv != 80.0 + i)
+                BOOST_FAIL("unexpected NPV for instrument " << i << ":"
+                           << "\n    calculated: " << results[i].npv
+                           << "\n    expected:   " << 80.0 + i);
+        }
+    }
+
+    if (recorder.threads() < 2 || recorder.threads() > threads)
+        BOOST_FAIL("unexpected number of evaluating threads: "
+                   << recorder.threads());
+}
+
 test_suite* InstrumentTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Instrument tests");
     suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testObservable));
     suite->add(QUANTLIB_TEST_CASE(
                             &InstrumentTest::testCompositeWhenShiftingDates));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testPortfolioValuation));
+    suite->add(QUANTLIB_TEST_CASE(
+                            &InstrumentTest::testPortfolioValuationThreads));
     return suite;
 }
 
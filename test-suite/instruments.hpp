@@ -30,6 +30,8 @@ class InstrumentTest {
   public:
     static void testObservable();
     static void testCompositeWhenShiftingDates();
+    static void testPortfolioValuation();
+    static void testPortfolioValuationThreads();
     static boost::unit_test_framework::test_suite* suite();
 };
 
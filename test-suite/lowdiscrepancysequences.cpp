@@ -30,6 +30,10 @@
 #include <ql/math/randomnumbers/randomizedlds.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/sobolblockrsg.hpp>
+#include <ql/math/randomnumbers/sobolbrownianbridgersg.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/math/randomnumbers/latticerules.hpp>
 #include <ql/math/randomnumbers/latticersg.hpp>
@@ -1089,6 +1093,155 @@ void LowDiscrepancyTest::testSobolSkipping() {
 }
 
 
+void LowDiscrepancyTest::testSobolBlockGenerator() {
+
+    BOOST_TEST_MESSAGE("Testing Sobol block generator...");
+
+    unsigned long seed = 42;
+    Size dimensionality[] = { 1, 10, 100, 1000 };
+    boost::uint_least32_t skip[] = { 0, 1, 42, 512, 100000 };
+    SobolRsg::DirectionIntegers integers[] = { SobolRsg::Jaeckel,
+                                               SobolRsg::JoeKuoD7 };
+    const Size blockSize = 37;
+
+    for (auto& integer : integers) {
+        for (Size& j : dimensionality) {
+            for (boost::uint_least32_t& k : skip) {
+                SobolRsg rsg(j, seed, integer);
+                rsg.skipTo(k);
+                SobolBlockRsg blockRsg(j, seed, integer);
+                blockRsg.skipTo(k);
+
+                std::vector<Real> block(blockSize*j);
+                for (Size b = 0; b < 3; b++) {
+                    blockRsg.nextBlock(blockSize, &block[0]);
+                    for (Size m = 0; m < blockSize; m++) {
+                        const std::vector<Real>& expected =
+                            rsg.nextSequence().value;
+                        for (Size n = 0; n < j; n++) {
+                            if (block[m*j+n] != expected[n]) {
+                                BOOST_FAIL("Mismatch of block generator:"
+                                    << "\n  size:     " << j
+                                    << "\n  integers: " << integer
+                                    << "\n  skipped:  " << k
+                                    << "\n  point:    " << b*blockSize+m
+                                    << "\n  at index: " << n
+                                    << "\n  expected: " << expected[n]
+                                    << "\n  found:    " << block[m*j+n]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // the fused Gaussian transform must reproduce the generic one
+    const Size dimension = 50;
+    InverseCumulativeRsg<SobolRsg, InverseCumulativeNormal> gaussian(
+        SobolRsg(dimension, seed, SobolRsg::JoeKuoD7));
+    InverseCumulativeRsg<SobolBlockRsg, InverseCumulativeNormal> blockGaussian(
+        SobolBlockRsg(dimension, seed, SobolRsg::JoeKuoD7));
+
+    for (Size m = 0; m < 500; m++) {
+        const std::vector<Real>& expected = gaussian.nextSequence().value;
+        const std::vector<Real>& calculated =
+            blockGaussian.nextSequence().value;
+        for (Size n = 0; n < dimension; n++) {
+            if (std::fabs(calculated[n] - expected[n]) > 1e-14) {
+                BOOST_FAIL("Mismatch of Gaussian block generator:"
+                           << "\n  point:      " << m
+                           << "\n  at index:   " << n
+                           << "\n  expected:   " << expected[n]
+                           << "\n  calculated: " << calculated[n]);
+            }
+        }
+    }
+}
+
+void LowDiscrepancyTest::testLowDiscrepancyBlockTraits() {
+
+    BOOST_TEST_MESSAGE("Testing low-discrepancy block traits...");
+
+    const unsigned long seed = 42;
+    const Size dimension = 30;
+    const BigNatural offsets[] = { 0, 1, 4096 };
+
+    for (BigNatural offset : offsets) {
+        RandomStreamSelector selector(offset);
+
+        const LowDiscrepancy::rsg_type rsg =
+            LowDiscrepancy::make_sequence_generator(dimension, seed);
+        const LowDiscrepancyBlock::rsg_type blockRsg =
+            LowDiscrepancyBlock::make_sequence_generator(dimension, seed);
+
+        for (Size m = 0; m < 300; m++) {
+            const std::vector<Real>& expected = rsg.nextSequence().value;
+            const std::vector<Real>& calculated =
+                blockRsg.nextSequence().value;
+            for (Size n = 0; n < dimension; n++) {
+                if (std::fabs(calculated[n] - expected[n]) > 1e-14) {
+                    BOOST_FAIL("Mismatch of low-discrepancy block traits:"
+                               << "\n  stream offset: " << offset
+                               << "\n  point:         " << m
+                               << "\n  at index:      " << n
+                               << "\n  expected:      " << expected[n]
+                               << "\n  calculated:    " << calculated[n]);
+                }
+            }
+        }
+    }
+}
+
+void LowDiscrepancyTest::testSobolBrownianBridgeRsg() {
+
+    BOOST_TEST_MESSAGE("Testing Brownian-bridged Sobol sequence generator...");
+
+    const unsigned long seed = 42;
+    const Size factors = 3, steps = 12;
+    const boost::uint_least32_t skip[] = { 0, 1000 };
+    const SobolBrownianGenerator::Ordering orderings[] = {
+        SobolBrownianGenerator::Factors, SobolBrownianGenerator::Steps,
+        SobolBrownianGenerator::Diagonal };
+
+    std::vector<Real> variates(factors);
+    for (auto ordering : orderings) {
+        for (boost::uint_least32_t k : skip) {
+            SobolBrownianGenerator generator(factors, steps, ordering,
+                                             seed, SobolRsg::JoeKuoD7);
+            generator.skipTo(k);
+            SobolBrownianBridgeRsg rsg(factors, steps, ordering,
+                                       seed, SobolRsg::JoeKuoD7);
+            rsg.skipTo(k);
+
+            for (Size m = 0; m < 100; m++) {
+                generator.nextPath();
+                const std::vector<Real>& calculated =
+                    rsg.nextSequence().value;
+                for (Size i = 0; i < steps; i++) {
+                    generator.nextStep(variates);
+                    for (Size j = 0; j < factors; j++) {
+                        if (calculated[i*factors+j] != variates[j]) {
+                            BOOST_FAIL(
+                                "Mismatch of Brownian-bridged Sobol "
+                                "sequence generator:"
+                                << "\n  ordering:   " << ordering
+                                << "\n  skipped:    " << k
+                                << "\n  path:       " << m
+                                << "\n  step:       " << i
+                                << "\n  factor:     " << j
+                                << "\n  expected:   " << variates[j]
+                                << "\n  calculated: "
+                                << calculated[i*factors+j]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
 test_suite* LowDiscrepancyTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Low-discrepancy sequence tests");
 
@@ -1126,6 +1279,11 @@ test_suite* LowDiscrepancyTest::suite() {
            &LowDiscrepancyTest::testSobolLevitanLemieuxSobolDiscrepancy));
 
     suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testSobolSkipping));
+    suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testSobolBlockGenerator));
+    suite->add(QUANTLIB_TEST_CASE(
+           &LowDiscrepancyTest::testLowDiscrepancyBlockTraits));
+    suite->add(QUANTLIB_TEST_CASE(
+           &LowDiscrepancyTest::testSobolBrownianBridgeRsg));
 
     suite->add(QUANTLIB_TEST_CASE(
            &LowDiscrepancyTest::testRandomizedLowDiscrepancySequence));
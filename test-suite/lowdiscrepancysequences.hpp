@@ -48,6 +48,9 @@ class LowDiscrepancyTest {
     static void testRandomizedLowDiscrepancySequence();
 
     static void testSobolSkipping();
+    static void testSobolBlockGenerator();
+    static void testLowDiscrepancyBlockTraits();
+    static void testSobolBrownianBridgeRsg();
 
     static void testRandomizedLattices();
 
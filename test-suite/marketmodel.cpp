@@ -4709,6 +4709,172 @@ void MarketModelTest::testCovariance() {
     }
 }
 
+void MarketModelTest::testParallelSimulation() {
+
+    BOOST_TEST_MESSAGE("Testing block-parallel market-model simulations...");
+
+    using namespace market_model_test;
+
+    setup();
+
+    Real fixedRate = 0.04;
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+                               fixedRate, false);
+
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), fixedRate);
+    SwapRateTrigger naifStrategy(rateTimes, swapTriggers, exerciseTimes);
+    NothingExerciseValue nullRebate(rateTimes);
+
+    CallSpecifiedMultiProduct callableProduct(receiverSwap, naifStrategy,
+                                              ExerciseAdapter(nullRebate));
+
+    MultiProductComposite products;
+    products.add(receiverSwap);
+    products.add(callableProduct);
+    products.finalize();
+
+    const EvolutionDescription& evolution = products.evolution();
+    std::vector<Size> numeraires = makeMeasure(products, MoneyMarketPlus);
+    ext::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 4,
+                        ExponentialCorrelationFlatVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    // paths are simulated in two calls to check that the second one
+    // goes on with the sequence
+    Size firstPaths = 1000, secondPaths = 1047, pathsPerBlock = 300;
+
+    SobolBrownianGeneratorFactory sobolFactory(
+                                   SobolBrownianGenerator::Diagonal, seed_);
+    MTBrownianGeneratorFactory mtFactory(seed_);
+    const BrownianGeneratorFactory* factories[] = { &sobolFactory,
+                                                    &mtFactory };
+
+    for (Size f=0; f<LENGTH(factories); ++f) {
+        const BrownianGeneratorFactory& factory = *factories[f];
+        auto makeEvolver = [&]() {
+            return makeMarketModelEvolver(marketModel, numeraires,
+                                          factory, Pc);
+        };
+
+        AccountingEngine engine(makeEvolver(), products,
+                                initialNumeraireValue);
+        SequenceStatisticsInc serialStats(products.numberOfProducts());
+        engine.multiplePathValues(serialStats, firstPaths);
+        engine.multiplePathValues(serialStats, secondPaths);
+
+        ParallelAccountingEngine parallelEngine(makeEvolver, products,
+                                                initialNumeraireValue,
+                                                pathsPerBlock);
+        SequenceStatisticsInc parallelStats(products.numberOfProducts());
+        parallelEngine.multiplePathValues(parallelStats, firstPaths);
+        parallelEngine.multiplePathValues(parallelStats, secondPaths);
+
+        // merged block statistics see the same paths
+        ParallelAccountingEngine mergingEngine(makeEvolver, products,
+                                               initialNumeraireValue,
+                                               pathsPerBlock);
+        SequenceStatisticsMergeable mergedStats(products.numberOfProducts());
+        mergingEngine.multiplePathValues(mergedStats, firstPaths);
+        mergingEngine.multiplePathValues(mergedStats, secondPaths);
+
+        if (parallelStats.samples() != serialStats.samples())
+            BOOST_FAIL("wrong number of samples: " << parallelStats.samples()
+                       << " instead of " << serialStats.samples());
+
+        std::vector<Real> serialMeans = serialStats.mean(),
+                          serialErrors = serialStats.errorEstimate(),
+                          parallelMeans = parallelStats.mean(),
+                          parallelErrors = parallelStats.errorEstimate(),
+                          mergedMeans = mergedStats.mean(),
+                          mergedErrors = mergedStats.errorEstimate();
+        if (mergedStats.samples() != parallelStats.samples())
+            BOOST_FAIL("wrong number of merged samples: "
+                       << mergedStats.samples() << " instead of "
+                       << parallelStats.samples());
+        for (Size i=0; i<products.numberOfProducts(); ++i) {
+            if (std::fabs(mergedMeans[i] - parallelMeans[i]) > 1.0e-12
+                || std::fabs(mergedErrors[i] - parallelErrors[i])
+                    > 1.0e-10*parallelErrors[i])
+                BOOST_ERROR("failed to reproduce results by merging"
+                            << "\n    generator:  "
+                            << (f == 0 ? "Sobol" : "Mersenne twister")
+                            << "\n    product:    " << i
+                            << "\n    stored:     " << parallelMeans[i]
+                            << " +/- " << parallelErrors[i]
+                            << "\n    merged:     " << mergedMeans[i]
+                            << " +/- " << mergedErrors[i]);
+
+            // Sobol generators are skipped to the first path of each
+            // block, so the results are the same; Mersenne-twister
+            // generators are seeded differently for each block
+            Real tolerance = (f == 0 ? 1.0e-12 :
+                              5.0 * std::sqrt(serialErrors[i]*serialErrors[i]
+                                              + parallelErrors[i]*parallelErrors[i]));
+            if (std::fabs(parallelMeans[i] - serialMeans[i]) > tolerance)
+                BOOST_ERROR("failed to reproduce serial result"
+                            << "\n    generator:  "
+                            << (f == 0 ? "Sobol" : "Mersenne twister")
+                            << "\n    product:    " << i
+                            << "\n    serial:     " << serialMeans[i]
+                            << " +/- " << serialErrors[i]
+                            << "\n    parallel:   " << parallelMeans[i]
+                            << " +/- " << parallelErrors[i]
+                            << "\n    tolerance:  " << tolerance);
+        }
+    }
+
+    // upper bound
+    SobolBrownianGeneratorFactory uFactory(SobolBrownianGenerator::Diagonal,
+                                           seed_+142);
+    auto makeOuterEvolver = [&]() {
+        return makeMarketModelEvolver(marketModel, numeraires, uFactory, Pc);
+    };
+    std::valarray<bool> isExerciseTime =
+        isInSubset(evolution.evolutionTimes(), naifStrategy.exerciseTimes());
+    auto makeInnerEvolvers = [&]() {
+        std::vector<ext::shared_ptr<MarketModelEvolver> > innerEvolvers;
+        for (Size s=0; s<isExerciseTime.size(); ++s) {
+            if (isExerciseTime[s]) {
+                SobolBrownianGeneratorFactory iFactory(
+                               SobolBrownianGenerator::Diagonal, seed_+s);
+                innerEvolvers.push_back(
+                    makeMarketModelEvolver(marketModel, numeraires,
+                                           iFactory, Pc, s));
+            }
+        }
+        return innerEvolvers;
+    };
+
+    Size outerPaths = 31, innerPaths = 64;
+    UpperBoundEngine uEngine(makeOuterEvolver(), makeInnerEvolvers(),
+                             receiverSwap, nullRebate,
+                             receiverSwap, nullRebate,
+                             naifStrategy, initialNumeraireValue);
+    Statistics serialStats;
+    uEngine.multiplePathValues(serialStats, outerPaths, innerPaths);
+
+    ParallelUpperBoundEngine parallelUEngine(makeOuterEvolver,
+                                             makeInnerEvolvers,
+                                             receiverSwap, nullRebate,
+                                             receiverSwap, nullRebate,
+                                             naifStrategy,
+                                             initialNumeraireValue, 8);
+    Statistics parallelStats;
+    parallelUEngine.multiplePathValues(parallelStats,
+                                       outerPaths, innerPaths);
+
+    if (parallelStats.samples() != serialStats.samples()
+        || std::fabs(parallelStats.mean() - serialStats.mean()) > 1.0e-12)
+        BOOST_ERROR("failed to reproduce serial upper bound"
+                    << "\n    serial:     " << serialStats.mean()
+                    << " (" << serialStats.samples() << " samples)"
+                    << "\n    parallel:   " << parallelStats.mean()
+                    << " (" << parallelStats.samples() << " samples)");
+}
+
 // --- Call the desired tests
 test_suite* MarketModelTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Market-model tests");
@@ -4734,6 +4900,7 @@ test_suite* MarketModelTest::suite(SpeedLevel speed) {
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAbcdDegenerateCases));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCovariance));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelSimulation));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testGreeks));
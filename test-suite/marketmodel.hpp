@@ -55,6 +55,7 @@ class MarketModelTest {
     static void testIsInSubset();
     static void testAbcdDegenerateCases();
     static void testCovariance();
+    static void testParallelSimulation();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -313,10 +313,128 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testStreamingCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing Longstaff-Schwartz calibration "
+                       "on regenerated paths...");
+
+    SavedSettings backup;
+
+    const Date todaysDate(15, May, 1998);
+    const Date settlementDate(17, May, 1998);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Date maturity(17, May, 1999);
+    const DayCounter dayCounter = Actual365Fixed();
+
+    ext::shared_ptr<Exercise> americanExercise(
+        new AmericanExercise(settlementDate, maturity));
+
+    Handle<YieldTermStructure> flatTermStructure(
+        ext::shared_ptr<YieldTermStructure>(
+            new FlatForward(settlementDate, 0.06, dayCounter)));
+    Handle<YieldTermStructure> flatDividendTS(
+        ext::shared_ptr<YieldTermStructure>(
+            new FlatForward(settlementDate, 0.0, dayCounter)));
+    Handle<BlackVolTermStructure> flatVolTS(
+        ext::shared_ptr<BlackVolTermStructure>(
+            new BlackConstantVol(settlementDate, NullCalendar(),
+                                 0.2, dayCounter)));
+    Handle<Quote> underlyingH(
+        ext::shared_ptr<Quote>(new SimpleQuote(36.0)));
+
+    ext::shared_ptr<GeneralizedBlackScholesProcess> stochasticProcess(
+        new GeneralizedBlackScholesProcess(
+            underlyingH, flatDividendTS, flatTermStructure, flatVolTS));
+
+    ext::shared_ptr<StrikedTypePayoff> payoff(
+        new PlainVanillaPayoff(Option::Put, 40.0));
+    VanillaOption americanOption(payoff, americanExercise);
+
+    americanOption.setPricingEngine(
+        MakeMCAmericanEngine<PseudoRandom>(stochasticProcess)
+            .withSteps(50)
+            .withAntitheticVariate()
+            .withSamples(4096)
+            .withCalibrationSamples(2048)
+            .withSeed(42));
+    const Real stored = americanOption.NPV();
+    const Real storedProbability =
+        americanOption.result<Real>("exerciseProbability");
+
+    americanOption.setPricingEngine(
+        MakeMCAmericanEngine<PseudoRandom>(stochasticProcess)
+            .withSteps(50)
+            .withAntitheticVariate()
+            .withSamples(4096)
+            .withCalibrationSamples(2048)
+            .withSeed(42)
+            .withStreamingCalibration());
+    const Real streamed = americanOption.NPV();
+    const Real errorEstimate = americanOption.errorEstimate();
+    const Real streamedProbability =
+        americanOption.result<Real>("exerciseProbability");
+
+    americanOption.setPricingEngine(ext::shared_ptr<PricingEngine>(
+        new FdBlackScholesVanillaEngine(stochasticProcess, 401, 200)));
+    const Real expected = americanOption.NPV();
+
+    // same calibration and pricing paths, hence the same exercise
+    // strategy up to the round-off of the regression
+    if (std::fabs(streamed - stored) > 1e-3
+        || std::fabs(streamedProbability - storedProbability) > 1e-3) {
+        BOOST_ERROR("streaming calibration differs from stored paths"
+                    << "\n    stored:      " << stored
+                    << "\n    streamed:    " << streamed
+                    << "\n    stored exercise probability:   "
+                    << storedProbability
+                    << "\n    streamed exercise probability: "
+                    << streamedProbability);
+    }
+
+    if (std::fabs(streamed - expected) > 2.34*errorEstimate) {
+        BOOST_ERROR("Failed to reproduce american option price "
+                    "with streaming calibration"
+                    << "\n    expected:   " << expected
+                    << "\n    calculated: " << streamed
+                    << " +/- " << errorEstimate);
+    }
+
+    // without a seed, or with a null calibration seed, a seed is
+    // drawn once per calculation so that the calibration sees the
+    // same paths on each regeneration; the path pricer checks it
+    // and would throw otherwise.  The prices are random, so their
+    // check is only a loose one.
+    MakeMCAmericanEngine<PseudoRandom> unseeded =
+        MakeMCAmericanEngine<PseudoRandom>(stochasticProcess)
+            .withSteps(50)
+            .withAntitheticVariate()
+            .withSamples(4096)
+            .withCalibrationSamples(2048)
+            .withStreamingCalibration();
+    const ext::shared_ptr<PricingEngine> defaultSeeds = unseeded;
+    const ext::shared_ptr<PricingEngine> nullCalibrationSeed =
+        unseeded.withSeedCalibration(0);
+    for (const auto& engine : { defaultSeeds, nullCalibrationSeed }) {
+        americanOption.setPricingEngine(engine);
+        Real npv = 0.0, error = 0.0;
+        BOOST_CHECK_NO_THROW(npv = americanOption.NPV());
+        BOOST_CHECK_NO_THROW(error = americanOption.errorEstimate());
+        if (std::fabs(npv - expected) > 5.0*error) {
+            BOOST_ERROR("Failed to reproduce american option price "
+                        "with unseeded streaming calibration"
+                        << "\n    expected:   " << expected
+                        << "\n    calculated: " << npv
+                        << " +/- " << error);
+        }
+    }
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
 
     suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testStreamingCalibration));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&MCLongstaffSchwartzEngineTest::testAmericanOption));
@@ -20,6 +20,8 @@
 #include "observable.hpp"
 #include "utilities.hpp"
 #include <ql/indexes/ibor/euribor.hpp>
+#include <ql/patterns/dependencyprofiler.hpp>
+#include <ql/patterns/lazyobject.hpp>
 #include <ql/patterns/observable.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/volatility/capfloor/capfloortermvolsurface.hpp>
@@ -27,6 +29,7 @@
 #include <ql/termstructures/volatility/optionlet/strippedoptionlet.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
+#include <sstream>
 
 
 using namespace QuantLib;
@@ -106,6 +109,354 @@ void ObservableTest::testObservableSettings() {
 }
 
 
+void ObservableTest::testObserverRegistration() {
+
+    BOOST_TEST_MESSAGE("Testing registration of many observers...");
+
+    const Size nObservers = 250, nQuotes = 10;
+
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+    for (Size j=0; j<nQuotes; ++j)
+        quotes.push_back(ext::make_shared<SimpleQuote>(0.0));
+    std::vector<UpdateCounter> observers(nObservers);
+
+    for (Size k=0; k<5; ++k) {
+        for (auto& observer : observers)
+            for (const auto& quote : quotes)
+                observer.registerWith(quote);
+
+        quotes[k]->setValue(Real(k+1));
+
+        for (Size i=0; i<nObservers; ++i) {
+            if (observers[i].unregisterWith(quotes[i%nQuotes]) != 1)
+                BOOST_FAIL("observer " << i << " was not registered");
+        }
+        for (auto& observer : observers)
+            observer.unregisterWithAll();
+
+        for (const auto& quote : quotes)
+            quote->setValue(quote->value() + 1.0);
+    }
+
+    for (Size i=0; i<nObservers; ++i) {
+        if (observers[i].counter() != 5)
+            BOOST_FAIL("observer " << i << " received "
+                       << observers[i].counter()
+                       << " notifications instead of 5");
+    }
+}
+
+void ObservableTest::testObserverNotification() {
+
+    BOOST_TEST_MESSAGE("Testing notification of many observers...");
+
+    const Size nObservers = 100, nNotifications = 10000;
+
+    const ext::shared_ptr<SimpleQuote> quote(new SimpleQuote(0.0));
+    std::vector<UpdateCounter> observers(nObservers);
+    for (auto& observer : observers)
+        observer.registerWith(quote);
+
+    for (Size k=0; k<nNotifications; ++k)
+        quote->setValue(Real(k+1));
+
+    for (Size i=0; i<nObservers; ++i) {
+        if (observers[i].counter() != nNotifications)
+            BOOST_FAIL("observer " << i << " received "
+                       << observers[i].counter()
+                       << " notifications instead of " << nNotifications);
+    }
+}
+
+void ObservableTest::testObserverTeardown() {
+
+    BOOST_TEST_MESSAGE("Testing destruction of many registered observers...");
+
+    const Size nObservers = 100, nCycles = 100;
+
+    const ext::shared_ptr<SimpleQuote> quote(new SimpleQuote(0.0));
+    UpdateCounter survivor;
+    survivor.registerWith(quote);
+
+    for (Size k=0; k<nCycles; ++k) {
+        std::vector<ext::shared_ptr<UpdateCounter> > observers;
+        for (Size i=0; i<nObservers; ++i) {
+            observers.push_back(ext::make_shared<UpdateCounter>());
+            observers.back()->registerWith(quote);
+        }
+        quote->setValue(Real(k+1));
+        if (observers.front()->counter() != 1)
+            BOOST_FAIL("observer was not notified");
+    }
+
+    if (survivor.counter() != nCycles)
+        BOOST_FAIL("observer received " << survivor.counter()
+                   << " notifications instead of " << nCycles);
+}
+
+
+namespace {
+
+    class QuoteSum : public LazyObject {
+      public:
+        explicit QuoteSum(std::vector<ext::shared_ptr<SimpleQuote> > quotes)
+        : quotes_(std::move(quotes)) {
+            for (const auto& quote : quotes_)
+                registerWith(quote);
+        }
+        void update() override {
+            ++updates_;
+            LazyObject::update();
+        }
+        Real value() const {
+            calculate();
+            return sum_;
+        }
+        Size updates() const { return updates_; }
+      private:
+        void performCalculations() const override {
+            sum_ = 0.0;
+            for (const auto& quote : quotes_)
+                sum_ += quote->value();
+        }
+        std::vector<ext::shared_ptr<SimpleQuote> > quotes_;
+        mutable Real sum_ = 0.0;
+        Size updates_ = 0;
+    };
+
+    // non-lazy observer, reading the sum as soon as it's notified
+    class SumReader : public Observer {
+      public:
+        SumReader(ext::shared_ptr<QuoteSum> sum,
+                  const ext::shared_ptr<SimpleQuote>& quote)
+        : sum_(std::move(sum)) {
+            registerWith(quote);
+            registerWith(sum_);
+            value_ = sum_->value();
+        }
+        void update() override {
+            ++updates_;
+            value_ = sum_->value();
+        }
+        Real value() const { return value_; }
+        Size updates() const { return updates_; }
+      private:
+        ext::shared_ptr<QuoteSum> sum_;
+        Real value_;
+        Size updates_ = 0;
+    };
+
+}
+
+void ObservableTest::testDependencyProfiler() {
+
+    BOOST_TEST_MESSAGE("Testing dependency profiler...");
+
+    DependencyProfiler& profiler = DependencyProfiler::instance();
+
+#if !defined(QL_ENABLE_DEPENDENCY_PROFILING)
+    BOOST_CHECK_THROW(profiler.enable(), Error);
+    BOOST_CHECK(!profiler.enabled());
+#else
+    profiler.enable();
+
+    const Size nQuotes = 3;
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+    for (Size i=0; i<nQuotes; ++i)
+        quotes.push_back(ext::make_shared<SimpleQuote>(1.0));
+    const ext::shared_ptr<QuoteSum> sum(new QuoteSum(quotes));
+    {
+        const ext::shared_ptr<SumReader> reader =
+            ext::make_shared<SumReader>(sum, quotes.front());
+
+        if (profiler.dependencies() != nQuotes+2)
+            BOOST_ERROR("unexpected number of dependencies:"
+                        << "\n    recorded: " << profiler.dependencies()
+                        << "\n    expected: " << nQuotes+2);
+
+        profiler.reset();
+        quotes.front()->setValue(2.0);
+
+        Size sumUpdates = 0, sumCalculations = 0, readerUpdates = 0;
+        for (const auto& s : profiler.statistics()) {
+            if (s.type.find("QuoteSum") != std::string::npos) {
+                sumUpdates = s.updates;
+                sumCalculations = s.calculations;
+            } else if (s.type.find("SumReader") != std::string::npos) {
+                readerUpdates = s.updates;
+            }
+        }
+        // the reader is notified by the quote and by the sum, and
+        // recalculates the sum once
+        if (sumUpdates != 1 || sumCalculations != 1 || readerUpdates != 2)
+            BOOST_ERROR("unexpected statistics:"
+                        << "\n    sum updates:      " << sumUpdates
+                        << " (expected 1)"
+                        << "\n    sum calculations: " << sumCalculations
+                        << " (expected 1)"
+                        << "\n    reader updates:   " << readerUpdates
+                        << " (expected 2)");
+
+        std::ostringstream dot, json, table;
+        profiler.writeGraph(dot, DependencyProfiler::Dot);
+        profiler.writeGraph(json, DependencyProfiler::Json);
+        profiler.writeHotSpots(table);
+        if (dot.str().find("digraph") == std::string::npos
+            || dot.str().find("SumReader") == std::string::npos)
+            BOOST_ERROR("unexpected DOT graph:\n" << dot.str());
+        if (json.str().find("\"edges\"") == std::string::npos
+            || json.str().find("QuoteSum") == std::string::npos)
+            BOOST_ERROR("unexpected JSON graph:\n" << json.str());
+        if (table.str().find("QuoteSum") == std::string::npos)
+            BOOST_ERROR("unexpected hot-spot table:\n" << table.str());
+    }
+
+    // destroyed observers are removed from the graph
+    if (profiler.dependencies() != nQuotes)
+        BOOST_ERROR("unexpected number of dependencies after destruction:"
+                    << "\n    recorded: " << profiler.dependencies()
+                    << "\n    expected: " << nQuotes);
+
+    profiler.disable();
+    profiler.reset();
+#endif
+}
+
+#if !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) && \
+    !defined(QL_ENABLE_RCU_OBSERVER_PATTERN)
+
+void ObservableTest::testNotificationTransaction() {
+
+    BOOST_TEST_MESSAGE("Testing notification transactions...");
+
+    ObservableSettings& settings = ObservableSettings::instance();
+
+    const Size nQuotes = 10;
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+    for (Size i=0; i<nQuotes; ++i)
+        quotes.push_back(ext::make_shared<SimpleQuote>(1.0));
+    const ext::shared_ptr<QuoteSum> sum(new QuoteSum(quotes));
+    // the reader depends on the first quote both directly and
+    // through the sum
+    SumReader reader(sum, quotes.front());
+
+    settings.resetNotificationCounters();
+    {
+        NotificationTransaction transaction;
+        for (Size k=0; k<2; ++k)
+            for (Size i=0; i<nQuotes; ++i)
+                quotes[i]->setValue(Real(k+2));
+
+        if (sum->updates() != 0 || reader.updates() != 0)
+            BOOST_FAIL("observers notified during transaction");
+
+        transaction.commit();
+    }
+
+    if (sum->updates() != 1)
+        BOOST_FAIL("sum updated " << sum->updates()
+                   << " times instead of once");
+    if (reader.updates() != 1)
+        BOOST_FAIL("reader updated " << reader.updates()
+                   << " times instead of once");
+    if (reader.value() != nQuotes*3.0)
+        BOOST_FAIL("reader updated before the sum:\n"
+                   << "    value:    " << reader.value() << "\n"
+                   << "    expected: " << nQuotes*3.0);
+
+    // 2 x (nQuotes+1) from the quotes, plus one from the sum
+    const Size requested = 2*(nQuotes+1) + 1;
+    if (settings.requestedNotifications() != requested
+        || settings.sentNotifications() != 2
+        || settings.savedNotifications() != requested-2)
+        BOOST_FAIL("unexpected notification counters:"
+                   << "\n    requested: "
+                   << settings.requestedNotifications()
+                   << " (expected " << requested << ")"
+                   << "\n    sent:      "
+                   << settings.sentNotifications() << " (expected 2)");
+
+    // without transactions, notifications are sent immediately
+    quotes.back()->setValue(0.0);
+    if (sum->updates() != 2 || reader.updates() != 2)
+        BOOST_FAIL("notification not sent outside transaction");
+    if (settings.sentNotifications() != 2)
+        BOOST_FAIL("counters updated outside transaction");
+}
+
+#endif
+
+
+#ifdef QL_ENABLE_RCU_OBSERVER_PATTERN
+
+#include <atomic>
+#include <thread>
+
+namespace {
+
+    class AtomicUpdateCounter : public Observer {
+      public:
+        AtomicUpdateCounter() { ++instanceCounter_; }
+        ~AtomicUpdateCounter() override { --instanceCounter_; }
+        void update() override { ++counter_; }
+        int counter() const { return counter_; }
+        static int instanceCounter() { return instanceCounter_; }
+
+      private:
+        std::atomic<int> counter_{0};
+        static std::atomic<int> instanceCounter_;
+    };
+
+    std::atomic<int> AtomicUpdateCounter::instanceCounter_{0};
+
+}
+
+void ObservableTest::testConcurrentNotification() {
+
+    BOOST_TEST_MESSAGE("Testing concurrent notification, registration "
+                       "and destruction of observers...");
+
+    const ext::shared_ptr<SimpleQuote> quote(new SimpleQuote(0.0));
+    const ext::shared_ptr<AtomicUpdateCounter> observer(
+                                                new AtomicUpdateCounter);
+    observer->registerWith(quote);
+
+    const int nThreads = 4, nNotifications = 20000;
+
+    // registers and destroys observers while the quote notifies
+    std::thread worker([&]() {
+        for (Size k=0; k<1000; ++k) {
+            std::vector<ext::shared_ptr<AtomicUpdateCounter> > observers;
+            for (Size i=0; i<20; ++i) {
+                observers.push_back(ext::make_shared<AtomicUpdateCounter>());
+                observers.back()->registerWith(quote);
+            }
+        }
+    });
+
+    std::vector<std::thread> notifiers;
+    for (int i=0; i<nThreads; ++i) {
+        notifiers.emplace_back([&]() {
+            for (int k=0; k<nNotifications; ++k)
+                quote->notifyObservers();
+        });
+    }
+    for (auto& notifier : notifiers)
+        notifier.join();
+    worker.join();
+
+    if (observer->counter() != nThreads*nNotifications)
+        BOOST_FAIL("observer received " << observer->counter()
+                   << " notifications instead of "
+                   << nThreads*nNotifications);
+    if (AtomicUpdateCounter::instanceCounter() != 1)
+        BOOST_FAIL(AtomicUpdateCounter::instanceCounter()-1
+                   << " temporary observers were not destroyed");
+}
+
+#endif
+
+
 #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
 #include <boost/atomic.hpp>
@@ -323,6 +674,19 @@ test_suite* ObservableTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Observer tests");
 
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testObservableSettings));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testObserverRegistration));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testObserverNotification));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testObserverTeardown));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testDependencyProfiler));
+
+#if !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) && \
+    !defined(QL_ENABLE_RCU_OBSERVER_PATTERN)
+    suite->add(QUANTLIB_TEST_CASE(
+        &ObservableTest::testNotificationTransaction));
+#endif
+#ifdef QL_ENABLE_RCU_OBSERVER_PATTERN
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testConcurrentNotification));
+#endif
 
 #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testAsyncGarbagCollector));
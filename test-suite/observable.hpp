@@ -28,6 +28,12 @@
 class ObservableTest {
   public:
     static void testObservableSettings();
+    static void testObserverRegistration();
+    static void testObserverNotification();
+    static void testObserverTeardown();
+    static void testDependencyProfiler();
+    static void testNotificationTransaction();
+    static void testConcurrentNotification();
     static void testAsyncGarbagCollector();
     static void testMultiThreadingGlobalSettings();
     static void testDeepUpdate();
@@ -20,6 +20,7 @@
 #include "piecewiseyieldcurve.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/iborcoupon.hpp>
+#include <ql/experimental/termstructures/multicurvesensitivities.hpp>
 #include <ql/indexes/bmaindex.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/indexes/ibor/jpylibor.hpp>
@@ -1499,6 +1500,168 @@ void PiecewiseYieldCurveTest::testIterativeBootstrapRetries() {
     BOOST_CHECK_SMALL(calcFwd - expFwd, 1e-10);
 }
 
+void PiecewiseYieldCurveTest::testBootstrapSensitivities() {
+    BOOST_TEST_MESSAGE("Testing bootstrap sensitivities by implicit differentiation...");
+
+    SavedSettings backup;
+
+    Calendar calendar = TARGET();
+    Date today = calendar.adjust(Date(15, March, 2021));
+    Settings::instance().evaluationDate() = today;
+
+    typedef PiecewiseYieldCurve<ZeroYield, Linear> ZeroCurve;
+
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+
+    // discount curve on 3M deposit and swaps
+    ext::shared_ptr<IborIndex> euribor3m(new Euribor3M);
+    std::vector<ext::shared_ptr<RateHelper> > discountHelpers;
+    quotes.push_back(ext::make_shared<SimpleQuote>(0.0050));
+    discountHelpers.push_back(ext::make_shared<DepositRateHelper>(
+        Handle<Quote>(quotes.back()), 3 * Months, 2, calendar,
+        ModifiedFollowing, true, Actual360()));
+    Integer discountTenors[] = { 1, 2, 3, 5, 7, 10 };
+    Rate discountRates[] = { 0.0060, 0.0080, 0.0100, 0.0130, 0.0150, 0.0170 };
+    for (Size i=0; i<LENGTH(discountTenors); ++i) {
+        quotes.push_back(ext::make_shared<SimpleQuote>(discountRates[i]));
+        discountHelpers.push_back(ext::make_shared<SwapRateHelper>(
+            Handle<Quote>(quotes.back()), discountTenors[i] * Years,
+            calendar, Annual, Unadjusted, Thirty360(Thirty360::BondBasis),
+            euribor3m));
+    }
+    ext::shared_ptr<ZeroCurve> discountCurve =
+        ext::make_shared<ZeroCurve>(today, discountHelpers, Actual365Fixed());
+    Handle<YieldTermStructure> discountHandle(discountCurve);
+
+    // forwarding curve on 6M deposit and swaps discounted on the other curve
+    ext::shared_ptr<IborIndex> euribor6m(new Euribor6M);
+    std::vector<ext::shared_ptr<RateHelper> > forwardHelpers;
+    quotes.push_back(ext::make_shared<SimpleQuote>(0.0070));
+    forwardHelpers.push_back(ext::make_shared<DepositRateHelper>(
+        Handle<Quote>(quotes.back()), 6 * Months, 2, calendar,
+        ModifiedFollowing, true, Actual360()));
+    Integer forwardTenors[] = { 2, 3, 5, 7, 10 };
+    Rate forwardRates[] = { 0.0090, 0.0110, 0.0140, 0.0160, 0.0180 };
+    for (Size i=0; i<LENGTH(forwardTenors); ++i) {
+        quotes.push_back(ext::make_shared<SimpleQuote>(forwardRates[i]));
+        forwardHelpers.push_back(ext::make_shared<SwapRateHelper>(
+            Handle<Quote>(quotes.back()), forwardTenors[i] * Years,
+            calendar, Annual, Unadjusted, Thirty360(Thirty360::BondBasis),
+            euribor6m, Handle<Quote>(), 0 * Days, discountHandle));
+    }
+    ext::shared_ptr<ZeroCurve> forwardCurve =
+        ext::make_shared<ZeroCurve>(today, forwardHelpers, Actual365Fixed());
+
+    std::vector<ext::shared_ptr<ZeroCurve> > curves = { discountCurve,
+                                                        forwardCurve };
+    Size n = quotes.size();
+
+    // reference results: shift each quote and bootstrap again
+    Real bump = 1.0e-5;
+    Matrix expected(n, n);
+    for (Size j=0; j<n; ++j) {
+        Rate quote = quotes[j]->value();
+        std::vector<Real> up, down;
+        quotes[j]->setValue(quote + bump);
+        for (const auto& curve : curves)
+            up.insert(up.end(), curve->data().begin() + 1, curve->data().end());
+        quotes[j]->setValue(quote - bump);
+        for (const auto& curve : curves)
+            down.insert(down.end(), curve->data().begin() + 1, curve->data().end());
+        quotes[j]->setValue(quote);
+        for (Size i=0; i<n; ++i)
+            expected[i][j] = (up[i] - down[i]) / (2.0 * bump);
+    }
+
+    BootstrapSensitivities sensitivities;
+    sensitivities.addCurve(discountCurve);
+    sensitivities.addCurve(forwardCurve);
+
+    const Matrix& jacobian = sensitivities.jacobian();
+    Real tolerance = 1.0e-6;
+    for (Size i=0; i<n; ++i) {
+        for (Size j=0; j<n; ++j) {
+            if (std::fabs(jacobian[i][j] - expected[i][j]) > tolerance)
+                BOOST_ERROR("failed to reproduce bootstrap sensitivity"
+                            << "\n    pillar:     " << i
+                            << "\n    quote:      " << j
+                            << std::setprecision(10)
+                            << "\n    calculated: " << jacobian[i][j]
+                            << "\n    expected:   " << expected[i][j]);
+        }
+    }
+
+    // the same results are used by MultiCurveSensitivities...
+    std::map<std::string, Handle<YieldTermStructure> > curveMap;
+    curveMap["1_discount"] = discountHandle;
+    curveMap["2_forward"] = Handle<YieldTermStructure>(forwardCurve);
+    Matrix multiCurve = MultiCurveSensitivities(curveMap).sensitivities();
+    Matrix rebootstrapped =
+        MultiCurveSensitivities(curveMap, true).sensitivities();
+    for (Size i=0; i<n; ++i) {
+        for (Size j=0; j<n; ++j) {
+            if (std::fabs(multiCurve[j][i] - jacobian[i][j]) > 1.0e-12)
+                BOOST_ERROR("failed to reproduce bootstrap sensitivity"
+                            " with MultiCurveSensitivities"
+                            << "\n    pillar:     " << i
+                            << "\n    quote:      " << j
+                            << std::setprecision(10)
+                            << "\n    calculated: " << multiCurve[j][i]
+                            << "\n    expected:   " << jacobian[i][j]);
+            // ...and are close to its 1bp shifts
+            if (std::fabs(rebootstrapped[j][i] - jacobian[i][j]) > 1.0e-3)
+                BOOST_ERROR("failed to reproduce 1bp bootstrap sensitivity"
+                            << "\n    pillar:     " << i
+                            << "\n    quote:      " << j
+                            << std::setprecision(10)
+                            << "\n    calculated: " << rebootstrapped[j][i]
+                            << "\n    expected:   " << jacobian[i][j]);
+        }
+    }
+
+    // shifted curves are close to the bootstrapped ones
+    Array shifts(n);
+    for (Size j=0; j<n; ++j)
+        shifts[j] = 1.0e-4 * (1.0 + Real(j % 3));
+    Array shifted = sensitivities.shiftedPillarValues(shifts);
+    Matrix scenarios(2, n, 0.0);
+    std::copy(shifts.begin(), shifts.end(), scenarios.row_begin(1));
+    Matrix scenarioValues = sensitivities.shiftedPillarValues(scenarios);
+    std::vector<ext::shared_ptr<YieldTermStructure> > shiftedCurves =
+        sensitivities.shiftedCurves(shifts);
+    std::vector<Date> pillars = sensitivities.pillarDates();
+    Array values = sensitivities.pillarValues();
+
+    for (Size j=0; j<n; ++j)
+        quotes[j]->setValue(quotes[j]->value() + shifts[j]);
+    std::vector<Real> bootstrapped;
+    for (const auto& curve : curves)
+        bootstrapped.insert(bootstrapped.end(),
+                            curve->data().begin() + 1, curve->data().end());
+
+    for (Size i=0, k=0; i<curves.size(); ++i) {
+        for (Size l=1; l<curves[i]->data().size(); ++l, ++k) {
+            Rate zero = shiftedCurves[i]->zeroRate(pillars[k], Actual365Fixed(),
+                                                   Continuous).rate();
+            if (std::fabs(zero - shifted[k]) > 1.0e-12
+                || std::fabs(scenarioValues[0][k] - values[k]) > 1.0e-12
+                || std::fabs(scenarioValues[1][k] - shifted[k]) > 1.0e-12)
+                BOOST_ERROR("inconsistent shifted pillar value"
+                            << "\n    pillar:         " << k
+                            << std::setprecision(12)
+                            << "\n    shifted value:  " << shifted[k]
+                            << "\n    scenario value: " << scenarioValues[1][k]
+                            << "\n    curve value:    " << zero);
+            if (std::fabs(shifted[k] - bootstrapped[k]) > 1.0e-7)
+                BOOST_ERROR("failed to reproduce shifted curve"
+                            << "\n    pillar:     " << k
+                            << std::setprecision(12)
+                            << "\n    calculated: " << shifted[k]
+                            << "\n    expected:   " << bootstrapped[k]);
+        }
+    }
+}
+
 test_suite* PiecewiseYieldCurveTest::suite() {
 
     auto* suite = BOOST_TEST_SUITE("Piecewise yield curve tests");
@@ -1560,3 +1723,9 @@ test_suite* PiecewiseYieldCurveTest::suite() {
 
     return suite;
 }
+
+test_suite* PiecewiseYieldCurveTest::experimental() {
+    auto* suite = BOOST_TEST_SUITE("Piecewise yield curve experimental tests");
+    suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testBootstrapSensitivities));
+    return suite;
+}
@@ -62,7 +62,10 @@ class PiecewiseYieldCurveTest {
 
     static void testIterativeBootstrapRetries();
 
+    static void testBootstrapSensitivities();
+
     static boost::unit_test_framework::test_suite* suite();
+    static boost::unit_test_framework::test_suite* experimental();
 };
 
 
@@ -138,17 +138,20 @@
 #include "barrieroption.hpp"
 #include "basketoption.hpp"
 #include "batesmodel.hpp"
+#include "blackformula.hpp"
 #include "convertiblebonds.hpp"
 #include "digitaloption.hpp"
 #include "dividendoption.hpp"
 #include "europeanoption.hpp"
 #include "fdheston.hpp"
+#include "fdmlinearop.hpp"
 #include "hestonmodel.hpp"
 #include "interpolations.hpp"
 #include "jumpdiffusion.hpp"
 #include "marketmodel_smm.hpp"
 #include "marketmodel_cms.hpp"
 #include "lowdiscrepancysequences.hpp"
+#include "observable.hpp"
 #include "quantooption.hpp"
 #include "riskstats.hpp"
 #include "shortratemodels.hpp"
@@ -227,6 +230,7 @@ namespace {
         const std::string name_;
         const double mflop_; // total number of mega floating
                              // point operations (not per sec!)
+                             // or zero for timing-only cases
     };
 
     std::list<Benchmark> bm;
@@ -242,29 +246,40 @@ namespace {
         std::cout << std::endl
                   << std::string(56,'-') << std::endl;
         std::cout << header << std::endl;
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        std::cout << "(thread-safe observer pattern)" << std::endl;
+        #elif defined(QL_ENABLE_RCU_OBSERVER_PATTERN)
+        std::cout << "(lock-free observer pattern)" << std::endl;
+        #endif
         std::cout << std::string(56,'-')
                   << std::endl << std::endl;
 
         double sum=0;
+        int n=0;
         std::list<double>::const_iterator iterT = runTimes.begin();
         std::list<Benchmark>::const_iterator iterBM = bm.begin();
 
         while (iterT != runTimes.end()) {
-            const double mflopsPerSec = iterBM->getMflop()/(*iterT);
             std::cout << iterBM->getName()
                       << std::string(42-iterBM->getName().length(),' ') << ":"
-                      << std::fixed << std::setw(6) << std::setprecision(1)
-                      << mflopsPerSec
-                      << " mflops" << std::endl;
-
-            sum+=mflopsPerSec;
+                      << std::fixed << std::setw(6) << std::setprecision(1);
+            if (iterBM->getMflop() > 0.0) {
+                const double mflopsPerSec = iterBM->getMflop()/(*iterT);
+                std::cout << mflopsPerSec << " mflops" << std::endl;
+
+                sum+=mflopsPerSec;
+                ++n;
+            } else {
+                // timing-only cases are not part of the index
+                std::cout << (*iterT)*1000.0 << " ms" << std::endl;
+            }
             ++iterT;
             ++iterBM;
         }
         std::cout << std::string(56,'-') << std::endl
                   << "QuantLib Benchmark Index                  :"
                   << std::fixed << std::setw(6) << std::setprecision(1)
-                  << sum/runTimes.size()
+                  << sum/n
                   << " mflops" << std::endl;
     }
 }
@@ -285,6 +300,10 @@ test_suite* init_unit_test_suite(int, char*[]) {
     bm.emplace_back("BasketOption::TavellaValues", &BasketOptionTest::testTavellaValues, 933.80);
     bm.emplace_back("BasketOption::OddSamples", &BasketOptionTest::testOddSamples, 642.46);
     bm.emplace_back("BatesModel::DAXCalibration", &BatesModelTest::testDAXCalibration, 1993.35);
+    bm.emplace_back("BlackFormula::ScalarImpliedStdDev",
+                    &BlackFormulaTest::testScalarImpliedStdDev, 0.0);
+    bm.emplace_back("BlackFormula::BatchImpliedStdDev",
+                    &BlackFormulaTest::testBatchImpliedStdDev, 0.0);
     bm.emplace_back("ConvertibleBondTest::testBond", &ConvertibleBondTest::testBond, 159.85);
     bm.emplace_back("DigitalOption::MCCashAtHit", &DigitalOptionTest::testMCCashAtHit, 995.87);
     bm.emplace_back("DividendOption::FdEuropeanGreeks", &DividendOptionTest::testFdEuropeanGreeks,
@@ -296,6 +315,16 @@ test_suite* init_unit_test_suite(int, char*[]) {
     bm.emplace_back("EuropeanOption::FdEngines", &EuropeanOptionTest::testFdEngines, 148.43);
     bm.emplace_back("FdHestonTest::testFdmHestonAmerican", &FdHestonTest::testFdmHestonAmerican,
                     234.21);
+    bm.emplace_back("FdHestonTest::testParallelAdiSweeps",
+                    &FdHestonTest::testParallelAdiSweeps, 0.0);
+    bm.emplace_back("FdHestonTest::testSerialAdiPricing",
+                    &FdHestonTest::testSerialAdiPricing, 0.0);
+    bm.emplace_back("FdHestonTest::testThreadedAdiPricing",
+                    &FdHestonTest::testThreadedAdiPricing, 0.0);
+    bm.emplace_back("FdmLinearOp::HestonHullWhiteBiCGstab",
+                    &FdmLinearOpTest::testHestonHullWhiteBiCGstab, 0.0);
+    bm.emplace_back("FdmLinearOp::HestonHullWhiteBiCGstabIlu0",
+                    &FdmLinearOpTest::testHestonHullWhiteBiCGstabIlu0, 0.0);
     bm.emplace_back("HestonModel::DAXCalibration", &HestonModelTest::testDAXCalibration, 555.19);
     bm.emplace_back("InterpolationTest::testSabrInterpolation",
                     &InterpolationTest::testSabrInterpolation, 2266.06);
@@ -304,6 +333,12 @@ test_suite* init_unit_test_suite(int, char*[]) {
                     &MarketModelCmsTest::testMultiStepCmSwapsAndSwaptions, 11497.73);
     bm.emplace_back("MarketModelSmmTest::testMultiSmmSwaptions",
                     &MarketModelSmmTest::testMultiStepCoterminalSwapsAndSwaptions, 11244.95);
+    bm.emplace_back("Observable::Registration",
+                    &ObservableTest::testObserverRegistration, 0.0);
+    bm.emplace_back("Observable::Notification",
+                    &ObservableTest::testObserverNotification, 0.0);
+    bm.emplace_back("Observable::Teardown",
+                    &ObservableTest::testObserverTeardown, 0.0);
     bm.emplace_back("QuantoOption::ForwardGreeks", &QuantoOptionTest::testForwardGreeks, 90.98);
     bm.emplace_back("RandomNumber::MersenneTwisterDescrepancy",
                     &LowDiscrepancyTest::testMersenneTwisterDiscrepancy, 951.98);
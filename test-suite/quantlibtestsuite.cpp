@@ -522,6 +522,7 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(NthToDefaultTest::suite(speed));
     test->add(PagodaOptionTest::suite());
     test->add(PartialTimeBarrierOptionTest::suite());
+    test->add(PiecewiseYieldCurveTest::experimental());
     test->add(QuantoOptionTest::experimental());
     test->add(RiskNeutralDensityCalculatorTest::experimental(speed));
     test->add(SofrFuturesTest::suite());
@@ -91,12 +91,117 @@ void RngTraitsTest::testCustomPoisson() {
                    << "    expected:   " << stored);
 }
 
+void RngTraitsTest::testPhilox() {
+
+    BOOST_TEST_MESSAGE("Testing counter-based Philox generator...");
+
+    // known-answer tests of the reference implementation
+    const boost::uint32_t counters[3][4] = {
+        { 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U },
+        { 0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU },
+        { 0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U }
+    };
+    const boost::uint32_t keys[3][2] = {
+        { 0x00000000U, 0x00000000U },
+        { 0xffffffffU, 0xffffffffU },
+        { 0xa4093822U, 0x299f31d0U }
+    };
+    const boost::uint32_t expected[3][4] = {
+        { 0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U },
+        { 0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU },
+        { 0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U }
+    };
+    for (Size i=0; i<3; ++i) {
+        boost::uint32_t output[4];
+        PhiloxUniformRng::encrypt(counters[i], keys[i], output);
+        for (Size j=0; j<4; ++j) {
+            if (output[j] != expected[i][j])
+                BOOST_FAIL("known-answer test #" << i << " failed\n"
+                           << std::hex
+                           << "    calculated: " << output[j] << "\n"
+                           << "    expected:   " << expected[i][j]);
+        }
+    }
+
+    const BigNatural seed = 42, stream = 7;
+    const Size n = 1000;
+    PhiloxUniformRng rng(seed, stream);
+    std::vector<Real> sequential(n);
+    for (Size i=0; i<n; ++i)
+        sequential[i] = rng.next().value;
+
+    // skipping to any position...
+    for (Size position : {0, 1, 3, 4, 5, 63, 64, 65, 257, 999}) {
+        PhiloxUniformRng g(seed);
+        g.seek(stream, position);
+        if (g.position() != position)
+            BOOST_FAIL("wrong position after skipping to " << position);
+        for (Size i=position; i<std::min(n, position+70); ++i) {
+            if (g.nextReal() != sequential[i])
+                BOOST_FAIL("number #" << i << " after skipping to "
+                           << position << " differs from sequential one");
+        }
+    }
+
+    // ...and block generation return the same numbers
+    PhiloxUniformRng g(seed, stream);
+    std::vector<Real> block(n);
+    Size first = 0;
+    for (Size size : {3, 1, 70, 4, 129, 793}) {
+        g.nextBlock(size, &block[first]);
+        first += size;
+    }
+    for (Size i=0; i<n; ++i) {
+        if (block[i] != sequential[i])
+            BOOST_FAIL("number #" << i << " of blocks differs "
+                       "from sequential one");
+    }
+
+    InverseCumulativeNormal icn;
+    PhiloxUniformRng h(seed, stream);
+    h.nextGaussianBlock(n, &block[0]);
+    for (Size i=0; i<n; ++i) {
+        if (block[i] != icn(sequential[i]))
+            BOOST_FAIL("Gaussian number #" << i << " of block differs "
+                       "from sequential one");
+    }
+
+    // different streams must not overlap
+    PhiloxUniformRng other(seed, stream+1);
+    Size equal = 0;
+    for (Size i=0; i<n; ++i)
+        if (other.nextReal() == sequential[i])
+            ++equal;
+    if (equal > 0)
+        BOOST_FAIL(equal << " numbers of adjacent streams coincide");
+
+    // the sequence generators of the traits continue the default
+    // stream when an offset is selected
+    const Size dimension = 13;
+    PhiloxPseudoRandom::rsg_type rsg =
+        PhiloxPseudoRandom::make_sequence_generator(dimension, seed);
+    std::vector<std::vector<Real> > paths(10);
+    for (auto& path : paths)
+        path = rsg.nextSequence().value;
+    for (Size offset=1; offset<paths.size(); ++offset) {
+        RandomStreamSelector selector(offset);
+        PhiloxPseudoRandom::rsg_type g =
+            PhiloxPseudoRandom::make_sequence_generator(dimension, seed);
+        for (Size i=offset; i<paths.size(); ++i) {
+            if (g.nextSequence().value != paths[i])
+                BOOST_FAIL("sequence #" << i << " of stream at offset "
+                           << offset << " differs from serial one");
+        }
+    }
+}
+
 
 test_suite* RngTraitsTest::suite() {
     auto* suite = BOOST_TEST_SUITE("RNG traits tests");
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testGaussian));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testDefaultPoisson));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCustomPoisson));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testPhilox));
     return suite;
 }
 
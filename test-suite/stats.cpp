@@ -24,6 +24,8 @@
 #include "utilities.hpp"
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/statistics/mergeablestatistics.hpp>
+#include <ql/math/statistics/tdigeststatistics.hpp>
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
@@ -123,6 +125,7 @@ void StatisticsTest::testStatistics() {
 
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
+    check<MergeableStatistics>(std::string("MergeableStatistics"));
     check<Statistics>(std::string("Statistics"));
 }
 
@@ -389,11 +392,233 @@ void StatisticsTest::testIncrementalStatistics() {
                                  << tol);
 }
 
+void StatisticsTest::testMergedStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing merged statistics...");
+
+    MersenneTwisterUniformRng mt(42);
+
+    const Size n = 100000;
+    std::vector<Real> x(n), w(n);
+    for (Size i = 0; i < n; ++i) {
+        x[i] = 2.0 * (mt.nextReal() - 0.5) * 1234.0;
+        w[i] = mt.nextReal();
+    }
+    // blocks of uneven size, as left by a parallel simulation
+    const Size bounds[] = { 0, 1, 10, 1000, 1001, 37000, 80000, n };
+
+    IncrementalStatistics reference;
+    MergeableStatistics single, merged;
+    for (Size i = 0; i < n; ++i) {
+        reference.add(x[i], w[i]);
+        single.add(x[i], w[i]);
+    }
+    for (Size k = 0; k < LENGTH(bounds) - 1; ++k) {
+        MergeableStatistics block;
+        for (Size i = bounds[k]; i < bounds[k+1]; ++i)
+            block.add(x[i], w[i]);
+        merged.merge(block);
+    }
+
+    const Real tolerance = 1.0e-10;
+    #define TEST_MERGED_STAT(f)                                                \
+    if (!close_enough(single.f(), reference.f(), 1000)                         \
+        || std::fabs(merged.f() - reference.f())                               \
+           > tolerance * std::fabs(reference.f()))                             \
+        BOOST_ERROR(std::setprecision(16) << std::scientific << #f             \
+                    << " of mergeable statistics differs from reference:\n"    \
+                    << "    single:    " << single.f() << "\n"                 \
+                    << "    merged:    " << merged.f() << "\n"                 \
+                    << "    reference: " << reference.f());
+    TEST_MERGED_STAT(weightSum)
+    TEST_MERGED_STAT(mean)
+    TEST_MERGED_STAT(variance)
+    TEST_MERGED_STAT(errorEstimate)
+    TEST_MERGED_STAT(skewness)
+    TEST_MERGED_STAT(kurtosis)
+    TEST_MERGED_STAT(min)
+    TEST_MERGED_STAT(max)
+    TEST_MERGED_STAT(downsideVariance)
+    #undef TEST_MERGED_STAT
+
+    if (merged.samples() != n || merged.downsideSamples()
+                                 != reference.downsideSamples())
+        BOOST_ERROR("wrong number of merged samples");
+
+    // numerical stability, as for IncrementalStatistics
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal_gen(mt);
+    GeneralStatistics twoPass;
+    MergeableStatistics stable;
+    for (Size k = 0; k < 10; ++k) {
+        MergeableStatistics block;
+        for (Size i = 0; i < 50000; ++i) {
+            Real y = normal_gen.next().value * 1E-1 + 1E8;
+            block.add(y);
+            twoPass.add(y);
+        }
+        stable.merge(block);
+    }
+    if (std::fabs(stable.variance() - twoPass.variance())
+        > 1E-6 * twoPass.variance())
+        BOOST_ERROR("variance (" << stable.variance()
+                    << ") differs from two-pass result "
+                    << twoPass.variance());
+
+    // statistics storing the samples are merged exactly, with and
+    // without unit weights
+    for (bool unitWeights : { true, false }) {
+        Statistics all, joined;
+        for (Size i = 0; i < n; ++i)
+            all.add(x[i], unitWeights ? 1.0 : w[i]);
+        for (Size k = 0; k < LENGTH(bounds) - 1; ++k) {
+            Statistics block;
+            for (Size i = bounds[k]; i < bounds[k+1]; ++i)
+                block.add(x[i], unitWeights ? 1.0 : w[i]);
+            joined.merge(block);
+        }
+        if (joined.samples() != n
+            || joined.mean() != all.mean()
+            || joined.variance() != all.variance()
+            || joined.valueAtRisk(0.99) != all.valueAtRisk(0.99)
+            || joined.expectedShortfall(0.99) != all.expectedShortfall(0.99)
+            || joined.percentile(0.3) != all.percentile(0.3)
+            || joined.topPercentile(0.3) != all.topPercentile(0.3))
+            BOOST_ERROR("merged statistics differ from the ones "
+                        "of the whole sample set"
+                        << (unitWeights ? " with unit weights" : ""));
+        if (joined.data() != all.data())
+            BOOST_ERROR("merged data differ from the whole sample set");
+    }
+
+    // mixed storage: unit weights merged with weighted samples
+    GeneralStatistics unit, weighted, expected;
+    for (Size i = 0; i < 10; ++i) {
+        unit.add(x[i]);
+        weighted.add(x[i+10], w[i+10]);
+        expected.add(x[i]);
+    }
+    for (Size i = 10; i < 20; ++i)
+        expected.add(x[i], w[i]);
+    unit.merge(weighted);
+    if (unit.data() != expected.data())
+        BOOST_ERROR("wrong data after merging weighted samples");
+
+    // sequence statistics
+    SequenceStatistics sequence, sequenceMerged(2), block(2);
+    for (Size i = 0; i < n; ++i) {
+        std::vector<Real> sample = { x[i], x[i]*w[i] };
+        sequence.add(sample, w[i]);
+        block.add(sample, w[i]);
+        if (i == n/2) {
+            sequenceMerged.merge(block);
+            block.reset(2);
+        }
+    }
+    sequenceMerged.merge(block);
+    Matrix c1 = sequence.covariance(), c2 = sequenceMerged.covariance();
+    for (Size i = 0; i < 2; ++i) {
+        for (Size j = 0; j < 2; ++j) {
+            if (std::fabs(c1[i][j] - c2[i][j]) > 1e-10 * std::fabs(c1[i][j]))
+                BOOST_ERROR("wrong merged covariance (" << i << ", " << j
+                            << "): " << c2[i][j] << " instead of "
+                            << c1[i][j]);
+        }
+    }
+}
+
+void StatisticsTest::testTDigestStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing risk statistics based on t-digest sketches...");
+
+    // skewed losses, collected by a few accumulators and merged
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal_gen(mt);
+
+    const Size n = 100000, blocks = 8;
+    RiskStatistics exact;
+    TDigestRiskStatistics single;
+    std::vector<TDigestRiskStatistics> parts(blocks);
+    for (Size i = 0; i < n; ++i) {
+        const Real x = 1.0 - std::exp(0.5*normal_gen.next().value);
+        exact.add(x);
+        single.add(x);
+        parts[i % blocks].add(x);
+    }
+    TDigestRiskStatistics merged;
+    for (const auto& part : parts)
+        merged.merge(part);
+
+    if (merged.samples() != n
+        || std::fabs(merged.mean() - exact.mean()) > 1e-12
+        || std::fabs(merged.variance() - exact.variance())
+            > 1e-10*exact.variance())
+        BOOST_ERROR("wrong moments of merged t-digest statistics"
+                    << "\n    samples:  " << merged.samples()
+                    << "\n    mean:     " << merged.mean()
+                    << "\n    expected: " << exact.mean());
+
+    // the memory used doesn't depend on the number of samples
+    if (merged.centroids() > 200 || single.centroids() > 200)
+        BOOST_ERROR("too many centroids in t-digest statistics"
+                    << "\n    merged: " << merged.centroids()
+                    << "\n    single: " << single.centroids());
+
+    const Real sigma = exact.standardDeviation();
+    const Real tolerance = 1e-2;
+    for (Real p : { 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99 }) {
+        const Real expected = exact.percentile(p);
+        const Real expectedTop = exact.topPercentile(p);
+        const Real scale = std::max(sigma, std::fabs(expected));
+        const Real scaleTop = std::max(sigma, std::fabs(expectedTop));
+        for (const TDigestRiskStatistics* stats : { &merged, &single }) {
+            if (std::fabs(stats->percentile(p) - expected)
+                    > tolerance*scale
+                || std::fabs(stats->topPercentile(p) - expectedTop)
+                    > tolerance*scaleTop)
+                BOOST_ERROR("wrong percentile of t-digest statistics"
+                            << "\n    percentile:   " << p
+                            << "\n    calculated:   " << stats->percentile(p)
+                            << "\n    expected:     " << expected
+                            << "\n    top:          "
+                            << stats->topPercentile(p)
+                            << "\n    expected top: " << expectedTop);
+        }
+    }
+
+    for (Real p : { 0.95, 0.99 }) {
+        const Real expectedVaR = exact.valueAtRisk(p);
+        const Real expectedES = exact.expectedShortfall(p);
+        for (const TDigestRiskStatistics* stats : { &merged, &single }) {
+            const Real VaR = stats->valueAtRisk(p);
+            const Real ES = stats->expectedShortfall(p);
+            if (std::fabs(VaR - expectedVaR) > tolerance*expectedVaR
+                || std::fabs(ES - expectedES) > tolerance*expectedES)
+                BOOST_ERROR("wrong risk measures of t-digest statistics"
+                            << "\n    percentile:  " << p
+                            << "\n    VaR:         " << VaR
+                            << "\n    expected:    " << expectedVaR
+                            << "\n    ES:          " << ES
+                            << "\n    expected:    " << expectedES);
+        }
+    }
+
+    // GeneralStatistics::data() reads the compact storage as it is
+    const RiskStatistics& constExact = exact;
+    const std::vector<std::pair<Real,Real> > data = constExact.data();
+    if (data.size() != n || data.front().second != 1.0
+        || constExact.data()[n-1] != data.back())
+        BOOST_ERROR("wrong data view of unit-weight statistics");
+}
+
 test_suite* StatisticsTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testIncrementalStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testMergedStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testTDigestStatistics));
     return suite;
 }